@@ -0,0 +1,109 @@
+#include "ActivationGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Donya/Constant.h"		// Use scast macro
+
+void ActivationGrid::Build( const std::vector<Donya::Vector3> &wsPoints, float wholeSize )
+{
+	Clear();
+	if ( wsPoints.empty() || wholeSize <= 0.0f ) { return; }
+	// else
+
+	blockWholeSize = wholeSize;
+
+	Donya::Int2 maxBlock{};
+	minBlock.x = maxBlock.x = ToBlockIndex( wsPoints.front().x );
+	minBlock.y = maxBlock.y = ToBlockIndex( wsPoints.front().y );
+	for ( const auto &it : wsPoints )
+	{
+		const int column = ToBlockIndex( it.x );
+		const int row    = ToBlockIndex( it.y );
+		minBlock.x = std::min( minBlock.x, column	);
+		minBlock.y = std::min( minBlock.y, row		);
+		maxBlock.x = std::max( maxBlock.x, column	);
+		maxBlock.y = std::max( maxBlock.y, row		);
+	}
+	blockCount.x = maxBlock.x - minBlock.x + 1;
+	blockCount.y = maxBlock.y - minBlock.y + 1;
+
+	const size_t pointCount = wsPoints.size();
+	std::vector<size_t> blockOfPoints( pointCount );
+	for ( size_t i = 0; i < pointCount; ++i )
+	{
+		const int column = ToBlockIndex( wsPoints[i].x ) - minBlock.x;
+		const int row    = ToBlockIndex( wsPoints[i].y ) - minBlock.y;
+		blockOfPoints[i] = scast<size_t>( row * blockCount.x + column );
+	}
+
+	// Counting sort by the block
+	const size_t wholeBlockCount = scast<size_t>( blockCount.x ) * scast<size_t>( blockCount.y );
+	blockBegins.assign( wholeBlockCount + 1, 0 );
+	for ( const size_t &block : blockOfPoints )
+	{
+		blockBegins[block + 1]++;
+	}
+	for ( size_t i = 0; i < wholeBlockCount; ++i )
+	{
+		blockBegins[i + 1] += blockBegins[i];
+	}
+
+	std::vector<size_t> writePositions( blockBegins.begin(), blockBegins.end() - 1 );
+	pointIndices.resize( pointCount );
+	for ( size_t i = 0; i < pointCount; ++i )
+	{
+		pointIndices[writePositions[blockOfPoints[i]]++] = i;
+	}
+}
+void ActivationGrid::Clear()
+{
+	blockWholeSize	= 0.0f;
+	minBlock		= Donya::Int2{};
+	blockCount		= Donya::Int2{};
+	blockBegins.clear();
+	pointIndices.clear();
+}
+size_t ActivationGrid::Select( const Donya::Collision::Box3F &wsArea, float wsMargin, std::vector<size_t> *pOutIndices ) const
+{
+	if ( !pOutIndices || blockBegins.empty() ) { return 0; }
+	// else
+
+	const Donya::Vector3 center = wsArea.WorldPosition();
+	const Donya::Vector3 extent = wsArea.size + Donya::Vector3{ wsMargin, wsMargin, 0.0f };
+
+	const int beginColumn	= std::max( 0,				ToBlockIndex( center.x - extent.x ) - minBlock.x );
+	const int endColumn		= std::min( blockCount.x,	ToBlockIndex( center.x + extent.x ) - minBlock.x + 1 );
+	const int beginRow		= std::max( 0,				ToBlockIndex( center.y - extent.y ) - minBlock.y );
+	const int endRow		= std::min( blockCount.y,	ToBlockIndex( center.y + extent.y ) - minBlock.y + 1 );
+
+	size_t visitedCount = 0;
+	for ( int row = beginRow; row < endRow; ++row )
+	{
+		for ( int column = beginColumn; column < endColumn; ++column )
+		{
+			const size_t block = scast<size_t>( row * blockCount.x + column );
+			pOutIndices->insert
+			(
+				pOutIndices->end(),
+				pointIndices.begin() + blockBegins[block],
+				pointIndices.begin() + blockBegins[block + 1]
+			);
+			visitedCount++;
+		}
+	}
+
+	return visitedCount;
+}
+size_t ActivationGrid::GetPointCount() const
+{
+	return pointIndices.size();
+}
+size_t ActivationGrid::GetBlockCount() const
+{
+	return ( blockBegins.empty() ) ? 0 : blockBegins.size() - 1;
+}
+int ActivationGrid::ToBlockIndex( float wsCoordinate ) const
+{
+	return scast<int>( std::floor( wsCoordinate / blockWholeSize ) );
+}
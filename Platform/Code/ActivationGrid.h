@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "Donya/Collision.h"
+#include "Donya/Vector.h"
+
+/// <summary>
+/// Buckets the points(e.g. spawn positions) into the blocks of tiles at once, and selects the points of the blocks around a screen.
+/// The selection visits only the overlapped blocks, so its cost does not depend on the whole point count.
+/// It does not use GPU, so you can use it without a window.
+/// </summary>
+class ActivationGrid
+{
+public:
+	/// <summary>
+	/// The default side length of a block, in tile count.
+	/// </summary>
+	static constexpr int defaultBlockTileCount = 16;
+private:
+	float				blockWholeSize	= 0.0f;
+	Donya::Int2			minBlock;					// The block index of the first block
+	Donya::Int2			blockCount;					// X:Column count, Y:Row count
+	std::vector<size_t>	blockBegins;				// [row * columnCount + column] The begin index of "pointIndices". The size is block count + 1.
+	std::vector<size_t>	pointIndices;				// Sorted by the block
+public:
+	/// <summary>
+	/// Buckets the "wsPoints" by the X-Y position. The stored index is the index of "wsPoints".<para></para>
+	/// The "blockWholeSize" is a side length of the block in world space.
+	/// </summary>
+	void Build( const std::vector<Donya::Vector3> &wsPoints, float blockWholeSize );
+	void Clear();
+	/// <summary>
+	/// Appends the indices of the points whose block overlaps the "wsArea" extended by "wsMargin" into "pOutIndices"(it will not be cleared).<para></para>
+	/// Returns the visited block count.
+	/// </summary>
+	size_t Select( const Donya::Collision::Box3F &wsArea, float wsMargin, std::vector<size_t> *pOutIndices ) const;
+public:
+	size_t GetPointCount() const;
+	size_t GetBlockCount() const;
+private:
+	int ToBlockIndex( float wsCoordinate ) const;
+};
@@ -0,0 +1,94 @@
+#include "AnimationLOD.h"
+
+namespace AnimationLOD
+{
+	namespace
+	{
+		static int evaluatedCount	= 0;
+		static int skippedCount		= 0;
+	}
+
+	Level Judge( const Donya::Collision::Box3F &wsBody, const Donya::Collision::Box3F &wsScreen )
+	{
+		if ( !wsScreen.exist ) { return Level::Full; }
+		// else
+
+		if ( Donya::Collision::IsHit( wsBody, wsScreen, /* considerExistFlag = */ false ) ) { return Level::Full; }
+		// else
+
+		Donya::Collision::Box3F nearArea = wsScreen;
+		nearArea.size.x += nearMargin;
+		nearArea.size.y += nearMargin;
+		return	( Donya::Collision::IsHit( wsBody, nearArea, /* considerExistFlag = */ false ) )
+				? Level::Reduced
+				: Level::Frozen;
+	}
+	Level Judge( const Donya::Vector3 &wsPos, const Donya::Collision::Box3F &wsScreen )
+	{
+		const Donya::Collision::Box3F point{ wsPos, Donya::Vector3::Zero() };
+		return Judge( point, wsScreen );
+	}
+
+	void  Throttle::SetLevel( Level newLevel )
+	{
+		level = newLevel;
+	}
+	Level Throttle::GetLevel() const
+	{
+		return level;
+	}
+	bool  Throttle::Consume( float elapsedTime, float *pOutElapsedTime )
+	{
+		pendingSecond += elapsedTime;
+
+		switch ( level )
+		{
+		case Level::Reduced:
+			waitFrame++;
+			if ( waitFrame < reducedInterval )
+			{
+				skippedCount++;
+				return false;
+			}
+			break;
+		case Level::Frozen:
+			skippedCount++;
+			return false;
+		default: break;
+		}
+
+		// Apply all the pending time, it also catches up the frozen time at re-entry
+		if ( pOutElapsedTime ) { *pOutElapsedTime = pendingSecond; }
+		pendingSecond	= 0.0f;
+		waitFrame		= 0;
+
+		evaluatedCount++;
+		return true;
+	}
+
+	void ResetStatistics()
+	{
+		evaluatedCount	= 0;
+		skippedCount	= 0;
+	}
+	int  GetEvaluatedCount()
+	{
+		return evaluatedCount;
+	}
+	int  GetSkippedCount()
+	{
+		return skippedCount;
+	}
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		ImGui::Text( u8"]F%d", evaluatedCount );
+		ImGui::Text( u8"ȗF%d", skippedCount );
+
+		ImGui::TreePop();
+	}
+#endif // USE_IMGUI
+}
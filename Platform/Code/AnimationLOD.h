@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+
+#include "Donya/Collision.h"
+#include "Donya/UseImGui.h"	// Use USE_IMGUI macro
+#include "Donya/Vector.h"
+
+/// <summary>
+/// Decides how often an object evaluates its motion, by the distance from the screen.
+/// </summary>
+namespace AnimationLOD
+{
+	enum class Level
+	{
+		Full,		// Evaluate every frame
+		Reduced,	// Evaluate every "reducedInterval" frames with the accumulated time
+		Frozen,		// Do not evaluate, but accumulate the time for catching up at re-entry
+	};
+
+	static constexpr float	nearMargin		= 4.0f;	// [m] The area around the screen that uses the Reduced level
+	static constexpr int	reducedInterval	= 3;	// [frame]
+
+	/// <summary>
+	/// Returns Level::Full if the "wsScreenHitBox" does not exist.
+	/// </summary>
+	Level Judge( const Donya::Collision::Box3F &wsBody, const Donya::Collision::Box3F &wsScreenHitBox );
+	/// <summary>
+	/// Returns Level::Full if the "wsScreenHitBox" does not exist.
+	/// </summary>
+	Level Judge( const Donya::Vector3 &wsPos, const Donya::Collision::Box3F &wsScreenHitBox );
+
+	/// <summary>
+	/// Holds the time that was not applied to the motion yet. Each object has one.
+	/// </summary>
+	class Throttle
+	{
+	private:
+		Level	level			= Level::Full;
+		float	pendingSecond	= 0.0f;
+		int		waitFrame		= 0;
+	public:
+		void  SetLevel( Level newLevel );
+		Level GetLevel() const;
+		/// <summary>
+		/// Returns true if the motion should be evaluated at this frame, then "pOutElapsedTime" receives the elapsed time that includes the skipped time.
+		/// Returns false if the evaluation should be skipped. The skipped time will be applied at the next evaluation.
+		/// It also counts the statistics.
+		/// </summary>
+		bool  Consume( float elapsedTime, float *pOutElapsedTime );
+	};
+
+	/// <summary>
+	/// Clear the counts of evaluation. Please call it at the beginning of a frame.
+	/// </summary>
+	void ResetStatistics();
+	int  GetEvaluatedCount();
+	int  GetSkippedCount();
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
+}
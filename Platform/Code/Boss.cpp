@@ -28,39 +28,40 @@ namespace Boss
 
 		static std::array<std::shared_ptr<ModelHelper::SkinningSet>, kindCount> modelPtrs{ nullptr };
 
-		bool LoadModels()
+		// A boss plays one motion at a time, so it draws by the palette baked at this rate
+		constexpr float paletteBakeStep = 1.0f / 60.0f;
+
+		std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeLoads()
 		{
 			const std::string folderName = modelFolderName;
-			bool succeeded = true;
-			std::string filePath{};
+			std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> loads{};
 			for ( size_t i = 0; i < kindCount; ++i )
 			{
 				if ( modelPtrs[i] ) { continue; }
 				// else
 
-				filePath = MakeModelPath( folderName + modelNames[i] );
-
-				if ( !Donya::IsExistFile( filePath ) )
-				{
-					const std::string msg = "Error: File is not found: " + filePath + "\n";
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
-
-				modelPtrs[i] = std::make_shared<ModelHelper::SkinningSet>();
-				const bool result = ModelHelper::Load( filePath, modelPtrs[i].get() );
-				if ( !result )
+				auto StoreModel = [i]( const std::shared_ptr<ModelHelper::SkinningSet> &pModel )
 				{
-					modelPtrs[i].reset(); // Make not loaded state
+					if ( !pModel->palette.IsBaked() )
+					{
+						pModel->palette.Bake( pModel->model, pModel->motionHolder, paletteBakeStep );
+					}
+					modelPtrs[i] = pModel;
+				};
+				loads.emplace_back
+				(
+					std::make_shared<ModelHelper::StagedSkinningLoad>( MakeModelPath( folderName + modelNames[i] ), StoreModel )
+				);
+			}
 
-					const std::string msg = "Failed: Loading failed: " + filePath;
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
+			return loads;
+		}
+		bool LoadModels()
+		{
+			bool succeeded = true;
+			for ( const auto &pLoad : MakeLoads() )
+			{
+				if ( !pLoad->LoadAll() ) { succeeded = false; }
 			}
 
 			return succeeded;
@@ -118,6 +119,10 @@ namespace Boss
 		Parameter::Load();
 		return LoadModels();
 	}
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads()
+	{
+		return MakeLoads();
+	}
 
 #if USE_IMGUI
 	void InitializeParam::ShowImGuiNode( const std::string &nodeCaption )
@@ -204,6 +209,7 @@ namespace Boss
 	void Base::Update( float elapsedTime, const Input &input )
 	{
 		hurtBox.UpdateIgnoreList( elapsedTime );
+		motionThrottle.SetLevel( AnimationLOD::Judge( body, input.wsScreenHitBox ) );
 
 		if ( NowDead() ) { return; }
 		// else
@@ -241,7 +247,14 @@ namespace Boss
 		pRenderer->UpdateConstant( modelConstant );
 		pRenderer->ActivateConstantModel();
 
-		pRenderer->Render( model.pResource->model, model.pose );
+		if ( model.CanDrawByPalette() )
+		{
+			pRenderer->Render( model.pResource->model, model.pResource->palette, model.assignedMotionIndex, model.CalcMotionSeconds() );
+		}
+		else
+		{
+			pRenderer->Render( model.pResource->model, model.pose );
+		}
 
 		pRenderer->DeactivateConstantModel();
 	}
@@ -371,12 +384,21 @@ namespace Boss
 	{
 		hurtBox.exist = ( invincibleTimer.NowWorking() ) ? false : true;
 	}
-	void Base::UpdateMotionIfCan( float elapsedTime, int motionIndex )
+	void Base::UpdateMotionIfCan( float elapsedTime, int motionIndex, bool fullRate )
 	{
 		if ( !model.IsAssignableIndex( motionIndex ) ) { return; }
 		// else
 
-		model.UpdateMotion( elapsedTime, motionIndex );
+		if ( fullRate )
+		{
+			motionThrottle.SetLevel( AnimationLOD::Level::Full );
+		}
+
+		float motionElapsedTime = 0.0f;
+		if ( !motionThrottle.Consume( elapsedTime, &motionElapsedTime ) ) { return; }
+		// else
+
+		model.UpdateMotion( motionElapsedTime, motionIndex );
 	}
 	std::vector<Donya::Collision::Box3F> Base::FetchSolidsByBody( const Map &terrain, const Donya::Collision::Box3F &hitBox, float elapsedTime, const Donya::Vector3 &currentVelocity )
 	{
@@ -492,6 +514,12 @@ namespace Boss
 		
 		initializer.ShowImGuiNode( u8"p[^" );
 
+		static ModelHelper::PaletteBenchmark paletteBenchmark{};
+		paletteBenchmark.ShowImGuiNode( u8"pbgĂ݂̌v", model.pResource.get() );
+
+		static ModelHelper::CompressionBenchmark compressionBenchmark{};
+		compressionBenchmark.ShowImGuiNode( u8"[Vǩv", model.pResource.get() );
+
 		ImGui::DragFloat3( u8"[hW", &body.pos.x, 0.01f );
 		ImGui::Helper::ShowFrontNode( u8"O", &orientation );
 
@@ -635,13 +663,17 @@ namespace Boss
 	{
 		return bosses.size();
 	}
+	std::string Container::MakeStageFilePath( int stageNumber, bool fromBinary )
+	{
+		return	( fromBinary )
+				? MakeStageParamPathBinary( ID, stageNumber )
+				: MakeStageParamPathJson  ( ID, stageNumber );
+	}
 	bool Container::LoadBosses( int stageNumber, bool fromBinary )
 	{
 		ClearAllBosses();
 
-		const std::string filePath	= ( fromBinary )
-									? MakeStageParamPathBinary( ID, stageNumber )
-									: MakeStageParamPathJson  ( ID, stageNumber );
+		const std::string filePath	= MakeStageFilePath( stageNumber, fromBinary );
 		Donya::Serializer tmp;
 		const bool succeeded		= ( fromBinary )
 									? tmp.LoadBinary( *this, filePath.c_str(), ID )
@@ -18,6 +18,7 @@
 #include "Donya/Serializer.h"
 #include "Donya/Vector.h"
 
+#include "AnimationLOD.h"
 #include "CSVLoader.h"
 #include "Damage.h"
 #include "Effect/Effect.h"
@@ -55,6 +56,11 @@ namespace Boss
 	}
 
 	bool LoadResource();
+	/// <summary>
+	/// Makes the loads of the models that have not been loaded. Each load stores its model when it finishes.<para></para>
+	/// It is for loading by the stages, so please call Parameter::Load() also. LoadResource() does both.
+	/// </summary>
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads();
 
 	struct Input
 	{
@@ -62,6 +68,7 @@ namespace Boss
 		Donya::Vector2 controllerInputDirection;
 		bool pressJump = false;
 		bool pressShot = false;
+		Donya::Collision::Box3F wsScreenHitBox = Donya::Collision::Box3F::Nil(); // Used for the animation LOD. The Nil means always full rate.
 	};
 
 	struct InitializeParam
@@ -115,6 +122,7 @@ namespace Boss
 		Donya::Collision::Box3F			roomArea;	// World space
 	protected:
 		ModelHelper::SkinningOperator	model;
+		AnimationLOD::Throttle			motionThrottle;
 		using					 Actor::body;		// VS a terrain
 		Donya::Collision::Box3F			hurtBox;	// VS an attack
 		using					 Actor::orientation;
@@ -192,7 +200,11 @@ namespace Boss
 		virtual void DieMoment();
 	protected:
 		void UpdateInvincibleExistence();
-		void UpdateMotionIfCan( float elapsedTime, int motionIndex );
+		/// <summary>
+		/// Evaluates the motion through the motion throttle.
+		/// Please set true to "fullRate" when the gameplay waits the end of the motion(WasEnded()), then the throttle does not delay it.
+		/// </summary>
+		void UpdateMotionIfCan( float elapsedTime, int motionIndex, bool fullRate = false );
 		std::vector<Donya::Collision::Box3F> FetchSolidsByBody( const Map &terrain, const Donya::Collision::Box3F &hitBoxVSTerrain, float elapsedTime, const Donya::Vector3 &currentVelocity );
 		/// <summary>
 		/// Returns the return value of Actor::MoveX().
@@ -301,6 +313,10 @@ namespace Boss
 		std::shared_ptr<const Base> GetBossOrNullptr( int roomID ) const;
 		void StartupBossIfStandby( int roomID );
 		size_t GetBossCount() const;
+		/// <summary>
+		/// Returns the path of the file that Init() reads.
+		/// </summary>
+		static std::string MakeStageFilePath( int stageNumber, bool fromBinary );
 	private:
 		bool LoadBosses( int stageNumber, bool fromBinary );
 		void AppearBoss( size_t appearIndex );
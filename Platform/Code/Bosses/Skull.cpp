@@ -69,9 +69,10 @@ namespace Boss
 		const size_t currentMotionIndex	= scast<size_t>( ToMotionIndex( currKind ) );
 		const size_t playSpeedCount		= data.animePlaySpeeds.size();
 		const float  motionAcceleration	= ( playSpeedCount <= currentMotionIndex ) ? 1.0f : data.animePlaySpeeds[currentMotionIndex];
-		inst.model.animator.Update( elapsedTime * motionAcceleration );
-		
-		AssignPose( inst, currKind );
+
+		// The non-loop motions decide the timing of next action by WasCurrentMotionEnded(), so I do not throttle them.
+		const bool fullRate = !ShouldEnableLoop( currKind );
+		inst.UpdateMotionIfCan( elapsedTime * motionAcceleration, ToMotionIndex( currKind ), fullRate );
 	}
 	void Skull::MotionManager::ChangeMotion( Skull &inst, MotionKind nextKind, bool resetTimerIfSameMotion )
 	{
@@ -32,39 +32,37 @@ namespace Bullet
 
 		static std::array<std::shared_ptr<ModelHelper::SkinningSet>, kindCount> modelPtrs{ nullptr };
 
-		bool LoadModels()
+		// Many bullets of the same kind play the same motion, so they share the poses quantized by this
+		constexpr float poseCacheStep = 1.0f / 60.0f;
+
+		std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeLoads()
 		{
 			const std::string folderName = modelFolderName;
-			bool succeeded = true;
-			std::string filePath{};
+			std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> loads{};
 			for ( size_t i = 0; i < kindCount; ++i )
 			{
 				if ( modelPtrs[i] ) { continue; }
 				// else
 
-				filePath = MakeModelPath( folderName + modelNames[i] );
-
-				if ( !Donya::IsExistFile( filePath ) )
+				auto StoreModel = [i]( const std::shared_ptr<ModelHelper::SkinningSet> &pModel )
 				{
-					const std::string msg = "Error: File is not found: " + filePath + "\n";
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
-
-				modelPtrs[i] = std::make_shared<ModelHelper::SkinningSet>();
-				const bool result = ModelHelper::Load( filePath, modelPtrs[i].get() );
-				if ( !result )
-				{
-					modelPtrs[i].reset(); // Make not loaded state
+					pModel->poseCache.Enable( poseCacheStep );
+					modelPtrs[i] = pModel;
+				};
+				loads.emplace_back
+				(
+					std::make_shared<ModelHelper::StagedSkinningLoad>( MakeModelPath( folderName + modelNames[i] ), StoreModel )
+				);
+			}
 
-					const std::string msg = "Failed: Loading failed: " + filePath;
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
+			return loads;
+		}
+		bool LoadModels()
+		{
+			bool succeeded = true;
+			for ( const auto &pLoad : MakeLoads() )
+			{
+				if ( !pLoad->LoadAll() ) { succeeded = false; }
 			}
 
 			return succeeded;
@@ -149,6 +147,10 @@ namespace Bullet
 		Parameter::Load();
 		return LoadModels();
 	}
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads()
+	{
+		return MakeLoads();
+	}
 
 #if USE_IMGUI
 	constexpr const char *GetKindName( Kind kind )
@@ -280,6 +282,8 @@ namespace Bullet
 		body.UpdateIgnoreList( elapsedTime );
 		hitSphere.UpdateIgnoreList( elapsedTime );
 
+		motionThrottle.SetLevel( AnimationLOD::Judge( GetPosition(), wsScreen ) );
+
 		secondToRemove -= elapsedTime;
 		if ( secondToRemove <= 0.0f )
 		{
@@ -492,7 +496,7 @@ namespace Bullet
 	}
 	void Base::PlayProtectedSE() const
 	{
-		Donya::Sound::Play( Music::Bullet_Protected );
+		Donya::Sound::RequestPlay( Music::Bullet_Protected );
 	}
 	void Base::CollidedProcess()
 	{
@@ -563,7 +567,11 @@ namespace Bullet
 		if ( !model.IsAssignableIndex( motionIndex ) ) { return; }
 		// else
 
-		model.UpdateMotion( elapsedTime, motionIndex );
+		float motionElapsedTime = 0.0f;
+		if ( !motionThrottle.Consume( elapsedTime, &motionElapsedTime ) ) { return; }
+		// else
+
+		model.UpdateMotion( motionElapsedTime, motionIndex );
 	}
 	Donya::Vector4x4 Base::MakeWorldMatrix( const Donya::Vector3 &scale, bool enableRotation, const Donya::Vector3 &translation ) const
 	{
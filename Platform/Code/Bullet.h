@@ -14,6 +14,7 @@
 #include "Donya/UseImGui.h"
 #include "Donya/Vector.h"
 
+#include "AnimationLOD.h"
 #include "Damage.h"
 #include "Map.h"
 #include "ModelHelper.h"
@@ -69,6 +70,11 @@ namespace Bullet
 	}
 
 	bool LoadResource();
+	/// <summary>
+	/// Makes the loads of the models that have not been loaded. Each load stores its model when it finishes.<para></para>
+	/// It is for loading by the stages, so please call Parameter::Load() also. LoadResource() does both.
+	/// </summary>
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads();
 
 	/// <summary>
 	/// Generate parameters. Descriptor.
@@ -122,6 +128,7 @@ namespace Bullet
 	{
 	protected:
 		ModelHelper::SkinningOperator	model;
+		AnimationLOD::Throttle			motionThrottle;
 		// Please make unused hit box has zero sizes(or radius), and false exist flag.
 		using					 Solid::body;		// Hit box as AABB
 		Donya::Collision::Sphere3F		hitSphere;	// Hit box as Sphere
@@ -4,6 +4,7 @@
 
 #include "../Effect/EffectAdmin.h"
 #include "../Effect/EffectKind.h"
+#include "../Effect/Particle.h"
 #include "../Music.h"
 #include "../Parameter.h"
 #include "../PointLightStorage.h"
@@ -103,6 +104,8 @@ namespace Bullet
 		}
 
 		Base::Init( adjusted );
+
+		Effect::Particle::Admin::Get().Emit( Effect::Particle::Kind::MuzzleFlash, adjusted.position, adjusted.direction );
 	}
 	void Buster::Uninit()
 	{
@@ -130,10 +133,11 @@ namespace Bullet
 	void Buster::GenerateCollidedEffect() const
 	{
 		Effect::Admin::Get().GenerateInstance( Effect::Kind::Hit_Buster, GetPosition() );
+		Effect::Particle::Admin::Get().Emit( Effect::Particle::Kind::HitSpark, GetPosition() );
 	}
 	void Buster::PlayCollidedSE() const
 	{
-		Donya::Sound::Play( Music::Bullet_HitBuster );
+		Donya::Sound::RequestPlay( Music::Bullet_HitBuster );
 	}
 	Definition::Damage Buster::GetDamageParameter() const
 	{
@@ -65,7 +65,7 @@ namespace Bullet
 	}
 	void SkullBuster::PlayCollidedSE() const
 	{
-		Donya::Sound::Play( Music::Bullet_HitBuster );
+		Donya::Sound::RequestPlay( Music::Bullet_HitBuster );
 	}
 	Definition::Damage SkullBuster::GetDamageParameter() const
 	{
@@ -197,7 +197,7 @@ namespace Bullet
 	}
 	void SkullShield::PlayCollidedSE() const
 	{
-		Donya::Sound::Play( Music::Bullet_HitShield );
+		Donya::Sound::RequestPlay( Music::Bullet_HitShield );
 	}
 	Definition::Damage SkullShield::GetDamageParameter() const
 	{
@@ -109,7 +109,7 @@ namespace Bullet
 	void SuperBall::PlayCollidedSE() const
 	{
 		// TODO: Change to a designated SE
-		Donya::Sound::Play( Music::Bullet_HitBuster );
+		Donya::Sound::RequestPlay( Music::Bullet_HitBuster );
 	}
 	Definition::Damage SuperBall::GetDamageParameter() const
 	{
@@ -113,15 +113,21 @@ namespace CheckPoint
 		LoadBin( stageNo );
 	#endif // DEBUG_MODE
 	}
+	std::string Container::MakeStageFilePath( int stageNo, bool fromBinary )
+	{
+		return	( fromBinary )
+				? MakeStageParamPathBinary( ID, stageNo )
+				: MakeStageParamPathJson  ( ID, stageNo );
+	}
 	void Container::LoadBin( int stageNo )
 	{
 		Donya::Serializer tmp;
-		tmp.LoadBinary( *this, MakeStageParamPathBinary( ID, stageNo ).c_str(), ID );
+		tmp.LoadBinary( *this, MakeStageFilePath( stageNo, /* fromBinary = */ true ).c_str(), ID );
 	}
 	void Container::LoadJson( int stageNo )
 	{
 		Donya::Serializer tmp;
-		tmp.LoadJSON( *this, MakeStageParamPathJson( ID, stageNo ).c_str(), ID );
+		tmp.LoadJSON( *this, MakeStageFilePath( stageNo, /* fromBinary = */ false ).c_str(), ID );
 	}
 	#if USE_IMGUI
 	void Container::RemakeByCSV( const CSVLoader &loadedData )
@@ -87,6 +87,10 @@ namespace CheckPoint
 		Instance *FetchPassedPointOrNullptr( const Donya::Collision::Box3F &wsVerifyArea );
 	public:
 		void LoadParameter( int stageNo );
+		/// <summary>
+		/// Returns the path of the file that LoadParameter() reads.
+		/// </summary>
+		static std::string MakeStageFilePath( int stageNo, bool fromBinary );
 	private:
 		void LoadBin( int stageNo );
 		void LoadJson( int stageNo );
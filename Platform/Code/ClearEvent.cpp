@@ -80,11 +80,15 @@ void ClearEvent::ApplyRoomID( const House &house )
 		it.roomID = house.CalcBelongRoomID( it.wsPos );
 	}
 }
+std::string ClearEvent::MakeStageFilePath( int stageNo, bool fromBinary )
+{
+	return	( fromBinary )
+			? MakeStageParamPathBinary( serializeID, stageNo )
+			: MakeStageParamPathJson  ( serializeID, stageNo );
+}
 bool ClearEvent::LoadEvents( int stageNo, bool fromBinary )
 {
-	const std::string filePath	= ( fromBinary )
-								? MakeStageParamPathBinary( serializeID, stageNo )
-								: MakeStageParamPathJson  ( serializeID, stageNo );
+	const std::string filePath = MakeStageFilePath( stageNo, fromBinary );
 	Donya::Serializer tmp;
 	return	( fromBinary )
 			? tmp.LoadBinary( *this, filePath.c_str(), serializeID )
@@ -61,6 +61,10 @@ public:
 public:
 	void ApplyRoomID( const House &house );
 	bool LoadEvents( int stageNo, bool fromBinary );
+	/// <summary>
+	/// Returns the path of the file that LoadEvents() reads.
+	/// </summary>
+	static std::string MakeStageFilePath( int stageNo, bool fromBinary );
 #if USE_IMGUI
 public:
 	void RemakeByCSV( const CSVLoader &loadedData );
@@ -0,0 +1,203 @@
+#include "CollisionPass.h"
+
+#include <memory>
+
+#include "Bullet.h"
+#include "Damage.h"
+
+namespace CollisionPass
+{
+	namespace
+	{
+		using Layer		= CollisionWorld::Layer;
+		using Volume	= CollisionWorld::Volume;
+
+		bool Contains( CollisionWorld::LayerMask layers, Layer layer )
+		{
+			return ( layers & CollisionWorld::ToMask( layer ) ) ? true : false;
+		}
+		bool IsPlayerBullet( const Donya::Collision::IDType playerCollisionID, const std::shared_ptr<const Bullet::Base> &pBullet )
+		{
+			if ( playerCollisionID == Donya::Collision::invalidID ) { return false; }
+			// else
+
+			const auto bulletAABB	= pBullet->GetHitBox();
+			const auto bulletSphere	= pBullet->GetHitSphere();
+			const auto activeOwnerID= ( bulletSphere.exist ) ? bulletSphere.ownerID : bulletAABB.ownerID;
+			return ( activeOwnerID == playerCollisionID ) ? true : false;
+		}
+		Volume MakeBulletVolume( Layer layer, size_t bulletIndex, const std::shared_ptr<const Bullet::Base> &pBullet )
+		{
+			Volume tmp{};
+			tmp.aabb				= pBullet->GetHitBox();
+			tmp.sphere				= pBullet->GetHitSphere();
+			tmp.aabbSubtractor		= pBullet->GetHitBoxSubtractor();
+			tmp.sphereSubtractor	= pBullet->GetHitSphereSubtractor();
+			// The bullet's hit box is only either AABB or Sphere is valid
+			tmp.useSphere			= !tmp.aabb.exist;
+			tmp.layer				= layer;
+			tmp.userIndex			= bulletIndex;
+			return tmp;
+		}
+	}
+
+	void RegisterBullets( CollisionWorld *pWorld, Donya::Collision::IDType playerID, CollisionWorld::LayerMask layers )
+	{
+		if ( !pWorld ) { return; }
+		if ( !Contains( layers, Layer::PlayerBullet ) && !Contains( layers, Layer::EnemyBullet ) ) { return; }
+		// else
+
+		auto &bulletAdmin = Bullet::Admin::Get();
+		const size_t bulletCount = bulletAdmin.GetInstanceCount();
+		for ( size_t i = 0; i < bulletCount; ++i )
+		{
+			const auto pBullet = bulletAdmin.GetInstanceOrNullptr( i );
+			if ( !pBullet ) { continue; }
+			// else
+
+			const Layer layer = ( IsPlayerBullet( playerID, pBullet ) ) ? Layer::PlayerBullet : Layer::EnemyBullet;
+			if ( !Contains( layers, layer ) ) { continue; }
+			// else
+
+			pWorld->Register( MakeBulletVolume( layer, i, pBullet ) );
+		}
+	}
+
+	void BulletVSBullet( const CollisionWorld &world )
+	{
+		auto &bulletAdmin = Bullet::Admin::Get();
+
+		std::shared_ptr<const Bullet::Base> pA = nullptr;
+		std::shared_ptr<const Bullet::Base> pB = nullptr;
+		auto Protectible	= []( const std::shared_ptr<const Bullet::Base> &pBullet )
+		{
+			using D = Definition::Damage;
+			return ( pBullet ) ? D::Contain( D::Type::Protection, pBullet->GetDamage().type ) : false;
+		};
+		auto HitProcess		= [&]( const auto &hitBoxA, const auto &hitBoxB )
+		{
+			if ( !pA || !pB ) { return; }
+			// else
+
+			const bool protectibleA = Protectible( pA );
+			const bool protectibleB = Protectible( pB );
+			if ( protectibleA ) { pB->ProtectedBy( hitBoxA ); }
+			if ( protectibleB ) { pA->ProtectedBy( hitBoxB ); }
+			if ( protectibleA || protectibleB ) { return; }
+			// else
+
+			const bool destructibleA = pA->Destructible();
+			const bool destructibleB = pB->Destructible();
+			pA->CollidedToObject( destructibleB );
+			pB->CollidedToObject( destructibleA );
+		};
+		auto HitProcessVS	= [&]( const auto &hitBoxA, const Volume &volumeB )
+		{
+			if ( volumeB.useSphere )
+			{
+				HitProcess( hitBoxA, volumeB.sphere );
+			}
+			else
+			{
+				HitProcess( hitBoxA, volumeB.aabb );
+			}
+		};
+
+		// The layers are different, so the owners of the pair are different
+		world.ForEachContact
+		(
+			Layer::PlayerBullet, Layer::EnemyBullet,
+			[&]( const Volume &volumeA, const Volume &volumeB )
+			{
+				pA = bulletAdmin.GetInstanceOrNullptr( volumeA.userIndex );
+				pB = bulletAdmin.GetInstanceOrNullptr( volumeB.userIndex );
+				if ( !pA || !pB ) { return; }
+				// else
+
+				// Disallow collision between a protected bullet.
+				// Because if allowed hitting to multiple objects in the same timing,
+				// the protection attribute does not affect to some another object that collided in the same timing.
+				// That bullet's collision will be disabled at next update, but I wanna apply immediately.
+				if ( pA->WasProtected() || pB->WasProtected() ) { return; }
+				// else
+
+				// Do collide if either one of bullet is destructible or protectible
+				const bool wantCollide	=  pA->Destructible()	|| pB->Destructible()
+										|| Protectible( pA )	|| Protectible( pB );
+				if ( !wantCollide ) { return; }
+				// else
+
+				if ( volumeA.useSphere )
+				{
+					HitProcessVS( volumeA.sphere, volumeB );
+				}
+				else
+				{
+					HitProcessVS( volumeA.aabb, volumeB );
+				}
+			}
+		);
+	}
+
+	void BulletVSEnemy( const CollisionWorld &world, const EnemyFetcher &fetchEnemy, const DefeatHandler &onDefeated )
+	{
+		if ( !fetchEnemy ) { return; }
+		// else
+
+		auto &bulletAdmin = Bullet::Admin::Get();
+
+		// The contacts are ordered by the bullet, and each pair of the bullet and the enemy appears only once.
+		// So I process the contacts per bullet, and apply the result when the bullet changes.
+		constexpr size_t noBullet = scast<size_t>( -1 );
+		size_t bulletIndex = noBullet;
+		bool   collided	= false;
+		bool   pierced	= false;
+		std::shared_ptr<const Bullet::Base> pBullet = nullptr;
+		auto ApplyResult = [&]()
+		{
+			if ( pBullet && collided )
+			{
+				pBullet->CollidedToObject( pierced );
+			}
+		};
+
+		world.ForEachContact
+		(
+			Layer::PlayerBullet, Layer::EnemyHurtBox,
+			[&]( const Volume &bulletVolume, const Volume &enemyVolume )
+			{
+				if ( bulletVolume.userIndex != bulletIndex )
+				{
+					ApplyResult();
+
+					bulletIndex	= bulletVolume.userIndex;
+					collided	= false;
+					pierced		= true;
+					pBullet		= bulletAdmin.GetInstanceOrNullptr( bulletIndex );
+					if ( pBullet && pBullet->WasProtected() ) { pBullet = nullptr; }
+				}
+
+				if ( !pBullet ) { return; }
+				// else
+
+				const Enemy::Base *pEnemy = fetchEnemy( enemyVolume.userIndex );
+				if ( !pEnemy ) { return; }
+				// else
+
+				collided = true;
+
+				pEnemy->GiveDamage( pBullet->GetDamage() );
+				if ( pEnemy->WillDie() )
+				{
+					if ( onDefeated ) { onDefeated( *pEnemy ); }
+				}
+				else
+				{
+					pierced = false;
+				}
+			}
+		);
+
+		ApplyResult();
+	}
+}
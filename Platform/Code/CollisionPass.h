@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+
+#include "Donya/Collision.h"
+
+#include "CollisionWorld.h"
+#include "Enemy.h"
+
+/// <summary>
+/// The collision passes that are shared between the scenes.
+/// A scene regenerates the contacts of CollisionWorld before each pass,
+/// because a previous pass may change the volumes(e.g. a bullet was protected, an enemy died).
+/// </summary>
+namespace CollisionPass
+{
+	/// <summary>
+	/// Registers the bullets of the Bullet::Admin that belong to the "layers".
+	/// The bullets that are owned by the "playerID" belong to the PlayerBullet, the others belong to the EnemyBullet.
+	/// Please register the bullets before the other objects, because the BulletVSEnemy() expects the contacts are ordered by the bullet.
+	/// </summary>
+	void RegisterBullets( CollisionWorld *pWorld, Donya::Collision::IDType playerID, CollisionWorld::LayerMask layers );
+
+	/// <summary>
+	/// Applies the contacts between the PlayerBullet and the EnemyBullet.
+	/// </summary>
+	void BulletVSBullet( const CollisionWorld &world );
+
+	using EnemyFetcher	= std::function<const Enemy::Base *( size_t userIndex )>;
+	using DefeatHandler	= std::function<void( const Enemy::Base &defeatedEnemy )>;
+	/// <summary>
+	/// Applies the contacts between the PlayerBullet and the EnemyHurtBox.
+	/// The "fetchEnemy" returns the enemy of the volume's userIndex, or nullptr.
+	/// The "onDefeated" is called when the enemy will die by the bullet. It may be empty.
+	/// </summary>
+	void BulletVSEnemy( const CollisionWorld &world, const EnemyFetcher &fetchEnemy, const DefeatHandler &onDefeated );
+}
@@ -0,0 +1,296 @@
+#include "CollisionWorld.h"
+
+#include <algorithm>				// Use std::sort, std::min, std::max
+#include <type_traits>				// Use std::decay_t
+
+#include "Donya/Benchmark.h"
+
+#undef max
+#undef min
+
+namespace
+{
+	namespace Col = Donya::Collision;
+	using Volume = CollisionWorld::Volume;
+
+	template<typename Process>
+	bool VisitBody( const Volume &volume, Process process )
+	{
+		return ( volume.useSphere ) ? process( volume.sphere ) : process( volume.aabb );
+	}
+
+	/// <summary>
+	/// body VS ( subtracted.body - subtracted.subtractor )
+	/// </summary>
+	template<typename Body>
+	bool IsHitVSSubtracted( const Body &body, const Volume &subtracted, bool considerExistFlag )
+	{
+		auto IsHitImpl = [&]( const auto &lhs )
+		{
+			using LHS = std::decay_t<decltype( lhs )>;
+			if ( subtracted.aabbSubtractor.exist )
+			{
+				const Col::Solid<LHS, Col::Box3F> solid{ lhs, subtracted.aabbSubtractor };
+				return Col::IsHitVSSubtracted( body, solid, considerExistFlag );
+			}
+			// else
+
+			const Col::Solid<LHS, Col::Sphere3F> solid{ lhs, subtracted.sphereSubtractor };
+			return Col::IsHitVSSubtracted( body, solid, considerExistFlag );
+		};
+		return VisitBody( subtracted, IsHitImpl );
+	}
+
+	bool IsHit( const Volume &a, const Volume &b )
+	{
+		const bool considerExistFlag = !( a.ignoreExistFlag || b.ignoreExistFlag );
+		const bool subtractA = a.HasSubtractor();
+		const bool subtractB = b.HasSubtractor();
+
+		// Do not use subtraction version.
+		// The both subtractors version is not supported yet.
+		if ( subtractA == subtractB )
+		{
+			return VisitBody
+			(
+				a, [&]( const auto &bodyA )
+				{
+					return VisitBody
+					(
+						b, [&]( const auto &bodyB )
+						{
+							return Col::IsHit( bodyA, bodyB, considerExistFlag );
+						}
+					);
+				}
+			);
+		}
+		// else
+
+		if ( subtractA )
+		{
+			return VisitBody
+			(
+				b, [&]( const auto &bodyB )
+				{
+					return IsHitVSSubtracted( bodyB, a, considerExistFlag );
+				}
+			);
+		}
+		// else
+
+		return VisitBody
+		(
+			a, [&]( const auto &bodyA )
+			{
+				return IsHitVSSubtracted( bodyA, b, considerExistFlag );
+			}
+		);
+	}
+
+	void AssignBound( const Volume &volume, float *pMinX, float *pMaxX, float *pMinY, float *pMaxY )
+	{
+		if ( volume.useSphere )
+		{
+			const Donya::Vector3 center = volume.sphere.WorldPosition();
+			*pMinX = center.x - volume.sphere.radius;
+			*pMaxX = center.x + volume.sphere.radius;
+			*pMinY = center.y - volume.sphere.radius;
+			*pMaxY = center.y + volume.sphere.radius;
+			return;
+		}
+		// else
+
+		const Donya::Vector3 min = volume.aabb.Min();
+		const Donya::Vector3 max = volume.aabb.Max();
+		*pMinX = min.x;
+		*pMaxX = max.x;
+		*pMinY = min.y;
+		*pMaxY = max.y;
+	}
+}
+
+CollisionWorld::Volume CollisionWorld::Volume::Make( Layer layer, size_t userIndex, const Donya::Collision::Box3F &aabb )
+{
+	Volume tmp{};
+	tmp.aabb		= aabb;
+	tmp.useSphere	= false;
+	tmp.layer		= layer;
+	tmp.userIndex	= userIndex;
+	return tmp;
+}
+CollisionWorld::Volume CollisionWorld::Volume::Make( Layer layer, size_t userIndex, const Donya::Collision::Sphere3F &sphere )
+{
+	Volume tmp{};
+	tmp.sphere		= sphere;
+	tmp.useSphere	= true;
+	tmp.layer		= layer;
+	tmp.userIndex	= userIndex;
+	return tmp;
+}
+bool CollisionWorld::Volume::HasSubtractor() const
+{
+	return ( aabbSubtractor.exist || sphereSubtractor.exist );
+}
+
+void CollisionWorld::SetPairFilter( Layer a, Layer b, bool collide )
+{
+	if ( a == Layer::LayerCount || b == Layer::LayerCount ) { return; }
+	// else
+
+	LayerMask &maskA = pairMasks[scast<size_t>( a )];
+	LayerMask &maskB = pairMasks[scast<size_t>( b )];
+	if ( collide )
+	{
+		maskA |= ToMask( b );
+		maskB |= ToMask( a );
+	}
+	else
+	{
+		maskA &= ~ToMask( b );
+		maskB &= ~ToMask( a );
+	}
+}
+bool CollisionWorld::ShouldCollide( Layer a, Layer b ) const
+{
+	if ( a == Layer::LayerCount || b == Layer::LayerCount ) { return false; }
+	// else
+	return ( pairMasks[scast<size_t>( a )] & ToMask( b ) ) ? true : false;
+}
+
+void CollisionWorld::BeginFrame()
+{
+	const float peakSeconds = statistics.peakSeconds;
+	statistics = Statistics{};
+	statistics.peakSeconds = peakSeconds;
+}
+void CollisionWorld::Clear()
+{
+	volumes.clear();
+	bounds.clear();
+	contacts.clear();
+}
+size_t CollisionWorld::Register( const Volume &volume )
+{
+	volumes.emplace_back( volume );
+	return volumes.size() - 1U;
+}
+void CollisionWorld::GenerateContacts()
+{
+	Benchmark timer{};
+	timer.Begin();
+
+	contacts.clear();
+
+	// Broad-phase: Sort and sweep along the X axis
+
+	const size_t volumeCount = volumes.size();
+	bounds.resize( volumeCount );
+	for ( size_t i = 0; i < volumeCount; ++i )
+	{
+		Bound &bound = bounds[i];
+		AssignBound( volumes[i], &bound.minX, &bound.maxX, &bound.minY, &bound.maxY );
+		bound.volume = i;
+	}
+	std::sort
+	(
+		bounds.begin(), bounds.end(),
+		[]( const Bound &lhs, const Bound &rhs )
+		{
+			return lhs.minX < rhs.minX;
+		}
+	);
+
+	for ( size_t i = 0; i < volumeCount; ++i )
+	{
+		const Bound  &boundA	= bounds[i];
+		const Volume &volumeA	= volumes[boundA.volume];
+		const LayerMask maskA	= pairMasks[scast<size_t>( volumeA.layer )];
+		if ( !maskA ) { continue; }
+		// else
+
+		for ( size_t j = i + 1; j < volumeCount && bounds[j].minX <= boundA.maxX; ++j )
+		{
+			const Bound  &boundB	= bounds[j];
+			const Volume &volumeB	= volumes[boundB.volume];
+			if ( !( maskA & ToMask( volumeB.layer ) ) ) { continue; }
+			// else
+			if ( boundB.maxY < boundA.minY || boundA.maxY < boundB.minY ) { continue; }
+			// else
+
+			statistics.candidateCount++;
+
+			// Narrow-phase
+			if ( !IsHit( volumeA, volumeB ) ) { continue; }
+			// else
+
+			Contact contact{};
+			contact.volumeA = std::min( boundA.volume, boundB.volume );
+			contact.volumeB = std::max( boundA.volume, boundB.volume );
+			contacts.emplace_back( contact );
+		}
+	}
+
+	// Make the order independent of the positions
+	std::sort
+	(
+		contacts.begin(), contacts.end(),
+		[]( const Contact &lhs, const Contact &rhs )
+		{
+			return	( lhs.volumeA != rhs.volumeA )
+					? lhs.volumeA < rhs.volumeA
+					: lhs.volumeB < rhs.volumeB;
+		}
+	);
+
+	statistics.passCount++;
+	statistics.volumeCount	+= volumeCount;
+	statistics.contactCount	+= contacts.size();
+	statistics.lastSeconds	+= timer.EndF();
+	statistics.peakSeconds	= std::max( statistics.peakSeconds, statistics.lastSeconds );
+}
+
+size_t CollisionWorld::GetVolumeCount() const
+{
+	return volumes.size();
+}
+const CollisionWorld::Volume &CollisionWorld::GetVolume( size_t volumeIndex ) const
+{
+	_ASSERT_EXPR( volumeIndex < volumes.size(), L"Error: Out of range!" );
+	return volumes[volumeIndex];
+}
+const std::vector<CollisionWorld::Contact> &CollisionWorld::GetContacts() const
+{
+	return contacts;
+}
+
+const CollisionWorld::Statistics &CollisionWorld::GetStatistics() const
+{
+	return statistics;
+}
+void CollisionWorld::ResetPeak()
+{
+	statistics.peakSeconds = 0.0f;
+}
+
+#if USE_IMGUI
+void CollisionWorld::ShowImGuiNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	constexpr float toMS = 1000.0f;
+	ImGui::Text( u8"񐔁F%d",			scast<int>( statistics.passCount		) );
+	ImGui::Text( u8"o^F%d",			scast<int>( statistics.volumeCount		) );
+	ImGui::Text( u8"yAF%d",		scast<int>( statistics.candidateCount	) );
+	ImGui::Text( u8"ڐGF%d",			scast<int>( statistics.contactCount		) );
+	ImGui::Text( u8"ڐGԁF%6.3f[ms]",	statistics.lastSeconds * toMS );
+	ImGui::Text( u8"ő厞ԁF%6.3f[ms]",		statistics.peakSeconds * toMS );
+	if ( ImGui::Button( u8"ő厞ԂZbg" ) )
+	{
+		ResetPeak();
+	}
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Donya/Collision.h"
+#include "Donya/Constant.h"			// Use scast macro.
+#include "Donya/UseImGui.h"			// Use USE_IMGUI macro.
+
+/// <summary>
+/// Gathers the collision volumes of a pass, then generates the contacts between them at once(broad-phase and narrow-phase).
+/// It does not know the owner objects, so a scene consumes the contacts and applies the reactions.
+/// A pass may change the objects, so please regenerate the contacts for each pass.
+/// It does not use GPU, so you can use it without a window.
+/// </summary>
+class CollisionWorld
+{
+public:
+	enum class Layer
+	{
+		PlayerHurtBox,
+		PlayerBullet,
+		EnemyBullet,
+		EnemyHitBox,	// The body that gives a touch damage
+		EnemyHurtBox,
+		BossHitBox,		// The body that gives a touch damage
+		BossHurtBox,
+		Item,
+
+		LayerCount
+	};
+	using LayerMask = unsigned int;
+	static constexpr LayerMask ToMask( Layer layer )
+	{
+		return 1U << scast<unsigned int>( layer );
+	}
+public:
+	struct Volume
+	{
+		Donya::Collision::Box3F		aabb				= Donya::Collision::Box3F::Nil();
+		Donya::Collision::Sphere3F	sphere				= Donya::Collision::Sphere3F::Nil();
+		Donya::Collision::Box3F		aabbSubtractor		= Donya::Collision::Box3F::Nil();	// Prior to the "sphereSubtractor"
+		Donya::Collision::Sphere3F	sphereSubtractor	= Donya::Collision::Sphere3F::Nil();
+		bool	useSphere		= false;	// Use the "sphere" as the body instead of the "aabb"
+		bool	ignoreExistFlag	= false;	// Collide even if the exist flag of the body is false
+		Layer	layer			= Layer::LayerCount;
+		size_t	userIndex		= 0;		// The index in the owner's container. The world does not access to the owner.
+	public:
+		static Volume Make( Layer layer, size_t userIndex, const Donya::Collision::Box3F &aabb );
+		static Volume Make( Layer layer, size_t userIndex, const Donya::Collision::Sphere3F &sphere );
+	public:
+		bool HasSubtractor() const;
+	};
+	struct Contact
+	{
+		size_t volumeA = 0;	// Smaller than the "volumeB"
+		size_t volumeB = 0;
+	};
+	/// <summary>
+	/// The sums of the GenerateContacts() calls since the last BeginFrame().
+	/// </summary>
+	struct Statistics
+	{
+		size_t	passCount		= 0;	// The count of GenerateContacts() calls
+		size_t	volumeCount		= 0;
+		size_t	candidateCount	= 0;	// The pairs that passed the broad-phase and the pair filter
+		size_t	contactCount	= 0;
+		float	lastSeconds		= 0.0f;	// The time of GenerateContacts() calls
+		float	peakSeconds		= 0.0f;	// The max "lastSeconds" since the last ResetPeak()
+	};
+private:
+	struct Bound
+	{
+		float	minX	= 0.0f;
+		float	maxX	= 0.0f;
+		float	minY	= 0.0f;
+		float	maxY	= 0.0f;
+		size_t	volume	= 0;
+	};
+private:
+	std::array<LayerMask, scast<size_t>( Layer::LayerCount )> pairMasks{};	// [layer] The layers that collide to the layer
+	std::vector<Volume>		volumes;
+	std::vector<Bound>		bounds;		// Sorted by the "minX" at the broad-phase
+	std::vector<Contact>	contacts;
+	Statistics				statistics;
+public:
+	/// <summary>
+	/// Allow or disallow the contacts between the layers. All pairs are disallowed by default.
+	/// </summary>
+	void SetPairFilter( Layer a, Layer b, bool collide );
+	bool ShouldCollide( Layer a, Layer b ) const;
+public:
+	/// <summary>
+	/// Resets the statistics except the peak. Please call it at the beginning of a frame.
+	/// </summary>
+	void BeginFrame();
+	/// <summary>
+	/// Removes the volumes and the contacts. The pair filter and the reserved memories are kept.
+	/// Please call it before the registration of a pass.
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// Returns the index of the registered volume.
+	/// The contacts are ordered by this registration order.
+	/// </summary>
+	size_t Register( const Volume &volume );
+	/// <summary>
+	/// Detects the all contacts between the registered volumes, and measures the time.
+	/// </summary>
+	void GenerateContacts();
+public:
+	size_t GetVolumeCount() const;
+	const Volume &GetVolume( size_t volumeIndex ) const;
+	const std::vector<Contact> &GetContacts() const;
+	/// <summary>
+	/// Calls the "process( volumeOfLayerA, volumeOfLayerB )" for every contact between the "layerA" and the "layerB", in the contact order.
+	/// </summary>
+	template<typename Process>
+	void ForEachContact( Layer layerA, Layer layerB, Process process ) const
+	{
+		for ( const auto &it : contacts )
+		{
+			const Volume &a = volumes[it.volumeA];
+			const Volume &b = volumes[it.volumeB];
+			if ( a.layer == layerA && b.layer == layerB )
+			{
+				process( a, b );
+			}
+			else
+			if ( a.layer == layerB && b.layer == layerA )
+			{
+				process( b, a );
+			}
+		}
+	}
+public:
+	const Statistics &GetStatistics() const;
+	void ResetPeak();
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
+};
@@ -0,0 +1,190 @@
+#include "DebugDrawQueue.h"
+
+#include <cstring>				// Use std::memcmp
+
+#include "Donya/Profiler.h"		// Use the benchmark helpers
+
+#undef max
+#undef min
+
+bool DebugDrawQueue::View::IsSame( const View &other ) const
+{
+	return
+	(
+		std::memcmp( &matViewProj,		&other.matViewProj,		sizeof( matViewProj		) ) == 0 &&
+		std::memcmp( &lightDirection,	&other.lightDirection,	sizeof( lightDirection	) ) == 0 &&
+		std::memcmp( &lightBias,		&other.lightBias,		sizeof( lightBias		) ) == 0
+	);
+}
+
+void DebugDrawQueue::PushCube( const View &view, const Donya::Vector4x4 &matWorld, const Donya::Vector4 &color )
+{
+	const size_t viewIndex = AppendView( view );
+	cubes.emplace_back( Instance{ matWorld, color } );
+	AppendToBatch( Shape::Cube, viewIndex, cubes.size() - 1 );
+}
+void DebugDrawQueue::PushSphere( const View &view, const Donya::Vector4x4 &matWorld, const Donya::Vector4 &color )
+{
+	const size_t viewIndex = AppendView( view );
+	spheres.emplace_back( Instance{ matWorld, color } );
+	AppendToBatch( Shape::Sphere, viewIndex, spheres.size() - 1 );
+}
+void DebugDrawQueue::Clear()
+{
+	views.clear();
+	cubes.clear();
+	spheres.clear();
+	batches.clear();
+}
+
+bool DebugDrawQueue::IsEmpty() const
+{
+	return ( cubes.empty() && spheres.empty() );
+}
+size_t DebugDrawQueue::GetCount( Shape shape ) const
+{
+	switch ( shape )
+	{
+	case Shape::Cube:	return cubes.size();
+	case Shape::Sphere:	return spheres.size();
+	default: break;
+	}
+
+	return 0;
+}
+const DebugDrawQueue::View &DebugDrawQueue::GetView( size_t viewIndex ) const
+{
+	_ASSERT_EXPR( viewIndex < views.size(), L"Error: Out of range!" );
+	return views[viewIndex];
+}
+const std::vector<DebugDrawQueue::Batch> &DebugDrawQueue::GetBatches() const
+{
+	return batches;
+}
+const std::vector<DebugDrawQueue::Instance> &DebugDrawQueue::GetInstances( Shape shape ) const
+{
+	static const std::vector<Instance> empty{};
+	switch ( shape )
+	{
+	case Shape::Cube:	return cubes;
+	case Shape::Sphere:	return spheres;
+	default: break;
+	}
+
+	return empty;
+}
+DebugDrawQueue::Statistics DebugDrawQueue::MakeStatistics() const
+{
+	Statistics stat{};
+	for ( size_t i = 0; i < shapeCount; ++i )
+	{
+		stat.shapeCounts[i] = GetCount( scast<Shape>( i ) );
+	}
+	for ( const auto &it : batches )
+	{
+		stat.batchCounts[scast<size_t>( it.shape )]++;
+	}
+	return stat;
+}
+size_t DebugDrawQueue::CalcDrawCallCount( Shape shape, size_t maxInstanceCountPerDraw ) const
+{
+	if ( !maxInstanceCountPerDraw ) { return 0; }
+	// else
+
+	size_t sum = 0;
+	for ( const auto &it : batches )
+	{
+		if ( it.shape != shape ) { continue; }
+		// else
+
+		sum += ( it.count + maxInstanceCountPerDraw - 1 ) / maxInstanceCountPerDraw;
+	}
+	return sum;
+}
+
+size_t DebugDrawQueue::AppendView( const View &view )
+{
+	// Usually the all shapes of a frame have the same view, so I only compare with the last one
+	if ( !views.empty() && views.back().IsSame( view ) )
+	{
+		return views.size() - 1;
+	}
+	// else
+
+	views.emplace_back( view );
+	return views.size() - 1;
+}
+void DebugDrawQueue::AppendToBatch( Shape shape, size_t viewIndex, size_t elementIndex )
+{
+	// Only the last batch can be extended, because merging with an older one changes the drawing order
+	if ( !batches.empty() )
+	{
+		Batch &last = batches.back();
+		if ( last.shape == shape && last.viewIndex == viewIndex && last.first + last.count == elementIndex )
+		{
+			last.count++;
+			return;
+		}
+	}
+	// else
+
+	batches.emplace_back( Batch{ shape, viewIndex, elementIndex, 1 } );
+}
+
+#if USE_IMGUI
+void DebugDrawQueue::ShowImGuiNode( const std::string &nodeCaption, const Statistics &lastFrame )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	constexpr std::array<const char *, shapeCount> shapeNames
+	{
+		"Cube",
+		"Sphere",
+	};
+
+	size_t shapeSum = 0;
+	for ( size_t i = 0; i < shapeCount; ++i )
+	{
+		ImGui::Text( u8"%sF%dC%dob`", shapeNames[i], scast<int>( lastFrame.shapeCounts[i] ), scast<int>( lastFrame.batchCounts[i] ) );
+		shapeSum += lastFrame.shapeCounts[i];
+	}
+	ImGui::Text( u8"`R[F%diʂɕ`悵ꍇF%dj", scast<int>( lastFrame.drawCallCount ), scast<int>( shapeSum ) );
+
+	if ( ImGui::TreeNode( u8"L^̌v" ) )
+	{
+		static Donya::Profiler::BenchmarkCounts counts{ 10000, 1 };
+		static int		maxInstanceCountPerDraw	= 1024;
+		static float	pushSeconds				= 0.0f;
+		static size_t	batchedDrawCallCount	= 0;
+
+		ImGui::DragInt( u8"xɕ`ł鐔", &maxInstanceCountPerDraw, 1.0f, 1, 65536 );
+		if ( counts.ShowControls( u8"}`̐", nullptr, u8"v" ) )
+		{
+			const View view{};
+			constexpr Donya::Vector4 color{ 1.0f, 1.0f, 1.0f, 0.5f };
+
+			DebugDrawQueue queue{};
+			const float secondsPerShape = Donya::Profiler::MeasureAverageSeconds
+			(
+				counts.elementCount,
+				[&]( int i )
+				{
+					Donya::Vector4x4 W = Donya::Vector4x4::Identity();
+					W._41 = scast<float>( i );
+					queue.PushCube( view, W, color );
+				}
+			);
+			pushSeconds = secondsPerShape * scast<float>( counts.elementCount );
+
+			batchedDrawCallCount = queue.CalcDrawCallCount( Shape::Cube, scast<size_t>( maxInstanceCountPerDraw ) );
+		}
+		ImGui::Text( u8"L^ԁF%6.3f ms", pushSeconds * 1000.0f );
+		ImGui::Text( u8"`R[F%diʂɕ`悵ꍇF%dj", scast<int>( batchedDrawCallCount ), counts.elementCount );
+
+		ImGui::TreePop();
+	}
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
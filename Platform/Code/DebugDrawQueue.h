@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Donya/Constant.h"		// Use scast macro.
+#include "Donya/UseImGui.h"		// Use USE_IMGUI macro.
+#include "Donya/Vector.h"
+
+/// <summary>
+/// Accumulates the debug shapes(cubes and spheres) of a frame into the per-shape instance arrays.
+/// The contiguous shapes that have the same kind and the same view are grouped into a batch, so a renderer can draw a batch by one instanced draw call.
+/// The batches keep the submitted order, so drawing them in order keeps the order of the translucent shapes.
+/// It does not use GPU, so you can use it without a device.
+/// </summary>
+class DebugDrawQueue
+{
+public:
+	enum class Shape
+	{
+		Cube,
+		Sphere,
+
+		ShapeCount
+	};
+	static constexpr size_t shapeCount = scast<size_t>( Shape::ShapeCount );
+	/// <summary>
+	/// The parameters that are shared in a batch.
+	/// </summary>
+	struct View
+	{
+		Donya::Vector4x4	matViewProj;
+		Donya::Vector3		lightDirection{ 0.0f, -1.0f, 0.0f };
+		float				lightBias = 0.5f;
+	public:
+		bool IsSame( const View &other ) const;
+	};
+	/// <summary>
+	/// Same layout as the Donya::Model::InstancedPrimitiveRenderer::Instance.
+	/// </summary>
+	struct Instance
+	{
+		Donya::Vector4x4	matWorld;
+		Donya::Vector4		color;
+	};
+	struct Batch
+	{
+		Shape  shape		= Shape::Cube;
+		size_t viewIndex	= 0;
+		size_t first		= 0;	// The index of the first element in the shape's array
+		size_t count		= 0;
+	};
+	struct Statistics
+	{
+		std::array<size_t, shapeCount> shapeCounts{};	// [shape]
+		std::array<size_t, shapeCount> batchCounts{};	// [shape]
+		size_t drawCallCount = 0;	// The renderer assigns it at the flushing
+	};
+private:
+	std::vector<View>								views;
+	std::vector<Instance>							cubes;
+	std::vector<Instance>							spheres;
+	std::vector<Batch>								batches;	// The submitted order
+public:
+	void PushCube	( const View &view, const Donya::Vector4x4 &matWorld, const Donya::Vector4 &color );
+	void PushSphere	( const View &view, const Donya::Vector4x4 &matWorld, const Donya::Vector4 &color );
+	/// <summary>
+	/// Removes the all shapes. The reserved memories are kept.
+	/// </summary>
+	void Clear();
+public:
+	bool IsEmpty() const;
+	size_t GetCount( Shape shape ) const;
+	const View &GetView( size_t viewIndex ) const;
+	/// <summary>
+	/// Returns the batches of all shapes in the submitted order. The "first" of a batch is the index in the array of its shape.
+	/// </summary>
+	const std::vector<Batch> &GetBatches() const;
+	const std::vector<Instance> &GetInstances( Shape shape ) const;
+	/// <summary>
+	/// The "drawCallCount" is zero.
+	/// </summary>
+	Statistics MakeStatistics() const;
+	/// <summary>
+	/// Returns the draw call count if the each batch is split by the "maxInstanceCountPerDraw".
+	/// </summary>
+	size_t CalcDrawCallCount( Shape shape, size_t maxInstanceCountPerDraw ) const;
+private:
+	size_t AppendView( const View &view );
+	void   AppendToBatch( Shape shape, size_t viewIndex, size_t elementIndex );
+public:
+#if USE_IMGUI
+	/// <summary>
+	/// Shows the "lastFrame" statistics, and a benchmark that compares the recording costs.
+	/// </summary>
+	static void ShowImGuiNode( const std::string &nodeCaption, const Statistics &lastFrame );
+#endif // USE_IMGUI
+};
@@ -0,0 +1,239 @@
+#include "AssetRegistry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cwctype>
+#include <vector>
+
+#include "Constant.h"		// Use scast macro
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Asset
+	{
+		namespace
+		{
+			constexpr size_t defaultBudget = 256U * 1024U * 1024U;
+
+			struct Registry
+			{
+				std::mutex					mutex;
+				std::vector<CacheBase *>	caches;
+				size_t						budget = defaultBudget;
+			};
+			// The caches are static objects of other translation units, so I make the registry at the first use.
+			Registry &GetRegistry()
+			{
+				static Registry instance{};
+				return instance;
+			}
+
+			std::atomic<std::uint64_t> tick{ 0 };
+
+			template<typename Char, typename Unsigned>
+			Key MakeKeyImpl( const std::basic_string<Char> &path )
+			{
+				// Widen by the code units, so the narrow and wide ASCII path have the same key
+				Key key{};
+				key.reserve( path.size() );
+				for ( const Char &it : path )
+				{
+					wchar_t unit = scast<wchar_t>( std::towlower( scast<std::wint_t>( scast<Unsigned>( it ) ) ) );
+					if ( unit == L'\\' ) { unit = L'/'; }
+
+					key.push_back( unit );
+				}
+				return key;
+			}
+
+			// Requires the lock of the registry.
+			size_t CalcTotalBytes( const Registry &registry )
+			{
+				size_t sum = 0;
+				for ( const auto &pCache : registry.caches )
+				{
+					sum += pCache->GetBytes();
+				}
+				return sum;
+			}
+		}
+
+		const char *GetTypeName( Type type )
+		{
+			switch ( type )
+			{
+			case Type::Texture:			return "Texture";
+			case Type::ObjFile:			return "ObjFile";
+			case Type::ObjMesh:			return "ObjMesh";
+			case Type::SkinningModel:	return "SkinningModel";
+			default: break;
+			}
+			return "ERROR_TYPE";
+		}
+
+		Key MakeKey( const std::string  &path ) { return MakeKeyImpl<char,    unsigned char>( path ); }
+		Key MakeKey( const std::wstring &path ) { return MakeKeyImpl<wchar_t, wchar_t>( path ); }
+
+		void	SetMemoryBudget( size_t bytes )
+		{
+			{
+				auto &registry = GetRegistry();
+				std::lock_guard<std::mutex> lock( registry.mutex );
+				registry.budget = bytes;
+			}
+
+			Trim();
+		}
+		size_t	GetMemoryBudget()
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			return registry.budget;
+		}
+		size_t	GetTotalBytes()
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			return CalcTotalBytes( registry );
+		}
+		size_t	Trim()
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			if ( registry.budget == 0 ) { return 0; }
+			// else
+
+			size_t evictedCount = 0;
+			while ( registry.budget < CalcTotalBytes( registry ) )
+			{
+				// Evict the least recently used one in all types
+				CacheBase		*pOldest	= nullptr;
+				std::uint64_t	oldestTick	= 0;
+				for ( const auto &pCache : registry.caches )
+				{
+					std::uint64_t lastUsed = 0;
+					if ( !pCache->FindEvictionCandidate( &lastUsed ) ) { continue; }
+					// else
+
+					if ( !pOldest || lastUsed < oldestTick )
+					{
+						pOldest		= pCache;
+						oldestTick	= lastUsed;
+					}
+				}
+
+				// All remaining assets are referenced
+				if ( !pOldest ) { break; }
+				// else
+
+				if ( !pOldest->EvictLeastRecentlyUsed() ) { break; }
+				// else
+
+				evictedCount++;
+			}
+
+			return evictedCount;
+		}
+		void	ReleaseAll()
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			for ( const auto &pCache : registry.caches )
+			{
+				pCache->Clear();
+			}
+		}
+
+		Statistics GetStatistics( Type type )
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+
+			Statistics sum{};
+			for ( const auto &pCache : registry.caches )
+			{
+				if ( pCache->GetType() != type ) { continue; }
+				// else
+
+				const Statistics statistics = pCache->GetStatistics();
+				sum.residentCount	+= statistics.residentCount;
+				sum.residentBytes	+= statistics.residentBytes;
+				sum.referencedCount	+= statistics.referencedCount;
+				sum.hitCount		+= statistics.hitCount;
+				sum.missCount		+= statistics.missCount;
+				sum.evictedCount	+= statistics.evictedCount;
+			}
+			return sum;
+		}
+
+	#if USE_IMGUI
+		void	ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			constexpr float toMiB = 1.0f / ( 1024.0f * 1024.0f );
+
+			int budgetMiB = scast<int>( scast<float>( GetMemoryBudget() ) * toMiB );
+			if ( ImGui::DragInt( "Budget(MiB, 0 is unlimited)", &budgetMiB, 1.0f, 0, 4096 ) )
+			{
+				SetMemoryBudget( scast<size_t>( std::max( 0, budgetMiB ) ) * 1024U * 1024U );
+			}
+			ImGui::Text( "Total:[%8.3f MiB]", scast<float>( GetTotalBytes() ) * toMiB );
+			if ( ImGui::Button( "Trim" ) )
+			{
+				Trim();
+			}
+
+			ImGui::Columns( 7 );
+			ImGui::Text( "Type"		); ImGui::NextColumn();
+			ImGui::Text( "Count"	); ImGui::NextColumn();
+			ImGui::Text( "Used"		); ImGui::NextColumn();
+			ImGui::Text( "MiB"		); ImGui::NextColumn();
+			ImGui::Text( "Hit"		); ImGui::NextColumn();
+			ImGui::Text( "Miss"		); ImGui::NextColumn();
+			ImGui::Text( "Evicted"	); ImGui::NextColumn();
+			ImGui::Separator();
+			for ( size_t i = 0; i < typeCount; ++i )
+			{
+				const Type type = scast<Type>( i );
+				const Statistics statistics = GetStatistics( type );
+				ImGui::Text( "%s", GetTypeName( type )							); ImGui::NextColumn();
+				ImGui::Text( "%d", scast<int>( statistics.residentCount )		); ImGui::NextColumn();
+				ImGui::Text( "%d", scast<int>( statistics.referencedCount )		); ImGui::NextColumn();
+				ImGui::Text( "%.3f", scast<float>( statistics.residentBytes ) * toMiB ); ImGui::NextColumn();
+				ImGui::Text( "%d", scast<int>( statistics.hitCount )			); ImGui::NextColumn();
+				ImGui::Text( "%d", scast<int>( statistics.missCount )			); ImGui::NextColumn();
+				ImGui::Text( "%d", scast<int>( statistics.evictedCount )		); ImGui::NextColumn();
+			}
+			ImGui::Columns( 1 );
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+
+		void			Register( CacheBase *pCache )
+		{
+			if ( !pCache ) { return; }
+			// else
+
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			registry.caches.emplace_back( pCache );
+		}
+		void			Unregister( CacheBase *pCache )
+		{
+			auto &registry = GetRegistry();
+			std::lock_guard<std::mutex> lock( registry.mutex );
+			auto &caches = registry.caches;
+			caches.erase( std::remove( caches.begin(), caches.end(), pCache ), caches.end() );
+		}
+		std::uint64_t	NextTick()
+		{
+			return ++tick;
+		}
+	}
+}
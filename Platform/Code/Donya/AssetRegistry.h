@@ -0,0 +1,327 @@
+#ifndef INCLUDED_DONYA_ASSET_REGISTRY_H_
+#define INCLUDED_DONYA_ASSET_REGISTRY_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "UseImGui.h"	// Use for USE_IMGUI macro.
+
+namespace Donya
+{
+	/// <summary>
+	/// The registry of the cached assets. Each asset type has a Cache, and the registry manages all of them together.<para></para>
+	/// An asset is identified by its normalized path, so the same file is loaded only once even if the path is written differently.<para></para>
+	/// It is not content-addressed, so the different files that have the same contents are cached separately.<para></para>
+	/// The registry has a memory budget. When the cached bytes exceed it, the least recently used assets that are not referenced by others are evicted.
+	/// The referenced assets are never evicted, so the bytes may exceed the budget while they are used.
+	/// </summary>
+	namespace Asset
+	{
+		enum class Type
+		{
+			Texture,
+			ObjFile,		// The result of Resource::LoadObjFile()
+			ObjMesh,		// The result of Resource::LoadObjMesh()
+			SkinningModel,
+
+			TypeCount
+		};
+		constexpr size_t typeCount = static_cast<size_t>( Type::TypeCount );
+		const char *GetTypeName( Type type );
+
+		using Key = std::wstring;
+		/// <summary>
+		/// Makes the key by normalizing the path. It ignores the case of letters, and regards '\\' as '/'.<para></para>
+		/// The narrow and wide version return the same key for the same ASCII path.
+		/// </summary>
+		Key MakeKey( const std::string  &path );
+		Key MakeKey( const std::wstring &path );
+
+		/// <summary>
+		/// A typed reference to an entry of Cache. It does not keep the asset alive, so it becomes stale when the asset is evicted.
+		/// </summary>
+		template<typename T>
+		struct Handle
+		{
+			Key		key;
+			bool	valid	= false;
+		public:
+			bool IsValid() const { return valid; }
+		};
+
+		struct Statistics
+		{
+			size_t	residentCount	= 0;
+			size_t	residentBytes	= 0;
+			size_t	referencedCount	= 0;	// Currently used by others than the cache
+			size_t	hitCount		= 0;
+			size_t	missCount		= 0;
+			size_t	evictedCount	= 0;
+		};
+
+		/// <summary>
+		/// The interface that the registry uses for the budget.
+		/// </summary>
+		class CacheBase
+		{
+		public:
+			virtual ~CacheBase() = default;
+		public:
+			virtual Type		GetType()		const = 0;
+			virtual size_t		GetBytes()		const = 0;
+			virtual Statistics	GetStatistics()	const = 0;
+			/// <summary>
+			/// Returns false if there is no unreferenced asset. Else outputs the last used tick of the least recently used one.
+			/// </summary>
+			virtual bool		FindEvictionCandidate( std::uint64_t *pOutLastUsed ) const = 0;
+			/// <summary>
+			/// Evicts the least recently used unreferenced asset. Returns false if there is nothing to evict.
+			/// </summary>
+			virtual bool		EvictLeastRecentlyUsed() = 0;
+			virtual void		Clear() = 0;
+		};
+
+		/// <summary>
+		/// The budget is 256 MiB by default. Zero means unlimited.
+		/// </summary>
+		void	SetMemoryBudget( size_t bytes );
+		size_t	GetMemoryBudget();
+		size_t	GetTotalBytes();
+		/// <summary>
+		/// Evicts the least recently used unreferenced assets of all types, until the total bytes fit into the budget.<para></para>
+		/// It is called by Cache::Store(), but please call it also when many assets become unreferenced(e.g. at a scene change).
+		/// Returns the count of the evicted assets.
+		/// </summary>
+		size_t	Trim();
+		/// <summary>
+		/// Clears all caches. The assets that are referenced by others stay alive until they are released.
+		/// </summary>
+		void	ReleaseAll();
+
+		Statistics GetStatistics( Type type );
+	#if USE_IMGUI
+		void	ShowImGuiNode( const std::string &nodeCaption );
+	#endif // USE_IMGUI
+
+		// These are used by Cache.
+		void			Register( CacheBase *pCache );
+		void			Unregister( CacheBase *pCache );
+		std::uint64_t	NextTick();
+
+		/// <summary>
+		/// The thread-safe cache of an asset type. The asset is shared by std::shared_ptr, and its use_count() is the reference count.<para></para>
+		/// If the asset is shared by another way(e.g. COM reference count), please pass the "isReferencedByOthers" for telling it.<para></para>
+		/// Please define the instance as a static object, it registers itself to the registry.
+		/// </summary>
+		template<typename T>
+		class Cache : public CacheBase
+		{
+		public:
+			using ReferenceChecker = std::function<bool( const T & )>;
+		private:
+			struct Entry
+			{
+				std::shared_ptr<T>	pAsset;
+				size_t				bytes		= 0;
+				std::uint64_t		lastUsed	= 0;
+			};
+		private:
+			const Type						type;
+			const ReferenceChecker			isReferencedByOthers;
+			mutable std::mutex				mutex;
+			std::unordered_map<Key, Entry>	entries;
+			size_t							bytes			= 0;
+			size_t							hitCount		= 0;
+			size_t							missCount		= 0;
+			size_t							evictedCount	= 0;
+		public:
+			explicit Cache( Type type, const ReferenceChecker &isReferencedByOthers = nullptr )
+				: type( type ), isReferencedByOthers( isReferencedByOthers )
+			{
+				Register( this );
+			}
+			~Cache()
+			{
+				Unregister( this );
+			}
+			Cache( const Cache & ) = delete;
+			Cache & operator = ( const Cache & ) = delete;
+		public:
+			Handle<T> Find( const std::string  &path ) const { return FindImpl( MakeKey( path ) ); }
+			Handle<T> Find( const std::wstring &path ) const { return FindImpl( MakeKey( path ) ); }
+			/// <summary>
+			/// Returns the asset and marks it as recently used. Returns nullptr if it is not cached(e.g. evicted).
+			/// </summary>
+			std::shared_ptr<T> Acquire( const Handle<T>    &handle	) { return ( handle.IsValid() ) ? AcquireImpl( handle.key ) : nullptr; }
+			std::shared_ptr<T> Acquire( const std::string  &path	) { return AcquireImpl( MakeKey( path ) ); }
+			std::shared_ptr<T> Acquire( const std::wstring &path	) { return AcquireImpl( MakeKey( path ) ); }
+			/// <summary>
+			/// Stores the asset, then trims the registry if the budget is exceeded.<para></para>
+			/// If the same path has been stored already, keeps the stored one. The "bytes" is used for the budget, so an estimate is enough.
+			/// </summary>
+			Handle<T> Store( const std::string  &path, const std::shared_ptr<T> &pAsset, size_t assetBytes ) { return StoreImpl( MakeKey( path ), pAsset, assetBytes ); }
+			Handle<T> Store( const std::wstring &path, const std::shared_ptr<T> &pAsset, size_t assetBytes ) { return StoreImpl( MakeKey( path ), pAsset, assetBytes ); }
+			void Release( const Handle<T> &handle )
+			{
+				if ( !handle.IsValid() ) { return; }
+				// else
+
+				std::lock_guard<std::mutex> lock( mutex );
+				const auto found = entries.find( handle.key );
+				if ( found == entries.end() ) { return; }
+				// else
+
+				bytes -= found->second.bytes;
+				entries.erase( found );
+			}
+		public:
+			Type GetType() const override { return type; }
+			size_t GetBytes() const override
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+				return bytes;
+			}
+			Statistics GetStatistics() const override
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+
+				Statistics statistics{};
+				statistics.residentCount	= entries.size();
+				statistics.residentBytes	= bytes;
+				statistics.hitCount			= hitCount;
+				statistics.missCount		= missCount;
+				statistics.evictedCount		= evictedCount;
+				for ( const auto &it : entries )
+				{
+					if ( IsReferenced( it.second ) ) { statistics.referencedCount++; }
+				}
+				return statistics;
+			}
+			bool FindEvictionCandidate( std::uint64_t *pOutLastUsed ) const override
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+
+				const auto found = FindLeastRecentlyUsed();
+				if ( found == entries.end() ) { return false; }
+				// else
+
+				if ( pOutLastUsed ) { *pOutLastUsed = found->second.lastUsed; }
+				return true;
+			}
+			bool EvictLeastRecentlyUsed() override
+			{
+				std::shared_ptr<T> pEvicted{};
+				{
+					std::lock_guard<std::mutex> lock( mutex );
+
+					const auto found = FindLeastRecentlyUsed();
+					if ( found == entries.end() ) { return false; }
+					// else
+
+					pEvicted = std::move( found->second.pAsset );
+					bytes -= found->second.bytes;
+					entries.erase( found );
+					evictedCount++;
+				}
+
+				// Destruct the asset without the lock
+				pEvicted.reset();
+				return true;
+			}
+			void Clear() override
+			{
+				std::unordered_map<Key, Entry> released{};
+				{
+					std::lock_guard<std::mutex> lock( mutex );
+					released.swap( entries );
+					bytes = 0;
+				}
+			}
+		private:
+			bool IsReferenced( const Entry &entry ) const
+			{
+				if ( 1 < entry.pAsset.use_count() ) { return true; }
+				// else
+				return ( isReferencedByOthers && isReferencedByOthers( *entry.pAsset ) );
+			}
+			// These require the lock.
+			typename std::unordered_map<Key, Entry>::const_iterator FindLeastRecentlyUsed() const
+			{
+				auto result = entries.end();
+				for ( auto it = entries.begin(); it != entries.end(); ++it )
+				{
+					if ( IsReferenced( it->second ) ) { continue; }
+					// else
+
+					if ( result == entries.end() || it->second.lastUsed < result->second.lastUsed )
+					{
+						result = it;
+					}
+				}
+				return result;
+			}
+			typename std::unordered_map<Key, Entry>::iterator FindLeastRecentlyUsed()
+			{
+				const auto found = static_cast<const Cache *>( this )->FindLeastRecentlyUsed();
+				return ( found == entries.cend() ) ? entries.end() : entries.find( found->first );
+			}
+		private:
+			Handle<T> FindImpl( const Key &key ) const
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+
+				Handle<T> handle{};
+				handle.key		= key;
+				handle.valid	= ( entries.find( key ) != entries.end() );
+				return handle;
+			}
+			std::shared_ptr<T> AcquireImpl( const Key &key )
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+
+				const auto found = entries.find( key );
+				if ( found == entries.end() )
+				{
+					missCount++;
+					return nullptr;
+				}
+				// else
+
+				hitCount++;
+				found->second.lastUsed = NextTick();
+				return found->second.pAsset;
+			}
+			Handle<T> StoreImpl( const Key &key, const std::shared_ptr<T> &pAsset, size_t assetBytes )
+			{
+				Handle<T> handle{};
+				if ( !pAsset ) { return handle; }
+				// else
+
+				{
+					std::lock_guard<std::mutex> lock( mutex );
+
+					Entry entry{};
+					entry.pAsset	= pAsset;
+					entry.bytes		= assetBytes;
+					entry.lastUsed	= NextTick();
+					const auto result = entries.emplace( key, std::move( entry ) );
+					if ( result.second ) { bytes += assetBytes; }
+				}
+
+				// Trim without the lock, the registry locks the caches one by one
+				Trim();
+
+				handle.key		= key;
+				handle.valid	= true;
+				return handle;
+			}
+		};
+	}
+}
+
+#endif // !INCLUDED_DONYA_ASSET_REGISTRY_H_
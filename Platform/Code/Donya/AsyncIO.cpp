@@ -0,0 +1,186 @@
+#include "AsyncIO.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Profiler.h"		// Use SetThreadName()
+
+namespace Donya
+{
+	namespace AsyncIO
+	{
+		namespace
+		{
+			struct ReadJob
+			{
+				std::string				filePath;
+				std::promise<Buffer>	promise;
+			};
+
+			static std::mutex										mutex;
+			static std::condition_variable							wakeUp;
+			static std::deque<ReadJob>								jobs;
+			static std::unordered_map<std::string, std::shared_future<Buffer>> futures;	// Key is the file path
+			static std::thread										reader;
+			static bool												stopRequested	= false;
+			static size_t											hitCount		= 0;
+			static size_t											waitCount		= 0;
+
+			Buffer ReadWholeFile( const std::string &filePath )
+			{
+				std::ifstream ifs( filePath, std::ios::in | std::ios::binary | std::ios::ate );
+				if ( !ifs.is_open() ) { return nullptr; }
+				// else
+
+				const std::streamoff length = ifs.tellg();
+				if ( length < 0 ) { return nullptr; }
+				// else
+
+				auto pBuffer = std::make_shared<std::vector<char>>( static_cast<size_t>( length ) );
+				ifs.seekg( 0, std::ios::beg );
+				ifs.read( pBuffer->data(), static_cast<std::streamsize>( length ) );
+				if ( !ifs ) { return nullptr; }
+				// else
+
+				return pBuffer;
+			}
+
+			void ReaderLoop()
+			{
+				Donya::Profiler::SetThreadName( "Donya::AsyncIO" );
+
+				while ( true )
+				{
+					ReadJob job{};
+					{
+						std::unique_lock<std::mutex> lock( mutex );
+						wakeUp.wait( lock, []() { return stopRequested || !jobs.empty(); } );
+						if ( stopRequested ) { break; }
+						// else
+
+						job = std::move( jobs.front() );
+						jobs.pop_front();
+					}
+
+					// Read without the lock, the requests can be accepted while reading
+					job.promise.set_value( ReadWholeFile( job.filePath ) );
+				}
+			}
+			// Requires the lock
+			void StartReaderIfNotRunning()
+			{
+				if ( reader.joinable() ) { return; }
+				// else
+
+				stopRequested = false;
+				reader = std::thread( ReaderLoop );
+			}
+			bool IsReady( const std::shared_future<Buffer> &future )
+			{
+				return ( future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready );
+			}
+		}
+
+		void Uninit()
+		{
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+				stopRequested = true;
+			}
+			wakeUp.notify_all();
+
+			if ( reader.joinable() ) { reader.join(); }
+
+			std::lock_guard<std::mutex> lock( mutex );
+			// Let the waiters of the pending requests return
+			for ( auto &it : jobs )
+			{
+				it.promise.set_value( nullptr );
+			}
+			jobs.clear();
+			futures.clear();
+			hitCount	= 0;
+			waitCount	= 0;
+		}
+
+		std::shared_future<Buffer> Request( const std::string &filePath )
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+
+			const auto found = futures.find( filePath );
+			if ( found != futures.end() ) { return found->second; }
+			// else
+
+			ReadJob job{};
+			job.filePath = filePath;
+			std::shared_future<Buffer> future = job.promise.get_future().share();
+
+			futures.emplace( filePath, future );
+			jobs.emplace_back( std::move( job ) );
+
+			StartReaderIfNotRunning();
+			wakeUp.notify_one();
+
+			return future;
+		}
+		Buffer Fetch( const std::string &filePath )
+		{
+			std::shared_future<Buffer> future{};
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+
+				const auto found = futures.find( filePath );
+				if ( found == futures.end() ) { return nullptr; }
+				// else
+
+				future = found->second;
+				if ( !IsReady( future ) ) { waitCount++; }
+				hitCount++;
+			}
+
+			// Wait without the lock, the reader requires it
+			return future.get();
+		}
+
+		void Release( const std::string &filePath )
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			futures.erase( filePath );
+		}
+		void ReleaseAll()
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			futures.clear();
+		}
+
+		Report GetReport()
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+
+			Report report{};
+			report.hitCount		= hitCount;
+			report.waitCount	= waitCount;
+			for ( const auto &it : futures )
+			{
+				if ( !IsReady( it.second ) )
+				{
+					report.pendingCount++;
+					continue;
+				}
+				// else
+
+				const Buffer &pBuffer = it.second.get();
+				if ( !pBuffer ) { continue; }
+				// else
+
+				report.residentCount++;
+				report.residentBytes += pBuffer->size();
+			}
+			return report;
+		}
+	}
+}
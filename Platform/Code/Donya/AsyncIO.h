@@ -0,0 +1,62 @@
+#ifndef INCLUDED_DONYA_ASYNC_IO_H_
+#define INCLUDED_DONYA_ASYNC_IO_H_
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Donya
+{
+	/// <summary>
+	/// The file reader that works on a background thread.<para></para>
+	/// A requested file is read into the memory and stays there(resident) until released,
+	/// so you can prefetch the files that will be used, and the loaders parse them without waiting the disk.<para></para>
+	/// Donya::Serializer and Donya::Loader use the resident buffer if the same path has been requested.
+	/// </summary>
+	namespace AsyncIO
+	{
+		/// <summary>
+		/// The whole bytes of the file. It is nullptr if the reading has failed.
+		/// </summary>
+		using Buffer = std::shared_ptr<const std::vector<char>>;
+
+		struct Report
+		{
+			size_t residentCount	= 0;	// Finished reading
+			size_t residentBytes	= 0;
+			size_t pendingCount		= 0;	// Requested but not finished
+			size_t hitCount			= 0;	// Fetch() has found the request
+			size_t waitCount		= 0;	// Fetch() has waited the reading
+		};
+
+		/// <summary>
+		/// Stops the thread and releases all buffers. The pending requests are regarded as failed.<para></para>
+		/// The thread starts at the first request, so you do not need an initialization.
+		/// </summary>
+		void Uninit();
+
+		/// <summary>
+		/// Requests the reading of the file. It does not block.<para></para>
+		/// If the same path has been requested already, returns the same future and does not read again.<para></para>
+		/// The path is compared as it is, so please use the same string with the loader(e.g. the result of MakeStageParamPathBinary()).
+		/// </summary>
+		std::shared_future<Buffer> Request( const std::string &filePath );
+		/// <summary>
+		/// Returns the buffer of the requested file. If the reading is in progress, waits for it.<para></para>
+		/// Returns nullptr if the file has not been requested or the reading has failed, then please read the file by yourself.
+		/// </summary>
+		Buffer Fetch( const std::string &filePath );
+
+		/// <summary>
+		/// Releases the buffer of the file. If the reading is in progress, it is released when the reading finishes.<para></para>
+		/// Please call it when the file is changed(e.g. saved), because the buffer is not updated.
+		/// </summary>
+		void Release( const std::string &filePath );
+		void ReleaseAll();
+
+		Report GetReport();
+	}
+}
+
+#endif // !INCLUDED_DONYA_ASYNC_IO_H_
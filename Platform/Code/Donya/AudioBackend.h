@@ -0,0 +1,75 @@
+#ifndef INCLUDED_DONYA_AUDIO_BACKEND_H_
+#define INCLUDED_DONYA_AUDIO_BACKEND_H_
+
+#include <cstddef>
+#include <string>
+
+namespace Donya
+{
+	/// <summary>
+	/// The interface of the audio implementation that is used by Donya::Sound.<para></para>
+	/// The handle is returned by Load(), and NULL is used as an error.
+	/// </summary>
+	class IAudioBackend
+	{
+	public:
+		/// <summary>
+		/// How to play a sound when its voices are full.
+		/// </summary>
+		enum class VoiceSteal
+		{
+			Oldest,		// Stops the oldest voice
+			Quietest,	// Stops the voice that has the lowest audibility
+			Reject,		// Does not play
+		};
+		static constexpr int defaultMaxVoiceCount = 8;
+
+		struct MemoryReport
+		{
+			int		currentBytes		= 0;	// The memory that is allocated by the backend now
+			int		maxBytes			= 0;	// The peak of allocated memory by the backend
+			int		sampleCount			= 0;	// The sounds that are decoded into memory
+			int		streamCount			= 0;
+			int		openedStreamCount	= 0;	// The streams that have been played once at least
+		};
+		struct Statistics
+		{
+			int		playingVoiceCount	= 0;
+			int		peakVoiceCount		= 0;	// Since the construction
+			float	updateMilliseconds	= 0.0f;	// The last Update()
+		};
+	public:
+		virtual ~IAudioBackend() = default;
+	public:
+		/// <summary>
+		/// Please call every frame.
+		/// </summary>
+		virtual void	Update() = 0;
+
+		virtual size_t	Load( std::string fileName, bool isEnableLoop, bool isStream = false, int maxVoiceCount = defaultMaxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) = 0;
+		virtual bool	SetVoiceLimit( size_t soundHandle, int maxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) = 0;
+
+		virtual bool	Play( size_t soundHandle, float volume = 1.0f ) = 0;
+		virtual bool	Pause( size_t soundHandle, bool isEnableForAll = false ) = 0;
+		virtual bool	Resume( size_t soundHandle, bool isEnableForAll = false, bool fromTheBeginning = false ) = 0;
+		virtual bool	Stop( size_t soundHandle, bool isEnableForAll = false ) = 0;
+		virtual bool	SetVolume( size_t soundHandle, float volume, bool isEnableForAll = false ) = 0;
+		virtual bool	AppendFadePoint( size_t soundHandle, float takeSeconds, float destinationVolume, bool isEnableForAll = false ) = 0;
+
+		virtual bool	Release( size_t soundHandle ) = 0;
+		virtual bool	ReleaseAll() = 0;
+	public:
+		/// <summary>
+		/// If failed count, or not found, returns -1.
+		/// </summary>
+		virtual int		GetNowPlayingSoundCount( size_t soundHandle ) const = 0;
+		/// <summary>
+		/// If failed count, returns -1.
+		/// </summary>
+		virtual int		GetNowPlayingChannelCount() = 0;
+		virtual MemoryReport	GetMemoryReport() const = 0;
+		virtual Statistics		GetStatistics() const = 0;
+	};
+}
+
+#endif // !INCLUDED_DONYA_AUDIO_BACKEND_H_
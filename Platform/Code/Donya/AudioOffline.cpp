@@ -0,0 +1,482 @@
+#include "AudioOffline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+
+#include "Constant.h"
+#include "Profiler.h"	// Use Now() for the statistics
+#include "Useful.h"		// Use IsExistFile()
+
+namespace
+{
+	bool IsWaveFile( const std::string &fileName )
+	{
+		if ( fileName.size() < 4 ) { return false; }
+		// else
+
+		std::string extension = fileName.substr( fileName.size() - 4 );
+		std::transform
+		(
+			extension.begin(), extension.end(), extension.begin(),
+			[]( char c ) { return scast<char>( ::tolower( scast<unsigned char>( c ) ) ); }
+		);
+		return extension == ".wav";
+	}
+	/// <summary>
+	/// Reads the length from the "fmt " and the "data" chunks of RIFF WAVE file. Returns a negative value if failed.
+	/// </summary>
+	float ReadWaveSeconds( const std::string &fileName )
+	{
+		std::ifstream ifs{ fileName, std::ios::binary };
+		if ( !ifs ) { return -1.0f; }
+		// else
+
+		auto ReadU32 = [&ifs]()
+		{
+			unsigned char bytes[4]{};
+			ifs.read( reinterpret_cast<char *>( bytes ), 4 );
+			return	  scast<std::uint32_t>( bytes[0] )
+					| scast<std::uint32_t>( bytes[1] ) << 8
+					| scast<std::uint32_t>( bytes[2] ) << 16
+					| scast<std::uint32_t>( bytes[3] ) << 24;
+		};
+		auto ReadTag = [&ifs]()
+		{
+			char tag[4]{};
+			ifs.read( tag, 4 );
+			return std::string( tag, 4 );
+		};
+
+		if ( ReadTag() != "RIFF" ) { return -1.0f; }
+		ReadU32(); // The file size
+		if ( ReadTag() != "WAVE" ) { return -1.0f; }
+		// else
+
+		std::uint32_t byteRate = 0;
+		while ( ifs )
+		{
+			const std::string	tag		= ReadTag();
+			const std::uint32_t	size	= ReadU32();
+			if ( !ifs ) { break; }
+			// else
+
+			if ( tag == "fmt " )
+			{
+				ifs.seekg( 8, std::ios::cur ); // Skip the format, the channel count, and the sample rate
+				byteRate = ReadU32();
+				ifs.seekg( scast<std::streamoff>( size ) - 12 + ( size & 1 ), std::ios::cur );
+				continue;
+			}
+			// else
+
+			if ( tag == "data" )
+			{
+				return ( byteRate == 0 ) ? -1.0f : scast<float>( size ) / scast<float>( byteRate );
+			}
+			// else
+
+			// The chunk is aligned by 2 bytes
+			ifs.seekg( scast<std::streamoff>( size ) + ( size & 1 ), std::ios::cur );
+		}
+
+		return -1.0f;
+	}
+}
+
+namespace Donya
+{
+	OfflineAudioBackend::OfflineAudioBackend( float stepSeconds ) :
+		stepSeconds( 0.0f ), sounds(), mixBuffer(), newerIndices(), statistics()
+	{
+		SetStepSeconds( stepSeconds );
+	}
+
+	void OfflineAudioBackend::Update()
+	{
+		const std::int64_t beginNS = Donya::Profiler::Now();
+
+		Mix();
+
+		for ( auto &it : sounds )
+		{
+			for ( auto &voice : it.second.voices )
+			{
+				AdvanceVoice( &voice, it.second );
+			}
+		}
+
+		statistics.playingVoiceCount	= GetNowPlayingChannelCount();
+		statistics.peakVoiceCount		= std::max( statistics.peakVoiceCount, statistics.playingVoiceCount );
+		statistics.updateMilliseconds	= scast<float>( Donya::Profiler::Now() - beginNS ) * 0.000001f;
+
+		peakBytes = std::max( peakBytes, CalcUsingBytes() );
+	}
+
+	size_t OfflineAudioBackend::Load( std::string fileName, bool isEnableLoop, bool isStream, int maxVoiceCount, VoiceSteal steal )
+	{
+		// Same as the AudioSystem
+		size_t hash = std::hash<std::string>()( fileName );
+		if ( hash == NULL )	// NULL using error code.
+		{
+			hash = 1;
+		}
+
+		if ( sounds.find( hash ) != sounds.end() ) { return hash; }
+		// else
+
+		if ( !Donya::IsExistFile( fileName ) ) { return NULL; }
+		// else
+
+		Source source{};
+		source.fileName		= fileName;
+		source.isEnableLoop	= isEnableLoop;
+		source.isStream		= isStream;
+		source.isOpened		= !isStream;
+		source.steal		= steal;
+
+		if ( IsWaveFile( fileName ) )
+		{
+			const float seconds = ReadWaveSeconds( fileName );
+			if ( 0.0f < seconds ) { source.lengthSeconds = seconds; }
+		}
+
+		// A stream can be played by one channel only
+		ResizeVoices( &source, ( isStream ) ? 1 : maxVoiceCount );
+
+		sounds.insert( std::make_pair( hash, std::move( source ) ) );
+		return hash;
+	}
+	bool OfflineAudioBackend::SetVoiceLimit( size_t handle, int maxVoiceCount, VoiceSteal steal )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		pSource->steal = steal;
+		ResizeVoices( pSource, maxVoiceCount );
+		return true;
+	}
+
+	bool OfflineAudioBackend::Play( size_t handle, float volume )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		Voice *pSlot = FindSlot( pSource );
+		if ( !pSlot ) { return false; } // The voices are full
+		// else
+
+		pSource->isOpened = true;
+
+		*pSlot = Voice{};
+		pSlot->active		= true;
+		pSlot->playOrder	= ++pSource->playedCount;
+		pSlot->volume		= volume;
+		return true;
+	}
+	bool OfflineAudioBackend::Pause( size_t handle, bool isEnableForAll )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		auto Operate = []( Voice &voice )
+		{
+			if ( voice.paused ) { return Operation::Skipped; }
+			// else
+
+			voice.paused = true;
+			return Operation::Applied;
+		};
+		return ApplyFromLatest( pSource, isEnableForAll, Operate );
+	}
+	bool OfflineAudioBackend::Resume( size_t handle, bool isEnableForAll, bool fromTheBeginning )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		auto Operate = [&]( Voice &voice )
+		{
+			if ( !voice.paused ) { return Operation::Skipped; }
+			// else
+
+			if ( fromTheBeginning ) { voice.position = 0.0f; }
+			voice.paused = false;
+			return Operation::Applied;
+		};
+		return ApplyFromLatest( pSource, isEnableForAll, Operate );
+	}
+	bool OfflineAudioBackend::Stop( size_t handle, bool isEnableForAll )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		auto Operate = []( Voice &voice )
+		{
+			voice.active = false;
+			return Operation::Applied;
+		};
+		return ApplyFromLatest( pSource, isEnableForAll, Operate );
+	}
+	bool OfflineAudioBackend::SetVolume( size_t handle, float volume, bool isEnableForAll )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		auto Operate = [&]( Voice &voice )
+		{
+			voice.volume = volume;
+			return Operation::Applied;
+		};
+		return ApplyFromLatest( pSource, isEnableForAll, Operate );
+	}
+	bool OfflineAudioBackend::AppendFadePoint( size_t handle, float takeSeconds, float destVolume, bool isEnableForAll )
+	{
+		Source *pSource = FindOrNullptr( handle );
+		if ( !pSource ) { return false; }
+		// else
+
+		auto Operate = [&]( Voice &voice )
+		{
+			voice.fadeFrom		= voice.fadeGain;
+			voice.fadeTo		= destVolume;
+			voice.fadeElapsed	= 0.0f;
+			voice.fadeLength	= std::max( 0.0f, takeSeconds );
+			if ( IsZero( voice.fadeLength ) )
+			{
+				voice.fadeGain = destVolume;
+			}
+			return Operation::Applied;
+		};
+		return ApplyFromLatest( pSource, isEnableForAll, Operate );
+	}
+
+	bool OfflineAudioBackend::Release( size_t handle )
+	{
+		const auto found = sounds.find( handle );
+		if ( found == sounds.end() ) { return false; }
+		// else
+
+		sounds.erase( found );
+		return true;
+	}
+	bool OfflineAudioBackend::ReleaseAll()
+	{
+		sounds.clear();
+		return true;
+	}
+
+	int OfflineAudioBackend::GetNowPlayingSoundCount( size_t handle ) const
+	{
+		const auto found = sounds.find( handle );
+		if ( found == sounds.end() ) { return -1; }
+		// else
+
+		int count = 0;
+		for ( const auto &voice : found->second.voices )
+		{
+			if ( voice.active ) { count++; }
+		}
+		return count;
+	}
+	int OfflineAudioBackend::GetNowPlayingChannelCount()
+	{
+		int count = 0;
+		for ( const auto &it : sounds )
+		{
+			for ( const auto &voice : it.second.voices )
+			{
+				if ( voice.active && !voice.paused ) { count++; }
+			}
+		}
+		return count;
+	}
+	OfflineAudioBackend::MemoryReport OfflineAudioBackend::GetMemoryReport() const
+	{
+		MemoryReport report{};
+		report.currentBytes	= CalcUsingBytes();
+		report.maxBytes		= std::max( peakBytes, report.currentBytes );
+
+		for ( const auto &it : sounds )
+		{
+			if ( !it.second.isStream )
+			{
+				report.sampleCount++;
+				continue;
+			}
+			// else
+
+			report.streamCount++;
+			if ( it.second.isOpened ) { report.openedStreamCount++; }
+		}
+
+		return report;
+	}
+	OfflineAudioBackend::Statistics OfflineAudioBackend::GetStatistics() const
+	{
+		return statistics;
+	}
+
+	void OfflineAudioBackend::SetStepSeconds( float newStepSeconds )
+	{
+		stepSeconds = std::max( 0.0f, newStepSeconds );
+
+		const size_t frameCount = scast<size_t>( stepSeconds * scast<float>( mixSampleRate ) + 0.5f );
+		mixBuffer.resize( frameCount * mixChannelCount );
+	}
+
+	OfflineAudioBackend::Source *OfflineAudioBackend::FindOrNullptr( size_t handle )
+	{
+		auto found = sounds.find( handle );
+		return ( found == sounds.end() ) ? nullptr : &found->second;
+	}
+	void OfflineAudioBackend::AdvanceVoice( Voice *pVoice, const Source &source ) const
+	{
+		if ( !pVoice->active || pVoice->paused ) { return; }
+		// else
+
+		if ( 0.0f < pVoice->fadeLength )
+		{
+			pVoice->fadeElapsed = std::min( pVoice->fadeLength, pVoice->fadeElapsed + stepSeconds );
+			const float percent = pVoice->fadeElapsed / pVoice->fadeLength;
+			pVoice->fadeGain = pVoice->fadeFrom + ( pVoice->fadeTo - pVoice->fadeFrom ) * percent;
+			if ( pVoice->fadeLength <= pVoice->fadeElapsed )
+			{
+				pVoice->fadeLength = 0.0f;
+			}
+		}
+
+		pVoice->position += stepSeconds;
+		if ( pVoice->position < source.lengthSeconds ) { return; }
+		// else
+
+		if ( source.isEnableLoop && 0.0f < source.lengthSeconds )
+		{
+			pVoice->position = std::fmod( pVoice->position, source.lengthSeconds );
+			return;
+		}
+		// else
+
+		pVoice->active = false;
+	}
+	void OfflineAudioBackend::Mix()
+	{
+		std::fill( mixBuffer.begin(), mixBuffer.end(), 0.0f );
+
+		const size_t sampleCount = mixBuffer.size();
+		for ( const auto &it : sounds )
+		{
+			for ( const auto &voice : it.second.voices )
+			{
+				if ( !voice.active || voice.paused ) { continue; }
+				// else
+
+				const float gain = voice.CalcAudibility();
+				for ( size_t i = 0; i < sampleCount; ++i )
+				{
+					mixBuffer[i] += gain;
+				}
+			}
+		}
+
+		mixedFrameCount += sampleCount / mixChannelCount;
+	}
+	int OfflineAudioBackend::CalcUsingBytes() const
+	{
+		size_t bytes = mixBuffer.capacity() * sizeof( float );
+		bytes += newerIndices.capacity() * sizeof( size_t );
+		for ( const auto &it : sounds )
+		{
+			bytes += sizeof( Source );
+			bytes += it.second.fileName.capacity();
+			bytes += it.second.voices.capacity() * sizeof( Voice );
+		}
+		return scast<int>( bytes );
+	}
+	void OfflineAudioBackend::ResizeVoices( Source *pSource, int maxVoiceCount ) const
+	{
+		auto &voices = pSource->voices;
+
+		// Keep the newer voices
+		std::stable_sort
+		(
+			voices.begin(), voices.end(),
+			[]( const Voice &lhs, const Voice &rhs )
+			{
+				if ( lhs.active != rhs.active ) { return lhs.active; }
+				// else
+				return rhs.playOrder < lhs.playOrder;
+			}
+		);
+		voices.resize( scast<size_t>( std::max( 1, maxVoiceCount ) ) );
+	}
+	OfflineAudioBackend::Voice *OfflineAudioBackend::FindSlot( Source *pSource ) const
+	{
+		auto &voices = pSource->voices;
+		for ( auto &it : voices )
+		{
+			if ( !it.active ) { return &it; }
+		}
+
+		auto CompareOldest = []( const Voice &lhs, const Voice &rhs )
+		{
+			return lhs.playOrder < rhs.playOrder;
+		};
+		auto CompareQuietest = []( const Voice &lhs, const Voice &rhs )
+		{
+			const float lhsAudibility = lhs.CalcAudibility();
+			const float rhsAudibility = rhs.CalcAudibility();
+			if ( lhsAudibility != rhsAudibility ) { return lhsAudibility < rhsAudibility; }
+			// else
+			return lhs.playOrder < rhs.playOrder;
+		};
+
+		switch ( pSource->steal )
+		{
+		case VoiceSteal::Oldest:	return &*std::min_element( voices.begin(), voices.end(), CompareOldest		);
+		case VoiceSteal::Quietest:	return &*std::min_element( voices.begin(), voices.end(), CompareQuietest	);
+		case VoiceSteal::Reject:	return nullptr;
+		default: break;
+		}
+		return nullptr;
+	}
+
+	template<typename Operate>
+	bool OfflineAudioBackend::ApplyFromLatest( Source *pSource, bool applyAll, Operate operation )
+	{
+		auto &voices = pSource->voices;
+
+		newerIndices.clear();
+		const size_t voiceCount = voices.size();
+		for ( size_t i = 0; i < voiceCount; ++i )
+		{
+			if ( voices[i].active ) { newerIndices.emplace_back( i ); }
+		}
+		std::sort
+		(
+			newerIndices.begin(), newerIndices.end(),
+			[&]( size_t lhs, size_t rhs )
+			{
+				return voices[rhs].playOrder < voices[lhs].playOrder;
+			}
+		);
+
+		for ( const size_t &index : newerIndices )
+		{
+			if ( operation( voices[index] ) == Operation::Skipped ) { continue; }
+			// else
+
+			if ( !applyAll ) { break; }
+		}
+
+		// The offline voices do not fail
+		return true;
+	}
+}
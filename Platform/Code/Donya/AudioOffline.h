@@ -0,0 +1,118 @@
+#ifndef INCLUDED_DONYA_AUDIO_OFFLINE_H_
+#define INCLUDED_DONYA_AUDIO_OFFLINE_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AudioBackend.h"
+
+namespace Donya
+{
+	/// <summary>
+	/// The audio backend that does not use the audio device nor FMOD. It is for the headless runs.<para></para>
+	/// The time advances by a fixed step per Update(), so the playing, the fading, and the voice counts are deterministic.<para></para>
+	/// The files are not decoded. The length is read from the header of WAVE file, or uses "defaultLengthSeconds".<para></para>
+	/// The mixer adds the gain of each voice into an offline buffer as a constant signal, so the cost scales like a real mixing.
+	/// </summary>
+	class OfflineAudioBackend final : public IAudioBackend
+	{
+	public:
+		static constexpr int	mixSampleRate			= 48000;
+		static constexpr int	mixChannelCount			= 2;
+		static constexpr float	defaultLengthSeconds	= 1.0f;
+	private:
+		struct Voice
+		{
+			bool			active		= false;
+			bool			paused		= false;
+			unsigned int	playOrder	= 0;		// The bigger is newer
+			float			position	= 0.0f;		// Second
+			float			volume		= 1.0f;
+			float			fadeGain	= 1.0f;
+			float			fadeFrom	= 1.0f;
+			float			fadeTo		= 1.0f;
+			float			fadeElapsed	= 0.0f;
+			float			fadeLength	= 0.0f;		// Zero means not fading
+		public:
+			float CalcAudibility() const { return volume * fadeGain; }
+		};
+		struct Source
+		{
+			std::string			fileName;
+			float				lengthSeconds	= defaultLengthSeconds;
+			bool				isEnableLoop	= false;
+			bool				isStream		= false;
+			bool				isOpened		= false;	// The stream is opened at the first play
+			VoiceSteal			steal			= VoiceSteal::Oldest;
+			std::vector<Voice>	voices;						// The size is the max voice count
+			unsigned int		playedCount		= 0;
+		};
+		enum class Operation
+		{
+			Applied,
+			Skipped,
+		};
+	private:
+		float								stepSeconds;
+		std::unordered_map<size_t, Source>	sounds;
+		std::vector<float>					mixBuffer;		// Interleaved samples of a step
+		std::vector<size_t>					newerIndices;	// Workspace for visiting the voices from the latest one
+		Statistics							statistics;
+		int									peakBytes		= 0;
+		unsigned long long					mixedFrameCount	= 0;
+	public:
+		/// <summary>
+		/// The "stepSeconds" is the time that advances per Update().
+		/// </summary>
+		explicit OfflineAudioBackend( float stepSeconds = 1.0f / 60.0f );
+		~OfflineAudioBackend() override = default;
+		OfflineAudioBackend( const OfflineAudioBackend &  ) = delete;
+		OfflineAudioBackend( const OfflineAudioBackend && ) = delete;
+		OfflineAudioBackend & operator = ( const OfflineAudioBackend &  ) = delete;
+		OfflineAudioBackend & operator = ( const OfflineAudioBackend && ) = delete;
+	public:
+		void	Update() override;
+
+		size_t	Load( std::string fileName, bool isEnableLoop, bool isStream = false, int maxVoiceCount = defaultMaxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) override;
+		bool	SetVoiceLimit( size_t soundHandle, int maxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) override;
+
+		bool	Play( size_t soundHandle, float volume = 1.0f ) override;
+		bool	Pause( size_t soundHandle, bool isEnableForAll = false ) override;
+		bool	Resume( size_t soundHandle, bool isEnableForAll = false, bool fromTheBeginning = false ) override;
+		bool	Stop( size_t soundHandle, bool isEnableForAll = false ) override;
+		bool	SetVolume( size_t soundHandle, float volume, bool isEnableForAll = false ) override;
+		bool	AppendFadePoint( size_t soundHandle, float takeSeconds, float destinationVolume, bool isEnableForAll = false ) override;
+
+		bool	Release( size_t soundHandle ) override;
+		bool	ReleaseAll() override;
+	public:
+		int		GetNowPlayingSoundCount( size_t soundHandle ) const override;
+		int		GetNowPlayingChannelCount() override;
+		MemoryReport	GetMemoryReport() const override;
+		Statistics		GetStatistics() const override;
+	public:
+		void	SetStepSeconds( float newStepSeconds );
+		float	GetStepSeconds()		const { return stepSeconds;		}
+		/// <summary>
+		/// The sample frames that have been mixed since the construction.
+		/// </summary>
+		unsigned long long GetMixedFrameCount() const { return mixedFrameCount; }
+	private:
+		Source	*FindOrNullptr( size_t soundHandle );
+		void	AdvanceVoice( Voice *pVoice, const Source &source ) const;
+		void	Mix();
+		int		CalcUsingBytes() const;
+		void	ResizeVoices( Source *pSource, int maxVoiceCount ) const;
+		Voice	*FindSlot( Source *pSource ) const;
+
+		/// <summary>
+		/// Applies the "operation" from the latest voice, to the first applied voice or all(when "applyAll" is true).<para></para>
+		/// Returns true always, because the offline voices do not fail.
+		/// </summary>
+		template<typename Operate>
+		bool	ApplyFromLatest( Source *pSource, bool applyAll, Operate operation );
+	};
+}
+
+#endif // !INCLUDED_DONYA_AUDIO_OFFLINE_H_
@@ -3,13 +3,15 @@
 #include <fmod.hpp>
 #include <fmod_studio.hpp>
 #include <fmod_errors.h>
+#include <algorithm>
 #include <functional>
-
 #include <string>
+#include <vector>
 
 #include <windows.h>	// For MB_OK macro
 
 #include "Constant.h"
+#include "Profiler.h"	// Use Now() for the statistics
 #include "Useful.h"
 
 bool FMODFailed( FMOD_RESULT fr )
@@ -58,300 +60,298 @@ bool OutputDebugErrorStringIfFMODFailed( FMOD_RESULT fr )
 
 namespace Donya
 {
+	/// <summary>
+	/// The voice table of a sound. The capacity is fixed by the max voice count, so the playing does not grow it.<para></para>
+	/// The finished channels are released by Poll(), then the slots are reused.
+	/// </summary>
 	class AudioSystem::Channels
 	{
 	private:
-		std::vector<FMOD::Channel *> channels;
+		struct Voice
+		{
+			FMOD::Channel	*pChannel	= nullptr;	// nullptr means the free slot
+			unsigned int	playOrder	= 0;		// The bigger is newer
+		};
+		enum class Operation
+		{
+			Applied,
+			Skipped,
+			Failed,
+		};
+	private:
+		std::vector<Voice>	voices;
+		std::vector<size_t>	newerIndices;	// Workspace for visiting the voices from the latest one. Its capacity is same as "voices".
+		VoiceSteal			steal;
+		unsigned int		playedCount	= 0;
 	public:
-		Channels() : channels() {}
-		~Channels() { std::vector<FMOD::Channel *>().swap( channels ); }
+		Channels( int maxVoiceCount, VoiceSteal steal ) : voices(), newerIndices(), steal( steal )
+		{
+			SetLimit( maxVoiceCount, steal );
+		}
+		~Channels() { ReleaseAll(); }
 	public:
+		/// <summary>
+		/// If the voices are full, it stops a voice and returns that slot, by the steal mode.<para></para>
+		/// Returns nullptr if the steal mode is Reject and the voices are full.
+		/// </summary>
 		FMOD::Channel **RequireNullChannel()
 		{
-			if ( channels.empty() || channels.back() != nullptr )
+			Voice *pSlot = FindFreeSlot();
+			if ( !pSlot )
 			{
-				channels.push_back( nullptr );
+				pSlot = FindStealTarget();
+				if ( !pSlot ) { return nullptr; }
+				// else
+
+				OutputDebugErrorStringIfFMODFailed( pSlot->pChannel->stop() );
+				pSlot->pChannel = nullptr;
 			}
 
-			return &channels.back();
+			pSlot->playOrder = ++playedCount;
+			return &pSlot->pChannel;
 		}
-	private:
-
-		// These method processing from latest channel. because I think the target of who want to operate is recently-played channel.
-
 		/// <summary>
-		/// Apply to first found channel, or all(when "applyAll" is true).<para></para>
-		/// If is there null channel or an error occurred, the channel will be remove. then I continue pause until successful.<para></para>
-		/// Return true if not failed.
+		/// Releases the slots of finished or invalid channels. Please call once per frame.
 		/// </summary>
-		bool SetPauseState( bool setPause, bool applyAll, bool resumeFromTheBeginning = false )
+		void Poll()
 		{
-			bool			failed		= false;
-			size_t			offset		= 0;
-			size_t			arraySize	= channels.size();
-			FMOD_RESULT		fr			= FMOD_OK;
-			FMOD::Channel	*pChannel	= nullptr;
-
-			auto PopBack = [&]()
-			{
-				channels.pop_back();
-				arraySize--;
-			};
-
-			while ( !channels.empty() )
+			bool		playing	= false;
+			FMOD_RESULT	fr		= FMOD_OK;
+			for ( auto &it : voices )
 			{
-				if ( arraySize <= offset ) { break; }
+				if ( !it.pChannel ) { continue; }
 				// else
 
-				pChannel = *( channels.rbegin() + offset );
-
-				if ( pChannel == nullptr )
+				playing = false;
+				fr = it.pChannel->isPlaying( &playing );
+				if ( fr != FMOD_OK || !playing )
 				{
-					PopBack();
-					continue;
+					it.pChannel = nullptr;
 				}
-				// else
+			}
+		}
+		/// <summary>
+		/// The voices over the new count are stopped from the oldest one.
+		/// </summary>
+		void SetLimit( int maxVoiceCount, VoiceSteal newSteal )
+		{
+			steal = newSteal;
 
-				bool nowPaused = false;
-				fr = pChannel->getPaused( &nowPaused );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
-				// else
+			const size_t newCount = scast<size_t>( std::max( 1, maxVoiceCount ) );
+			while ( newCount < CountAliveVoices() )
+			{
+				Voice *pOldest = FindOldest();
+				OutputDebugErrorStringIfFMODFailed( pOldest->pChannel->stop() );
+				pOldest->pChannel = nullptr;
+			}
 
-				if ( nowPaused == setPause ) { offset++; continue; }
+			// Move the alive voices to front, then shrink or extend the table
+			std::stable_partition
+			(
+				voices.begin(), voices.end(),
+				[]( const Voice &v ) { return v.pChannel != nullptr; }
+			);
+			voices.resize( newCount );
+			newerIndices.reserve( newCount );
+		}
+	private:
+		size_t CountAliveVoices() const
+		{
+			size_t count = 0;
+			for ( const auto &it : voices )
+			{
+				if ( it.pChannel ) { count++; }
+			}
+			return count;
+		}
+		Voice *FindFreeSlot()
+		{
+			for ( auto &it : voices )
+			{
+				if ( !it.pChannel ) { return &it; }
+			}
+			return nullptr;
+		}
+		Voice *FindOldest()
+		{
+			Voice *pOldest = nullptr;
+			for ( auto &it : voices )
+			{
+				if ( !it.pChannel ) { continue; }
 				// else
 
-				if ( !setPause && resumeFromTheBeginning )
+				if ( !pOldest || it.playOrder < pOldest->playOrder )
 				{
-					fr = pChannel->setPosition( 0, FMOD_TIMEUNIT_MS );
-					if ( OutputDebugErrorStringIfFMODFailed( fr ) )
-					{
-						failed = true;
-						PopBack();
-						continue;
-					}
+					pOldest = &it;
 				}
+			}
+			return pOldest;
+		}
+		Voice *FindQuietest()
+		{
+			Voice	*pQuietest	= nullptr;
+			float	minimum		= 0.0f;
+			float	audibility	= 0.0f;
+			for ( auto &it : voices )
+			{
+				if ( !it.pChannel ) { continue; }
+				// else
 
-				fr = pChannel->setPaused( setPause ? true : false );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				// The audibility contains the volume, the fade, and the 3D attenuation
+				if ( FMODFailed( it.pChannel->getAudibility( &audibility ) ) ) { continue; }
 				// else
 
-				if ( applyAll )
+				if ( !pQuietest || audibility < minimum || ( audibility == minimum && it.playOrder < pQuietest->playOrder ) )
 				{
-					offset++;
-					continue;
+					pQuietest	= &it;
+					minimum		= audibility;
 				}
-				// else
-				return ( failed ) ? false : true;
 			}
-
-			return ( failed ) ? false : true;
+			return ( pQuietest ) ? pQuietest : FindOldest();
+		}
+		Voice *FindStealTarget()
+		{
+			switch ( steal )
+			{
+			case VoiceSteal::Oldest:	return FindOldest();
+			case VoiceSteal::Quietest:	return FindQuietest();
+			case VoiceSteal::Reject:	return nullptr;
+			default: break;
+			}
+			return nullptr;
 		}
+
 		/// <summary>
-		/// Apply to first found channel, or all(when "applyAll" is true).<para></para>
-		/// If is there null channel or an error occurred, the channel will be remove. then I continue stop until successful.<para></para>
+		/// Visits the alive voices from the latest one, because I think the target of who want to operate is recently-played channel.<para></para>
+		/// Applies the "operation" to first applied voice, or all(when "applyAll" is true).<para></para>
+		/// If an error occurred, the voice will be released. then I continue until successful.<para></para>
 		/// Return true if not failed.
 		/// </summary>
-		bool StopAndRemove( bool applyAll )
+		template<typename Operate>
+		bool ApplyFromLatest( bool applyAll, Operate operation )
 		{
-			bool			failed		= false;
-			size_t			offset		= 0;
-			size_t			arraySize	= channels.size();
-			FMOD_RESULT		fr			= FMOD_OK;
-			FMOD::Channel	*pChannel	= nullptr;
-
-			auto PopBack = [&]()
+			newerIndices.clear();
+			const size_t voiceCount = voices.size();
+			for ( size_t i = 0; i < voiceCount; ++i )
 			{
-				channels.pop_back();
-				arraySize--;
-			};
-
-			while ( !channels.empty() )
-			{
-				if ( arraySize <= offset ) { break; }
-				// else
-
-				pChannel = *( channels.rbegin() + offset );
-
-				if ( pChannel == nullptr )
+				if ( voices[i].pChannel ) { newerIndices.emplace_back( i ); }
+			}
+			std::sort
+			(
+				newerIndices.begin(), newerIndices.end(),
+				[&]( size_t lhs, size_t rhs )
 				{
-					PopBack();
-					continue;
+					return voices[rhs].playOrder < voices[lhs].playOrder;
 				}
-				// else
+			);
 
-				// Applies only to now playing channel. because if stop pausing channel, user don't understand result.
-				bool isPlaying = false;
-				fr = pChannel->isPlaying( &isPlaying );
-				if ( FMODFailed( fr ) )
+			bool failed = false;
+			for ( const size_t &index : newerIndices )
+			{
+				Voice &voice = voices[index];
+				const Operation result = operation( voice );
+				if ( result == Operation::Failed )
 				{
 					failed = true;
-					PopBack();
+					voice.pChannel = nullptr;
 					continue;
 				}
 				// else
 
-				if ( !isPlaying ) { offset++; continue; }
+				if ( result == Operation::Skipped ) { continue; }
 				// else
 
-				fr = pChannel->stop();
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
-				// else
-
-				// Remove stoped channel.
-				PopBack();
-
-				if ( applyAll ) { continue; }
-				// else
-				return ( failed ) ? false : true;
+				if ( !applyAll ) { break; }
 			}
 
 			return ( failed ) ? false : true;
 		}
-		/// <summary>
-		/// Apply to first found channel, or all(when "applyAll" is true).<para></para>
-		/// If is there null channel or an error occurred, the channel will be remove. then I continue setting volume until successful.<para></para>
-		/// Return true if not failed.
-		/// </summary>
-		bool SetVolume( float volume, bool applyAll )
-		{
-			bool			failed		= false;
-			size_t			offset		= 0;
-			size_t			arraySize	= channels.size();
-			FMOD_RESULT		fr			= FMOD_OK;
-			FMOD::Channel	*pChannel	= nullptr;
 
-			auto PopBack = [&]()
+		bool SetPauseState( bool setPause, bool applyAll, bool resumeFromTheBeginning = false )
+		{
+			auto Operate = [&]( Voice &voice )
 			{
-				channels.pop_back();
-				arraySize--;
-			};
+				FMOD::Channel *pChannel = voice.pChannel;
 
-			while ( !channels.empty() )
-			{
-				if ( arraySize <= offset ) { break; }
+				bool nowPaused = false;
+				FMOD_RESULT fr = pChannel->getPaused( &nowPaused );
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
 
-				pChannel = *( channels.rbegin() + offset );
+				if ( nowPaused == setPause ) { return Operation::Skipped; }
+				// else
 
-				if ( pChannel == nullptr )
+				if ( !setPause && resumeFromTheBeginning )
 				{
-					PopBack();
-					continue;
+					fr = pChannel->setPosition( 0, FMOD_TIMEUNIT_MS );
+					if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { return Operation::Failed; }
+					// else
 				}
+
+				fr = pChannel->setPaused( setPause ? true : false );
+				return ( FMODFailed( fr ) ) ? Operation::Failed : Operation::Applied;
+			};
+			return ApplyFromLatest( applyAll, Operate );
+		}
+		bool StopAndRemove( bool applyAll )
+		{
+			auto Operate = []( Voice &voice )
+			{
+				// Applies only to now playing channel. because if stop pausing channel, user don't understand result.
+				bool isPlaying = false;
+				FMOD_RESULT fr = voice.pChannel->isPlaying( &isPlaying );
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
 
-				fr = pChannel->setVolume( volume );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( !isPlaying ) { return Operation::Skipped; }
 				// else
 
-				if ( applyAll )
-				{
-					offset++;
-					continue;
-				}
+				fr = voice.pChannel->stop();
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
-				return ( failed ) ? false : true;
-			}
 
-			return ( failed ) ? false : true;
+				// Release the stopped slot
+				voice.pChannel = nullptr;
+				return Operation::Applied;
+			};
+			return ApplyFromLatest( applyAll, Operate );
 		}
-		/// <summary>
-		/// Apply to first found channel, or all(when "applyAll" is true).<para></para>
-		/// If is there null channel or an error occurred, the channel will be remove. then I continue append fade-point until successful.<para></para>
-		/// Return true if not failed.
-		/// </summary>
-		bool AppendFadePoint( float takeSecond, float destVolume, bool applyAll )
+		bool SetVolume( float volume, bool applyAll )
 		{
-			bool				failed		= false;
-			size_t				offset		= 0;
-			size_t				arraySize	= channels.size();
-			FMOD_RESULT			fr			= FMOD_OK;
-			FMOD::Channel		*pChannel	= nullptr;
-
-			int					mixerRate	= 0;
-			float				oldVolume	= 0.0f;
-			unsigned long long	DSPClock	= 0ull;	// Reference clock, which is the parent channel group.
-			unsigned long long	distance	= 0ull;	// "DSPClock" + "distance" = destination clock.
-			FMOD::System		*pSystem	= nullptr;
-
-			auto PopBack = [&]()
+			auto Operate = [&]( Voice &voice )
 			{
-				channels.pop_back();
-				arraySize--;
+				const FMOD_RESULT fr = voice.pChannel->setVolume( volume );
+				return ( FMODFailed( fr ) ) ? Operation::Failed : Operation::Applied;
 			};
-
-			while ( !channels.empty() )
+			return ApplyFromLatest( applyAll, Operate );
+		}
+		bool AppendFadePoint( float takeSecond, float destVolume, bool applyAll )
+		{
+			auto Operate = [&]( Voice &voice )
 			{
-				if ( arraySize <= offset ) { break; }
-				// else
-
-				pChannel = *( channels.rbegin() + offset );
-
-				if ( pChannel == nullptr )
-				{
-					PopBack();
-					continue;
-				}
-				// else
+				FMOD::Channel		*pChannel	= voice.pChannel;
+				FMOD_RESULT			fr			= FMOD_OK;
+				int					mixerRate	= 0;
+				float				oldVolume	= 0.0f;
+				unsigned long long	DSPClock	= 0ull;	// Reference clock, which is the parent channel group.
+				unsigned long long	distance	= 0ull;	// "DSPClock" + "distance" = destination clock.
+				FMOD::System		*pSystem	= nullptr;
 
 				// see https://qa.fmod.com/t/how-do-i-fade-in-and-fade-out-a-channel-with-stop/11738/2
 
 			#pragma region FetchRequiredVariables
 
 				fr = pChannel->getVolume( &oldVolume );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
-
 				fr = pChannel->getSystemObject( &pSystem );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
-
 				fr = pSystem->getSoftwareFormat( &mixerRate, 0, 0 );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
-				
 				fr = pChannel->getDSPClock( 0, &DSPClock );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
 
 			// region FetchRequiredVariables
@@ -363,37 +363,20 @@ namespace Donya
 				distance = scast<unsigned long long>( dMixerRate * dTakeSecond );
 
 				fr = pChannel->addFadePoint( DSPClock, oldVolume );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
 				fr = pChannel->addFadePoint( DSPClock + distance, destVolume );
-				if ( FMODFailed( fr ) )
-				{
-					failed = true;
-					PopBack();
-					continue;
-				}
-				// else
-
-				if ( applyAll )
-				{
-					offset++;
-					continue;
-				}
+				if ( FMODFailed( fr ) ) { return Operation::Failed; }
 				// else
-				return ( failed ) ? false : true;
-			}
 
-			return ( failed ) ? false : true;
+				return Operation::Applied;
+			};
+			return ApplyFromLatest( applyAll, Operate );
 		}
 	public:
 		/// <summary>
 		/// Pause one out of channels of not pausing.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed pause.
 		/// </summary>
 		bool PauseOne()
@@ -402,7 +385,7 @@ namespace Donya
 		}
 		/// <summary>
 		/// Pause all channels of not pausing.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed pause of all in channels.
 		/// </summary>
 		bool PauseAll()
@@ -412,7 +395,7 @@ namespace Donya
 
 		/// <summary>
 		/// Resume one out of channels of now pausing.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed resume.
 		/// </summary>
 		bool ResumeOne( bool fromTheBeginning )
@@ -421,7 +404,7 @@ namespace Donya
 		}
 		/// <summary>
 		/// Resume all channels of now pausing.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed resume of all in channels.
 		/// </summary>
 		bool ResumeAll( bool fromTheBeginning )
@@ -431,7 +414,7 @@ namespace Donya
 
 		/// <summary>
 		/// Stop one out of channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed stop.
 		/// </summary>
 		bool StopOne()
@@ -440,7 +423,7 @@ namespace Donya
 		}
 		/// <summary>
 		/// Stop all channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if successed stop of all in channels.
 		/// </summary>
 		bool StopAll()
@@ -450,7 +433,7 @@ namespace Donya
 
 		/// <summary>
 		/// Set the volume of sound one out of channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if setting volume is successed.
 		/// </summary>
 		bool SetVolumeOne( float volume )
@@ -459,7 +442,7 @@ namespace Donya
 		}
 		/// <summary>
 		/// Set the volume of sound all channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if setting volume is successed of all in channels.
 		/// </summary>
 		bool SetVolumeAll( float volume )
@@ -469,7 +452,7 @@ namespace Donya
 
 		/// <summary>
 		/// Append fade-point of sound one out of channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if append fade-point is successed.
 		/// </summary>
 		bool AppendFadePointOne( float takeSecond, float destVolume )
@@ -478,7 +461,7 @@ namespace Donya
 		}
 		/// <summary>
 		/// Append fade-point of sound all channels.<para></para>
-		/// If found invalid channel, remove the channel.<para></para>
+		/// If found invalid channel, release the slot of the channel.<para></para>
 		/// Returns true if append fade-point is successed of all in channels.
 		/// </summary>
 		bool AppendFadePointAll( float takeSecond, float destVolume )
@@ -492,9 +475,12 @@ namespace Donya
 			bool		playing	= false;
 			FMOD_RESULT	fr		= FMOD_OK;
 
-			for ( const auto &pChannel : channels )
+			for ( const auto &it : voices )
 			{
-				fr = pChannel->isPlaying( &playing );
+				if ( !it.pChannel ) { continue; }
+				// else
+
+				fr = it.pChannel->isPlaying( &playing );
 				if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { continue; }
 				// else
 
@@ -507,21 +493,15 @@ namespace Donya
 		void ReleaseAll()
 		{
 			FMOD_RESULT fr = FMOD_OK;
-			FMOD::Channel *pChannel = nullptr;
-			while ( !channels.empty() )
+			for ( auto &it : voices )
 			{
-				pChannel = channels.back();
-				if ( pChannel == nullptr )
-				{
-					channels.pop_back();
-					continue;
-				}
+				if ( !it.pChannel ) { continue; }
 				// else
 
-				fr = pChannel->stop();
+				fr = it.pChannel->stop();
 				OutputDebugErrorStringIfFMODFailed( fr );
 
-				channels.pop_back();
+				it.pChannel = nullptr;
 			}
 		}
 	};
@@ -530,7 +510,7 @@ namespace Donya
 
 	AudioSystem::AudioSystem() :
 		pLowSystem( nullptr ), pSystem( nullptr ),
-		sounds(), channels()
+		sounds(), channels(), statistics()
 	{
 		FMOD_RESULT fr = FMOD_OK;
 
@@ -578,6 +558,8 @@ namespace Donya
 
 	void AudioSystem::Update()
 	{
+		const std::int64_t beginNS = Donya::Profiler::Now();
+
 		FMOD_RESULT fr = FMOD_OK;
 		fr = pSystem->update();	// FMOD::Studio::update() is also calling FMOD::update().
 		if ( FMODFailed( fr ) )
@@ -586,9 +568,19 @@ namespace Donya
 			return;
 		}
 		// else
+
+		for ( auto &it : channels )
+		{
+			it.second->Poll();
+		}
+
+		const int playingCount = GetNowPlayingChannelCount();
+		statistics.playingVoiceCount	= std::max( 0, playingCount );
+		statistics.peakVoiceCount		= std::max( statistics.peakVoiceCount, statistics.playingVoiceCount );
+		statistics.updateMilliseconds	= scast<float>( Donya::Profiler::Now() - beginNS ) * 0.000001f;
 	}
 
-	size_t AudioSystem::Load( std::string fileName, bool isEnableLoop )
+	size_t AudioSystem::Load( std::string fileName, bool isEnableLoop, bool isStream, int maxVoiceCount, VoiceSteal steal )
 	{
 		size_t hash = std::hash<std::string>()( fileName );
 		if ( hash == NULL )	// NULL using error code.
@@ -600,36 +592,98 @@ namespace Donya
 		if ( it != sounds.end() ) { return it->first; } // it->first == hash
 		// else
 
-		FMOD_RESULT fr = FMOD_OK;
 		FMOD_MODE mode = FMOD_DEFAULT;
 		mode |= ( isEnableLoop ) ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
+		mode |= ( isStream     ) ? FMOD_CREATESTREAM : FMOD_CREATESAMPLE;
 
-		FMOD::Sound *pSound = nullptr;
-		fr = pLowSystem->createSound( fileName.c_str(), mode, nullptr, &pSound );
-		if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { return NULL; }
-		// else
+		Source source{};
+		source.fileName	= fileName;
+		source.mode		= mode;
+		source.isStream	= isStream;
 
-		sounds.insert( std::make_pair( hash, pSound ) );
-		channels.insert( std::make_pair( hash, std::make_unique<Channels>() ) );
+		if ( isStream )
+		{
+			// The stream is opened at the first play, so only check the file here.
+			if ( !Donya::IsExistFile( fileName ) ) { return NULL; }
+			// else
+
+			// A stream can be played by one channel only
+			maxVoiceCount = 1;
+		}
+		else
+		{
+			if ( !OpenSource( &source ) ) { return NULL; }
+			// else
+		}
+
+		sounds.insert( std::make_pair( hash, std::move( source ) ) );
+		channels.insert( std::make_pair( hash, std::make_unique<Channels>( maxVoiceCount, steal ) ) );
 
 		return hash;
 	}
+	bool AudioSystem::OpenSource( Source *pSource )
+	{
+		if ( pSource->pSound ) { return true; }
+		// else
 
-	bool AudioSystem::Play( size_t handle )
+		FMOD_RESULT fr = pLowSystem->createSound( pSource->fileName.c_str(), scast<FMOD_MODE>( pSource->mode ), nullptr, &pSource->pSound );
+		if ( OutputDebugErrorStringIfFMODFailed( fr ) )
+		{
+			pSource->pSound = nullptr;
+			return false;
+		}
+		// else
+
+		return true;
+	}
+
+	bool AudioSystem::SetVoiceLimit( size_t handle, int maxVoiceCount, VoiceSteal steal )
+	{
+		decltype( channels )::iterator itrChannel = channels.find( handle );
+		if ( itrChannel == channels.end() ) { return false; }
+		// else
+
+		itrChannel->second->SetLimit( maxVoiceCount, steal );
+		return true;
+	}
+
+	bool AudioSystem::Play( size_t handle, float volume )
 	{
 		decltype( sounds )::iterator itrSound = sounds.find( handle );
 		if ( itrSound == sounds.end() ) { return false; }
 		// else
 
+		// Open the stream lazily
+		if ( !OpenSource( &itrSound->second ) ) { return false; }
+		// else
+
 		FMOD_RESULT fr = FMOD_OK;
 
 		decltype( channels )::iterator itrChannel = channels.find( handle );
 		FMOD::Channel **pChannel = itrChannel->second->RequireNullChannel();
+		if ( !pChannel ) { return false; } // The voices are full
+		// else
 
-		fr = pLowSystem->playSound( itrSound->second, NULL, false, pChannel );
-		if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { return false; }
+		// Start as paused if the volume should be changed before it sounds
+		const bool changeVolume = ( volume != 1.0f );
+
+		fr = pLowSystem->playSound( itrSound->second.pSound, NULL, changeVolume, pChannel );
+		if ( OutputDebugErrorStringIfFMODFailed( fr ) )
+		{
+			*pChannel = nullptr; // Release the slot
+			return false;
+		}
 		// else
 
+		if ( changeVolume )
+		{
+			fr = ( *pChannel )->setVolume( volume );
+			OutputDebugErrorStringIfFMODFailed( fr );
+			fr = ( *pChannel )->setPaused( false );
+			if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { return false; }
+			// else
+		}
+
 		return true;
 	}
 
@@ -689,14 +743,21 @@ namespace Donya
 		if ( itrSound == sounds.end() ) { return false; }
 		// else
 
+		decltype( channels )::iterator itrChannel = channels.find( handle );
+		itrChannel->second->ReleaseAll();
+
+		// The not opened stream does not have the sound
 		FMOD_RESULT fr = FMOD_OK;
-		fr = itrSound->second->release();
+		if ( itrSound->second.pSound )
+		{
+			fr = itrSound->second.pSound->release();
+		}
 
 		if ( OutputDebugErrorStringIfFMODFailed( fr ) ) { return false; }
 		// else
 
-		decltype( channels )::iterator itrChannel = channels.find( handle );
-		itrChannel->second->ReleaseAll();
+		sounds.erase( itrSound );
+		channels.erase( itrChannel );
 
 		return true;
 	}
@@ -709,7 +770,10 @@ namespace Donya
 
 		for ( auto &it : sounds )
 		{
-			*appResult = it.second->release();
+			if ( !it.second.pSound ) { continue; }
+			// else
+
+			*appResult = it.second.pSound->release();
 			if ( FMODFailed( *appResult ) )
 			{
 				appResult = &irrelevant;
@@ -753,4 +817,31 @@ namespace Donya
 		return rv;
 	}
 
+	AudioSystem::MemoryReport AudioSystem::GetMemoryReport() const
+	{
+		MemoryReport report{};
+
+		FMOD_RESULT fr = FMOD::Memory_GetStats( &report.currentBytes, &report.maxBytes, false );
+		OutputDebugErrorStringIfFMODFailed( fr );
+
+		for ( const auto &it : sounds )
+		{
+			if ( !it.second.isStream )
+			{
+				report.sampleCount++;
+				continue;
+			}
+			// else
+
+			report.streamCount++;
+			if ( it.second.pSound ) { report.openedStreamCount++; }
+		}
+
+		return report;
+	}
+	AudioSystem::Statistics AudioSystem::GetStatistics() const
+	{
+		return statistics;
+	}
+
 }
\ No newline at end of file
@@ -2,8 +2,11 @@
 #define INCLUDED_DONYA_AUDIO_SYSTEM_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 
+#include "AudioBackend.h"
+
 namespace FMOD
 {
 	class System;
@@ -21,17 +24,29 @@ namespace Donya
 	/// This class Provides audio system by FMOD.<para></para>
 	/// The constructor is doing initialize, the destructor is doing uninitialize.
 	/// </summary>
-	class AudioSystem
+	class AudioSystem final : public IAudioBackend
 	{
 	private:
 		class Channels;
+		/// <summary>
+		/// The stream does not have the "pSound" until first play.
+		/// </summary>
+		struct Source
+		{
+			FMOD::Sound		*pSound		= nullptr;
+			std::string		fileName;
+			unsigned int	mode		= 0;	// FMOD_MODE
+			bool			isStream	= false;
+		};
 	private:
 		FMOD::System			*pLowSystem;
 		FMOD::Studio::System	*pSystem;
 
 		// I should replace raw-pointer to smart-ptr.
-		std::unordered_map<size_t, FMOD::Sound *>	sounds;
+		std::unordered_map<size_t, Source>			sounds;
 		std::unordered_map<size_t, std::unique_ptr<Channels>>	channels;
+
+		Statistics				statistics;
 	public:
 		AudioSystem();
 		~AudioSystem();
@@ -43,42 +58,50 @@ namespace Donya
 		/// <summary>
 		/// Please call every frame.
 		/// </summary>
-		void Update();
+		void Update() override;
 	public:
 		/// <summary>
 		/// Please set relative-path or whole-path to fileName.<para></para>
 		/// If load successed, returns unique handle of sound.<para></para>
 		/// If load failed, returns NULL. <para></para>
-		/// If fileName is already loaded, returns that loaded handle.
+		/// If fileName is already loaded, returns that loaded handle.<para></para>
+		/// If "isStream" is true, the sound is decoded while playing instead of decoding whole into memory, and the file is opened at the first play. It is suitable for long BGM.<para></para>
+		/// The sound can be played simultaneously up to "maxVoiceCount", the over is handled by "steal". The stream can be played by one voice only.
+		/// </summary>
+		size_t Load( std::string fileName, bool isEnableLoop, bool isStream = false, int maxVoiceCount = defaultMaxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) override;
+
+		/// <summary>
+		/// Changes the max voice count of the sound. If the playing voices are over it, those are stopped from the oldest.<para></para>
+		/// If not found, returns false.
 		/// </summary>
-		size_t Load( std::string fileName, bool isEnableLoop );
+		bool SetVoiceLimit( size_t soundHandle, int maxVoiceCount, VoiceSteal steal = VoiceSteal::Oldest ) override;
 
 		/// <summary>
 		/// Play the sound identified by handle.<para></para>
-		/// If failed play, or not found, returns false.
+		/// If failed play, or not found, or the voices are full with VoiceSteal::Reject, returns false.
 		/// </summary>
-		bool Play( size_t soundHandle );
+		bool Play( size_t soundHandle, float volume = 1.0f ) override;
 
 		/// <summary>
 		/// Pause the sound identified by handle.<para></para>
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed pause, or not found, returns false.
 		/// </summary>
-		bool Pause( size_t soundHandle, bool isEnableForAll = false );
+		bool Pause( size_t soundHandle, bool isEnableForAll = false ) override;
 		
 		/// <summary>
 		/// Resume the sound identified by handle.<para></para>
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed resume, or not found, returns false.
 		/// </summary>
-		bool Resume( size_t soundHandle, bool isEnableForAll = false, bool fromTheBeginning = false );
+		bool Resume( size_t soundHandle, bool isEnableForAll = false, bool fromTheBeginning = false ) override;
 
 		/// <summary>
 		/// Stop the sound identified by handle.<para></para>
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed stop, or not found, returns false.
 		/// </summary>
-		bool Stop( size_t soundHandle, bool isEnableForAll = false );
+		bool Stop( size_t soundHandle, bool isEnableForAll = false ) override;
 
 		/// <summary>
 		/// Stop the sound identified by handle.<para></para>
@@ -86,7 +109,7 @@ namespace Donya
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed set to volume, or not found, returns false.
 		/// </summary>
-		bool SetVolume( size_t soundHandle, float volume, bool isEnableForAll = false );
+		bool SetVolume( size_t soundHandle, float volume, bool isEnableForAll = false ) override;
 
 		/// <summary>
 		/// Append the fade-point to sound identified by handle.<para></para>
@@ -95,28 +118,41 @@ namespace Donya
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed this method, or not found, returns false.
 		/// </summary>
-		bool AppendFadePoint( size_t soundHandle, float takeSeconds, float destinationVolume, bool isEnableForAll = false );
+		bool AppendFadePoint( size_t soundHandle, float takeSeconds, float destinationVolume, bool isEnableForAll = false ) override;
 
 		/// <summary>
 		/// Release the sound identified by handle.<para></para>
 		/// If failed release, or not found, returns false.
 		/// </summary>
-		bool Release( size_t soundHandle );
+		bool Release( size_t soundHandle ) override;
 
 		/// <summary>
 		/// Release every sound.<para></para>
 		/// If even one could not released, returns false.
 		/// </summary>
-		bool ReleaseAll();
+		bool ReleaseAll() override;
 	public:
 		/// <summary>
 		/// If failed count, or not found, returns -1.
 		/// </summary>
-		int GetNowPlayingSoundCount( size_t soundHandle ) const;
+		int GetNowPlayingSoundCount( size_t soundHandle ) const override;
 		/// <summary>
 		/// If failed count, returns -1.
 		/// </summary>
-		int GetNowPlayingChannelCount();
+		int GetNowPlayingChannelCount() override;
+		/// <summary>
+		/// Returns the memory usage of FMOD and the count of loaded sounds.
+		/// </summary>
+		MemoryReport GetMemoryReport() const override;
+		/// <summary>
+		/// The "updateMilliseconds" contains the FMOD update.
+		/// </summary>
+		Statistics GetStatistics() const override;
+	private:
+		/// <summary>
+		/// Creates the sound of the source if it has not been created. Returns false if failed.
+		/// </summary>
+		bool OpenSource( Source *pSource );
 	};
 }
 
@@ -9,6 +9,8 @@
 #include <Windows.Foundation.h> // Use Windows::Foundation::Initialize(), Windows::Foundation::Uninitialize().
 #include <wrl.h>
 
+#include "AssetRegistry.h"
+#include "AsyncIO.h"
 #include "Blend.h"
 #include "Constant.h"
 #include "GamepadXInput.h"
@@ -630,7 +632,8 @@ namespace Donya
 		enableCaptionBar( true ),
 		isAppendFPS( true ),
 		fullScreenMode( false ),
-		enableMultiThreaded( true )
+		enableMultiThreaded( true ),
+		enableAudioDevice( true )
 	{}
 	
 	LRESULT CALLBACK WndProc( HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam )
@@ -997,7 +1000,7 @@ namespace Donya
 		Donya::DepthStencil::CreateDefinedStates( GetDevice() );
 		Donya::Rasterizer::CreateDefinedStates( GetDevice() );
 		Donya::Sampler::CreateDefinedStates( GetDevice() );
-		Donya::Sound::Init();
+		Donya::Sound::Init( ( desc.enableAudioDevice ) ? Donya::Sound::Backend::FMOD : Donya::Sound::Backend::Offline );
 		Donya::Sprite::Init();
 
 		Donya::ScreenShake::SetEnableState( true );
@@ -1227,9 +1230,12 @@ namespace Donya
 
 		Donya::Sound::Uninit();
 
+		Donya::AsyncIO::Uninit();
+
 		Donya::XInput::Uninit();
 
 		Donya::Resource::ReleaseAllCachedResources();
+		Donya::Asset::ReleaseAll();
 
 	#if USE_IMGUI
 
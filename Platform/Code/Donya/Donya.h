@@ -23,6 +23,7 @@ namespace Donya
 		bool isAppendFPS;			// Specify append an FPS information behind window-caption. This flag enables only when debug-mode(default is true).
 		bool fullScreenMode;		// Specify the window-mode. Default is false.
 		bool enableMultiThreaded;	// Specify use multi-thread. Default is true.
+		bool enableAudioDevice;		// Specify play the sounds by FMOD. If false, the sounds are simulated by an offline backend without the audio device. Default is true.
 	public:
 		LibraryInitializer();
 	};
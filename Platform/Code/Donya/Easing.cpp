@@ -0,0 +1,135 @@
+#include "Easing.h"
+
+#include <utility>		// Use std::index_sequence
+#include <vector>
+
+namespace Donya
+{
+	namespace Easing
+	{
+		namespace
+		{
+			constexpr int kindCount = GetKindCount();
+			constexpr int typeCount = GetTypeCount();
+			constexpr int functionCount = kindCount * typeCount;
+
+			template<float( *RawFunction )( float ), Type type>
+			float Composite( float t )
+			{
+				return Impl::AdjustResult( type, t, RawFunction( Impl::AdjustTime( type, t ) ) );
+			}
+			// The Linear ignores the type
+			float LinearFunction( float t )
+			{
+				return Impl::Linear( t );
+			}
+
+			// The order is same as the Kind, then the Type
+			constexpr std::array<Function, functionCount> functions
+			{
+				&LinearFunction, &LinearFunction, &LinearFunction,
+				&Composite<Impl::Back,			Type::In>, &Composite<Impl::Back,			Type::Out>, &Composite<Impl::Back,			Type::InOut>,
+				&Composite<Impl::Bounce,		Type::In>, &Composite<Impl::Bounce,			Type::Out>, &Composite<Impl::Bounce,		Type::InOut>,
+				&Composite<Impl::Circular,		Type::In>, &Composite<Impl::Circular,		Type::Out>, &Composite<Impl::Circular,		Type::InOut>,
+				&Composite<Impl::Cubic,			Type::In>, &Composite<Impl::Cubic,			Type::Out>, &Composite<Impl::Cubic,			Type::InOut>,
+				&Composite<Impl::Elastic,		Type::In>, &Composite<Impl::Elastic,		Type::Out>, &Composite<Impl::Elastic,		Type::InOut>,
+				&Composite<Impl::Exponential,	Type::In>, &Composite<Impl::Exponential,	Type::Out>, &Composite<Impl::Exponential,	Type::InOut>,
+				&Composite<Impl::Quadratic,		Type::In>, &Composite<Impl::Quadratic,		Type::Out>, &Composite<Impl::Quadratic,		Type::InOut>,
+				&Composite<Impl::Quartic,		Type::In>, &Composite<Impl::Quartic,		Type::Out>, &Composite<Impl::Quartic,		Type::InOut>,
+				&Composite<Impl::Quintic,		Type::In>, &Composite<Impl::Quintic,		Type::Out>, &Composite<Impl::Quintic,		Type::InOut>,
+				&Composite<Impl::Smooth,		Type::In>, &Composite<Impl::Smooth,			Type::Out>, &Composite<Impl::Smooth,		Type::InOut>,
+				&Composite<Impl::Sinusoidal,	Type::In>, &Composite<Impl::Sinusoidal,		Type::Out>, &Composite<Impl::Sinusoidal,	Type::InOut>,
+				&Composite<Impl::SoftBack,		Type::In>, &Composite<Impl::SoftBack,		Type::Out>, &Composite<Impl::SoftBack,		Type::InOut>,
+				&Composite<Impl::Step,			Type::In>, &Composite<Impl::Step,			Type::Out>, &Composite<Impl::Step,			Type::InOut>,
+			};
+
+			// The count of the intervals. A table has one more sample for the end.
+			constexpr int tableResolution = 1024;
+			using Table = std::vector<float>;
+
+			Kind ToKind( int functionIndex )
+			{
+				return static_cast<Kind>( functionIndex / typeCount );
+			}
+			/// <summary>
+			/// Only the expensive kinds have the table, the others are empty.
+			/// </summary>
+			const std::array<Table, functionCount> &GetTables()
+			{
+				static const std::array<Table, functionCount> tables = []()
+				{
+					std::array<Table, functionCount> result{};
+					for ( int i = 0; i < functionCount; ++i )
+					{
+						if ( !IsExpensive( ToKind( i ) ) ) { continue; }
+						// else
+
+						result[i].resize( tableResolution + 1 );
+						for ( int s = 0; s <= tableResolution; ++s )
+						{
+							result[i][s] = functions[i]( static_cast<float>( s ) / static_cast<float>( tableResolution ) );
+						}
+					}
+					return result;
+				}();
+				return tables;
+			}
+			template<size_t index>
+			float SampleTable( float t )
+			{
+				const Table &table = GetTables()[index];
+
+				const float clamped	= ( t < 0.0f ) ? 0.0f : ( 1.0f < t ) ? 1.0f : t;
+				const float pos		= clamped * static_cast<float>( tableResolution );
+				int left = static_cast<int>( pos );
+				if ( tableResolution <= left ) { left = tableResolution - 1; }
+
+				const float fraction = pos - static_cast<float>( left );
+				return table[left] + ( table[left + 1] - table[left] ) * fraction;
+			}
+			template<size_t ...Indices>
+			constexpr std::array<Function, functionCount> MakeTableFunctions( std::index_sequence<Indices...> )
+			{
+				return std::array<Function, functionCount>{ { &SampleTable<Indices>... } };
+			}
+			constexpr std::array<Function, functionCount> tableFunctions = MakeTableFunctions( std::make_index_sequence<functionCount>{} );
+
+			int ToIndex( Kind kind, Type type )
+			{
+				const int k = static_cast<int>( kind );
+				const int t = static_cast<int>( type );
+				if ( k < 0 || kindCount <= k ) { return -1; }
+				if ( t < 0 || typeCount <= t ) { return -1; }
+				// else
+				return ( k * typeCount ) + t;
+			}
+		}
+
+		Function GetFunction( Kind kind, Type type )
+		{
+			const int index = ToIndex( kind, type );
+			return ( index < 0 ) ? nullptr : functions[index];
+		}
+		bool IsExpensive( Kind kind )
+		{
+			switch ( kind )
+			{
+			case Kind::Bounce:
+			case Kind::Circular:
+			case Kind::Exponential:
+			case Kind::Sinusoidal:
+				return true;
+			default: break;
+			}
+			return false;
+		}
+		Function GetTableFunction( Kind kind, Type type )
+		{
+			if ( !IsExpensive( kind ) ) { return GetFunction( kind, type ); }
+			// else
+
+			const int index = ToIndex( kind, type );
+			return ( index < 0 ) ? nullptr : tableFunctions[index];
+		}
+	}
+}
@@ -250,103 +250,36 @@ namespace Donya
 			return "Unexpected easing type !";
 		}
 
+		/// <summary>
+		/// The ease function that is specialized to a kind and a type, so it does not dispatch by the switch.
+		/// </summary>
+		using Function = float( * )( float currentTime );
+		/// <summary>
+		/// Returns the function that returns the same result as Ease( kind, type, t ).
+		/// Returns nullptr if the kind is invalid.
+		/// </summary>
+		Function GetFunction( Kind kind, Type type );
+		/// <summary>
+		/// Returns true if the kind calls the math functions(powf, cosf, etc.).
+		/// </summary>
+		bool IsExpensive( Kind kind );
+		/// <summary>
+		/// Same as GetFunction(), but an expensive kind is replaced with the function that samples a precomputed table.<para></para>
+		/// The table is made at the first call. The result differs from Ease() slightly because of the linear interpolation.
+		/// </summary>
+		Function GetTableFunction( Kind kind, Type type );
+
 		/// <summary>
 		/// Return value range is basically 0.0f ~ 1.0f(depends on type).<para></para>
 		/// Please set 0.0f ~ 1.0f to "currentTime".
 		/// </summary>
 		static float Ease( Kind kind, Type type, float currentTime )
 		{
-			if ( kind == Kind::ENUM_TERMINATION ) { return NULL; }
+			const Function function = GetFunction( kind, type );
+			if ( !function ) { return NULL; }
 			// else
 
-			float adjustedTime = Impl::AdjustTime( type, currentTime );
-
-			switch ( kind )
-			{
-			case Donya::Easing::Kind::Linear:
-				return Impl::Linear( currentTime );
-			case Donya::Easing::Kind::Back:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Back( adjustedTime )
-				);
-			case Donya::Easing::Kind::Bounce:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Bounce( adjustedTime )
-				);
-			case Donya::Easing::Kind::Circular:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Circular( adjustedTime )
-				);
-			case Donya::Easing::Kind::Cubic:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Cubic( adjustedTime )
-				);
-			case Donya::Easing::Kind::Elastic:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Elastic( adjustedTime )
-				);
-			case Donya::Easing::Kind::Exponential:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Exponential( adjustedTime )
-				);
-			case Donya::Easing::Kind::Quadratic:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Quadratic( adjustedTime )
-				);
-			case Donya::Easing::Kind::Quartic:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Quartic( adjustedTime )
-				);
-			case Donya::Easing::Kind::Quintic:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Quintic( adjustedTime )
-				);
-			case Donya::Easing::Kind::Smooth:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Smooth( adjustedTime )
-				);
-			case Donya::Easing::Kind::Sinusoidal:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Sinusoidal( adjustedTime )
-				);
-			case Donya::Easing::Kind::SoftBack:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::SoftBack( adjustedTime )
-				);
-			case Donya::Easing::Kind::Step:
-				return Impl::AdjustResult
-				(
-					type, currentTime,
-					Impl::Step( adjustedTime )
-				);
-			default: break;
-			}
-			
-			return NULL;
+			return function( currentTime );
 		}
 		/// <summary>
 		/// Return value range is basically 0.0f ~ 1.0f(depends on type).<para></para>
@@ -1,6 +1,6 @@
 #include "Font.h"
 
-#include <algorithm>	// Use std::sort
+#include <algorithm>	// Use std::stable_sort
 
 #include "Constant.h"	// Use scast macro
 #include "Donya.h"
@@ -423,29 +423,100 @@ namespace Donya
 			       ^original-width  ^extended-width(i.e. "ssSize")
 			*/
 
+			const size_t strLength = wcslen( string );
+			if ( strLength < 1 ) { return Donya::Vector2::Zero(); }
+			// else
+
+			std::vector<Donya::Sprite::Quad>	quads;
+			std::vector<Layout::Run>			runs;
+			const Donya::Vector2 size = MakeQuads( string, &quads, &runs );
+
+			const Donya::Vector2 drawScale
+			{
+				( ssSize.x < 0.0f ) ? scale.x : ssSize.x / size.x,
+				( ssSize.y < 0.0f ) ? scale.y : ssSize.y / size.y,
+			};
+			const Donya::Vector2 drawSize{ size.x * drawScale.x, size.y * drawScale.y };
+			const Donya::Vector2 center // Screen space
+			{
+				pivot.x * drawSize.x,
+				pivot.y * drawSize.y,
+			};
+			SubmitQuads( quads, runs, ssPos, center, drawScale, color );
+
+			return drawSize;
+		}
+		Donya::Vector2 Renderer::DrawStretchedExt( const std::wstring &string,	const Donya::Vector2 &ssPos, const Donya::Vector2 &ssSize, const Donya::Vector2 &pivot, const Donya::Vector2 &scale, const Donya::Vector4 &color ) const
+		{
+			return DrawStretchedExt( string.c_str(),	ssPos, ssSize, pivot, scale, color );
+		}
+		Donya::Vector2 Renderer::Draw( const Layout &layout,					const Donya::Vector2 &ssPos, const Donya::Vector2 &pivot, const Donya::Vector4 &color ) const
+		{
+			return DrawExt( layout, ssPos, pivot, defaultScale, color );
+		}
+		Donya::Vector2 Renderer::DrawExt( const Layout &layout,				const Donya::Vector2 &ssPos, const Donya::Vector2 &pivot, const Donya::Vector2 &scale, const Donya::Vector4 &color ) const
+		{
+			if ( layout.text.empty() ) { return Donya::Vector2::Zero(); }
+			// else
+
+			const Donya::Vector2 size = Shape( layout );
+
+			const Donya::Vector2 drawSize{ size.x * scale.x, size.y * scale.y };
+			const Donya::Vector2 center // Screen space
+			{
+				pivot.x * drawSize.x,
+				pivot.y * drawSize.y,
+			};
+			SubmitQuads( layout.quads, layout.runs, ssPos, center, scale, color );
+
+			return drawSize;
+		}
+		Donya::Vector2 Renderer::Shape( const Layout &layout ) const
+		{
+			if ( layout.shaped && layout.pShaper == this ) { return layout.size; }
+			// else
+
+			layout.size		= MakeQuads( layout.text.c_str(), &layout.quads, &layout.runs );
+			layout.pShaper	= this;
+			layout.shaped	= true;
+			return layout.size;
+		}
+		std::vector<size_t> Renderer::GetTextureHandles() const
+		{
+			std::vector<size_t> handles{};
+			for ( const auto &it : textures )
+			{
+				if ( it.handle == NULL ) { continue; }
+				// else
+
+				handles.emplace_back( it.handle );
+			}
+			return handles;
+		}
+		Donya::Vector2 Renderer::MakeQuads( const wchar_t *string, std::vector<Donya::Sprite::Quad> *pQuads, std::vector<Layout::Run> *pRuns ) const
+		{
+			pQuads->clear();
+			pRuns->clear();
+
 			const auto &characters			= info.GetCharacters();
 			const auto &charIndices			= info.GetCharacterIndices();
-			const Donya::Vector2 &origin	= ssPos;
 			const Donya::Vector2 &fontSize	= info.GetFontSize();
 
 			const size_t strLength = wcslen( string );
 			if ( strLength < 1 ) { return Donya::Vector2::Zero(); }
 			// else
 
-			struct Instance
+			struct Glyph
 			{
-				size_t			handle = NULL;
-				Donya::Vector2	pos;	// Left-Top
-				Donya::Vector2	size;	// Whole size
-				Donya::Vector2	uvPos;	// Left-Top
-				Donya::Vector2	uvSize;	// Whole size
+				size_t				handle = NULL;
+				Donya::Sprite::Quad	quad;
 			};
-			std::vector<Instance> elements{ strLength };
+			std::vector<Glyph> glyphs;
+			glyphs.reserve( strLength );
 
-			Donya::Vector2 drawPos  = origin; // Next drawing position of character (screen space)
-			Donya::Vector2 drawSize = { 0.0f, fontSize.y * scale.y }; // Sum of character widths in the string (screen space)
+			Donya::Vector2 drawPos  = Donya::Vector2::Zero();		// Next drawing position of character, relative to the origin
+			Donya::Vector2 drawSize = { 0.0f, fontSize.y };		// Sum of character widths in the string
 
-			// Set drawing informations to "elements"
 			for ( size_t i = 0; i < strLength; ++i )
 			{
 				const CharType character = scast<CharType>( string[i] );
@@ -455,23 +526,23 @@ namespace Donya
 				// else
 				if ( charCode == Character::Code::idReturn )
 				{
-					drawPos.x  =  origin.x;
-					drawPos.y  += fontSize.y * scale.y;
-					drawSize.y += fontSize.y * scale.y;
+					drawPos.x  =  0.0f;
+					drawPos.y  += fontSize.y;
+					drawSize.y += fontSize.y;
 					continue;
 				}
 				// else
 				if ( charCode == Character::Code::idTab )
 				{
-					drawPos.x  += fontSize.x * scale.x * 4.0f;
-					drawSize.x += fontSize.x * scale.x * 4.0f;
+					drawPos.x  += fontSize.x * 4.0f;
+					drawSize.x += fontSize.x * 4.0f;
 					continue;
 				}
 				// else
 				if ( charCode == Character::Code::idSpace )
 				{
-					drawPos.x  += fontSize.x * scale.x;
-					drawSize.x += fontSize.x * scale.x;
+					drawPos.x  += fontSize.x;
+					drawSize.x += fontSize.x;
 					continue;
 				}
 				// else
@@ -481,61 +552,88 @@ namespace Donya
 				// else
 
 				const auto &usingTexture = textures[data.pageNo];
-				elements[i].handle		= usingTexture.handle;
-				elements[i].pos			= drawPos;
-				elements[i].pos.x		+= data.offset.x * scale.x;
-				elements[i].pos.y		+= data.offset.y * scale.y;
-				elements[i].size		= data.uvPartSize;
-				elements[i].uvPos		= data.uvMin;
-				elements[i].uvSize		= data.uvMax - data.uvMin;
+				Glyph glyph{};
+				glyph.handle			= usingTexture.handle;
+				glyph.quad.ssPos		= drawPos + data.offset;
+				glyph.quad.ssSize		= data.uvPartSize;
+				glyph.quad.texPos		= data.uvMin;
+				glyph.quad.texSize		= data.uvMax - data.uvMin;
 				// Donya::Sprite::DrawXX requires uv parameter as texture space
-				elements[i].uvPos.x		*= usingTexture.wholeSize.x;
-				elements[i].uvPos.y		*= usingTexture.wholeSize.y;
-				elements[i].uvSize.x	*= usingTexture.wholeSize.x;
-				elements[i].uvSize.y	*= usingTexture.wholeSize.y;
-
-				drawPos.x  += data.advance * scale.x;
-				drawSize.x += data.advance * scale.x;
+				glyph.quad.texPos.x		*= usingTexture.wholeSize.x;
+				glyph.quad.texPos.y		*= usingTexture.wholeSize.y;
+				glyph.quad.texSize.x	*= usingTexture.wholeSize.x;
+				glyph.quad.texSize.y	*= usingTexture.wholeSize.y;
+				glyphs.emplace_back( glyph );
+
+				drawPos.x  += data.advance;
+				drawSize.x += data.advance;
 			}
 
 			// Sort for sprite batching
-			auto AscendingOrder = []( const Instance &lhs, const Instance &rhs )
+			auto AscendingOrder = []( const Glyph &lhs, const Glyph &rhs )
 			{
 				return lhs.handle < rhs.handle;
 			};
-			std::sort( elements.begin(), elements.end(), AscendingOrder );
-			
-			// Draw
-			const Donya::Vector2 center // Texture space
-			{
-				pivot.x * drawSize.x,
-				pivot.y * drawSize.y,
-			};
-			const Donya::Vector2 drawScale
+			std::stable_sort( glyphs.begin(), glyphs.end(), AscendingOrder );
+
+			pQuads->reserve( glyphs.size() );
+			for ( const auto &it : glyphs )
 			{
-				( ssSize.x < 0.0f ) ? scale.x : ssSize.x / drawSize.x,
-				( ssSize.y < 0.0f ) ? scale.y : ssSize.y / drawSize.y,
-			};
-			for ( const auto &it : elements )
+				if ( pRuns->empty() || pRuns->back().handle != it.handle )
+				{
+					Layout::Run run{};
+					run.handle	= it.handle;
+					run.first	= pQuads->size();
+					pRuns->emplace_back( run );
+				}
+
+				pQuads->emplace_back( it.quad );
+				pRuns->back().count++;
+			}
+
+			return drawSize;
+		}
+		void Renderer::SubmitQuads( const std::vector<Donya::Sprite::Quad> &quads, const std::vector<Layout::Run> &runs, const Donya::Vector2 &ssPos, const Donya::Vector2 &center, const Donya::Vector2 &scale, const Donya::Vector4 &color ) const
+		{
+			for ( const auto &it : runs )
 			{
-				Donya::Sprite::DrawGeneralExt
+				Donya::Sprite::DrawQuads
 				(
 					it.handle,
-					it.pos.x,		it.pos.y,
-					it.size.x,		it.size.y,
-					it.uvPos.x,		it.uvPos.y,
-					it.uvSize.x,	it.uvSize.y,
-					drawScale.x,	drawScale.y,
-					0.0f,			center,
+					quads.data() + it.first, it.count,
+					ssPos.x,	ssPos.y,
+					scale.x,	scale.y,
+					center,
 					color.w, color.x, color.y, color.z
 				);
 			}
+		}
 
-			return drawSize;
+		Layout::Layout( const std::wstring &text ) :
+			text( text )
+		{}
+		bool Layout::SetText( const std::wstring &newText )
+		{
+			if ( newText == text ) { return false; }
+			// else
+
+			text = newText;
+			Invalidate();
+			return true;
 		}
-		Donya::Vector2 Renderer::DrawStretchedExt( const std::wstring &string,	const Donya::Vector2 &ssPos, const Donya::Vector2 &ssSize, const Donya::Vector2 &pivot, const Donya::Vector2 &scale, const Donya::Vector4 &color ) const
+		bool Layout::SetText( const wchar_t *newText )
 		{
-			return DrawStretchedExt( string.c_str(),	ssPos, ssSize, pivot, scale, color );
+			if ( !newText ) { newText = L""; }
+			if ( text.compare( newText ) == 0 ) { return false; }
+			// else
+
+			text = newText;
+			Invalidate();
+			return true;
+		}
+		void Layout::Invalidate()
+		{
+			shaped = false;
 		}
 	}
 }
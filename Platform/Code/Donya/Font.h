@@ -12,8 +12,12 @@
 #include <cereal/types/vector.hpp>
 
 #include "Serializer.h"
+#include "Sprite.h"		// Use Sprite::Quad
 #include "Vector.h"
 
+#undef max
+#undef min
+
 namespace Donya
 {
 	/// <summary>
@@ -125,6 +129,53 @@ namespace Donya
 			const std::array<CharType, twoByteLimit>	&GetCharacterIndices()	const { return characterIndices;	}
 		};
 
+		class Renderer;
+
+		/// <summary>
+		/// The string that is shaped into the glyph quads once, then drawn with only the position, the scale and the color.<para></para>
+		/// The quads are remade at the next draw only if the text was changed.
+		/// </summary>
+		class Layout
+		{
+		private:
+			struct Run // The continuous quads that use the same texture
+			{
+				size_t	handle	= NULL;
+				size_t	first	= 0;
+				size_t	count	= 0;
+			};
+		private:
+			friend class Renderer;
+			std::wstring								text;
+			mutable std::vector<Donya::Sprite::Quad>	quads;				// Sorted by the texture. The positions are not scaled.
+			mutable std::vector<Run>					runs;
+			mutable Donya::Vector2						size;				// The drawn length that is not scaled
+			mutable const Renderer						*pShaper = nullptr;	// The renderer that made the quads
+			mutable bool								shaped = false;
+		public:
+			Layout() = default;
+			Layout( const std::wstring &text );
+		public:
+			/// <summary>
+			/// Returns true if the text was changed.
+			/// </summary>
+			bool SetText( const std::wstring &newText );
+			/// <summary>
+			/// Returns true if the text was changed.
+			/// </summary>
+			bool SetText( const wchar_t *newText );
+			/// <summary>
+			/// The quads will be remade at the next draw.
+			/// </summary>
+			void Invalidate();
+		public:
+			const std::wstring &GetText() const { return text; }
+			/// <summary>
+			/// Returns the count of drawn characters. It is zero until the first draw.
+			/// </summary>
+			size_t GetGlyphCount() const { return quads.size(); }
+		};
+
 		/// <summary>
 		/// Draw a string with Holder's data
 		/// </summary>
@@ -167,6 +218,27 @@ namespace Donya
 			/// Using the Donya::Sprite internally. So you should care the flush timing because the sprite using batching process.
 			/// </summary>
 			Donya::Vector2 DrawExt( const std::wstring &string,			const Donya::Vector2 &ssPos, const Donya::Vector2 &pivot01 = { 0.0f, 0.0f }, const Donya::Vector2 &drawScale = { 1.0f, 1.0f }, const Donya::Vector4 &blendColor = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
+			/// <summary>
+			/// Draw the quads of the "layout". The quads are made only if the text was changed, or the layout was shaped by another renderer.<para></para>
+			/// It returns the drawn length in screen space.
+			/// Using the Donya::Sprite internally. So you should care the flush timing because the sprite using batching process.
+			/// </summary>
+			Donya::Vector2 Draw( const Layout &layout,					const Donya::Vector2 &ssPos, const Donya::Vector2 &pivot01 = { 0.0f, 0.0f }, const Donya::Vector4 &blendColor = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
+			/// <summary>
+			/// Draw the quads of the "layout". The quads are made only if the text was changed, or the layout was shaped by another renderer.<para></para>
+			/// It returns the drawn length in screen space.
+			/// Using the Donya::Sprite internally. So you should care the flush timing because the sprite using batching process.
+			/// </summary>
+			Donya::Vector2 DrawExt( const Layout &layout,				const Donya::Vector2 &ssPos, const Donya::Vector2 &pivot01 = { 0.0f, 0.0f }, const Donya::Vector2 &drawScale = { 1.0f, 1.0f }, const Donya::Vector4 &blendColor = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
+			/// <summary>
+			/// Make the quads of the "layout" if it is not shaped by this renderer yet.
+			/// It returns the length that is not scaled.
+			/// </summary>
+			Donya::Vector2 Shape( const Layout &layout ) const;
+			/// <summary>
+			/// Returns the sprite identifiers of the font textures. The failed texture is not contained.
+			/// </summary>
+			std::vector<size_t> GetTextureHandles() const;
 		private: // FIXME: Font::Renderer::DrawStretched, Ext is not working expectedly.
 			/// <summary>
 			/// Draw the string by keeping the size within the bounds of "ssDrawSize".
@@ -196,6 +268,13 @@ namespace Donya
 			/// Using the Donya::Sprite internally. So you should care the flush timing because the sprite using batching process.
 			/// </summary>
 			Donya::Vector2 DrawStretchedExt( const std::wstring &string,	const Donya::Vector2 &ssPos, const Donya::Vector2 &ssDrawSize, const Donya::Vector2 &pivot01 = { 0.0f, 0.0f }, const Donya::Vector2 &drawScale = { 1.0f, 1.0f }, const Donya::Vector4 &blendColor = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
+		private:
+			/// <summary>
+			/// Resolve the characters of the "string" into the quads, then sort them by the texture.
+			/// It returns the length that is not scaled.
+			/// </summary>
+			Donya::Vector2 MakeQuads( const wchar_t *string, std::vector<Donya::Sprite::Quad> *pQuads, std::vector<Layout::Run> *pRuns ) const;
+			void SubmitQuads( const std::vector<Donya::Sprite::Quad> &quads, const std::vector<Layout::Run> &runs, const Donya::Vector2 &ssPos, const Donya::Vector2 &center, const Donya::Vector2 &scale, const Donya::Vector4 &color ) const;
 		};
 	}
 }
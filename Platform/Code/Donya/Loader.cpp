@@ -8,6 +8,7 @@
 #include <fbxsdk.h>
 #endif // USE_FBX_SDK
 
+#include "AsyncIO.h"	// Use the prefetched file.
 #include "Constant.h"	// Use scast macro.
 #include "Donya.h"	// Use GetHWnd().
 #include "Useful.h"	// Use OutputDebugStr().
@@ -1081,6 +1082,14 @@ namespace Donya
 		};
 		if ( ShouldLoadByCereal( fullPath ) )
 		{
+			// Use the prefetched file if exists
+			const AsyncIO::Buffer pResident = AsyncIO::Fetch( filePath );
+			if ( pResident )
+			{
+				return LoadFromMemory( filePath, pResident->data(), pResident->size(), outputProgress );
+			}
+			// else
+
 			OutputDebugProgress( std::string{ "Start By Cereal:" + filePath }, outputProgress );
 
 			bool succeeded = LoadByCereal( fullPath, outputProgress );
@@ -1097,6 +1106,38 @@ namespace Donya
 		return false;
 	}
 
+	bool Loader::LoadFromMemory( const std::string &filePath, const char *pBinary, size_t byteLength, bool outputProgress )
+	{
+		if ( !pBinary ) { return false; }
+		// else
+
+		// Reads the memory directly, without copying into a stringstream
+		struct MemoryBuffer : public std::streambuf
+		{
+			MemoryBuffer( const char *begin, const char *end )
+			{
+				char *pBegin = const_cast<char *>( begin );
+				setg( pBegin, pBegin, const_cast<char *>( end ) );
+			}
+		};
+
+		const std::string fullPath = ToFullPath( filePath );
+		OutputDebugProgress( std::string{ "Start By Memory:" + filePath }, outputProgress );
+
+		MemoryBuffer	buffer{ pBinary, pBinary + byteLength };
+		std::istream	stream{ &buffer };
+		{
+			cereal::BinaryInputArchive archive( stream );
+			archive( cereal::make_nvp( SERIAL_ID, *this ) );
+		}
+
+		fileDirectory	= ExtractFileDirectoryFromFullPath( fullPath );
+		fileName		= fullPath.substr( fileDirectory.size() );
+
+		OutputDebugProgress( std::string{ "Load By Memory Successful:" + filePath }, outputProgress );
+		return true;
+	}
+
 	void Loader::SaveByCereal( const std::string &filePath ) const
 	{
 		std::lock_guard<std::mutex> lock( cerealMutex );
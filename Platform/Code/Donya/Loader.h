@@ -90,6 +90,11 @@ namespace Donya
 		/// .bin.
 		/// </summary>
 		bool Load( const std::string &filePath, bool outputDebugProgress = true );
+		/// <summary>
+		/// Decodes the binary that was made by SaveByCereal() from the memory. The "filePath" is used for the file directory and name.<para></para>
+		/// The archive is made per call, so it does not lock the mutex of Load(), and you can decode several models in parallel.
+		/// </summary>
+		bool LoadFromMemory( const std::string &filePath, const char *pBinary, size_t byteLength, bool outputDebugProgress = true );
 	public:
 		/// <summary>
 		/// We expect the "filePath" contain extension also.
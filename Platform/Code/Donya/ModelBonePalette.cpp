@@ -0,0 +1,149 @@
+#include "ModelBonePalette.h"
+
+#include <algorithm>	// Use std::min, std::max
+#include <cmath>		// Use std::ceil, std::floor
+
+#include "Constant.h"	// Use scast macro.
+#include "Model.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		bool BonePalette::Bake( const Model &model, const MotionHolder &holder, float step )
+		{
+			Clear();
+			if ( step <= 0.0f ) { return false; }
+			// else
+
+			// Decide the layout of a frame.
+			// It is the same as SkinningRenderer::MakeBoneConstants(), so the mesh that has no bone uses one matrix.
+			const auto &meshes = model.GetMeshes();
+			const size_t meshCount = meshes.size();
+			meshRanges.resize( meshCount );
+			for ( size_t i = 0; i < meshCount; ++i )
+			{
+				const size_t boneCount = meshes[i].boneIndices.size();
+				meshRanges[i].offset = matrixCountPerFrame;
+				meshRanges[i].count  = ( boneCount == 0 ) ? 1U : std::min( boneCount, scast<size_t>( Constants::PerMesh::Bone::MAX_BONE_COUNT ) );
+				matrixCountPerFrame += meshRanges[i].count;
+			}
+
+			Animator sampler{};
+			sampler.DisableLoop(); // Take the last key-frame at the end of motion
+
+			const size_t motionCount = holder.GetMotionCount();
+			tracks.resize( motionCount );
+			for ( size_t m = 0; m < motionCount; ++m )
+			{
+				const auto &motion = holder.GetMotion( scast<int>( m ) );
+				if ( motion.keyFrames.empty() ) { continue; }
+				// else
+
+				auto &track = tracks[m];
+				track.wholeSeconds	= motion.keyFrames.back().seconds;
+				track.frameCount	= scast<size_t>( std::ceil( track.wholeSeconds / step ) ) + 1U;
+				track.matrices.resize( track.frameCount * matrixCountPerFrame );
+
+				for ( size_t f = 0; f < track.frameCount; ++f )
+				{
+					sampler.SetInternalElapsedTime( std::min( track.wholeSeconds, step * f ) );
+					const auto currentPose = sampler.CalcCurrentPose( motion ).keyPose;
+
+					Donya::Vector4x4 *pFrame = track.matrices.data() + ( f * matrixCountPerFrame );
+					for ( size_t i = 0; i < meshCount; ++i )
+					{
+						const auto &mesh	= meshes[i];
+						const auto &range	= meshRanges[i];
+						if ( mesh.boneIndices.empty() )
+						{
+							if ( 0 <= mesh.boneIndex && scast<size_t>( mesh.boneIndex ) < currentPose.size() )
+							{
+								pFrame[range.offset] = currentPose[mesh.boneIndex].global;
+							}
+							continue;
+						}
+						// else
+
+						for ( size_t b = 0; b < range.count; ++b )
+						{
+							const size_t poseIndex = mesh.boneIndices[b];
+							if ( currentPose.size() <= poseIndex ) { continue; }
+							// else
+
+							pFrame[range.offset + b] = mesh.boneOffsets[b].global * currentPose[poseIndex].global;
+						}
+					}
+				}
+			}
+
+			sampleStep = step;
+			return true;
+		}
+		void BonePalette::Clear()
+		{
+			sampleStep			= 0.0f;
+			matrixCountPerFrame	= 0;
+			meshRanges.clear();
+			tracks.clear();
+		}
+		bool BonePalette::IsBaked() const { return ( 0.0f < sampleStep ); }
+
+		bool BonePalette::Sample( int motionIndex, float seconds, size_t meshIndex, bool interpolate, Constants::PerMesh::Bone *pOutput ) const
+		{
+			if ( !pOutput || !IsBaked() ) { return false; }
+			if ( motionIndex < 0 || tracks.size() <= scast<size_t>( motionIndex ) ) { return false; }
+			if ( meshRanges.size() <= meshIndex ) { return false; }
+			// else
+
+			const auto &track = tracks[motionIndex];
+			if ( !track.frameCount ) { return false; }
+			// else
+
+			const float  frameF	= std::max( 0.0f, std::min( track.wholeSeconds, seconds ) ) / sampleStep;
+			const size_t last	= track.frameCount - 1U;
+			const auto  &range	= meshRanges[meshIndex];
+
+			auto GetFrame = [&]( size_t frameIndex )
+			{
+				return track.matrices.data() + ( frameIndex * matrixCountPerFrame ) + range.offset;
+			};
+
+			if ( !interpolate )
+			{
+				const size_t nearest = std::min( last, scast<size_t>( frameF + 0.5f ) );
+				const Donya::Vector4x4 *pFrame = GetFrame( nearest );
+				std::copy( pFrame, pFrame + range.count, pOutput->boneTransforms.begin() );
+				return true;
+			}
+			// else
+
+			const size_t frameL		= std::min( last, scast<size_t>( std::floor( frameF ) ) );
+			const size_t frameR		= std::min( last, frameL + 1U );
+			const float  percent	= frameF - scast<float>( frameL );
+			const Donya::Vector4x4 *pFrameL = GetFrame( frameL );
+			const Donya::Vector4x4 *pFrameR = GetFrame( frameR );
+			for ( size_t i = 0; i < range.count; ++i )
+			{
+				pOutput->boneTransforms[i] = Donya::Lerp( pFrameL[i], pFrameR[i], percent );
+			}
+			return true;
+		}
+
+		float  BonePalette::GetSampleStep() const { return sampleStep; }
+		size_t BonePalette::GetMotionCount() const { return tracks.size(); }
+		size_t BonePalette::GetMeshCount() const { return meshRanges.size(); }
+		size_t BonePalette::CalcMemoryBytes() const
+		{
+			size_t sum = sizeof( MeshRange ) * meshRanges.size();
+			for ( const auto &it : tracks )
+			{
+				sum += sizeof( Donya::Vector4x4 ) * it.matrices.size();
+			}
+			return sum;
+		}
+	}
+}
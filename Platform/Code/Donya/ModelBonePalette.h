@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+
+#include "ModelCommon.h"
+#include "ModelMotion.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		class Model; // Use for a reference at Bake() method.
+
+		/// <summary>
+		/// The final skinning matrices(bone-offset * current pose) of each mesh, that are baked per motion at a fixed sample rate.
+		/// You can use it instead of the Pose if you play only one motion at a time. The CPU-side matrix multiplying at draw will be removed.
+		/// </summary>
+		class BonePalette
+		{
+		private:
+			struct MeshRange
+			{
+				size_t offset	= 0;	// Offset of matrices in a frame
+				size_t count	= 0;
+			};
+			struct Track
+			{
+				float	wholeSeconds	= 0.0f;
+				size_t	frameCount		= 0;
+				std::vector<Donya::Vector4x4> matrices;	// [frame * matrixCountPerFrame + meshRange.offset + bone]
+			};
+		private:
+			float					sampleStep			= 0.0f;	// Zero means not baked.
+			size_t					matrixCountPerFrame	= 0;
+			std::vector<MeshRange>	meshRanges;				// [mesh]
+			std::vector<Track>		tracks;					// [motion]
+		public:
+			/// <summary>
+			/// Calculate the palettes of all motions of the "motionHolder" at every "sampleStepSeconds".
+			/// The "model" must be the same source as the "motionHolder".
+			/// Returns false if the arguments are invalid.
+			/// </summary>
+			bool Bake( const Model &model, const MotionHolder &motionHolder, float sampleStepSeconds );
+			/// <summary>
+			/// Release the baked palettes.
+			/// </summary>
+			void Clear();
+			bool IsBaked() const;
+		public:
+			/// <summary>
+			/// Stores the palette of specified mesh at "motionSeconds" into "pOutput".
+			/// If "interpolate" is true, blend the two neighbor frames. Else pick the nearest frame.
+			/// Returns false if the arguments are out of range, then the "pOutput" is not changed.
+			/// </summary>
+			bool Sample( int motionIndex, float motionSeconds, size_t meshIndex, bool interpolate, Constants::PerMesh::Bone *pOutput ) const;
+		public:
+			float  GetSampleStep() const;
+			size_t GetMotionCount() const;
+			size_t GetMeshCount() const;
+			/// <summary>
+			/// Returns the byte size of stored matrices.
+			/// </summary>
+			size_t CalcMemoryBytes() const;
+		};
+	}
+}
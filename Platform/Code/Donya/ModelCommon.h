@@ -369,6 +369,20 @@ namespace Donya
 				};
 			}
 			/// <summary>
+			/// The constants that update per instance. These are stored into a structured buffer instead of a constant-buffer.
+			/// </summary>
+			namespace PerInstance
+			{
+				/// <summary>
+				/// The everything instanced model types is using this structure's member.
+				/// </summary>
+				struct Common
+				{
+					Donya::Vector4   drawColor;
+					Donya::Vector4x4 worldMatrix;	// Model space -> World space
+				};
+			}
+			/// <summary>
 			/// The constants that update per mesh.
 			/// </summary>
 			namespace PerMesh
@@ -391,6 +405,15 @@ namespace Donya
 					// This matrix transforms to world space of game from bone space in initial-pose.
 					std::array<Donya::Vector4x4, MAX_BONE_COUNT> boneTransforms;
 				};
+
+				/// <summary>
+				/// The instanced model type of using skinning. The bone transforms are stored into a structured buffer as [instance][bone].
+				/// </summary>
+				struct InstancedBone
+				{
+					unsigned int boneCountPerInstance = 1;
+					unsigned int _paddings[3]{ 0 };
+				};
 			}
 			/// <summary>
 			/// The constants that update per subset.
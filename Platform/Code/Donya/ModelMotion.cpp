@@ -3,6 +3,7 @@
 #include <numeric>			// Use std::accumulate.
 
 #include "Constant.h"	// Use scast macro.
+#include "Profiler.h"
 #include "Useful.h"	// Use EPSILON constant, and IsZero().
 
 namespace Donya
@@ -165,6 +166,8 @@ namespace Donya
 
 		Animation::KeyFrame Animator::CalcCurrentPose( const std::vector<Animation::KeyFrame> &motion ) const
 		{
+			PROFILE_SCOPE( "Animator::CalcCurrentPose" );
+
 			if ( motion.empty()     ) { return Animation::KeyFrame{}; } // Returns empty.
 			if ( motion.size() == 1 ) { return motion.front(); }
 			// else
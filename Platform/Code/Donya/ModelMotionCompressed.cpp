@@ -0,0 +1,448 @@
+#include "ModelMotionCompressed.h"
+
+#include <algorithm>	// Use std::upper_bound, std::min, std::max
+#include <cmath>		// Use std::fabs, std::sqrt, std::fmod
+
+#include "Constant.h"	// Use scast macro.
+#include "Profiler.h"
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Model
+	{
+		namespace
+		{
+			constexpr float			componentLimit	= 0.70710678f;	// 1 / sqrt( 2 ), the max magnitude of the components except the largest one
+			constexpr std::uint16_t	rotationMax		= 0x7FFF;		// 15 bits per component, the top bits store the index of the largest
+			constexpr std::uint16_t	vectorMax		= 0xFFFF;
+
+			float &ComponentOf( Donya::Quaternion &q, int index )
+			{
+				switch ( index )
+				{
+				case 0:  return q.x;
+				case 1:  return q.y;
+				case 2:  return q.z;
+				default: return q.w;
+				}
+			}
+			float ComponentOf( const Donya::Quaternion &q, int index )
+			{
+				switch ( index )
+				{
+				case 0:  return q.x;
+				case 1:  return q.y;
+				case 2:  return q.z;
+				default: return q.w;
+				}
+			}
+
+			/// <summary>
+			/// Stores the three smallest components of normalized "q" into "pOut[0~2]".
+			/// The index of the largest component is stored into the top bit of pOut[0] and pOut[1].
+			/// </summary>
+			void PackSmallestThree( Donya::Quaternion q, std::uint16_t *pOut )
+			{
+				q.Normalize();
+
+				int largest = 0;
+				for ( int i = 1; i < 4; ++i )
+				{
+					if ( std::fabs( ComponentOf( q, largest ) ) < std::fabs( ComponentOf( q, i ) ) )
+					{
+						largest = i;
+					}
+				}
+
+				// The q and -q represent the same rotation, so make the largest be positive for restoring it from the others
+				const float sign = ( ComponentOf( q, largest ) < 0.0f ) ? -1.0f : 1.0f;
+
+				int store = 0;
+				for ( int i = 0; i < 4; ++i )
+				{
+					if ( i == largest ) { continue; }
+					// else
+
+					const float normalized	= ( sign * ComponentOf( q, i ) / componentLimit ) * 0.5f + 0.5f;	// [0.0f ~ 1.0f]
+					const float clamped		= std::max( 0.0f, std::min( 1.0f, normalized ) );
+					pOut[store++] = scast<std::uint16_t>( clamped * rotationMax + 0.5f );
+				}
+
+				pOut[0] |= scast<std::uint16_t>( ( largest >> 1 ) << 15 );
+				pOut[1] |= scast<std::uint16_t>( ( largest &  1 ) << 15 );
+			}
+			Donya::Quaternion UnpackSmallestThree( const std::uint16_t *pIn )
+			{
+				const int largest = ( ( pIn[0] >> 15 ) << 1 ) | ( pIn[1] >> 15 );
+
+				Donya::Quaternion q{};
+				float sumSq = 0.0f;
+				int   load  = 0;
+				for ( int i = 0; i < 4; ++i )
+				{
+					if ( i == largest ) { continue; }
+					// else
+
+					const float normalized = scast<float>( pIn[load++] & rotationMax ) / rotationMax;
+					const float component  = ( normalized * 2.0f - 1.0f ) * componentLimit;
+					ComponentOf( q, i ) = component;
+					sumSq += component * component;
+				}
+				ComponentOf( q, largest ) = std::sqrt( std::max( 0.0f, 1.0f - sumSq ) );
+				return q;
+			}
+
+			Donya::Vector3 Dequantize( const std::uint16_t *pIn, const Donya::Vector3 &minimum, const Donya::Vector3 &extent )
+			{
+				constexpr float toRatio = 1.0f / vectorMax;
+				return Donya::Vector3
+				{
+					minimum.x + extent.x * ( scast<float>( pIn[0] ) * toRatio ),
+					minimum.y + extent.y * ( scast<float>( pIn[1] ) * toRatio ),
+					minimum.z + extent.z * ( scast<float>( pIn[2] ) * toRatio ),
+				};
+			}
+			std::uint16_t QuantizeComponent( float value, float minimum, float extent )
+			{
+				if ( extent <= 0.0f ) { return 0; }
+				// else
+
+				const float ratio = std::max( 0.0f, std::min( 1.0f, ( value - minimum ) / extent ) );
+				return scast<std::uint16_t>( ratio * vectorMax + 0.5f );
+			}
+
+			template<typename Fetch>
+			bool IsConstantVector( size_t keyCount, Fetch fetch, float tolerance )
+			{
+				const Donya::Vector3 first = fetch( 0 );
+				for ( size_t k = 1; k < keyCount; ++k )
+				{
+					const Donya::Vector3 diff = fetch( k ) - first;
+					if ( tolerance < std::fabs( diff.x ) ) { return false; }
+					if ( tolerance < std::fabs( diff.y ) ) { return false; }
+					if ( tolerance < std::fabs( diff.z ) ) { return false; }
+				}
+				return true;
+			}
+			template<typename Fetch, typename Track>
+			void CompressVectorTrack( size_t keyCount, Fetch fetch, float tolerance, Track *pTrack )
+			{
+				pTrack->quantized.clear();
+				pTrack->isConstant = IsConstantVector( keyCount, fetch, tolerance );
+				if ( pTrack->isConstant )
+				{
+					pTrack->minimum	= fetch( 0 );
+					pTrack->extent	= Donya::Vector3::Zero();
+					return;
+				}
+				// else
+
+				Donya::Vector3 minimum = fetch( 0 );
+				Donya::Vector3 maximum = minimum;
+				for ( size_t k = 1; k < keyCount; ++k )
+				{
+					const Donya::Vector3 v = fetch( k );
+					minimum.x = std::min( minimum.x, v.x );	maximum.x = std::max( maximum.x, v.x );
+					minimum.y = std::min( minimum.y, v.y );	maximum.y = std::max( maximum.y, v.y );
+					minimum.z = std::min( minimum.z, v.z );	maximum.z = std::max( maximum.z, v.z );
+				}
+				pTrack->minimum	= minimum;
+				pTrack->extent	= maximum - minimum;
+
+				pTrack->quantized.resize( keyCount * 3U );
+				for ( size_t k = 0; k < keyCount; ++k )
+				{
+					const Donya::Vector3 v = fetch( k );
+					std::uint16_t *pOut = pTrack->quantized.data() + ( k * 3U );
+					pOut[0] = QuantizeComponent( v.x, minimum.x, pTrack->extent.x );
+					pOut[1] = QuantizeComponent( v.y, minimum.y, pTrack->extent.y );
+					pOut[2] = QuantizeComponent( v.z, minimum.z, pTrack->extent.z );
+				}
+			}
+		}
+
+		bool CompressedMotion::Compress( const Animation::Motion &source, const Tolerance &tolerance )
+		{
+			Clear();
+
+			const auto &keyFrames = source.keyFrames;
+			if ( keyFrames.empty() ) { return false; }
+			// else
+
+			const size_t keyCount  = keyFrames.size();
+			const size_t boneCount = keyFrames.front().keyPose.size();
+			for ( const auto &it : keyFrames )
+			{
+				if ( it.keyPose.size() != boneCount ) { return false; }
+			}
+			// else
+
+			name			= source.name;
+			samplingRate	= source.samplingRate;
+			animSeconds		= source.animSeconds;
+
+			keySeconds.resize( keyCount );
+			for ( size_t k = 0; k < keyCount; ++k )
+			{
+				keySeconds[k] = keyFrames[k].seconds;
+			}
+
+			bindBones.resize( boneCount );
+			tracks.resize( boneCount );
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				bindBones[b] = keyFrames.front().keyPose[b].bone;
+				bindBones[b].transform = Animation::Transform::Identity();
+
+				auto TransformOf = [&]( size_t keyIndex )->const Animation::Transform &
+				{
+					return keyFrames[keyIndex].keyPose[b].bone.transform;
+				};
+
+				auto &track = tracks[b];
+
+				// Rotation
+				{
+					auto &rotation = track.rotation;
+					const Donya::Quaternion first = TransformOf( 0 ).rotation.Unit();
+
+					rotation.isConstant = true;
+					for ( size_t k = 1; k < keyCount; ++k )
+					{
+						const float dot = Donya::Quaternion::Dot( first, TransformOf( k ).rotation.Unit() );
+						if ( tolerance.rotation < 1.0f - std::fabs( dot ) )
+						{
+							rotation.isConstant = false;
+							break;
+						}
+					}
+
+					rotation.packed.clear();
+					if ( rotation.isConstant )
+					{
+						rotation.constant = first;
+					}
+					else
+					{
+						rotation.packed.resize( keyCount * 3U );
+						for ( size_t k = 0; k < keyCount; ++k )
+						{
+							PackSmallestThree( TransformOf( k ).rotation, rotation.packed.data() + ( k * 3U ) );
+						}
+					}
+				}
+
+				CompressVectorTrack
+				(
+					keyCount,
+					[&]( size_t keyIndex ) { return TransformOf( keyIndex ).translation; },
+					tolerance.translation,
+					&track.translation
+				);
+				CompressVectorTrack
+				(
+					keyCount,
+					[&]( size_t keyIndex ) { return TransformOf( keyIndex ).scale; },
+					tolerance.scale,
+					&track.scale
+				);
+			}
+
+			return true;
+		}
+		bool CompressedMotion::Compress( const Animation::Motion &source )
+		{
+			return Compress( source, Tolerance{} );
+		}
+		void CompressedMotion::Clear()
+		{
+			name.clear();
+			samplingRate	= Animation::Motion::DEFAULT_SAMPLING_RATE;
+			animSeconds		= 0.0f;
+			keySeconds.clear();
+			bindBones.clear();
+			tracks.clear();
+		}
+		bool CompressedMotion::IsEmpty() const
+		{
+			return keySeconds.empty();
+		}
+
+		bool CompressedMotion::DecodeKey( size_t keyIndex, std::vector<Animation::Node> *pOutSkeletal ) const
+		{
+			if ( !pOutSkeletal || keySeconds.size() <= keyIndex ) { return false; }
+			// else
+
+			AssignBindBones( pOutSkeletal );
+			DecodeTransformsAt( keyIndex, pOutSkeletal );
+			UpdateMatrices( pOutSkeletal );
+			return true;
+		}
+		bool CompressedMotion::Sample( float motionSeconds, bool loop, std::vector<Animation::Node> *pOutSkeletal ) const
+		{
+			if ( !pOutSkeletal || IsEmpty() ) { return false; }
+			// else
+
+			PROFILE_SCOPE( "CompressedMotion::Sample" );
+
+			AssignBindBones( pOutSkeletal );
+
+			const size_t keyCount		= keySeconds.size();
+			const float  wholeSeconds	= keySeconds.back();
+			float seconds = std::max( 0.0f, motionSeconds );
+			if ( wholeSeconds <= seconds )
+			{
+				seconds = ( loop && 0.0f < wholeSeconds ) ? std::fmod( seconds, wholeSeconds ) : wholeSeconds;
+			}
+
+			// The right key is the first key that is greater than the "seconds"
+			const auto   found	= std::upper_bound( keySeconds.begin(), keySeconds.end(), seconds );
+			const size_t keyR	= std::min( keyCount - 1U, scast<size_t>( found - keySeconds.begin() ) );
+			const size_t keyL	= ( keyR == 0 ) ? 0U : keyR - 1U;
+			const float  span	= keySeconds[keyR] - keySeconds[keyL];
+			const float  percent= ( 0.0f < span ) ? std::max( 0.0f, std::min( 1.0f, ( seconds - keySeconds[keyL] ) / span ) ) : 0.0f;
+
+			constexpr size_t elementCount = 3U;
+			const size_t offsetL = keyL * elementCount;
+			const size_t offsetR = keyR * elementCount;
+
+			auto &skeletal = *pOutSkeletal;
+			const size_t boneCount = tracks.size();
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				const auto &track		= tracks[b];
+				auto &transform			= skeletal[b].bone.transform;
+
+				if ( track.rotation.isConstant )
+				{
+					transform.rotation = track.rotation.constant;
+				}
+				else
+				{
+					const Donya::Quaternion L = UnpackSmallestThree( track.rotation.packed.data() + offsetL );
+					const Donya::Quaternion R = UnpackSmallestThree( track.rotation.packed.data() + offsetR );
+					transform.rotation = Donya::Quaternion::Slerp( L, R, percent );
+				}
+
+				auto DecodeVector = [&]( const VectorTrack &vectorTrack )
+				{
+					if ( vectorTrack.isConstant ) { return vectorTrack.minimum; }
+					// else
+
+					const Donya::Vector3 L = Dequantize( vectorTrack.quantized.data() + offsetL, vectorTrack.minimum, vectorTrack.extent );
+					const Donya::Vector3 R = Dequantize( vectorTrack.quantized.data() + offsetR, vectorTrack.minimum, vectorTrack.extent );
+					return Donya::Lerp( L, R, percent );
+				};
+				transform.translation	= DecodeVector( track.translation	);
+				transform.scale			= DecodeVector( track.scale			);
+			}
+
+			UpdateMatrices( pOutSkeletal );
+			return true;
+		}
+
+		const std::string &CompressedMotion::GetName() const { return name; }
+		size_t CompressedMotion::GetKeyCount() const { return keySeconds.size(); }
+		size_t CompressedMotion::GetBoneCount() const { return tracks.size(); }
+		size_t CompressedMotion::GetConstantTrackCount() const
+		{
+			size_t count = 0;
+			for ( const auto &it : tracks )
+			{
+				if ( it.rotation.isConstant		) { count++; }
+				if ( it.translation.isConstant	) { count++; }
+				if ( it.scale.isConstant		) { count++; }
+			}
+			return count;
+		}
+		size_t CompressedMotion::CalcMemoryBytes() const
+		{
+			size_t sum = sizeof( *this );
+			sum += name.capacity();
+			sum += sizeof( float ) * keySeconds.capacity();
+			sum += sizeof( Animation::Bone ) * bindBones.capacity();
+			for ( const auto &it : bindBones )
+			{
+				sum += it.name.capacity() + it.parentName.capacity();
+			}
+			sum += sizeof( BoneTrack ) * tracks.capacity();
+			for ( const auto &it : tracks )
+			{
+				sum += sizeof( std::uint16_t ) * it.rotation.packed.capacity();
+				sum += sizeof( std::uint16_t ) * it.translation.quantized.capacity();
+				sum += sizeof( std::uint16_t ) * it.scale.quantized.capacity();
+			}
+			return sum;
+		}
+		size_t CompressedMotion::CalcMemoryBytes( const Animation::Motion &motion )
+		{
+			size_t sum = sizeof( motion );
+			sum += motion.name.capacity();
+			sum += sizeof( Animation::KeyFrame ) * motion.keyFrames.capacity();
+			for ( const auto &keyFrame : motion.keyFrames )
+			{
+				sum += sizeof( Animation::Node ) * keyFrame.keyPose.capacity();
+				for ( const auto &node : keyFrame.keyPose )
+				{
+					sum += node.bone.name.capacity() + node.bone.parentName.capacity();
+				}
+			}
+			return sum;
+		}
+
+		void CompressedMotion::DecodeTransformsAt( size_t keyIndex, std::vector<Animation::Node> *pOutSkeletal ) const
+		{
+			const size_t offset = keyIndex * 3U;
+
+			auto &skeletal = *pOutSkeletal;
+			const size_t boneCount = tracks.size();
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				const auto &track	= tracks[b];
+				auto &transform		= skeletal[b].bone.transform;
+
+				transform.rotation		= ( track.rotation.isConstant )
+										? track.rotation.constant
+										: UnpackSmallestThree( track.rotation.packed.data() + offset );
+				transform.translation	= ( track.translation.isConstant )
+										? track.translation.minimum
+										: Dequantize( track.translation.quantized.data() + offset, track.translation.minimum, track.translation.extent );
+				transform.scale			= ( track.scale.isConstant )
+										? track.scale.minimum
+										: Dequantize( track.scale.quantized.data() + offset, track.scale.minimum, track.scale.extent );
+			}
+		}
+		void CompressedMotion::AssignBindBones( std::vector<Animation::Node> *pOutSkeletal ) const
+		{
+			auto &skeletal = *pOutSkeletal;
+			if ( skeletal.size() == bindBones.size() ) { return; }
+			// else
+
+			const size_t boneCount = bindBones.size();
+			skeletal.resize( boneCount );
+			for ( size_t b = 0; b < boneCount; ++b )
+			{
+				skeletal[b].bone = bindBones[b];
+			}
+		}
+		void CompressedMotion::UpdateMatrices( std::vector<Animation::Node> *pOutSkeletal ) const
+		{
+			// Same as the Pose::UpdateTransformMatrices(). The parent is placed before the child.
+			for ( auto &it : *pOutSkeletal )
+			{
+				it.local = it.bone.transform.ToWorldMatrix();
+				if ( it.bone.parentIndex == -1 )
+				{
+					it.global = it.local;
+				}
+				else
+				{
+					it.global = it.local * ( *pOutSkeletal )[it.bone.parentIndex].global;
+				}
+			}
+		}
+	}
+}
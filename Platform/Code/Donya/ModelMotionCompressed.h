@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>		// Use std::uint16_t
+#include <string>
+#include <vector>
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "ModelCommon.h"
+
+namespace Donya
+{
+	namespace Model
+	{
+		/// <summary>
+		/// The compressed version of an Animation::Motion.
+		/// It stores per-bone tracks instead of per-key skeletals:
+		/// the bone's names and hierarchy once, the rotations by the smallest-three quantization,
+		/// the translations and scales by the range quantization, and only one value if a track is constant.
+		/// </summary>
+		class CompressedMotion
+		{
+		public:
+			/// <summary>
+			/// A track is considered constant if the all keys are within the tolerance from the first key.
+			/// </summary>
+			struct Tolerance
+			{
+				float rotation		= 0.0001f;	// The threshold of ( 1 - |dot( q, first )| )
+				float translation	= 0.0001f;	// The threshold of each component
+				float scale			= 0.0001f;	// The threshold of each component
+			};
+		private:
+			struct RotationTrack
+			{
+				bool						isConstant = true;
+				Donya::Quaternion			constant;
+				std::vector<std::uint16_t>	packed;		// Three elements per key
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive
+					(
+						CEREAL_NVP( isConstant	),
+						CEREAL_NVP( constant	),
+						CEREAL_NVP( packed		)
+					);
+				}
+			};
+			struct VectorTrack
+			{
+				bool						isConstant = true;
+				Donya::Vector3				minimum;	// It is the value itself if the track is constant
+				Donya::Vector3				extent;
+				std::vector<std::uint16_t>	quantized;	// Three elements per key
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive
+					(
+						CEREAL_NVP( isConstant	),
+						CEREAL_NVP( minimum		),
+						CEREAL_NVP( extent		),
+						CEREAL_NVP( quantized	)
+					);
+				}
+			};
+			struct BoneTrack
+			{
+				RotationTrack	rotation;
+				VectorTrack		translation;
+				VectorTrack		scale;
+			private:
+				friend class cereal::access;
+				template<class Archive>
+				void serialize( Archive &archive, std::uint32_t version )
+				{
+					archive
+					(
+						CEREAL_NVP( rotation	),
+						CEREAL_NVP( translation	),
+						CEREAL_NVP( scale		)
+					);
+				}
+			};
+		private:
+			std::string						name;
+			float							samplingRate	= Animation::Motion::DEFAULT_SAMPLING_RATE;
+			float							animSeconds		= 0.0f;
+			std::vector<float>				keySeconds;		// [key]
+			std::vector<Animation::Bone>	bindBones;		// [bone] The names, hierarchy and "transformToParent" of the first key. The "transform" is not used.
+			std::vector<BoneTrack>			tracks;			// [bone]
+		public:
+			/// <summary>
+			/// Compresses the "source". The all key-frames of the "source" must have the same skeletal.
+			/// Returns false if the "source" is empty or it has inconsistent key-frames, then I become empty.
+			/// </summary>
+			bool Compress( const Animation::Motion &source, const Tolerance &tolerance );
+			/// <summary>
+			/// Compresses the "source" with the default tolerance.
+			/// </summary>
+			bool Compress( const Animation::Motion &source );
+			void Clear();
+			bool IsEmpty() const;
+		public:
+			/// <summary>
+			/// Decodes the skeletal at specified key into "pOutSkeletal", with the local and global matrices.
+			/// The bones' names and hierarchy are assigned only if the size of "pOutSkeletal" is different, so you should reuse the buffer for a motion.
+			/// Returns false if the arguments are invalid.
+			/// </summary>
+			bool DecodeKey( size_t keyIndex, std::vector<Animation::Node> *pOutSkeletal ) const;
+			/// <summary>
+			/// Decodes the skeletal at "motionSeconds" with interpolating the two neighbor keys, like the Animator::CalcCurrentPose().
+			/// If "loop" is true, the "motionSeconds" that over the last key will be wrapped around. Else it will be clamped.
+			/// The bones' names and hierarchy are assigned only if the size of "pOutSkeletal" is different, so you should reuse the buffer for a motion.
+			/// Returns false if I am empty or the "pOutSkeletal" is null.
+			/// </summary>
+			bool Sample( float motionSeconds, bool loop, std::vector<Animation::Node> *pOutSkeletal ) const;
+		public:
+			const std::string &GetName() const;
+			size_t GetKeyCount() const;
+			size_t GetBoneCount() const;
+			/// <summary>
+			/// Returns the count of the tracks that are stored as one value. A bone has three tracks.
+			/// </summary>
+			size_t GetConstantTrackCount() const;
+			/// <summary>
+			/// Returns the byte size that I allocated.
+			/// </summary>
+			size_t CalcMemoryBytes() const;
+			/// <summary>
+			/// Returns the byte size that the "motion" allocated, for a comparison.
+			/// </summary>
+			static size_t CalcMemoryBytes( const Animation::Motion &motion );
+		private:
+			void DecodeTransformsAt( size_t keyIndex, std::vector<Animation::Node> *pOutSkeletal ) const;
+			void AssignBindBones( std::vector<Animation::Node> *pOutSkeletal ) const;
+			void UpdateMatrices( std::vector<Animation::Node> *pOutSkeletal ) const;
+		private:
+			friend class cereal::access;
+			template<class Archive>
+			void serialize( Archive &archive, std::uint32_t version )
+			{
+				archive
+				(
+					CEREAL_NVP( name			),
+					CEREAL_NVP( samplingRate	),
+					CEREAL_NVP( animSeconds		),
+					CEREAL_NVP( keySeconds		),
+					CEREAL_NVP( bindBones		),
+					CEREAL_NVP( tracks			)
+				);
+
+				if ( 1 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+			}
+		};
+	}
+}
+CEREAL_CLASS_VERSION( Donya::Model::CompressedMotion, 0 )
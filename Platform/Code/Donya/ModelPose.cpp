@@ -4,7 +4,10 @@ namespace Donya
 {
 	namespace Model
 	{
-		const std::vector<Animation::Node> &Pose::GetCurrentPose() const { return skeletal; }
+		const std::vector<Animation::Node> &Pose::GetCurrentPose() const
+		{
+			return ( pSharedSkeletal ) ? *pSharedSkeletal : skeletal;
+		}
 
 		bool Pose::HasCompatibleWith( const std::vector<Animation::Node> &validation ) const
 		{
@@ -14,15 +17,17 @@ namespace Donya
 				2. Each bones name are the same as others.
 			*/
 
+			const auto &current = GetCurrentPose();
+
 			// No.1
-			if ( validation.size() != skeletal.size() ) { return false; }
+			if ( validation.size() != current.size() ) { return false; }
 			// else
 
 			// No.2
-			const size_t boneCount = skeletal.size();
+			const size_t boneCount = current.size();
 			for ( size_t i = 0;  i < boneCount; ++i )
 			{
-				if ( validation[i].bone.name != skeletal[i].bone.name )
+				if ( validation[i].bone.name != current[i].bone.name )
 				{
 					return false;
 				}
@@ -37,6 +42,10 @@ namespace Donya
 
 		void Pose::AssignSkeletal( const std::vector<Animation::Node> &newPose )
 		{
+			// The "newPose" may be a part of the shared skeletal, so keep it alive until the copy is finished
+			const SharedSkeletal pOldShared = std::move( pSharedSkeletal );
+			pSharedSkeletal.reset();
+
 			const size_t newSize = newPose.size();
 			skeletal.clear();
 			skeletal.resize( newSize );
@@ -50,9 +59,17 @@ namespace Donya
 		{
 			AssignSkeletal( newKeyFrame.keyPose );
 		}
+		void Pose::AssignSharedSkeletal( const SharedSkeletal &pReadOnlySkeletal )
+		{
+			pSharedSkeletal = pReadOnlySkeletal;
+		}
 
 		void Pose::UpdateTransformMatrices()
 		{
+			// The shared skeletal has been updated by the owner, and copying it loses the sharing
+			if ( pSharedSkeletal ) { return; }
+			// else
+
 			UpdateLocalMatrices();
 			UpdateGlobalMatrices();
 		}
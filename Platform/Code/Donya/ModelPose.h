@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "ModelCommon.h"
@@ -13,8 +14,11 @@ namespace Donya
 		/// </summary>
 		class Pose
 		{
+		public:
+			using SharedSkeletal = std::shared_ptr<const std::vector<Animation::Node>>;
 		private:
 			std::vector<Animation::Node> skeletal;	// Provides the matrices of the current pose. That transforms space is bone -> mesh.
+			SharedSkeletal	pSharedSkeletal;		// A read-only skeletal that is owned by others(e.g. a pose cache). It is prior to "skeletal" if it is not null.
 		public:
 			const std::vector<Animation::Node> &GetCurrentPose() const;
 
@@ -37,9 +41,14 @@ namespace Donya
 			/// Assign the skeletal by key-pose of the argument.
 			/// </summary>
 			void AssignSkeletal( const Animation::KeyFrame &newSkeletal );
+			/// <summary>
+			/// Refer the read-only skeletal instead of copying it. The owner must update its matrices before sharing it.
+			/// </summary>
+			void AssignSharedSkeletal( const SharedSkeletal &pReadOnlySkeletal );
 		public:
 			/// <summary>
-			/// Calculate the transform matrix of each node of internal skeletal. So it is heavy,
+			/// Calculate the transform matrix of each node of internal skeletal. So it is heavy,<para></para>
+			/// It does nothing while referring a shared skeletal, because the owner has updated it already.
 			/// </summary>
 			void UpdateTransformMatrices();
 		private:
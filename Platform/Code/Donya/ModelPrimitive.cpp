@@ -1,6 +1,7 @@
 #include "ModelPrimitive.h"
 
 #include <array>
+#include <cstring>			// Use memcpy().
 
 #include "Constant.h"		// Use scast macro.
 #include "Donya.h"			// Use GetDevice(), GetImmdiateContext().
@@ -96,6 +97,65 @@ namespace Donya
 			{
 				return RegisterDesc::Make( 0U, true, true );
 			}
+
+			static constexpr const char *InstancedCode()
+			{
+				return
+				"struct VS_IN\n"
+				"{\n"
+				"	float4		pos			: POSITION;\n"
+				"	float4		normal		: NORMAL;\n"
+				"	row_major\n"
+				"	float4x4	world		: WORLD;\n"
+				"	float4		color		: COLOR;\n"
+				"};\n"
+				"struct VS_OUT\n"
+				"{\n"
+				"	float4		svPos		: SV_POSITION;\n"
+				"	float4		normal		: NORMAL;\n"
+				"	float4		color		: COLOR;\n"
+				"};\n"
+
+				"cbuffer Constant : register( b0 )\n"
+				"{\n"
+				"	row_major\n"
+				"	float4x4	cbViewProj;\n"
+				"	float3		cbLightDirection;\n"
+				"	float		cbLightBias;\n"
+				"};\n"
+
+				"VS_OUT VSMain( VS_IN vin )\n"
+				"{\n"
+				"	vin.pos.w		= 1.0f;\n"
+				"	vin.normal.w	= 0.0f;\n"
+
+				"	float4x4 WVP	= mul( vin.world, cbViewProj );\n"
+
+				"	VS_OUT vout		= ( VS_OUT )( 0 );\n"
+				"	vout.svPos		= mul( vin.pos, WVP );\n"
+				"	vout.normal		= normalize( mul( vin.normal, vin.world ) );\n"
+				"	vout.color		= vin.color;\n"
+				"	return vout;\n"
+				"}\n"
+
+				"float Lambert( float3 nwsNormal, float3 nwsToLightVec )\n"
+				"{\n"
+				"	return max( 0.0f, dot( nwsNormal, nwsToLightVec ) );\n"
+				"}\n"
+				"float4 PSMain( VS_OUT pin ) : SV_TARGET\n"
+				"{\n"
+				"			pin.normal		= normalize( pin.normal );\n"
+			
+				"	float3	nLightVec		= normalize( -cbLightDirection );	// Vector from position.\n"
+				"	float	diffuse			= Lambert( pin.normal.rgb, nLightVec );\n"
+				"	float	Kd				= ( 1.0f - cbLightBias ) + ( diffuse * cbLightBias );\n"
+
+				"	return	float4( pin.color.rgb * Kd, pin.color.a );\n"
+				"}\n"
+				;
+			}
+			static constexpr const char *InstancedNameVS	= "Donya::InstancedPrimitiveVS";
+			static constexpr const char *InstancedNamePS	= "Donya::InstancedPrimitivePS";
 		}
 
 		namespace Impl
@@ -643,6 +703,12 @@ namespace Donya
 			ID3D11DeviceContext *pImmediateContext = Donya::GetImmediateContext();
 			pImmediateContext->DrawIndexed( INDEX_COUNT, 0U, 0 );
 		}
+		void Cube::CallDrawInstanced( unsigned int instanceCount ) const
+		{
+			constexpr UINT INDEX_COUNT = 3U * 2U * 6U;
+			ID3D11DeviceContext *pImmediateContext = Donya::GetImmediateContext();
+			pImmediateContext->DrawIndexedInstanced( INDEX_COUNT, instanceCount, 0U, 0, 0U );
+		}
 
 
 		bool CubeRenderer::Create()
@@ -771,6 +837,11 @@ namespace Donya
 			ID3D11DeviceContext *pImmediateContext = Donya::GetImmediateContext();
 			pImmediateContext->DrawIndexed( indexCount, 0U, 0 );
 		}
+		void Sphere::CallDrawInstanced( unsigned int instanceCount ) const
+		{
+			ID3D11DeviceContext *pImmediateContext = Donya::GetImmediateContext();
+			pImmediateContext->DrawIndexedInstanced( indexCount, instanceCount, 0U, 0, 0U );
+		}
 
 
 		bool SphereRenderer::Create()
@@ -846,5 +917,147 @@ namespace Donya
 
 	// region Sphere
 	#pragma endregion
+
+	#pragma region Instanced
+
+		InstancedPrimitiveRenderer::InstancedPrimitiveRenderer( size_t maxInstanceCountPerDraw )
+			: maxInstanceCount( ( maxInstanceCountPerDraw ) ? maxInstanceCountPerDraw : 1U ), pInstanceBuffer()
+		{}
+		bool InstancedPrimitiveRenderer::Create()
+		{
+			ID3D11Device *pDevice = Donya::GetDevice();
+			bool result		= true;
+			bool succeeded	= true;
+
+			if ( !cbuffer.Create() )
+			{
+				AssertBaseCreation( "cbuffer", "InstancedPrimitive" );
+				succeeded = false;
+			}
+
+			// Instance buffer.
+			{
+				const std::vector<Instance> initialInstances( maxInstanceCount );
+				HRESULT hr = Donya::CreateVertexBuffer<Instance>
+				(
+					pDevice, initialInstances,
+					D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE,
+					pInstanceBuffer.ReleaseAndGetAddressOf()
+				);
+				if ( FAILED( hr ) )
+				{
+					AssertBaseCreation( "buffer", "Instance" );
+					succeeded = false;
+				}
+			}
+
+			// States.
+			{
+				idDS = CreateDS( BasicDepthStencilDesc()	);
+				idRS = CreateRS( BasicRasterizerDesc()		);
+				if ( idDS == DEFAULT_STATE_ID )
+				{
+					AssertBaseCreation( "state", "DepthStencil" );
+					succeeded = false;
+				}
+				if ( idRS == DEFAULT_STATE_ID )
+				{
+					AssertBaseCreation( "state", "Rasterizer" );
+					succeeded = false;
+				}
+			}
+
+			// Shaders.
+			{
+				const auto arrayIEDesc = Vertex::Pos::GenerateInputElements( 0 );
+				std::vector<D3D11_INPUT_ELEMENT_DESC> IEDescs{ arrayIEDesc.begin(), arrayIEDesc.end() };
+				IEDescs.emplace_back( D3D11_INPUT_ELEMENT_DESC{ "WORLD",	0, DXGI_FORMAT_R32G32B32A32_FLOAT,	1, D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1 } );
+				IEDescs.emplace_back( D3D11_INPUT_ELEMENT_DESC{ "WORLD",	1, DXGI_FORMAT_R32G32B32A32_FLOAT,	1, D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1 } );
+				IEDescs.emplace_back( D3D11_INPUT_ELEMENT_DESC{ "WORLD",	2, DXGI_FORMAT_R32G32B32A32_FLOAT,	1, D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1 } );
+				IEDescs.emplace_back( D3D11_INPUT_ELEMENT_DESC{ "WORLD",	3, DXGI_FORMAT_R32G32B32A32_FLOAT,	1, D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1 } );
+				IEDescs.emplace_back( D3D11_INPUT_ELEMENT_DESC{ "COLOR",	0, DXGI_FORMAT_R32G32B32A32_FLOAT,	1, D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1 } );
+
+				result = VS.CreateByEmbededSourceCode
+				(
+					ShaderSource::InstancedNameVS, ShaderSource::InstancedCode(), ShaderSource::EntryPointVS,
+					IEDescs,
+					pDevice
+				);
+				if ( !result )
+				{
+					AssertBaseCreation( "shader", "InstancedPrimitive::VS" );
+					succeeded = false;
+				}
+
+				result = PS.CreateByEmbededSourceCode
+				(
+					ShaderSource::InstancedNamePS, ShaderSource::InstancedCode(), ShaderSource::EntryPointPS,
+					pDevice
+				);
+				if ( !result )
+				{
+					AssertBaseCreation( "shader", "InstancedPrimitive::PS" );
+					succeeded = false;
+				}
+			}
+
+			return succeeded;
+		}
+		void InstancedPrimitiveRenderer::ActivateConstant()
+		{
+			const auto desc = ShaderSource::BasicPrimitiveSetting();
+			PrimitiveRenderer::ActivateConstant( desc.setSlot, desc.setVS, desc.setPS );
+		}
+		size_t InstancedPrimitiveRenderer::GetMaxInstanceCount() const
+		{
+			return maxInstanceCount;
+		}
+		size_t InstancedPrimitiveRenderer::Draw( const Impl::PrimitiveModel &model, const Instance *pInstances, size_t instanceCount )
+		{
+			if ( !pInstances || !instanceCount || !pInstanceBuffer ) { return 0; }
+			// else
+
+			ID3D11DeviceContext *pImmediateContext = Donya::GetImmediateContext();
+
+			model.SetVertexBuffers();
+			model.SetIndexBuffer();
+			model.SetPrimitiveTopology();
+
+			constexpr UINT INSTANCE_SLOT = 1U;
+			constexpr UINT stride = sizeof( Instance );
+			constexpr UINT offset = 0;
+			pImmediateContext->IASetVertexBuffers( INSTANCE_SLOT, 1U, pInstanceBuffer.GetAddressOf(), &stride, &offset );
+
+			size_t drawCallCount = 0;
+			for ( size_t first = 0; first < instanceCount; first += maxInstanceCount )
+			{
+				const size_t remaining	= instanceCount - first;
+				const size_t count		= ( remaining < maxInstanceCount ) ? remaining : maxInstanceCount;
+
+				D3D11_MAPPED_SUBRESOURCE msr{};
+				HRESULT hr = pImmediateContext->Map( pInstanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &msr );
+				if ( FAILED( hr ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Mapping at InstancedPrimitiveRenderer." );
+					break;
+				}
+				// else
+
+				memcpy( msr.pData, pInstances + first, sizeof( Instance ) * count );
+				pImmediateContext->Unmap( pInstanceBuffer.Get(), 0 );
+
+				model.CallDrawInstanced( scast<unsigned int>( count ) );
+				drawCallCount++;
+			}
+
+			ID3D11Buffer *pNullBuffer = nullptr;
+			constexpr UINT nullStride = 0;
+			pImmediateContext->IASetVertexBuffers( INSTANCE_SLOT, 1U, &pNullBuffer, &nullStride, &offset );
+
+			return drawCallCount;
+		}
+
+	// region Instanced
+	#pragma endregion
 	}
 }
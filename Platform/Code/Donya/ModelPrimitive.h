@@ -46,6 +46,10 @@ namespace Donya
 				virtual void SetPrimitiveTopology() const = 0;
 			public:
 				virtual void CallDraw() const = 0;
+				/// <summary>
+				/// Call the DrawIndexedInstanced(). The instance buffer should be set to slot 1 by the caller.
+				/// </summary>
+				virtual void CallDrawInstanced( unsigned int instanceCount ) const = 0;
 			};
 
 			template<typename PrimitiveConstant>
@@ -131,6 +135,7 @@ namespace Donya
 			void SetPrimitiveTopology() const override;
 		public:
 			void CallDraw() const override;
+			void CallDrawInstanced( unsigned int instanceCount ) const override;
 		};
 		/// <summary>
 		/// Provides a shader and a constant buffer for the Cubes.
@@ -176,6 +181,7 @@ namespace Donya
 			void SetPrimitiveTopology() const override;
 		public:
 			void CallDraw() const override;
+			void CallDrawInstanced( unsigned int instanceCount ) const override;
 		};
 		/// <summary>
 		/// Provides a shader and a constant buffer for the Spheres.
@@ -195,5 +201,47 @@ namespace Donya
 			/// </summary>
 			void Draw( const Sphere &sphere );
 		};
+
+
+		struct InstancedPrimitiveConstant
+		{
+			Donya::Vector4x4	matViewProj;
+			Donya::Vector3		lightDirection{ 0.0f, -1.0f, 0.0f };
+			float				lightBias = 0.5f; // Used to adjust the lighting influence. ( 1.0f - bias ) + ( light * bias )
+		};
+		/// <summary>
+		/// Provides a shader, a constant buffer and an instance buffer for drawing many Cubes or Spheres by one draw call.
+		/// The world matrix and the color are stored per instance.
+		/// </summary>
+		class InstancedPrimitiveRenderer : public Impl::PrimitiveRenderer<InstancedPrimitiveConstant>
+		{
+		public:
+			using Constant = InstancedPrimitiveConstant;
+			struct Instance
+			{
+				Donya::Vector4x4	matWorld;
+				Donya::Vector4		drawColor;
+			};
+		private:
+			size_t maxInstanceCount = 1;
+			Microsoft::WRL::ComPtr<ID3D11Buffer> pInstanceBuffer;
+		public:
+			InstancedPrimitiveRenderer( size_t maxInstanceCountPerDraw = 1024U );
+		public:
+			bool Create() override;
+		public:
+			/// <summary>
+			/// Setting slot is 0.
+			/// </summary>
+			void ActivateConstant();
+		public:
+			size_t GetMaxInstanceCount() const;
+			/// <summary>
+			/// Set the buffers of the "model" and the instance buffer, then call the CallDrawInstanced() of the "model".
+			/// If the "instanceCount" is over than the max instance count, it is split into some draw calls.
+			/// Returns the count of the draw calls.
+			/// </summary>
+			size_t Draw( const Impl::PrimitiveModel &model, const Instance *pInstances, size_t instanceCount );
+		};
 	}
 }
@@ -1,5 +1,6 @@
 #include "ModelRenderer.h"
 
+#include <cstring>				// Use memcpy().
 #include <exception>
 #include <tuple>
 
@@ -59,6 +60,103 @@ namespace Donya
 			{
 				cbuffer.Deactivate( pImmediateContext );
 			}
+
+			bool InstancedSkinningMeshConstant::CreateBuffer( ID3D11Device *pDevice )
+			{
+				return cbuffer.Create( pDevice );
+			}
+			void InstancedSkinningMeshConstant::Update( const Constants::PerMesh::Common &srcCommon, const Constants::PerMesh::InstancedBone &srcBone )
+			{
+				AssignCommon( &cbuffer.data, srcCommon );
+				cbuffer.data.bone = srcBone;
+			}
+			void InstancedSkinningMeshConstant::Activate( const RegisterDesc &desc, ID3D11DeviceContext *pImmediateContext ) const
+			{
+				cbuffer.Activate( desc.setSlot, desc.setVS, desc.setPS, pImmediateContext );
+			}
+			void InstancedSkinningMeshConstant::Deactivate( ID3D11DeviceContext *pImmediateContext ) const
+			{
+				cbuffer.Deactivate( pImmediateContext );
+			}
+
+			StructuredBuffer::StructuredBuffer( size_t elementStride ) :
+				elementStride( ( elementStride ) ? elementStride : 1U ), capacity( 0 ),
+				usingDesc(), pBuffer(), pSRV()
+			{}
+			bool StructuredBuffer::Update( const void *pElements, size_t elementCount, ID3D11Device *pDevice, ID3D11DeviceContext *pImmediateContext )
+			{
+				if ( !pElements || !elementCount ) { return false; }
+				if ( !Reserve( elementCount, pDevice ) ) { return false; }
+				// else
+
+				D3D11_MAPPED_SUBRESOURCE mapped{};
+				HRESULT hr = pImmediateContext->Map( pBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped );
+				if ( FAILED( hr ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Mapping of a structured buffer." );
+					return false;
+				}
+				// else
+
+				memcpy( mapped.pData, pElements, elementStride * elementCount );
+				pImmediateContext->Unmap( pBuffer.Get(), 0 );
+				return true;
+			}
+			void StructuredBuffer::Activate( const RegisterDesc &desc, ID3D11DeviceContext *pImmediateContext ) const
+			{
+				usingDesc = desc;
+				if ( desc.setVS ) { pImmediateContext->VSSetShaderResources( desc.setSlot, 1U, pSRV.GetAddressOf() ); }
+				if ( desc.setPS ) { pImmediateContext->PSSetShaderResources( desc.setSlot, 1U, pSRV.GetAddressOf() ); }
+			}
+			void StructuredBuffer::Deactivate( ID3D11DeviceContext *pImmediateContext ) const
+			{
+				ID3D11ShaderResourceView *pNullSRV = nullptr;
+				if ( usingDesc.setVS ) { pImmediateContext->VSSetShaderResources( usingDesc.setSlot, 1U, &pNullSRV ); }
+				if ( usingDesc.setPS ) { pImmediateContext->PSSetShaderResources( usingDesc.setSlot, 1U, &pNullSRV ); }
+			}
+			bool StructuredBuffer::Reserve( size_t elementCount, ID3D11Device *pDevice )
+			{
+				if ( elementCount <= capacity && pBuffer && pSRV ) { return true; }
+				// else
+
+				// Grow by double for reducing the re-creation
+				size_t newCapacity = ( capacity ) ? capacity : 16U;
+				while ( newCapacity < elementCount ) { newCapacity *= 2U; }
+
+				D3D11_BUFFER_DESC bufferDesc{};
+				bufferDesc.ByteWidth			= scast<UINT>( elementStride * newCapacity );
+				bufferDesc.Usage				= D3D11_USAGE_DYNAMIC;
+				bufferDesc.BindFlags			= D3D11_BIND_SHADER_RESOURCE;
+				bufferDesc.CPUAccessFlags		= D3D11_CPU_ACCESS_WRITE;
+				bufferDesc.MiscFlags			= D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+				bufferDesc.StructureByteStride	= scast<UINT>( elementStride );
+
+				HRESULT hr = pDevice->CreateBuffer( &bufferDesc, nullptr, pBuffer.ReleaseAndGetAddressOf() );
+				if ( FAILED( hr ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Creation of a structured buffer." );
+					capacity = 0;
+					return false;
+				}
+				// else
+
+				D3D11_SHADER_RESOURCE_VIEW_DESC SRVDesc{};
+				SRVDesc.Format					= DXGI_FORMAT_UNKNOWN;
+				SRVDesc.ViewDimension			= D3D11_SRV_DIMENSION_BUFFER;
+				SRVDesc.Buffer.FirstElement		= 0;
+				SRVDesc.Buffer.NumElements		= scast<UINT>( newCapacity );
+				hr = pDevice->CreateShaderResourceView( pBuffer.Get(), &SRVDesc, pSRV.ReleaseAndGetAddressOf() );
+				if ( FAILED( hr ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Creation of a SRV of structured buffer." );
+					capacity = 0;
+					return false;
+				}
+				// else
+
+				capacity = newCapacity;
+				return true;
+			}
 		}
 	
 		namespace EmbeddedSourceCode
@@ -916,7 +1014,7 @@ namespace Donya
 			pImmediateContext->IASetIndexBuffer( mesh.indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0 );
 		}
 
-		void Renderer::DrawEachSubsets( const Model &model, size_t meshIndex, const RegisterDesc &descSubset, const RegisterDesc &descDiffuseMap, const RegisterDesc &descNormalMap, ID3D11DeviceContext *pImmediateContext )
+		void Renderer::DrawEachSubsets( const Model &model, size_t meshIndex, const RegisterDesc &descSubset, const RegisterDesc &descDiffuseMap, const RegisterDesc &descNormalMap, ID3D11DeviceContext *pImmediateContext, size_t instanceCount )
 		{
 			const auto &meshes	= model.GetMeshes();
 			const auto &mesh	= meshes[meshIndex];
@@ -931,7 +1029,7 @@ namespace Donya
 				SetTexture( descDiffuseMap,	subset.diffuse.pSRV.GetAddressOf(),	pImmediateContext );
 				SetTexture( descNormalMap,	subset.normal.pSRV.GetAddressOf(),	pImmediateContext );
 
-				DrawIndexed( model, meshIndex, j, pImmediateContext );
+				DrawIndexed( model, meshIndex, j, instanceCount, pImmediateContext );
 
 				UnsetTexture( descNormalMap, pImmediateContext );
 				UnsetTexture( descDiffuseMap, pImmediateContext );
@@ -986,13 +1084,20 @@ namespace Donya
 			}
 		}
 
-		void Renderer::DrawIndexed( const Model &model, size_t meshIndex, size_t subsetIndex, ID3D11DeviceContext *pImmediateContext ) const
+		void Renderer::DrawIndexed( const Model &model, size_t meshIndex, size_t subsetIndex, size_t instanceCount, ID3D11DeviceContext *pImmediateContext ) const
 		{
 			const auto &meshes	= model.GetMeshes();
 			const auto &mesh	= meshes[meshIndex];
 			const auto &subset	= mesh.subsets[subsetIndex];
 
-			pImmediateContext->DrawIndexed( subset.indexCount, subset.indexStart, 0 );
+			if ( instanceCount <= 1U )
+			{
+				pImmediateContext->DrawIndexed( subset.indexCount, subset.indexStart, 0 );
+				return;
+			}
+			// else
+
+			pImmediateContext->DrawIndexedInstanced( subset.indexCount, scast<UINT>( instanceCount ), subset.indexStart, 0, 0U );
 		}
 
 
@@ -1015,7 +1120,7 @@ namespace Donya
 
 
 		StaticRenderer::StaticRenderer( ID3D11Device *pDevice ) : Renderer( pDevice ),
-			CBPerMesh()
+			CBPerMesh(), instanceBuffer( sizeof( Constants::PerInstance::Common ) )
 		{
 			SetDefaultIfNullptr( &pDevice );
 
@@ -1047,6 +1152,35 @@ namespace Donya
 				DeactivateCBPerMesh( pImmediateContext );
 			}
 		}
+		void StaticRenderer::RenderInstanced( const StaticModel &model, const Pose &pose, const Constants::PerInstance::Common *pInstances, size_t instanceCount, const RegisterDesc &descMesh, const RegisterDesc &descSubset, const RegisterDesc &descDiffuseMap, const RegisterDesc &descNormalMap, const RegisterDesc &descInstance, ID3D11DeviceContext *pImmediateContext )
+		{
+			if ( !pInstances || !instanceCount ) { return; }
+			// else
+
+			SetDefaultIfNullptr( &pImmediateContext );
+
+			if ( !instanceBuffer.Update( pInstances, instanceCount, Donya::GetDevice(), pImmediateContext ) ) { return; }
+			// else
+
+			instanceBuffer.Activate( descInstance, pImmediateContext );
+			pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+
+			const size_t meshCount = model.GetMeshes().size();
+			for ( size_t i = 0; i < meshCount; ++i )
+			{
+				UpdateCBPerMesh( model, i, pose, descMesh, pImmediateContext );
+				ActivateCBPerMesh( descMesh, pImmediateContext );
+
+				SetVertexBuffers( model, i, pImmediateContext );
+				SetIndexBuffer( model, i, pImmediateContext );
+
+				DrawEachSubsets( model, i, descSubset, descDiffuseMap, descNormalMap, pImmediateContext, instanceCount );
+
+				DeactivateCBPerMesh( pImmediateContext );
+			}
+
+			instanceBuffer.Deactivate( pImmediateContext );
+		}
 		Constants::PerMesh::Common StaticRenderer::MakeCommonConstantsPerMesh( const Model &model, size_t meshIndex, const Pose &pose ) const
 		{
 			Constants::PerMesh::Common constants;
@@ -1071,11 +1205,14 @@ namespace Donya
 
 
 		SkinningRenderer::SkinningRenderer( ID3D11Device *pDevice ) : Renderer( pDevice ),
-			CBPerMesh()
+			CBPerMesh(), CBPerMeshInstanced(),
+			instanceBuffer( sizeof( Constants::PerInstance::Common ) ),
+			boneBuffer( sizeof( Donya::Vector4x4 ) ),
+			bonesOfInstances()
 		{
 			SetDefaultIfNullptr( &pDevice );
 
-			bool  result = CBPerMesh.CreateBuffer( pDevice );
+			bool  result = CBPerMesh.CreateBuffer( pDevice ) && CBPerMeshInstanced.CreateBuffer( pDevice );
 			if ( !result )
 			{
 				const std::string errMsg =
@@ -1103,7 +1240,82 @@ namespace Donya
 				DeactivateCBPerMesh( pImmediateContext );
 			}
 		}
-		Constants::PerMesh::Common SkinningRenderer::MakeCommonConstantsPerMesh( const Model &model, size_t meshIndex, const Pose &pose ) const
+		void SkinningRenderer::Render( const SkinningModel &model, const BonePalette &palette, int motionIndex, float motionSeconds, const RegisterDesc &descMesh, const RegisterDesc &descSubset, const RegisterDesc &descDiffuseMap, const RegisterDesc &descNormalMap, ID3D11DeviceContext *pImmediateContext )
+		{
+			SetDefaultIfNullptr( &pImmediateContext );
+
+			pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+
+			Constants::PerMesh::Bone constantsBone{};
+			const Constants::PerMesh::Common constantsCommon = MakeCommonConstantsPerMesh( model );
+
+			const size_t meshCount = model.GetMeshes().size();
+			for ( size_t i = 0; i < meshCount; ++i )
+			{
+				if ( !palette.Sample( motionIndex, motionSeconds, i, /* interpolate = */ true, &constantsBone ) )
+				{
+					_ASSERT_EXPR( 0, L"Error: The palette is not compatible with the model!" );
+					return;
+				}
+				// else
+
+				CBPerMesh.Update( constantsCommon, constantsBone );
+				ActivateCBPerMesh( descMesh, pImmediateContext );
+
+				SetVertexBuffers( model, i, pImmediateContext );
+				SetIndexBuffer( model, i, pImmediateContext );
+
+				DrawEachSubsets( model, i, descSubset, descDiffuseMap, descNormalMap, pImmediateContext );
+
+				DeactivateCBPerMesh( pImmediateContext );
+			}
+		}
+		void SkinningRenderer::RenderInstanced( const SkinningModel &model, const Pose *const *ppPoses, const Constants::PerInstance::Common *pInstances, size_t instanceCount, const RegisterDesc &descMesh, const RegisterDesc &descSubset, const RegisterDesc &descDiffuseMap, const RegisterDesc &descNormalMap, const RegisterDesc &descInstance, const RegisterDesc &descBone, ID3D11DeviceContext *pImmediateContext )
+		{
+			if ( !ppPoses || !pInstances || !instanceCount ) { return; }
+			// else
+
+			SetDefaultIfNullptr( &pImmediateContext );
+			ID3D11Device *pDevice = Donya::GetDevice();
+
+			if ( !instanceBuffer.Update( pInstances, instanceCount, pDevice, pImmediateContext ) ) { return; }
+			// else
+
+			instanceBuffer.Activate( descInstance, pImmediateContext );
+			pImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+
+			const Constants::PerMesh::Common constantsCommon = MakeCommonConstantsPerMesh( model );
+
+			const size_t meshCount = model.GetMeshes().size();
+			for ( size_t i = 0; i < meshCount; ++i )
+			{
+				const size_t boneCount = CalcBoneCount( model, i );
+				bonesOfInstances.resize( boneCount * instanceCount );
+				for ( size_t j = 0; j < instanceCount; ++j )
+				{
+					WriteBoneTransforms( model, i, *ppPoses[j], bonesOfInstances.data() + ( boneCount * j ) );
+				}
+				if ( !boneBuffer.Update( bonesOfInstances.data(), bonesOfInstances.size(), pDevice, pImmediateContext ) ) { break; }
+				// else
+
+				Constants::PerMesh::InstancedBone constantsBone{};
+				constantsBone.boneCountPerInstance = scast<unsigned int>( boneCount );
+				CBPerMeshInstanced.Update( constantsCommon, constantsBone );
+				CBPerMeshInstanced.Activate( descMesh, pImmediateContext );
+				boneBuffer.Activate( descBone, pImmediateContext );
+
+				SetVertexBuffers( model, i, pImmediateContext );
+				SetIndexBuffer( model, i, pImmediateContext );
+
+				DrawEachSubsets( model, i, descSubset, descDiffuseMap, descNormalMap, pImmediateContext, instanceCount );
+
+				boneBuffer.Deactivate( pImmediateContext );
+				CBPerMeshInstanced.Deactivate( pImmediateContext );
+			}
+
+			instanceBuffer.Deactivate( pImmediateContext );
+		}
+		Constants::PerMesh::Common SkinningRenderer::MakeCommonConstantsPerMesh( const Model &model ) const
 		{
 			Constants::PerMesh::Common constants;
 			constants.adjustMatrix =
@@ -1114,36 +1326,47 @@ namespace Donya
 			return constants;
 		}
 		Constants::PerMesh::Bone   SkinningRenderer::MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose ) const
+		{
+			Constants::PerMesh::Bone constants{};
+			WriteBoneTransforms( model, meshIndex, pose, constants.boneTransforms.data() );
+			return constants;
+		}
+		void SkinningRenderer::WriteBoneTransforms( const Model &model, size_t meshIndex, const Pose &pose, Donya::Vector4x4 *pDest ) const
 		{
 			const auto &meshes		= model.GetMeshes();
 			const auto &mesh		= meshes[meshIndex];
 			const auto &currentPose	= pose.GetCurrentPose();
-			Constants::PerMesh::Bone constants{};
 
 			if ( mesh.boneIndices.empty() )
 			{
-				constants.boneTransforms[0] = currentPose[mesh.boneIndex].global;
-				return constants;
+				pDest[0] = currentPose[mesh.boneIndex].global;
+				return;
 			}
 			// else
 
 			Donya::Vector4x4 meshToBone{}; // So-called "Bone offset matrix".
 			Donya::Vector4x4 boneToMesh{}; // Transform to mesh space of current pose.
-			const size_t boneCount = std::min( mesh.boneIndices.size(), scast<size_t>( Constants::PerMesh::Bone::MAX_BONE_COUNT ) );
+			const size_t boneCount = CalcBoneCount( model, meshIndex );
 			for ( size_t i = 0; i < boneCount; ++i )
 			{
 				const size_t poseIndex = mesh.boneIndices[i]; // This index was fetched with boneOffset's name.
 				meshToBone = mesh.boneOffsets[i].global;
 				boneToMesh = currentPose[poseIndex].global;
 				
-				constants.boneTransforms[i] = meshToBone * boneToMesh;
+				pDest[i] = meshToBone * boneToMesh;
 			}
+		}
+		size_t SkinningRenderer::CalcBoneCount( const Model &model, size_t meshIndex ) const
+		{
+			const auto &mesh = model.GetMeshes()[meshIndex];
+			if ( mesh.boneIndices.empty() ) { return 1U; }
+			// else
 
-			return constants;
+			return std::min( mesh.boneIndices.size(), scast<size_t>( Constants::PerMesh::Bone::MAX_BONE_COUNT ) );
 		}
 		void SkinningRenderer::UpdateCBPerMesh( const Model &model, size_t meshIndex, const Pose &pose, const RegisterDesc &desc, ID3D11DeviceContext *pImmediateContext )
 		{
-			Constants::PerMesh::Common	constantsCommon	= MakeCommonConstantsPerMesh( model, meshIndex, pose );
+			Constants::PerMesh::Common	constantsCommon	= MakeCommonConstantsPerMesh( model );
 			Constants::PerMesh::Bone	constantsBone	= MakeBoneConstants( model, meshIndex, pose );
 			
 			CBPerMesh.Update( constantsCommon, constantsBone );
@@ -3,8 +3,10 @@
 #include <array>			// Use std::array for bone-transforms.
 #include <d3d11.h>
 #include <memory>
+#include <vector>
 
 #include "CBuffer.h"
+#include "ModelBonePalette.h"
 #include "ModelCommon.h"
 #include "ModelMotion.h"
 #include "ModelPose.h"
@@ -64,6 +66,51 @@ namespace Donya
 				void Activate( const RegisterDesc &setting, ID3D11DeviceContext *pImmediateContext ) const override;
 				void Deactivate( ID3D11DeviceContext *pImmediateContext ) const override;
 			};
+
+			class InstancedSkinningMeshConstant : public BaseMeshConstant
+			{
+			public:
+				struct Constant
+				{
+					Constants::PerMesh::Common			common;
+					Constants::PerMesh::InstancedBone	bone;
+				};
+			private:
+				Donya::CBuffer<Constant> cbuffer;
+			public:
+				bool CreateBuffer( ID3D11Device *pDevice ) override;
+			public:
+				void Update( const Constants::PerMesh::Common &sourceCommon, const Constants::PerMesh::InstancedBone &sourceBone );
+			public:
+				void Activate( const RegisterDesc &setting, ID3D11DeviceContext *pImmediateContext ) const override;
+				void Deactivate( ID3D11DeviceContext *pImmediateContext ) const override;
+			};
+
+			/// <summary>
+			/// The dynamic structured buffer that is bound as a shader resource.<para></para>
+			/// The capacity grows when the Update() receives more elements than it.
+			/// </summary>
+			class StructuredBuffer
+			{
+			private:
+				size_t	elementStride	= 1;
+				size_t	capacity		= 0;	// The count of elements
+				mutable RegisterDesc					usingDesc;
+				ComPtr<ID3D11Buffer>					pBuffer;
+				ComPtr<ID3D11ShaderResourceView>		pSRV;
+			public:
+				StructuredBuffer( size_t elementStride );
+			public:
+				/// <summary>
+				/// Copies the "elementCount" elements to the buffer. Returns false if the creation or the mapping was failed.
+				/// </summary>
+				bool Update( const void *pElements, size_t elementCount, ID3D11Device *pDevice, ID3D11DeviceContext *pImmediateContext );
+			public:
+				void Activate( const RegisterDesc &setting, ID3D11DeviceContext *pImmediateContext ) const;
+				void Deactivate( ID3D11DeviceContext *pImmediateContext ) const;
+			private:
+				bool Reserve( size_t elementCount, ID3D11Device *pDevice );
+			};
 		}
 
 		class Model;			// Use for a reference at Render() method.
@@ -254,7 +301,10 @@ namespace Donya
 			void SetVertexBuffers( const Model &model, size_t meshIndex, ID3D11DeviceContext *pImmediateContext );
 			void SetIndexBuffer( const Model &model, size_t meshIndex, ID3D11DeviceContext *pImmediateContext );
 
-			void DrawEachSubsets( const Model &model, size_t meshIndex, const RegisterDesc &subsetSetting, const RegisterDesc &diffuseMapSetting, const RegisterDesc &normalMapSetting, ID3D11DeviceContext *pImmediateContext );
+			/// <summary>
+			/// If the "instanceCount" is greater than 1, it uses the instanced draw call.
+			/// </summary>
+			void DrawEachSubsets( const Model &model, size_t meshIndex, const RegisterDesc &subsetSetting, const RegisterDesc &diffuseMapSetting, const RegisterDesc &normalMapSetting, ID3D11DeviceContext *pImmediateContext, size_t instanceCount = 1U );
 		private:
 			void UpdateCBPerSubset( const Model &model, size_t meshIndex, size_t subsetIndex, const RegisterDesc &subsetSettings, ID3D11DeviceContext *pImmediateContext );
 			void ActivateCBPerSubset( const RegisterDesc &subsetSettings, ID3D11DeviceContext *pImmediateContext );
@@ -264,7 +314,7 @@ namespace Donya
 			void SetTexture( const RegisterDesc &mapSettings, SRVType mapSRV, ID3D11DeviceContext *pImmediateContext ) const;
 			void UnsetTexture( const RegisterDesc &mapSettings, ID3D11DeviceContext *pImmediateContext ) const;
 
-			void DrawIndexed( const Model &model, size_t meshIndex, size_t subsetIndex, ID3D11DeviceContext *pImmediateContext ) const;
+			void DrawIndexed( const Model &model, size_t meshIndex, size_t subsetIndex, size_t instanceCount, ID3D11DeviceContext *pImmediateContext ) const;
 		};
 		inline Renderer::~Renderer() {}
 
@@ -272,6 +322,7 @@ namespace Donya
 		{
 		private:
 			Impl::StaticMeshConstant CBPerMesh;
+			Impl::StructuredBuffer	 instanceBuffer;
 		public:
 			/// <summary>
 			/// If you set nullptr to "pDevice", use default device.
@@ -293,6 +344,25 @@ namespace Donya
 				const RegisterDesc	&textureMapNormal,
 				ID3D11DeviceContext	*pImmediateContext = nullptr
 			);
+			/// <summary>
+			/// Render the "instanceCount" instances that share the "model" and the "pose" by one draw call per subset.<para></para>
+			/// The world matrix and the draw color are fetched from the "structuredInstance" slot instead of the cbuffer per model, so you should use a shader for instancing.<para></para>
+			/// The "structuredInstance" is used as a StructuredBuffer's slot in HLSL.<para></para>
+			/// If you set nullptr to "pImmediateContext", use default device-context.
+			/// </summary>
+			void RenderInstanced
+			(
+				const StaticModel	&model,
+				const Pose			&pose,
+				const Constants::PerInstance::Common *pInstances,
+				size_t				instanceCount,
+				const RegisterDesc	&cbufferPerMesh,
+				const RegisterDesc	&cbufferPerSubset,
+				const RegisterDesc	&textureMapDiffuse,
+				const RegisterDesc	&textureMapNormal,
+				const RegisterDesc	&structuredInstance,
+				ID3D11DeviceContext	*pImmediateContext = nullptr
+			);
 		private:
 			Constants::PerMesh::Common MakeCommonConstantsPerMesh( const Model &model, size_t meshIndex, const Pose &pose ) const;
 			void UpdateCBPerMesh( const Model &model, size_t meshIndex, const Pose &pose, const RegisterDesc &meshSetting, ID3D11DeviceContext *pImmediateContext );
@@ -303,7 +373,11 @@ namespace Donya
 		class SkinningRenderer : public Renderer
 		{
 		private:
-			Impl::SkinningMeshConstant CBPerMesh;
+			Impl::SkinningMeshConstant			CBPerMesh;
+			Impl::InstancedSkinningMeshConstant	CBPerMeshInstanced;
+			Impl::StructuredBuffer				instanceBuffer;
+			Impl::StructuredBuffer				boneBuffer;
+			std::vector<Donya::Vector4x4>		bonesOfInstances;	// The workspace of the bone transforms as [instance][bone]
 		public:
 			/// <summary>
 			/// If you set nullptr to "pDevice", use default device.
@@ -325,9 +399,53 @@ namespace Donya
 				const RegisterDesc	&textureMapNormal,
 				ID3D11DeviceContext	*pImmediateContext = nullptr
 			);
+			/// <summary>
+			/// Render with the baked palette instead of the pose. The palette is sampled at "motionSeconds" of "motionIndex".<para></para>
+			/// The "cbufferPerMesh" and "cbufferPerSubset" are used as a cbuffer's slot in HLSL.<para></para>
+			/// The "textureMapDiffuse" and "textureMapNormal" is used as a Texture2D's slot in HLSL.<para></para>
+			/// If you set nullptr to "pImmediateContext", use default device-context.
+			/// </summary>
+			void Render
+			(
+				const SkinningModel	&model,
+				const BonePalette	&palette,
+				int					motionIndex,
+				float				motionSeconds,
+				const RegisterDesc	&cbufferPerMesh,
+				const RegisterDesc	&cbufferPerSubset,
+				const RegisterDesc	&textureMapDiffuse,
+				const RegisterDesc	&textureMapNormal,
+				ID3D11DeviceContext	*pImmediateContext = nullptr
+			);
+			/// <summary>
+			/// Render the "instanceCount" instances that share the "model" by one draw call per subset.<para></para>
+			/// The "ppPoses" must have the "instanceCount" poses. The bone transforms of all instances are stored into the "structuredBone" slot as [instance][bone].<para></para>
+			/// The world matrix and the draw color are fetched from the "structuredInstance" slot instead of the cbuffer per model, so you should use a shader for instancing.<para></para>
+			/// The "structuredInstance" and "structuredBone" are used as a StructuredBuffer's slot in HLSL.<para></para>
+			/// If you set nullptr to "pImmediateContext", use default device-context.
+			/// </summary>
+			void RenderInstanced
+			(
+				const SkinningModel	&model,
+				const Pose			*const *ppPoses,
+				const Constants::PerInstance::Common *pInstances,
+				size_t				instanceCount,
+				const RegisterDesc	&cbufferPerMesh,
+				const RegisterDesc	&cbufferPerSubset,
+				const RegisterDesc	&textureMapDiffuse,
+				const RegisterDesc	&textureMapNormal,
+				const RegisterDesc	&structuredInstance,
+				const RegisterDesc	&structuredBone,
+				ID3D11DeviceContext	*pImmediateContext = nullptr
+			);
 		private:
-			Constants::PerMesh::Common MakeCommonConstantsPerMesh( const Model &model, size_t meshIndex, const Pose &pose ) const;
+			Constants::PerMesh::Common MakeCommonConstantsPerMesh( const Model &model ) const;
 			Constants::PerMesh::Bone   MakeBoneConstants( const Model &model, size_t meshIndex, const Pose &pose ) const;
+			/// <summary>
+			/// Writes the bone transforms of the mesh to the "pDest" that has the CalcBoneCount() elements at least.
+			/// </summary>
+			void WriteBoneTransforms( const Model &model, size_t meshIndex, const Pose &pose, Donya::Vector4x4 *pDest ) const;
+			size_t CalcBoneCount( const Model &model, size_t meshIndex ) const;
 			void UpdateCBPerMesh( const Model &model, size_t meshIndex, const Pose &pose, const RegisterDesc &meshSetting, ID3D11DeviceContext *pImmediateContext );
 			void ActivateCBPerMesh( const RegisterDesc &meshSetting, ID3D11DeviceContext *pImmediateContext );
 			void DeactivateCBPerMesh( ID3D11DeviceContext *pImmediateContext );
@@ -0,0 +1,514 @@
+#include "ObjParser.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "Constant.h"	// Use scast macro
+#include "Useful.h"		// Use ReadByteCode()
+
+namespace
+{
+	bool IsSpace( char c )			{ return ( c == ' ' || c == '\t' ); }
+	bool IsEndOfLine( char c )		{ return ( c == '\n' || c == '\r' ); }
+	bool IsDigit( char c )			{ return ( '0' <= c && c <= '9' ); }
+
+	void SkipSpaces( const char *&p, const char *end )
+	{
+		while ( p < end && IsSpace( *p ) ) { ++p; }
+	}
+	void SkipLine( const char *&p, const char *end )
+	{
+		while ( p < end && *p != '\n' ) { ++p; }
+		if ( p < end ) { ++p; }
+	}
+	/// <summary>
+	/// Returns true and advances the "p" if the line starts with the "keyword" that is followed by a space.
+	/// </summary>
+	bool MatchKeyword( const char *&p, const char *end, const char *keyword )
+	{
+		const char *it = p;
+		for ( ; *keyword; ++keyword, ++it )
+		{
+			if ( end <= it || *it != *keyword ) { return false; }
+		}
+		if ( end <= it || !IsSpace( *it ) ) { return false; }
+		// else
+
+		p = it;
+		SkipSpaces( p, end );
+		return true;
+	}
+	/// <summary>
+	/// Returns the rest of the line without the surrounding spaces.
+	/// </summary>
+	std::string ReadRestOfLine( const char *p, const char *end )
+	{
+		SkipSpaces( p, end );
+		const char *last = p;
+		while ( last < end && !IsEndOfLine( *last ) ) { ++last; }
+		while ( p < last && IsSpace( *( last - 1 ) ) ) { --last; }
+		return std::string{ p, last };
+	}
+	/// <summary>
+	/// Returns the last token of the line. It skips the options of map, e.g. "map_Kd -s 1 1 1 texture.png".
+	/// </summary>
+	std::string ReadLastToken( const char *p, const char *end )
+	{
+		const std::string line = ReadRestOfLine( p, end );
+		const size_t found = line.find_last_of( " \t" );
+		return ( found == std::string::npos ) ? line : line.substr( found + 1 );
+	}
+
+	bool ParseInt( const char *&p, const char *end, int *pOutput )
+	{
+		bool negative = false;
+		if ( p < end && ( *p == '-' || *p == '+' ) )
+		{
+			negative = ( *p == '-' );
+			++p;
+		}
+		if ( end <= p || !IsDigit( *p ) ) { return false; }
+		// else
+
+		long long value = 0;
+		for ( ; p < end && IsDigit( *p ); ++p )
+		{
+			value = value * 10 + ( *p - '0' );
+			if ( std::numeric_limits<int>::max() < value ) { return false; }
+		}
+
+		*pOutput = scast<int>( ( negative ) ? -value : value );
+		return true;
+	}
+	bool ParseFloat( const char *&p, const char *end, float *pOutput )
+	{
+		// The digits beyond this are dropped, because the float can not represent them anyway
+		constexpr unsigned long long maxMantissa = 100000000000000000ULL;
+		constexpr double powersOf10[] =
+		{
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+		};
+		constexpr int maxExactPower = scast<int>( sizeof( powersOf10 ) / sizeof( powersOf10[0] ) ) - 1;
+
+		bool negative = false;
+		if ( p < end && ( *p == '-' || *p == '+' ) )
+		{
+			negative = ( *p == '-' );
+			++p;
+		}
+
+		unsigned long long mantissa = 0;
+		int  exponent	= 0;
+		bool hasDigit	= false;
+		for ( ; p < end && IsDigit( *p ); ++p )
+		{
+			if ( mantissa < maxMantissa )	{ mantissa = mantissa * 10 + ( *p - '0' ); }
+			else							{ exponent++; }
+			hasDigit = true;
+		}
+		if ( p < end && *p == '.' )
+		{
+			++p;
+			for ( ; p < end && IsDigit( *p ); ++p )
+			{
+				if ( mantissa < maxMantissa )
+				{
+					mantissa = mantissa * 10 + ( *p - '0' );
+					exponent--;
+				}
+				hasDigit = true;
+			}
+		}
+		if ( !hasDigit ) { return false; }
+		// else
+
+		if ( p < end && ( *p == 'e' || *p == 'E' ) )
+		{
+			const char *exponentBegin = p + 1;
+			int exponentValue = 0;
+			if ( ParseInt( exponentBegin, end, &exponentValue ) )
+			{
+				exponent += exponentValue;
+				p = exponentBegin;
+			}
+		}
+
+		double value = scast<double>( mantissa );
+		if ( mantissa != 0 && exponent != 0 )
+		{
+			if ( 0 < exponent && exponent <= maxExactPower )
+			{
+				value *= powersOf10[exponent];
+			}
+			else if ( exponent < 0 && -exponent <= maxExactPower )
+			{
+				value /= powersOf10[-exponent];
+			}
+			else
+			{
+				value *= std::pow( 10.0, exponent );
+			}
+		}
+
+		*pOutput = scast<float>( ( negative ) ? -value : value );
+		return true;
+	}
+	bool ParseFloats( const char *&p, const char *end, float *pOutput, int count )
+	{
+		for ( int i = 0; i < count; ++i )
+		{
+			SkipSpaces( p, end );
+			if ( !ParseFloat( p, end, &pOutput[i] ) ) { return false; }
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Converts the one-based(or negative relative) index into zero-based. Returns -1 if it is out of range.
+	/// </summary>
+	int ResolveIndex( int index, size_t elementCount )
+	{
+		const int count = scast<int>( elementCount );
+		if ( 0 < index  ) { return ( index <= count ) ? index - 1 : -1; }
+		if ( index < 0  ) { return ( -index <= count ) ? count + index : -1; }
+		// else
+		return -1;
+	}
+
+	/// <summary>
+	/// The open addressing hash table from the (position, texCoord, normal) triple to the vertex index.
+	/// </summary>
+	class VertexTable
+	{
+	private:
+		struct Entry
+		{
+			int				position	= -1;
+			int				texCoord	= -1;
+			int				normal		= -1;
+			std::uint32_t	vertexIndex	= emptyIndex;
+		};
+		static constexpr std::uint32_t emptyIndex = std::numeric_limits<std::uint32_t>::max();
+	private:
+		std::vector<Entry>	entries;
+		size_t				usedCount = 0;
+	public:
+		explicit VertexTable( size_t initialCapacity = 1024 )
+		{
+			size_t capacity = 16;
+			while ( capacity < initialCapacity ) { capacity <<= 1; }
+			entries.resize( capacity );
+		}
+	public:
+		/// <summary>
+		/// Returns the registered index if the triple is found, otherwise registers the "newIndex" and returns it.
+		/// </summary>
+		std::uint32_t FindOrInsert( int position, int texCoord, int normal, std::uint32_t newIndex )
+		{
+			if ( entries.size() < ( usedCount + 1 ) * 2 ) { Grow(); }
+			// else
+
+			const size_t mask = entries.size() - 1;
+			for ( size_t i = Hash( position, texCoord, normal ) & mask; ; i = ( i + 1 ) & mask )
+			{
+				Entry &entry = entries[i];
+				if ( entry.vertexIndex == emptyIndex )
+				{
+					entry.position		= position;
+					entry.texCoord		= texCoord;
+					entry.normal		= normal;
+					entry.vertexIndex	= newIndex;
+					usedCount++;
+					return newIndex;
+				}
+				// else
+				if ( entry.position == position && entry.texCoord == texCoord && entry.normal == normal )
+				{
+					return entry.vertexIndex;
+				}
+			}
+		}
+	private:
+		static size_t Hash( int position, int texCoord, int normal )
+		{
+			std::uint64_t h = scast<std::uint32_t>( position );
+			h = h * 0x9E3779B97F4A7C15ULL ^ scast<std::uint32_t>( texCoord );
+			h = h * 0x9E3779B97F4A7C15ULL ^ scast<std::uint32_t>( normal );
+			h ^= h >> 29;
+			return scast<size_t>( h );
+		}
+		void Grow()
+		{
+			std::vector<Entry> oldEntries( entries.size() * 2 );
+			oldEntries.swap( entries );
+
+			const size_t mask = entries.size() - 1;
+			for ( const Entry &it : oldEntries )
+			{
+				if ( it.vertexIndex == emptyIndex ) { continue; }
+				// else
+
+				size_t i = Hash( it.position, it.texCoord, it.normal ) & mask;
+				while ( entries[i].vertexIndex != emptyIndex ) { i = ( i + 1 ) & mask; }
+				entries[i] = it;
+			}
+		}
+	};
+
+	bool ReadWholeFile( const std::wstring &filePath, std::unique_ptr<char[]> *pBuffer, long *pByteLength )
+	{
+		*pByteLength = Donya::ReadByteCode( pBuffer, filePath, L"rb" );
+		return ( 0 <= *pByteLength );
+	}
+}
+
+namespace Donya
+{
+	namespace Resource
+	{
+		namespace Obj
+		{
+			void Mesh::Clear()
+			{
+				positions.clear();
+				normals.clear();
+				texCoords.clear();
+				indices16.clear();
+				indices32.clear();
+				subsets.clear();
+				mtllibName.clear();
+			}
+
+			bool ParseObj( const char *begin, const char *end, Mesh *pOutput, bool allow16BitIndices )
+			{
+				if ( !pOutput ) { return false; }
+				// else
+				pOutput->Clear();
+				if ( !begin || end <= begin ) { return true; }
+				// else
+
+				std::vector<DirectX::XMFLOAT3>	filePositions;
+				std::vector<DirectX::XMFLOAT2>	fileTexCoords;
+				std::vector<DirectX::XMFLOAT3>	fileNormals;
+				VertexTable vertexTable{};
+
+				auto &indices = pOutput->indices32;
+				auto CloseSubset = [&]()
+				{
+					if ( pOutput->subsets.empty() ) { return; }
+					// else
+					Subset &last = pOutput->subsets.back();
+					last.indexCount = scast<std::uint32_t>( indices.size() ) - last.indexStart;
+				};
+
+				// Reads a corner of face, e.g. "1", "1/2", "1//3", "1/2/3". Returns false if it is invalid.
+				auto ParseCorner = [&]( const char *&p, std::uint32_t *pVertexIndex )
+				{
+					int position = 0, texCoord = 0, normal = 0;
+					if ( !ParseInt( p, end, &position ) ) { return false; }
+					// else
+					if ( p < end && *p == '/' )
+					{
+						++p;
+						if ( p < end && *p != '/' && !ParseInt( p, end, &texCoord ) ) { return false; }
+						// else
+						if ( p < end && *p == '/' )
+						{
+							++p;
+							if ( !ParseInt( p, end, &normal ) ) { return false; }
+						}
+					}
+
+					position = ResolveIndex( position, filePositions.size() );
+					if ( position < 0 ) { return false; }
+					// else
+					if ( texCoord != 0 )
+					{
+						texCoord = ResolveIndex( texCoord, fileTexCoords.size() );
+						if ( texCoord < 0 ) { return false; }
+					}
+					else { texCoord = -1; }
+					if ( normal != 0 )
+					{
+						normal = ResolveIndex( normal, fileNormals.size() );
+						if ( normal < 0 ) { return false; }
+					}
+					else { normal = -1; }
+
+					const std::uint32_t newIndex	= scast<std::uint32_t>( pOutput->positions.size() );
+					const std::uint32_t vertexIndex	= vertexTable.FindOrInsert( position, texCoord, normal, newIndex );
+					if ( vertexIndex == newIndex )
+					{
+						pOutput->positions.emplace_back( filePositions[position] );
+						pOutput->texCoords.emplace_back( ( 0 <= texCoord ) ? fileTexCoords[texCoord] : DirectX::XMFLOAT2{ 0.0f, 0.0f } );
+						pOutput->normals.emplace_back  ( ( 0 <= normal   ) ? fileNormals[normal]     : DirectX::XMFLOAT3{ 0.0f, 0.0f, 0.0f } );
+					}
+
+					*pVertexIndex = vertexIndex;
+					return true;
+				};
+
+				const char *p = begin;
+				while ( p < end )
+				{
+					SkipSpaces( p, end );
+					if ( end <= p ) { break; }
+					// else
+
+					if ( MatchKeyword( p, end, "v" ) )
+					{
+						DirectX::XMFLOAT3 v{};
+						if ( !ParseFloats( p, end, &v.x, 3 ) ) { return false; }
+						// else
+						filePositions.emplace_back( v );
+					}
+					else if ( MatchKeyword( p, end, "vt" ) )
+					{
+						DirectX::XMFLOAT2 v{};
+						if ( !ParseFloats( p, end, &v.x, 2 ) ) { return false; }
+						// else
+						v.y = -v.y; // If obj-file is RH
+						fileTexCoords.emplace_back( v );
+					}
+					else if ( MatchKeyword( p, end, "vn" ) )
+					{
+						DirectX::XMFLOAT3 v{};
+						if ( !ParseFloats( p, end, &v.x, 3 ) ) { return false; }
+						// else
+						fileNormals.emplace_back( v );
+					}
+					else if ( MatchKeyword( p, end, "f" ) )
+					{
+						if ( pOutput->subsets.empty() )
+						{
+							pOutput->subsets.emplace_back();
+						}
+
+						// Triangulate as a fan
+						std::uint32_t first = 0, previous = 0, current = 0;
+						int cornerCount = 0;
+						while ( p < end && !IsEndOfLine( *p ) )
+						{
+							if ( !ParseCorner( p, &current ) ) { return false; }
+							// else
+
+							if ( cornerCount == 0 ) { first = current; }
+							if ( 2 <= cornerCount )
+							{
+								indices.emplace_back( first		);
+								indices.emplace_back( previous	);
+								indices.emplace_back( current	);
+							}
+							previous = current;
+							cornerCount++;
+
+							SkipSpaces( p, end );
+						}
+					}
+					else if ( MatchKeyword( p, end, "usemtl" ) )
+					{
+						CloseSubset();
+
+						Subset subset{};
+						subset.materialName	= ReadRestOfLine( p, end );
+						subset.indexStart	= scast<std::uint32_t>( indices.size() );
+						pOutput->subsets.emplace_back( std::move( subset ) );
+					}
+					else if ( MatchKeyword( p, end, "mtllib" ) )
+					{
+						pOutput->mtllibName = ReadRestOfLine( p, end );
+					}
+					// The others(comment, group, smooth, etc.) are ignored.
+
+					SkipLine( p, end );
+				}
+
+				CloseSubset();
+
+				if ( allow16BitIndices && pOutput->positions.size() <= scast<size_t>( std::numeric_limits<std::uint16_t>::max() ) + 1 )
+				{
+					pOutput->indices16.assign( indices.begin(), indices.end() );
+					std::vector<std::uint32_t>().swap( indices );
+				}
+
+				return true;
+			}
+
+			bool ParseMtl( const char *begin, const char *end, std::vector<MaterialDesc> *pOutput )
+			{
+				if ( !pOutput ) { return false; }
+				if ( !begin || end <= begin ) { return true; }
+				// else
+
+				MaterialDesc *pCurrent = nullptr;
+
+				const char *p = begin;
+				while ( p < end )
+				{
+					SkipSpaces( p, end );
+					if ( end <= p ) { break; }
+					// else
+
+					if ( MatchKeyword( p, end, "newmtl" ) )
+					{
+						pOutput->emplace_back();
+						pCurrent = &pOutput->back();
+						pCurrent->name = ReadRestOfLine( p, end );
+					}
+					else if ( !pCurrent )
+					{
+						// The properties before "newmtl" are ignored.
+					}
+					else if ( MatchKeyword( p, end, "Ns" ) )
+					{
+						if ( !ParseFloats( p, end, &pCurrent->shininess, 1 ) ) { return false; }
+					}
+					else if ( MatchKeyword( p, end, "Ka" ) )
+					{
+						if ( !ParseFloats( p, end, pCurrent->ambient, 3 ) ) { return false; }
+					}
+					else if ( MatchKeyword( p, end, "Kd" ) )
+					{
+						if ( !ParseFloats( p, end, pCurrent->diffuse, 3 ) ) { return false; }
+					}
+					else if ( MatchKeyword( p, end, "Ks" ) )
+					{
+						if ( !ParseFloats( p, end, pCurrent->specular, 3 ) ) { return false; }
+					}
+					else if ( MatchKeyword( p, end, "illum" ) )
+					{
+						if ( !ParseInt( p, end, &pCurrent->illuminate ) ) { return false; }
+					}
+					else if ( MatchKeyword( p, end, "map_Kd" ) )
+					{
+						pCurrent->diffuseMapName = ReadLastToken( p, end );
+					}
+					// The others are ignored.
+
+					SkipLine( p, end );
+				}
+
+				return true;
+			}
+
+			bool ParseObjFile( const std::wstring &objFilePath, Mesh *pOutput, bool allow16BitIndices )
+			{
+				std::unique_ptr<char[]> buffer{};
+				long byteLength = 0;
+				if ( !ReadWholeFile( objFilePath, &buffer, &byteLength ) ) { return false; }
+				// else
+				return ParseObj( buffer.get(), buffer.get() + byteLength, pOutput, allow16BitIndices );
+			}
+			bool ParseMtlFile( const std::wstring &mtlFilePath, std::vector<MaterialDesc> *pOutput )
+			{
+				std::unique_ptr<char[]> buffer{};
+				long byteLength = 0;
+				if ( !ReadWholeFile( mtlFilePath, &buffer, &byteLength ) ) { return false; }
+				// else
+				return ParseMtl( buffer.get(), buffer.get() + byteLength, pOutput );
+			}
+		}
+	}
+}
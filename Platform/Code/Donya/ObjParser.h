@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+
+namespace Donya
+{
+	namespace Resource
+	{
+		/// <summary>
+		/// The parser of OBJ and MTL file that works on a byte buffer in one pass.<para></para>
+		/// It does not use the device, so you can use it on any thread or without a window.
+		/// </summary>
+		namespace Obj
+		{
+			/// <summary>
+			/// It is one of material in mtl-file.
+			/// </summary>
+			struct MaterialDesc
+			{
+				std::string	name;
+				int			illuminate = 0;		// 0 ~ 10
+				float		shininess = 0.0f;	// 0.0f ~ 1000.0f
+				float		ambient[3]{};		// RGB, 0.0f ~ 1.0f
+				float		diffuse[3]{};		// RGB, 0.0f ~ 1.0f
+				float		specular[3]{};		// RGB, 0.0f ~ 1.0f
+				std::string	diffuseMapName;		// fileName.extension, as written in the file
+			};
+			/// <summary>
+			/// The range of indices that uses one material.
+			/// </summary>
+			struct Subset
+			{
+				std::string		materialName;	// Empty if the "usemtl" is not specified
+				std::uint32_t	indexStart = 0;
+				std::uint32_t	indexCount = 0;
+			};
+			/// <summary>
+			/// The vertices are unique by the (position, texCoord, normal) triple, and the faces are triangulated.<para></para>
+			/// Only one of "indices16" or "indices32" is used.
+			/// </summary>
+			struct Mesh
+			{
+				std::vector<DirectX::XMFLOAT3>	positions;
+				std::vector<DirectX::XMFLOAT3>	normals;	// Same size as the positions, zero if the face does not specify
+				std::vector<DirectX::XMFLOAT2>	texCoords;	// Same size as the positions, zero if the face does not specify
+				std::vector<std::uint16_t>		indices16;
+				std::vector<std::uint32_t>		indices32;
+				std::vector<Subset>				subsets;
+				std::string						mtllibName;	// As written in the file
+			public:
+				bool	Uses16BitIndices()	const { return !indices16.empty(); }
+				size_t	GetIndexCount()		const { return ( Uses16BitIndices() ) ? indices16.size() : indices32.size(); }
+				void	Clear();
+			};
+
+			/// <summary>
+			/// Parses the OBJ text of [begin, end).<para></para>
+			/// The indices are stored as 16-bit if "allow16BitIndices" is true and the vertex count fits, otherwise as 32-bit.<para></para>
+			/// The V of texture coordinate is negated, same as Resource::LoadObjFile().<para></para>
+			/// Returns false if a face refers an undefined element.
+			/// </summary>
+			bool ParseObj( const char *begin, const char *end, Mesh *pOutput, bool allow16BitIndices = true );
+			/// <summary>
+			/// Parses the MTL text of [begin, end), and appends the materials into "pOutput".
+			/// </summary>
+			bool ParseMtl( const char *begin, const char *end, std::vector<MaterialDesc> *pOutput );
+
+			/// <summary>
+			/// Reads the whole file and calls ParseObj(). Returns false if the reading or the parsing is failed.
+			/// </summary>
+			bool ParseObjFile( const std::wstring &objFilePath, Mesh *pOutput, bool allow16BitIndices = true );
+			/// <summary>
+			/// Reads the whole file and calls ParseMtl(). Returns false if the reading or the parsing is failed.
+			/// </summary>
+			bool ParseMtlFile( const std::wstring &mtlFilePath, std::vector<MaterialDesc> *pOutput );
+		}
+	}
+}
@@ -0,0 +1,518 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace Profiler
+	{
+		namespace
+		{
+			using Clock = std::chrono::steady_clock;
+			const Clock::time_point epoch = Clock::now();
+
+			std::atomic<bool> enabled{ true };
+
+			/// <summary>
+			/// A slot of the ring buffer. The owner may overwrite it while the main thread reads it,
+			/// so the members are atomic, and the reader discards the slot that may be overwritten.
+			/// </summary>
+			struct Slot
+			{
+				std::atomic<const char *>	name{ nullptr };
+				std::atomic<std::int64_t>	beginNS{ 0 };
+				std::atomic<std::int64_t>	endNS{ 0 };
+				std::atomic<std::uint32_t>	depth{ 0 };
+			};
+			/// <summary>
+			/// The single-producer single-consumer ring buffer.
+			/// The owner thread only writes the slots and the "writeCount",
+			/// and the main thread only reads them at the EndFrame() with the "readCount".
+			/// </summary>
+			struct ThreadBuffer
+			{
+				std::array<Slot, eventCapacityPerThread>	slots{};
+				std::atomic<std::uint64_t>	writeCount{ 0 };
+				std::uint64_t				readCount = 0;	// Accessed by the gathering thread only
+				std::atomic<bool>			released{ false };
+				std::uint32_t				threadID  = 0;
+				std::uint32_t				depth     = 0;	// Accessed by the owner thread only
+			};
+			/// <summary>
+			/// Releases the buffer when the owner thread is finished, then a new thread can reuse it.
+			/// </summary>
+			struct BufferOwner
+			{
+				ThreadBuffer *pBuffer = nullptr;
+			public:
+				~BufferOwner()
+				{
+					if ( pBuffer ) { pBuffer->released.store( true, std::memory_order_release ); }
+				}
+			};
+
+			std::mutex									registryMutex;
+			std::vector<std::unique_ptr<ThreadBuffer>>	buffers;		// Never shrinks until the program ends
+			std::unordered_map<std::uint32_t, std::string> threadNames;	// [threadID]
+			std::uint32_t								nextThreadID = 0;
+
+			thread_local BufferOwner					localOwner;
+			thread_local std::string					localThreadName;	// Applied when the buffer is acquired
+
+			ThreadBuffer *AcquireLocalBuffer()
+			{
+				if ( localOwner.pBuffer ) { return localOwner.pBuffer; }
+				// else
+
+				std::lock_guard<std::mutex> lock( registryMutex );
+
+				ThreadBuffer *pBuffer = nullptr;
+				for ( auto &it : buffers )
+				{
+					// The buffer of a finished thread can be reused after the all events are gathered
+					if ( !it->released.load( std::memory_order_acquire ) ) { continue; }
+					if ( it->readCount != it->writeCount.load( std::memory_order_acquire ) ) { continue; }
+					// else
+
+					pBuffer = it.get();
+					break;
+				}
+				if ( !pBuffer )
+				{
+					buffers.emplace_back( std::make_unique<ThreadBuffer>() );
+					pBuffer = buffers.back().get();
+				}
+
+				pBuffer->released.store( false, std::memory_order_relaxed );
+				pBuffer->threadID	= nextThreadID++;
+				pBuffer->depth		= 0;
+				threadNames[pBuffer->threadID] = ( localThreadName.empty() ) ? "Thread " + std::to_string( pBuffer->threadID ) : localThreadName;
+
+				localOwner.pBuffer = pBuffer;
+				return pBuffer;
+			}
+
+			struct Frame
+			{
+				std::int64_t		beginNS = 0;
+				std::int64_t		endNS   = 0;
+				std::vector<Event>	events;
+			};
+			struct ScopeHistory
+			{
+				std::array<float, historyFrameCount> samplesMS{};
+				size_t	sampleCount		= 0;
+				size_t	nextIndex		= 0;
+				float	frameTotalMS	= 0.0f;	// The accumulation of the current frame
+				int		frameCallCount	= 0;	// The accumulation of the current frame
+			};
+
+			// These are accessed by the main thread only
+
+			std::array<Frame, retainFrameCount>			frames{};	// The ring buffer of the gathered frames
+			size_t										frameCount	= 0;
+			size_t										frameNext	= 0;
+			std::int64_t								lastEndNS	= 0;
+			float										lastFrameMS	= 0.0f;
+			size_t										droppedCount = 0;
+
+			std::unordered_map<const char *, size_t>	indexByPointer;	// [name pointer] index of the "histories"
+			std::unordered_map<std::string,  size_t>	indexByName;	// Merges the same name that has another pointer
+			std::vector<ScopeHistory>					histories;
+			std::vector<ScopeStatistics>				statistics;		// Same order as the "histories"
+			std::vector<float>							sortBuffer;
+
+			size_t FindOrAppendScope( const char *name )
+			{
+				const auto foundPtr = indexByPointer.find( name );
+				if ( foundPtr != indexByPointer.end() ) { return foundPtr->second; }
+				// else
+
+				const std::string strName{ ( name ) ? name : "(null)" };
+				const auto foundName = indexByName.find( strName );
+				if ( foundName != indexByName.end() )
+				{
+					indexByPointer.emplace( name, foundName->second );
+					return foundName->second;
+				}
+				// else
+
+				const size_t index = histories.size();
+				histories.emplace_back();
+				statistics.emplace_back();
+				statistics.back().name = strName;
+
+				indexByPointer.emplace( name, index );
+				indexByName.emplace( strName, index );
+				return index;
+			}
+
+			/// <summary>
+			/// Moves the available events of the "buffer" to the "pDest".
+			/// </summary>
+			void Drain( ThreadBuffer &buffer, std::vector<Event> *pDest )
+			{
+				const std::uint64_t written = buffer.writeCount.load( std::memory_order_acquire );
+				if ( eventCapacityPerThread < written - buffer.readCount )
+				{
+					droppedCount += scast<size_t>( written - buffer.readCount - eventCapacityPerThread );
+					buffer.readCount = written - eventCapacityPerThread;
+				}
+
+				const size_t oldSize = pDest->size();
+				for ( std::uint64_t i = buffer.readCount; i < written; ++i )
+				{
+					const Slot &slot = buffer.slots[scast<size_t>( i % eventCapacityPerThread )];
+					Event tmp{};
+					tmp.name		= slot.name.load( std::memory_order_relaxed );
+					tmp.beginNS		= slot.beginNS.load( std::memory_order_relaxed );
+					tmp.endNS		= slot.endNS.load( std::memory_order_relaxed );
+					tmp.depth		= slot.depth.load( std::memory_order_relaxed );
+					tmp.threadID	= buffer.threadID;
+					pDest->emplace_back( tmp );
+				}
+
+				// The owner may have overwritten the slots while the copying, so discard them.
+				// The fence pairs with the one of Record(), so the "rewritten" also counts the write that is in progress.
+				std::atomic_thread_fence( std::memory_order_acquire );
+				const std::uint64_t rewritten = buffer.writeCount.load( std::memory_order_relaxed ) + 1;
+				if ( eventCapacityPerThread < rewritten - buffer.readCount )
+				{
+					const std::uint64_t invalidCount = std::min<std::uint64_t>( written - buffer.readCount, rewritten - buffer.readCount - eventCapacityPerThread );
+					const auto begin = pDest->begin() + oldSize;
+					pDest->erase( begin, begin + scast<size_t>( invalidCount ) );
+					droppedCount += scast<size_t>( invalidCount );
+				}
+
+				buffer.readCount = written;
+			}
+
+			float Percentile( std::vector<float> *pSorted, float ratio )
+			{
+				if ( pSorted->empty() ) { return 0.0f; }
+				// else
+
+				const size_t last  = pSorted->size() - 1;
+				const size_t index = std::min( last, scast<size_t>( ratio * scast<float>( pSorted->size() ) ) );
+				std::nth_element( pSorted->begin(), pSorted->begin() + index, pSorted->end() );
+				return ( *pSorted )[index];
+			}
+
+			void UpdateStatistics( size_t index )
+			{
+				ScopeHistory	&history = histories[index];
+				ScopeStatistics	&stat    = statistics[index];
+
+				stat.lastCallCount	= history.frameCallCount;
+				stat.lastMS			= history.frameTotalMS;
+
+				history.samplesMS[history.nextIndex] = history.frameTotalMS;
+				history.nextIndex	= ( history.nextIndex + 1 ) % historyFrameCount;
+				history.sampleCount	= std::min( history.sampleCount + 1, historyFrameCount );
+				history.frameTotalMS	= 0.0f;
+				history.frameCallCount	= 0;
+
+				sortBuffer.assign( history.samplesMS.begin(), history.samplesMS.begin() + history.sampleCount );
+
+				float sum = 0.0f;
+				float min = sortBuffer.front();
+				for ( const float &it : sortBuffer )
+				{
+					sum += it;
+					min =  std::min( min, it );
+				}
+
+				stat.minMS			= min;
+				stat.avgMS			= sum / scast<float>( sortBuffer.size() );
+				stat.p99MS			= Percentile( &sortBuffer, 0.99f );
+				stat.sampleCount	= scast<int>( history.sampleCount );
+			}
+
+			void WriteEscaped( std::ofstream &ofs, const std::string &str )
+			{
+				for ( const char &c : str )
+				{
+					switch ( c )
+					{
+					case '\"': ofs << "\\\""; break;
+					case '\\': ofs << "\\\\"; break;
+					case '\n': ofs << "\\n";  break;
+					case '\t': ofs << "\\t";  break;
+					default:
+						if ( scast<unsigned char>( c ) < 0x20 ) { break; }
+						// else
+						ofs << c;
+						break;
+					}
+				}
+			}
+		}
+
+		std::int64_t Now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - epoch ).count();
+		}
+
+		void SetEnable( bool enable )
+		{
+			enabled.store( enable, std::memory_order_relaxed );
+		}
+		bool IsEnabled()
+		{
+			return enabled.load( std::memory_order_relaxed );
+		}
+
+		void SetThreadName( const std::string &threadName )
+		{
+		#if USE_PROFILER
+			localThreadName = threadName;
+
+			// The thread that has not recorded yet has no buffer, the name is applied when it acquires
+			ThreadBuffer *pBuffer = localOwner.pBuffer;
+			if ( !pBuffer ) { return; }
+			// else
+
+			std::lock_guard<std::mutex> lock( registryMutex );
+			threadNames[pBuffer->threadID] = threadName;
+		#endif // USE_PROFILER
+		}
+
+		void Record( const char *name, std::int64_t beginNS, std::int64_t endNS )
+		{
+			ThreadBuffer *pBuffer = AcquireLocalBuffer();
+
+			const std::uint64_t written = pBuffer->writeCount.load( std::memory_order_relaxed );
+			Slot &dest		= pBuffer->slots[scast<size_t>( written % eventCapacityPerThread )];
+
+			// The reader that sees the new values of this slot also sees the "written" by this fence
+			std::atomic_thread_fence( std::memory_order_release );
+			dest.name.store		( name,				std::memory_order_relaxed );
+			dest.beginNS.store	( beginNS,			std::memory_order_relaxed );
+			dest.endNS.store	( endNS,			std::memory_order_relaxed );
+			dest.depth.store	( pBuffer->depth,	std::memory_order_relaxed );
+			pBuffer->writeCount.store( written + 1, std::memory_order_release );
+		}
+
+		Scope::Scope( const char *name ) : name( name ), beginNS( 0 )
+		{
+			if ( !IsEnabled() ) { this->name = nullptr; return; }
+			// else
+
+			AcquireLocalBuffer()->depth++;
+			beginNS = Now();
+		}
+		Scope::~Scope()
+		{
+			if ( !name ) { return; }
+			// else
+
+			const std::int64_t endNS = Now();
+			ThreadBuffer *pBuffer = AcquireLocalBuffer();
+			pBuffer->depth--;
+			Record( name, beginNS, endNS );
+		}
+
+		void EndFrame()
+		{
+			const std::int64_t nowNS = Now();
+			lastFrameMS = scast<float>( nowNS - lastEndNS ) * 0.000001f;
+
+			Frame &frame = frames[frameNext];
+			frame.beginNS	= lastEndNS;
+			frame.endNS		= nowNS;
+			frame.events.clear();
+			{
+				std::lock_guard<std::mutex> lock( registryMutex );
+				for ( auto &it : buffers )
+				{
+					Drain( *it, &frame.events );
+				}
+			}
+			frameNext	= ( frameNext + 1 ) % retainFrameCount;
+			frameCount	= std::min( frameCount + 1, retainFrameCount );
+			lastEndNS	= nowNS;
+
+			// Aggregate by name
+
+			std::vector<size_t> measuredIndices;
+			for ( const auto &it : frame.events )
+			{
+				const size_t index = FindOrAppendScope( it.name );
+				ScopeHistory &history = histories[index];
+				if ( history.frameCallCount == 0 )
+				{
+					measuredIndices.emplace_back( index );
+				}
+
+				history.frameTotalMS += scast<float>( it.endNS - it.beginNS ) * 0.000001f;
+				history.frameCallCount++;
+			}
+
+			// The scope that was not called in this frame keeps its statistics
+			for ( const size_t &index : measuredIndices )
+			{
+				UpdateStatistics( index );
+			}
+		}
+
+		float GetLastFrameMS()
+		{
+			return lastFrameMS;
+		}
+		size_t GetDroppedEventCount()
+		{
+			return droppedCount;
+		}
+		const std::vector<ScopeStatistics> &GetStatistics()
+		{
+			return statistics;
+		}
+		size_t GetRetainedFrameCount()
+		{
+			return frameCount;
+		}
+		void CollectEvents( size_t collectCount, std::vector<Event> *pOutput )
+		{
+			if ( !pOutput ) { return; }
+			// else
+
+			collectCount = std::min( collectCount, frameCount );
+			for ( size_t i = 0; i < collectCount; ++i )
+			{
+				// From the old one
+				const size_t index = ( frameNext + retainFrameCount - collectCount + i ) % retainFrameCount;
+				const auto  &events = frames[index].events;
+				pOutput->insert( pOutput->end(), events.begin(), events.end() );
+			}
+		}
+
+		bool ExportChromeTrace( const std::string &filePath, size_t exportCount )
+		{
+			std::ofstream ofs{ filePath, std::ios::out | std::ios::trunc };
+			if ( !ofs.is_open() ) { return false; }
+			// else
+
+			std::vector<Event> events;
+			CollectEvents( exportCount, &events );
+
+			std::unordered_map<std::uint32_t, std::string> names;
+			{
+				std::lock_guard<std::mutex> lock( registryMutex );
+				names = threadNames;
+			}
+
+			constexpr int processID = 0;
+			ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+			bool isFirst = true;
+			for ( const auto &it : names )
+			{
+				if ( !isFirst ) { ofs << ",\n"; }
+				isFirst = false;
+
+				ofs << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processID << ",\"tid\":" << it.first << ",\"args\":{\"name\":\"";
+				WriteEscaped( ofs, it.second );
+				ofs << "\"}}";
+			}
+
+			ofs.setf( std::ios::fixed );
+			ofs.precision( 3 );
+			for ( const auto &it : events )
+			{
+				if ( !isFirst ) { ofs << ",\n"; }
+				isFirst = false;
+
+				// The Chrome trace uses micro seconds
+				ofs << "{\"name\":\"";
+				WriteEscaped( ofs, ( it.name ) ? it.name : "(null)" );
+				ofs << "\",\"ph\":\"X\",\"ts\":"	<< scast<double>( it.beginNS ) * 0.001
+					<< ",\"dur\":"					<< scast<double>( it.endNS - it.beginNS ) * 0.001
+					<< ",\"pid\":"					<< processID
+					<< ",\"tid\":"					<< it.threadID
+					<< "}";
+			}
+
+			ofs << "\n]}\n";
+			return ofs.good();
+		}
+
+		void ResetStatistics()
+		{
+			for ( auto &it : frames ) { it.events.clear(); }
+			frameCount		= 0;
+			frameNext		= 0;
+			droppedCount	= 0;
+
+			indexByPointer.clear();
+			indexByName.clear();
+			histories.clear();
+			statistics.clear();
+		}
+
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			bool enable = IsEnabled();
+			if ( ImGui::Checkbox( "Enable recording", &enable ) )
+			{
+				SetEnable( enable );
+			}
+
+			ImGui::Text( "Frame:[%6.3f ms]", lastFrameMS );
+			ImGui::Text( "Retained frames:[%d], Dropped events:[%d]", scast<int>( frameCount ), scast<int>( droppedCount ) );
+
+			static std::string exportResult;
+			if ( ImGui::Button( "Export Chrome trace" ) )
+			{
+				constexpr const char *filePath = "ProfilerTrace.json";
+				exportResult = ( ExportChromeTrace( filePath ) )
+				? std::string{ "Exported to " } + filePath
+				: std::string{ "Failed to write " } + filePath;
+			}
+			ImGui::SameLine();
+			if ( ImGui::Button( "Reset" ) )
+			{
+				ResetStatistics();
+				exportResult.clear();
+			}
+			if ( !exportResult.empty() )
+			{
+				ImGui::Text( "%s", exportResult.c_str() );
+			}
+
+			ImGui::Text( "[Name] Calls | Last | Min | Avg | P99 (ms)" );
+			for ( const auto &it : statistics )
+			{
+				ImGui::Text
+				(
+					"[%s] %d | %6.3f | %6.3f | %6.3f | %6.3f",
+					it.name.c_str(), it.lastCallCount,
+					it.lastMS, it.minMS, it.avgMS, it.p99MS
+				);
+			}
+
+			ImGui::TreePop();
+		}
+
+		bool BenchmarkCounts::ShowControls( const char *elementCaption, const char *loopCaption, const char *buttonCaption )
+		{
+			if ( elementCaption	) { ImGui::DragInt( elementCaption,	&elementCount,	10.0f,	1, 10000000	); }
+			if ( loopCaption	) { ImGui::DragInt( loopCaption,	&loopCount,		1.0f,	1, 100000	); }
+			return ImGui::Button( ( buttonCaption ) ? buttonCaption : "Measure" );
+		}
+	#endif // USE_IMGUI
+	}
+}
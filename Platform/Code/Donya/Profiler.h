@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Constant.h"	// Use for DEBUG_MODE macro.
+#include "UseImGui.h"	// Use for USE_IMGUI macro.
+
+#ifndef FORCE_USE_PROFILER
+#define FORCE_USE_PROFILER	( false )
+#endif // FORCE_USE_PROFILER
+
+#define USE_PROFILER		( DEBUG_MODE || FORCE_USE_PROFILER )
+
+/// <summary>
+/// The scope markers, that measure the time by the std::chrono::steady_clock.
+/// Each thread writes the events into an own ring buffer without any lock,
+/// and the main thread gathers them at EndFrame(), then aggregates them per frame.
+/// It does not depend on the Windows API, so you can use it without a window.
+/// </summary>
+namespace Donya
+{
+	namespace Profiler
+	{
+		/// <summary>
+		/// The "name" must be a string literal(or a string that outlives the profiler), because only the pointer is stored.
+		/// </summary>
+		struct Event
+		{
+			const char		*name		= nullptr;
+			std::int64_t	beginNS		= 0;	// [nano second] From the profiler's epoch
+			std::int64_t	endNS		= 0;	// [nano second] From the profiler's epoch
+			std::uint32_t	threadID	= 0;	// The profiler's own ID, not the OS's one
+			std::uint32_t	depth		= 0;	// The nest level in the thread
+		};
+		/// <summary>
+		/// The statistics of the same name scopes, over the recent frames that the scope was measured.
+		/// </summary>
+		struct ScopeStatistics
+		{
+			std::string	name;
+			int			lastCallCount	= 0;	// The call count at the last measured frame
+			float		lastMS			= 0.0f;	// [milli second] The total time at the last measured frame
+			float		minMS			= 0.0f;	// [milli second]
+			float		avgMS			= 0.0f;	// [milli second]
+			float		p99MS			= 0.0f;	// [milli second] 99th percentile
+			int			sampleCount		= 0;	// The count of frames that used for the statistics
+		};
+
+		static constexpr size_t eventCapacityPerThread	= 8192;	// The old events will be overwritten if the EndFrame() is not called for a long time
+		static constexpr size_t historyFrameCount		= 240;	// The frame count that used for the statistics
+		static constexpr size_t retainFrameCount		= 300;	// The frame count that keeps the events for the exporting
+
+		/// <summary>
+		/// Returns the current time in nano seconds from the profiler's epoch.
+		/// </summary>
+		std::int64_t Now();
+
+		/// <summary>
+		/// Enable or disable the recording. It is enabled by default.
+		/// </summary>
+		void SetEnable( bool enable );
+		bool IsEnabled();
+
+		/// <summary>
+		/// Names the calling thread. It is shown in the exported trace.
+		/// It does not acquire the buffer of the thread, and does nothing if the USE_PROFILER is false.
+		/// </summary>
+		void SetThreadName( const std::string &threadName );
+
+		/// <summary>
+		/// Records an event into the ring buffer of the calling thread. Usually the Scope calls it.
+		/// </summary>
+		void Record( const char *name, std::int64_t beginNS, std::int64_t endNS );
+
+		/// <summary>
+		/// RAII scope marker. Please use the PROFILE_SCOPE macro instead of using it directly.
+		/// </summary>
+		class Scope
+		{
+		private:
+			const char		*name		= nullptr;
+			std::int64_t	beginNS		= 0;
+		public:
+			explicit Scope( const char *name );
+			~Scope();
+			Scope( const Scope & )				= delete;
+			Scope( Scope && )					= delete;
+			Scope &operator = ( const Scope & )	= delete;
+			Scope &operator = ( Scope && )		= delete;
+		};
+
+		/// <summary>
+		/// Gathers the events of all threads and updates the statistics.
+		/// Please call it once at the end of a frame, on the main thread.
+		/// </summary>
+		void EndFrame();
+
+		/// <summary>
+		/// Returns the time between the last two EndFrame() calls in milli seconds.
+		/// </summary>
+		float GetLastFrameMS();
+		/// <summary>
+		/// Returns the count of the events that were overwritten before the gathering.
+		/// </summary>
+		size_t GetDroppedEventCount();
+		/// <summary>
+		/// The statistics are sorted by the first measured order.
+		/// </summary>
+		const std::vector<ScopeStatistics> &GetStatistics();
+		/// <summary>
+		/// Returns the count of the frames that have the events.
+		/// </summary>
+		size_t GetRetainedFrameCount();
+		/// <summary>
+		/// Appends the events of the last "frameCount" frames to the "pOutput", from the old one.
+		/// </summary>
+		void CollectEvents( size_t frameCount, std::vector<Event> *pOutput );
+
+		/// <summary>
+		/// Writes the events of the last "frameCount" frames as the Chrome trace JSON(chrome://tracing, Perfetto).
+		/// Returns false if the file could not open.
+		/// </summary>
+		bool ExportChromeTrace( const std::string &filePath, size_t frameCount = retainFrameCount );
+
+		/// <summary>
+		/// Removes the all gathered events and statistics. The events that are not gathered yet are kept.
+		/// </summary>
+		void ResetStatistics();
+
+		/// <summary>
+		/// Calls the "process( loopIndex )" the "loopCount" times, then returns the average seconds of a call.
+		/// It uses the Now(), so it also works if the USE_PROFILER is false. Returns 0.0f if the "loopCount" is not positive.
+		/// </summary>
+		template<typename Process>
+		float MeasureAverageSeconds( int loopCount, Process &&process )
+		{
+			if ( loopCount <= 0 ) { return 0.0f; }
+			// else
+
+			const std::int64_t beginNS = Now();
+			for ( int i = 0; i < loopCount; ++i )
+			{
+				process( i );
+			}
+			const std::int64_t elapsedNS = Now() - beginNS;
+
+			return scast<float>( scast<double>( elapsedNS ) * 0.000000001 / scast<double>( loopCount ) );
+		}
+
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption );
+
+		/// <summary>
+		/// The counts of a benchmark that is started by a button in an ImGui node. Please define it as a static object.
+		/// </summary>
+		struct BenchmarkCounts
+		{
+			int elementCount	= 10000;	// The size of the measured data(e.g. the count of particles)
+			int loopCount		= 60;		// The repeat count for the average(e.g. the count of frames)
+		public:
+			/// <summary>
+			/// Shows the drags of the counts and the button. The drag of a count is not shown if its caption is nullptr.
+			/// Returns true if the button was pressed.
+			/// </summary>
+			bool ShowControls( const char *elementCaption, const char *loopCaption, const char *buttonCaption );
+		};
+	#endif // USE_IMGUI
+	}
+}
+
+#define DONYA_PROFILER_CONCAT_IMPL( a, b )	a##b
+#define DONYA_PROFILER_CONCAT( a, b )		DONYA_PROFILER_CONCAT_IMPL( a, b )
+
+#if USE_PROFILER
+/// <summary>
+/// Measures the time until the end of the current scope. The "name" must be a string literal.
+/// </summary>
+#define PROFILE_SCOPE( name )	Donya::Profiler::Scope DONYA_PROFILER_CONCAT( profilerScope_, __LINE__ ){ name }
+#else
+#define PROFILE_SCOPE( name )	( ( void )0 )
+#endif // USE_PROFILER
@@ -1,5 +1,6 @@
 #include "Resource.h"
 
+#include <algorithm>
 #include <D3D11.h>
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
@@ -11,13 +12,19 @@
 #include <DDSTextureLoader.h>
 #include <WICTextureLoader.h>
 
+#include "AssetRegistry.h"
 #include "Constant.h"
 #include "Donya.h"		// Use for GetDevice().
+#include "ObjParser.h"
+#include "Profiler.h"	// Use MeasureAverageSeconds() for CompareObjLoaders().
 #include "Useful.h"
 
 // This resolve un external symbol.
 #pragma comment( lib, "d3dcompiler.lib" )
 
+#undef max
+#undef min
+
 using namespace DirectX;
 using namespace Microsoft::WRL;
 
@@ -526,7 +533,81 @@ namespace Donya
 			{}
 		};
 
-		static std::unordered_map<std::wstring, SpriteCacheContents> spriteCache{};
+		/// <summary>
+		/// The callers receive the raw pointer with AddRef(), so the shared_ptr of the contents is not shared.
+		/// </summary>
+		static bool IsSpriteReferencedByOthers( const SpriteCacheContents &contents )
+		{
+			if ( !contents.d3dShaderResourceView ) { return false; }
+			// else
+
+			// Release() returns the new reference count, and the cache has one of them.
+			contents.d3dShaderResourceView->AddRef();
+			return ( 1 < contents.d3dShaderResourceView->Release() );
+		}
+		static size_t CalcBitsPerPixel( DXGI_FORMAT format )
+		{
+			switch ( format )
+			{
+			case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+			case DXGI_FORMAT_R32G32B32A32_FLOAT:
+				return 128;
+			case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+			case DXGI_FORMAT_R16G16B16A16_FLOAT:
+			case DXGI_FORMAT_R16G16B16A16_UNORM:
+				return 64;
+			case DXGI_FORMAT_R8_UNORM:
+			case DXGI_FORMAT_A8_UNORM:
+			case DXGI_FORMAT_BC2_UNORM:
+			case DXGI_FORMAT_BC2_UNORM_SRGB:
+			case DXGI_FORMAT_BC3_UNORM:
+			case DXGI_FORMAT_BC3_UNORM_SRGB:
+			case DXGI_FORMAT_BC5_UNORM:
+			case DXGI_FORMAT_BC6H_UF16:
+			case DXGI_FORMAT_BC7_UNORM:
+			case DXGI_FORMAT_BC7_UNORM_SRGB:
+				return 8;
+			case DXGI_FORMAT_BC1_UNORM:
+			case DXGI_FORMAT_BC1_UNORM_SRGB:
+			case DXGI_FORMAT_BC4_UNORM:
+				return 4;
+			default: break;
+			}
+			// The WIC loader makes 32 bits formats mostly
+			return 32;
+		}
+		/// <summary>
+		/// Returns an estimate of the video memory. It is used for the budget of the registry.
+		/// </summary>
+		static size_t CalcTextureBytes( const D3D11_TEXTURE2D_DESC &desc )
+		{
+			const size_t bitsPerPixel = CalcBitsPerPixel( desc.Format );
+
+			size_t sum		= 0;
+			UINT   width	= desc.Width;
+			UINT   height	= desc.Height;
+			const UINT mipLevels = std::max( 1U, desc.MipLevels );
+			for ( UINT i = 0; i < mipLevels; ++i )
+			{
+				sum += ( scast<size_t>( width ) * height * bitsPerPixel ) / 8;
+				width	= std::max( 1U, width  >> 1 );
+				height	= std::max( 1U, height >> 1 );
+			}
+			return sum * std::max( 1U, desc.ArraySize );
+		}
+		static D3D11_TEXTURE2D_DESC FetchTexture2DDesc( ID3D11Resource *pResource )
+		{
+			D3D11_TEXTURE2D_DESC desc{};
+			if ( !pResource ) { return desc; }
+			// else
+
+			Microsoft::WRL::ComPtr<ID3D11Texture2D> d3dTexture2D;
+			const HRESULT hr = pResource->QueryInterface<ID3D11Texture2D>( d3dTexture2D.GetAddressOf() );
+			if ( SUCCEEDED( hr ) ) { d3dTexture2D->GetDesc( &desc ); }
+			return desc;
+		}
+
+		static Donya::Asset::Cache<SpriteCacheContents> spriteCache{ Donya::Asset::Type::Texture, IsSpriteReferencedByOthers };
 
 		// HACK: CreateTextureFromFile is just a copy of CreateTexture2DFromFile
 		bool CreateTextureFromFile( ID3D11Device *d3dDevice, const std::wstring &filename, ID3D11ShaderResourceView **d3dShaderResourceView, bool isEnableCache )
@@ -536,10 +617,10 @@ namespace Donya
 			if ( !Donya::IsExistFile( filename ) ) { return false; }
 			// else
 
-			auto it =  spriteCache.find( filename );
-			if ( it != spriteCache.end() )
+			const auto pCached = spriteCache.Acquire( filename );
+			if ( pCached )
 			{
-				*d3dShaderResourceView = it->second.d3dShaderResourceView.Get();
+				*d3dShaderResourceView = pCached->d3dShaderResourceView.Get();
 				( *d3dShaderResourceView )->AddRef();
 
 				return true;
@@ -569,13 +650,11 @@ namespace Donya
 
 			if ( isEnableCache )
 			{
-				spriteCache.insert
+				spriteCache.Store
 				(
-					std::make_pair
-					(
-						filename,
-						SpriteCacheContents{ *d3dShaderResourceView }
-					)
+					filename,
+					std::make_shared<SpriteCacheContents>( *d3dShaderResourceView ),
+					CalcTextureBytes( FetchTexture2DDesc( d3dResource.Get() ) )
 				);
 			}
 
@@ -589,15 +668,15 @@ namespace Donya
 			if ( !Donya::IsExistFile( filename ) ) { return false; }
 			// else
 
-			auto it =  spriteCache.find( filename );
-			if ( it != spriteCache.end() )
+			const auto pCached = spriteCache.Acquire( filename );
+			if ( pCached )
 			{
-				*d3dShaderResourceView = it->second.d3dShaderResourceView.Get();
+				*d3dShaderResourceView = pCached->d3dShaderResourceView.Get();
 				( *d3dShaderResourceView )->AddRef();
 
-				if ( it->second.d3dTexture2DDesc )
+				if ( pCached->d3dTexture2DDesc )
 				{
-					*d3dTexture2DDesc = *it->second.d3dTexture2DDesc;
+					*d3dTexture2DDesc = *pCached->d3dTexture2DDesc;
 				}
 
 				return true;
@@ -655,17 +734,11 @@ namespace Donya
 
 			if ( isEnableCache )
 			{
-				spriteCache.insert
+				spriteCache.Store
 				(
-					std::make_pair
-					(
-						filename,
-						SpriteCacheContents
-						{
-							*d3dShaderResourceView,
-							d3dTexture2DDesc
-						}
-					)
+					filename,
+					std::make_shared<SpriteCacheContents>( *d3dShaderResourceView, d3dTexture2DDesc ),
+					CalcTextureBytes( *d3dTexture2DDesc )
 				);
 			}
 
@@ -699,12 +772,12 @@ namespace Donya
 			std::wstring dummyFileName = L"SYSTEM_Unicolor:";
 			dummyFileName += L"[RGBA:"		+ std::to_wstring( RGBA			) + L"]";
 			dummyFileName += L"[DIMENSION:"	+ std::to_wstring( dimensions	) + L"]";
-			auto it =  spriteCache.find( dummyFileName );
-			if ( it != spriteCache.end() )
+			const auto pCached = spriteCache.Acquire( dummyFileName );
+			if ( pCached )
 			{
-				if ( it->second.d3dTexture2DDesc )
-				{ *pOutTexDesc	= *it->second.d3dTexture2DDesc; }
-				*pOutSRV		= it->second.d3dShaderResourceView.Get();
+				if ( pCached->d3dTexture2DDesc )
+				{ *pOutTexDesc	= *pCached->d3dTexture2DDesc; }
+				*pOutSRV		= pCached->d3dShaderResourceView.Get();
 				( *pOutSRV )->AddRef();
 
 				return;
@@ -750,24 +823,18 @@ namespace Donya
 
 			if ( isEnableCache )
 			{
-				spriteCache.insert
+				spriteCache.Store
 				(
-					std::make_pair
-					(
-						dummyFileName,
-						SpriteCacheContents
-						{
-							*pOutSRV,
-							pOutTexDesc
-						}
-					)
+					dummyFileName,
+					std::make_shared<SpriteCacheContents>( *pOutSRV, pOutTexDesc ),
+					CalcTextureBytes( *pOutTexDesc )
 				);
 			}
 		}
 
 		void ReleaseAllTexture2DCaches()
 		{
-			spriteCache.clear();
+			spriteCache.Clear();
 		}
 
 		#pragma endregion
@@ -859,9 +926,20 @@ namespace Donya
 				std::vector<size_t>().swap( indices );
 				std::vector<Material>().swap( materials );
 			}
+		public:
+			size_t CalcBytes() const
+			{
+				return
+					sizeof( DirectX::XMFLOAT3	) * vertices.size()		+
+					sizeof( DirectX::XMFLOAT3	) * normals.size()		+
+					sizeof( DirectX::XMFLOAT2	) * texCoords.size()	+
+					sizeof( size_t				) * indices.size()		+
+					sizeof( Material			) * materials.size()	;
+			}
 		};
 
-		static std::unordered_map<std::wstring, ObjFileCacheContents> objFileCache;
+		// The contents are copied to the callers, so they are always evictable.
+		static Donya::Asset::Cache<ObjFileCacheContents> objFileCache{ Donya::Asset::Type::ObjFile };
 
 		/// <summary>
 		/// It is storage of materials by mtl-file.
@@ -1096,14 +1174,14 @@ namespace Donya
 
 			// check objFileName already has cached ?
 			{
-				decltype( objFileCache )::iterator it = objFileCache.find( objFileName );
-				if ( it != objFileCache.end() )
+				const auto pCached = objFileCache.Acquire( objFileName );
+				if ( pCached )
 				{
-					if ( pVertices  ) { *pVertices  = it->second.vertices;  }
-					if ( pNormals   ) { *pNormals   = it->second.normals;   }
-					if ( pTexCoords ) { *pNormals   = it->second.normals;   }
-					if ( pIndices   ) { *pIndices   = it->second.indices;   }
-					if ( pMaterials ) { *pMaterials = it->second.materials; }
+					if ( pVertices  ) { *pVertices  = pCached->vertices;  }
+					if ( pNormals   ) { *pNormals   = pCached->normals;   }
+					if ( pTexCoords ) { *pNormals   = pCached->normals;   }
+					if ( pIndices   ) { *pIndices   = pCached->indices;   }
+					if ( pMaterials ) { *pMaterials = pCached->materials; }
 
 					return true;
 				}
@@ -1371,22 +1449,181 @@ namespace Donya
 
 			if ( isEnableCache )
 			{
-				objFileCache.insert
-				(
-					std::make_pair
-					(
-						objFileName,
-						ObjFileCacheContents{ pVertices, pNormals, pTexCoords, pIndices, pMaterials }
-					)
-				);
+				auto pContents = std::make_shared<ObjFileCacheContents>( pVertices, pNormals, pTexCoords, pIndices, pMaterials );
+				const size_t contentsBytes = pContents->CalcBytes();
+				objFileCache.Store( objFileName, pContents, contentsBytes );
 			}
 
 			return true;
 		}
 
+		static Donya::Asset::Cache<const ObjMesh> objMeshCache{ Donya::Asset::Type::ObjMesh };
+
+		static D3D11_SAMPLER_DESC MakeDiffuseMapSamplerDesc()
+		{
+			D3D11_SAMPLER_DESC samplerDesc{};
+			samplerDesc.Filter			= D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+			samplerDesc.AddressU		= D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerDesc.AddressV		= D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerDesc.AddressW		= D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerDesc.ComparisonFunc	= D3D11_COMPARISON_NEVER;
+			samplerDesc.MinLOD			= 0;
+			samplerDesc.MaxLOD			= D3D11_FLOAT32_MAX;
+			return samplerDesc;
+		}
+		static Material ToMaterial( ID3D11Device *pDevice, const Obj::MaterialDesc &source, const std::wstring &mapDirectory )
+		{
+			Material material{};
+			material.illuminate	= source.illuminate;
+			material.shininess	= source.shininess;
+			for ( int i = 0; i < 3; ++i )
+			{
+				material.ambient[i]		= source.ambient[i];
+				material.diffuse[i]		= source.diffuse[i];
+				material.specular[i]	= source.specular[i];
+			}
+
+			if ( !source.diffuseMapName.empty() )
+			{
+				material.diffuseMap.mapName = mapDirectory + Donya::MultiToWide( source.diffuseMapName );
+				material.CreateDiffuseMap( pDevice, MakeDiffuseMapSamplerDesc() );
+			}
+
+			return material;
+		}
+
+		std::shared_ptr<const ObjMesh> LoadObjMesh( ID3D11Device *pDevice, const std::wstring &objFileName, bool allow16BitIndices, bool isEnableCache )
+		{
+			if ( isEnableCache )
+			{
+				const auto pCached = objMeshCache.Acquire( objFileName );
+				if ( pCached ) { return pCached; }
+			}
+			// else
+
+			Obj::Mesh parsed{};
+			if ( !Obj::ParseObjFile( objFileName, &parsed, allow16BitIndices ) )
+			{
+				_ASSERT_EXPR( 0, L"Failed : load obj flie." );
+				return nullptr;
+			}
+			// else
+
+			const std::wstring directory = Donya::ExtractFileDirectoryFromFullPath( objFileName );
+
+			std::vector<Obj::MaterialDesc> materialDescs;
+			if ( !parsed.mtllibName.empty() )
+			{
+				if ( !Obj::ParseMtlFile( directory + Donya::MultiToWide( parsed.mtllibName ), &materialDescs ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : load mtl flie." );
+				}
+			}
+
+			// Create the textures once per material, and the subsets share them.
+			std::unordered_map<std::string, Material> materialsByName;
+			for ( const auto &it : materialDescs )
+			{
+				materialsByName.insert( std::make_pair( it.name, ToMaterial( pDevice, it, directory ) ) );
+			}
+
+			auto pMesh = std::make_shared<ObjMesh>();
+			pMesh->positions	= std::move( parsed.positions	);
+			pMesh->normals		= std::move( parsed.normals		);
+			pMesh->texCoords	= std::move( parsed.texCoords	);
+			pMesh->indices16	= std::move( parsed.indices16	);
+			pMesh->indices32	= std::move( parsed.indices32	);
+			pMesh->materials.reserve( parsed.subsets.size() );
+			for ( const auto &subset : parsed.subsets )
+			{
+				const auto found = materialsByName.find( subset.materialName );
+				Material material = ( found != materialsByName.end() ) ? found->second : Material{};
+				material.indexStart = subset.indexStart;
+				material.indexCount = subset.indexCount;
+				pMesh->materials.emplace_back( std::move( material ) );
+			}
+
+			if ( isEnableCache )
+			{
+				const size_t meshBytes =
+					sizeof( DirectX::XMFLOAT3	) * ( pMesh->positions.size() + pMesh->normals.size() ) +
+					sizeof( DirectX::XMFLOAT2	) * pMesh->texCoords.size()	+
+					sizeof( std::uint16_t		) * pMesh->indices16.size()	+
+					sizeof( std::uint32_t		) * pMesh->indices32.size()	+
+					sizeof( Material			) * pMesh->materials.size()	;
+				objMeshCache.Store( objFileName, pMesh, meshBytes );
+			}
+
+			return pMesh;
+		}
+
 		void ReleaseAllObjFileCaches()
 		{
-			objFileCache.clear();
+			objFileCache.Clear();
+			objMeshCache.Clear();
+		}
+
+		float ObjLoaderComparison::CalcLegacyMBPerSecond() const
+		{
+			return ( IsZero( legacySeconds ) ) ? 0.0f : scast<float>( fileBytes ) / legacySeconds * 0.000001f;
+		}
+		float ObjLoaderComparison::CalcFastMBPerSecond() const
+		{
+			return ( IsZero( fastSeconds ) ) ? 0.0f : scast<float>( fileBytes ) / fastSeconds * 0.000001f;
+		}
+		ObjLoaderComparison CompareObjLoaders( ID3D11Device *pDevice, const std::wstring &objFileName, int loopCount )
+		{
+			ObjLoaderComparison result{};
+			if ( loopCount <= 0 || !Donya::IsExistFile( objFileName ) ) { return result; }
+			// else
+
+			{
+				std::unique_ptr<char[]> buffer{};
+				const long byteLength = Donya::ReadByteCode( &buffer, objFileName );
+				result.fileBytes = scast<size_t>( std::max( 0L, byteLength ) );
+			}
+
+			bool succeeded = true;
+
+			std::vector<DirectX::XMFLOAT3>	vertices;
+			std::vector<DirectX::XMFLOAT3>	normals;
+			std::vector<DirectX::XMFLOAT2>	texCoords;
+			std::vector<size_t>				indices;
+			std::vector<Material>			materials;
+			result.legacySeconds = Donya::Profiler::MeasureAverageSeconds
+			(
+				loopCount,
+				[&]( int )
+				{
+					vertices.clear();
+					normals.clear();
+					texCoords.clear();
+					indices.clear();
+					materials.clear();
+					succeeded = LoadObjFile( pDevice, objFileName, &vertices, &normals, &texCoords, &indices, &materials, nullptr, /* isEnableCache = */ false ) && succeeded;
+				}
+			);
+			result.legacyVertexCount	= vertices.size();
+
+			std::shared_ptr<const ObjMesh> pMesh{};
+			result.fastSeconds = Donya::Profiler::MeasureAverageSeconds
+			(
+				loopCount,
+				[&]( int )
+				{
+					pMesh = LoadObjMesh( pDevice, objFileName, /* allow16BitIndices = */ true, /* isEnableCache = */ false );
+					succeeded = ( pMesh != nullptr ) && succeeded;
+				}
+			);
+			if ( pMesh )
+			{
+				result.fastVertexCount		= pMesh->positions.size();
+				result.fastIndexCount		= pMesh->GetIndexCount();
+				result.fastUses16BitIndex	= pMesh->Uses16BitIndices();
+			}
+
+			result.succeeded = succeeded;
+			return result;
 		}
 
 		#pragma endregion
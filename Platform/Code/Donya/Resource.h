@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <D3D11.h>
@@ -157,6 +159,9 @@ namespace Donya
 			float A = 1.0f
 		);
 
+		/// <summary>
+		/// The textures are cached by Donya::Asset, so the unreferenced ones are evicted when the budget is exceeded.
+		/// </summary>
 		void ReleaseAllTexture2DCaches();
 
 		#pragma endregion
@@ -248,8 +253,60 @@ namespace Donya
 			bool isEnableCache = true
 		);
 
+		/// <summary>
+		/// The indexed mesh of obj-file. The vertices are unique by the (position, texCoord, normal) triple, and the faces are triangulated.<para></para>
+		/// Only one of "indices16" or "indices32" is used. A material is made per "usemtl", and its indexStart and indexCount are the range of the indices.
+		/// </summary>
+		struct ObjMesh
+		{
+			std::vector<DirectX::XMFLOAT3>	positions;
+			std::vector<DirectX::XMFLOAT3>	normals;	// Same size as the positions
+			std::vector<DirectX::XMFLOAT2>	texCoords;	// Same size as the positions
+			std::vector<std::uint16_t>		indices16;
+			std::vector<std::uint32_t>		indices32;
+			std::vector<Material>			materials;
+		public:
+			bool	Uses16BitIndices()	const { return !indices16.empty(); }
+			size_t	GetIndexCount()		const { return ( Uses16BitIndices() ) ? indices16.size() : indices32.size(); }
+		};
+
+		/// <summary>
+		/// Loads the obj-file and its mtl-file by the one-pass parser of Donya::Resource::Obj.<para></para>
+		/// If "allow16BitIndices" is true and the vertex count fits, the indices are stored as 16-bit.<para></para>
+		/// The cached mesh is shared without copying. Returns nullptr if failed.
+		/// </summary>
+		std::shared_ptr<const ObjMesh> LoadObjMesh
+		(
+			ID3D11Device		*pDevice,
+			const std::wstring	&objFileName,
+			bool allow16BitIndices	= true,
+			bool isEnableCache		= true
+		);
+
 		void ReleaseAllObjFileCaches();
 
+		/// <summary>
+		/// The result of CompareObjLoaders(). The seconds are the average of a load.
+		/// </summary>
+		struct ObjLoaderComparison
+		{
+			bool	succeeded			= false;
+			size_t	fileBytes			= 0;
+			float	legacySeconds		= 0.0f;	// LoadObjFile()
+			float	fastSeconds			= 0.0f;	// LoadObjMesh()
+			size_t	legacyVertexCount	= 0;
+			size_t	fastVertexCount		= 0;
+			size_t	fastIndexCount		= 0;
+			bool	fastUses16BitIndex	= false;
+		public:
+			float	CalcLegacyMBPerSecond()	const;
+			float	CalcFastMBPerSecond()	const;
+		};
+		/// <summary>
+		/// Loads the same obj-file by LoadObjFile() and LoadObjMesh() "loopCount" times each, without the cache.
+		/// </summary>
+		ObjLoaderComparison CompareObjLoaders( ID3D11Device *pDevice, const std::wstring &objFileName, int loopCount );
+
 		#pragma endregion
 
 		/// <summary>
@@ -12,6 +12,8 @@
 #include "cereal/archives/binary.hpp"
 #include "cereal/archives/json.hpp"
 
+#include "AsyncIO.h"
+
 namespace Donya
 {
 	class Serializer
@@ -39,6 +41,17 @@ namespace Donya
 		template<class InputArchiveType, class SerializeObject>
 		bool LoadImpl( int fileOpenMode, const char *filePath, const char *objectName, SerializeObject &instance ) const
 		{
+			// Use the prefetched file if exists
+			const AsyncIO::Buffer pResident = AsyncIO::Fetch( filePath );
+			if ( pResident )
+			{
+				std::stringstream ss{ std::string{ pResident->data(), pResident->size() } };
+				InputArchiveType archive( ss );
+				archive( cereal::make_nvp( objectName, instance ) );
+				return true;
+			}
+			// else
+
 			std::ifstream ifs( filePath, fileOpenMode );
 			if ( !ifs.is_open() ) { return false; }
 			// else
@@ -75,6 +88,9 @@ namespace Donya
 			ofs.close();
 			ss.clear();
 
+			// The prefetched buffer is old now
+			AsyncIO::Release( filePath );
+
 			return true;
 		}
 	public:
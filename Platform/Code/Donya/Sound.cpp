@@ -1,11 +1,14 @@
 #include "Sound.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "fmod.hpp"
 
+#include "AudioOffline.h"
 #include "AudioSystem.h"
 #include "Constant.h"		// Use for DEBUG_MODE.
 
@@ -20,12 +23,28 @@ namespace Donya
 		typedef std::unordered_map<int, size_t> SoundHandleMap;
 
 		// Instances does not create until use.
-		static std::unique_ptr<AudioSystem>		pAudio{ nullptr };
+		static std::unique_ptr<IAudioBackend>	pAudio{ nullptr };
 		static std::unique_ptr<SoundHandleMap>	pSoundHandles{ nullptr };
+		// The loading scene calls the Load() from a worker thread, so the accesses to "pAudio" and "pSoundHandles" are guarded by this.
+		// The Init() and the Uninit() are not guarded, please call them while no worker uses the sounds.
+		static std::mutex						tableMutex;
 
-		void Init()
+		static PlayQueue						playQueue;
+		static std::vector<PlayQueue::Play>		flushedPlays;	// Workspace of Update()
+
+		void Init( Backend backend )
 		{
-			pAudio			= std::make_unique<AudioSystem>();
+			Uninit();
+
+			switch ( backend )
+			{
+			case Backend::FMOD:		pAudio = std::make_unique<AudioSystem>();			break;
+			case Backend::Offline:	pAudio = std::make_unique<OfflineAudioBackend>();	break;
+			default:
+				_ASSERT_EXPR( 0, L"Error: Unexpected audio backend!" );
+				pAudio = std::make_unique<AudioSystem>();
+				break;
+			}
 			pSoundHandles	= std::make_unique<SoundHandleMap>();
 		}
 		void Uninit()
@@ -33,9 +52,11 @@ namespace Donya
 			if ( !pAudio ) { return; }	// Already Uninitialized.
 			// else
 
+			playQueue.Clear();
+
 			pAudio->ReleaseAll();
 
-			pAudio.reset( nullptr ); // Doing release of sounds by AudioSystem::destructor.
+			pAudio.reset( nullptr ); // Doing release of sounds by the destructor of the backend.
 			pSoundHandles.reset( nullptr );
 		}
 
@@ -44,6 +65,9 @@ namespace Donya
 			if ( pAudio == nullptr ) { Init(); }
 		}
 
+		/// <summary>
+		/// Please lock the "tableMutex" before calling this.
+		/// </summary>
 		size_t GetHandleOrNull( int id )
 		{
 			// HACK:"pSoundHandles" may be null.
@@ -58,16 +82,35 @@ namespace Donya
 		{
 			InitIfNullptr();
 
+			// The Load() of a worker holds the lock while decoding a file.
+			// I skip this frame instead of waiting it, the play requests are kept until next Update().
+			std::unique_lock<std::mutex> lock( tableMutex, std::try_to_lock );
+			if ( !lock.owns_lock() ) { return; }
+			// else
+
+			flushedPlays.clear();
+			playQueue.Flush( &flushedPlays );
+			for ( const auto &it : flushedPlays )
+			{
+				const size_t handle = GetHandleOrNull( it.soundIdentifier );
+				if ( handle == NULL ) { continue; }
+				// else
+
+				pAudio->Play( handle, it.volume );
+			}
+
 			pAudio->Update();
 		}
 
-		bool Load( int id, std::string fileName, bool isEnableLoop )
+		bool Load( int id, std::string fileName, bool isEnableLoop, bool isStream, int maxVoiceCount, IAudioBackend::VoiceSteal steal )
 		{
+			std::lock_guard<std::mutex> lock( tableMutex );
+
 			size_t handle = GetHandleOrNull( id );
 			if ( handle != NULL ) { return true; }	// already loaded.
 			// else
 
-			handle = pAudio->Load( fileName.c_str(), isEnableLoop );
+			handle = pAudio->Load( fileName.c_str(), isEnableLoop, isStream, maxVoiceCount, steal );
 
 			if ( handle == NULL )
 			{
@@ -91,11 +134,23 @@ namespace Donya
 			return true;
 		}
 
+		bool SetVoiceLimit( int id, int maxVoiceCount, IAudioBackend::VoiceSteal steal )
+		{
+			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
+
+			size_t handle = GetHandleOrNull( id );
+			if ( handle == NULL ) { return false; }
+			// else
+			return pAudio->SetVoiceLimit( handle, maxVoiceCount, steal );
+		}
+
 		bool Play( int id )
 		{
 			// TODO:I want user can specify play mode(ex:loop).
 
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -103,9 +158,35 @@ namespace Donya
 			return pAudio->Play( handle );
 		}
 
+		bool RequestPlay( int id, float volume )
+		{
+			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
+
+			size_t handle = GetHandleOrNull( id );
+			if ( handle == NULL ) { return false; }
+			// else
+
+			playQueue.Push( id, volume );
+			return true;
+		}
+		void SetCoalesceConfig( const PlayQueue::Config &config )
+		{
+			playQueue.SetConfig( config );
+		}
+		PlayQueue::Statistics GetCoalesceStatistics()
+		{
+			return playQueue.GetStatistics();
+		}
+		void ResetCoalesceStatistics()
+		{
+			playQueue.ResetStatistics();
+		}
+
 		bool Pause( int id, bool isEnableForAll )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -116,6 +197,7 @@ namespace Donya
 		bool Resume( int id, bool isEnableForAll, bool fromTheBeginning )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -126,6 +208,7 @@ namespace Donya
 		bool Stop( int id, bool isEnableForAll )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -136,6 +219,7 @@ namespace Donya
 		bool SetVolume( int id, float volume, bool isEnableForAll )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -146,6 +230,7 @@ namespace Donya
 		bool AppendFadePoint( int id, float sec, float destVol, bool isEnableForAll )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -159,6 +244,7 @@ namespace Donya
 		int  GetNowPlayingSoundCount( int id )
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			size_t handle = GetHandleOrNull( id );
 			if ( handle == NULL ) { return false; }
@@ -169,8 +255,24 @@ namespace Donya
 		int  GetNowPlayingChannelCount()
 		{
 			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
 
 			return pAudio->GetNowPlayingChannelCount();
 		}
+
+		IAudioBackend::MemoryReport GetMemoryReport()
+		{
+			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
+
+			return pAudio->GetMemoryReport();
+		}
+		IAudioBackend::Statistics GetStatistics()
+		{
+			InitIfNullptr();
+			std::lock_guard<std::mutex> lock( tableMutex );
+
+			return pAudio->GetStatistics();
+		}
 	}
 }
\ No newline at end of file
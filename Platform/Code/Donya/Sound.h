@@ -3,34 +3,54 @@
 
 #include <string>
 
+#include "AudioBackend.h"	// Use IAudioBackend::VoiceSteal
+#include "SoundQueue.h"
+
 namespace Donya
 {
 	/// <summary>
 	/// This namespace is facade-pattern.<para></para>
-	/// For users to use AudioSystem from anywhere.
+	/// For users to use the audio backend from anywhere.
 	/// </summary>
 	namespace Sound
 	{
+		enum class Backend
+		{
+			FMOD,		// Donya::AudioSystem, plays by the audio device
+			Offline,	// Donya::OfflineAudioBackend, simulates without the audio device nor FMOD
+		};
+
 		/// <summary>
-		/// Doing initialize and load sounds.
+		/// Doing initialize and load sounds.<para></para>
+		/// If already initialized, the current backend is released and replaced.
 		/// </summary>
-		void Init();
+		void Init( Backend backend = Backend::FMOD );
 		/// <summary>
 		/// Doing release sounds and uninitialize.
 		/// </summary>
 		void Uninit();
 
 		/// <summary>
-		/// Please call every frame.
+		/// Please call every frame.<para></para>
+		/// If a worker thread is loading a sound, this frame is skipped and the play requests are kept.
 		/// </summary>
 		void Update();
 
 		/// <summary>
 		/// The soundIdentifier is became identifier of the sound of another sound function.<para></para>
 		/// Please set relative-path or whole-path to fileName.<para></para>
-		/// If load successed or already loaded, returns true.
+		/// If load successed or already loaded, returns true.<para></para>
+		/// If "isStream" is true, the sound is decoded while playing, and the file is opened at the first play. Please use it for long BGM.<para></para>
+		/// The sound can be played simultaneously up to "maxVoiceCount", the over is handled by "steal". The stream can be played by one voice only.<para></para>
+		/// It can be called from a worker thread. Please call the Init() before that.
+		/// </summary>
+		bool Load( int soundIdentifier, std::string fileName, bool isEnableLoop, bool isStream = false, int maxVoiceCount = IAudioBackend::defaultMaxVoiceCount, IAudioBackend::VoiceSteal steal = IAudioBackend::VoiceSteal::Oldest );
+
+		/// <summary>
+		/// Changes the max voice count of the sound.<para></para>
+		/// If the identifier is incorrect, returns false.
 		/// </summary>
-		bool Load( int soundIdentifier, std::string fileName, bool isEnableLoop );
+		bool SetVoiceLimit( int soundIdentifier, int maxVoiceCount, IAudioBackend::VoiceSteal steal = IAudioBackend::VoiceSteal::Oldest );
 
 		/// <summary>
 		/// If failed play sound, or the identifier is incorrect, returns false.
@@ -38,6 +58,22 @@ namespace Donya
 		bool Play( int soundIdentifier );
 		// TODO:I want user can specify play mode(ex:loop).
 
+		/// <summary>
+		/// Registers a play request. The requests are played at next Update(), and the duplicates of same identifier are merged into one play.<para></para>
+		/// The volume of merged play is scaled by the request count. Please use this for the sounds that may be played many times in a frame.<para></para>
+		/// If the identifier is incorrect, returns false.
+		/// </summary>
+		bool RequestPlay( int soundIdentifier, float volume = 1.0f );
+		/// <summary>
+		/// Sets the window and the volume scaling of the merging by RequestPlay().
+		/// </summary>
+		void SetCoalesceConfig( const PlayQueue::Config &config );
+		/// <summary>
+		/// Returns the counts of RequestPlay(). The "mergedCount" is the count of requests that did not play by merging.
+		/// </summary>
+		PlayQueue::Statistics GetCoalesceStatistics();
+		void ResetCoalesceStatistics();
+
 		/// <summary>
 		/// If you want apply for all, set true to "isEnableForAll".<para></para>
 		/// If failed pause sound, or the identifier is incorrect, returns false.
@@ -80,6 +116,15 @@ namespace Donya
 		/// If failed count, returns -1.
 		/// </summary>
 		int  GetNowPlayingChannelCount();
+
+		/// <summary>
+		/// Returns the memory usage of FMOD and the count of loaded sounds.
+		/// </summary>
+		IAudioBackend::MemoryReport GetMemoryReport();
+		/// <summary>
+		/// Returns the voice counts and the update time of the backend.
+		/// </summary>
+		IAudioBackend::Statistics GetStatistics();
 	}
 }
 
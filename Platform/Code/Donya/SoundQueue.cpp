@@ -0,0 +1,72 @@
+#include "SoundQueue.h"
+
+#include <algorithm>
+
+#include "Constant.h"	// Use scast macro
+
+namespace Donya
+{
+	namespace Sound
+	{
+		void PlayQueue::Push( int id, float volume )
+		{
+			statistics.requestedCount++;
+
+			Entry &entry = entries[id];
+			if ( entry.pendingCount <= 0 )
+			{
+				entry.pendingCount	= 0;
+				entry.baseVolume	= volume;
+				pendingIdentifiers.emplace_back( id );
+			}
+
+			entry.pendingCount++;
+			entry.baseVolume = std::max( entry.baseVolume, volume );
+		}
+		void PlayQueue::Flush( std::vector<Play> *pDest )
+		{
+			const int window = std::max( 1, config.windowFrames );
+
+			for ( const int &id : pendingIdentifiers )
+			{
+				Entry &entry = entries[id];
+				const int requestCount = entry.pendingCount;
+				entry.pendingCount = 0;
+
+				const bool withinWindow = entry.everPlayed && ( currentFrame - entry.lastPlayedFrame < window );
+				if ( withinWindow || !pDest )
+				{
+					statistics.mergedCount += scast<size_t>( requestCount );
+					continue;
+				}
+				// else
+
+				Play play;
+				play.soundIdentifier	= id;
+				play.requestCount		= requestCount;
+				play.volume				= CalcVolume( entry.baseVolume, requestCount );
+				pDest->emplace_back( play );
+
+				entry.lastPlayedFrame	= currentFrame;
+				entry.everPlayed		= true;
+
+				statistics.playedCount++;
+				statistics.mergedCount += scast<size_t>( requestCount - 1 );
+			}
+
+			pendingIdentifiers.clear();
+			currentFrame++;
+		}
+		void PlayQueue::Clear()
+		{
+			pendingIdentifiers.clear();
+			entries.clear();
+			currentFrame = 0;
+		}
+		float PlayQueue::CalcVolume( float baseVolume, int requestCount ) const
+		{
+			const float scale = 1.0f + config.volumeGainPerMerge * scast<float>( requestCount - 1 );
+			return std::min( config.maxVolume, baseVolume * scale );
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace Donya
+{
+	namespace Sound
+	{
+		/// <summary>
+		/// Collects the play requests of a frame, and merges the duplicates of same identifier.<para></para>
+		/// A sound is played once per "windowFrames" at most, the requests within the window are merged into it.<para></para>
+		/// It does not depend on the audio system, so you can use it without a device.
+		/// </summary>
+		class PlayQueue
+		{
+		public:
+			struct Config
+			{
+				int		windowFrames		= 2;	// The sound is not played again until this frames elapsed. 1 merges the requests of the same frame only.
+				float	volumeGainPerMerge	= 0.1f;	// The volume increases by this per a merged request
+				float	maxVolume			= 1.5f;	// The upper limit of the scaled volume
+			};
+			/// <summary>
+			/// A merged request that should be played.
+			/// </summary>
+			struct Play
+			{
+				int		soundIdentifier	= 0;
+				int		requestCount	= 0;
+				float	volume			= 1.0f;
+			};
+			struct Statistics
+			{
+				size_t	requestedCount	= 0;
+				size_t	playedCount		= 0;
+				size_t	mergedCount		= 0;	// requestedCount - playedCount, except the pending requests
+			};
+		private:
+			struct Entry
+			{
+				int		pendingCount	= 0;
+				float	baseVolume		= 0.0f;	// The max volume of the pending requests
+				int		lastPlayedFrame	= 0;
+				bool	everPlayed		= false;
+			};
+		private:
+			Config							config;
+			Statistics						statistics;
+			int								currentFrame = 0;
+			std::unordered_map<int, Entry>	entries;
+			std::vector<int>				pendingIdentifiers;	// The identifiers that have pending requests, in requested order
+		public:
+			/// <summary>
+			/// Registers a play request of this frame.
+			/// </summary>
+			void Push( int soundIdentifier, float volume = 1.0f );
+			/// <summary>
+			/// Outputs the merged requests that should be played now, then advances the frame. Please call once per frame.<para></para>
+			/// The requests that are within the window of their last play are merged and discarded.
+			/// </summary>
+			void Flush( std::vector<Play> *pDestination );
+			/// <summary>
+			/// Discards the pending requests and the play history.
+			/// </summary>
+			void Clear();
+		public:
+			void SetConfig( const Config &newConfig ) { config = newConfig; }
+			const Config		&GetConfig()		const { return config;		}
+			const Statistics	&GetStatistics()	const { return statistics;	}
+			void ResetStatistics() { statistics = Statistics{}; }
+			size_t GetPendingCount() const { return pendingIdentifiers.size(); }
+		private:
+			float CalcVolume( float baseVolume, int requestCount ) const;
+		};
+	}
+}
@@ -1,5 +1,6 @@
 #include "Sprite.h"
 
+#include <algorithm>		// Use std::find.
 #include <array>
 #include <d3d11.h>
 #include <memory>
@@ -607,6 +608,48 @@ namespace Donya
 		Batch::Batch( const std::wstring filename, size_t maxInstancesCount ) :
 			MAX_INSTANCES( maxInstancesCount ), reserveCount( NULL ), instances(),
 			texture2DDesc(), pInstanceBuffer(), pVertexBuffer(), pShaderResourceView()
+		{
+			CreateBuffers();
+
+			// Read Texture
+			{
+				bool succeeded = Resource::CreateTexture2DFromFile
+				(
+					::Donya::GetDevice(),
+					filename,
+					pShaderResourceView.GetAddressOf(),
+					&texture2DDesc
+				);
+				if ( !succeeded )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Create a texture of sprite." );
+				}
+			}
+		}
+		Batch::Batch( const ComPtr<ID3D11ShaderResourceView> &pTextureSRV, size_t maxInstancesCount ) :
+			MAX_INSTANCES( maxInstancesCount ), reserveCount( NULL ), instances(),
+			texture2DDesc(), pInstanceBuffer(), pVertexBuffer(), pShaderResourceView( pTextureSRV )
+		{
+			CreateBuffers();
+
+			// Fetch the description of the texture
+			if ( pShaderResourceView )
+			{
+				ComPtr<ID3D11Resource>	pResource;
+				ComPtr<ID3D11Texture2D>	pTexture;
+				pShaderResourceView->GetResource( pResource.GetAddressOf() );
+				HRESULT hr = pResource.As( &pTexture );
+				if ( SUCCEEDED( hr ) )
+				{
+					pTexture->GetDesc( &texture2DDesc );
+				}
+				else
+				{
+					_ASSERT_EXPR( 0, L"Failed : The texture of sprite is not a Texture2D." );
+				}
+			}
+		}
+		void Batch::CreateBuffers()
 		{
 			HRESULT hr = S_OK;
 			ID3D11Device *pDevice = ::Donya::GetDevice();
@@ -641,21 +684,6 @@ namespace Donya
 				);
 				_ASSERT_EXPR( SUCCEEDED( hr ), L"Failed : Create instance-buffer()" );
 			}
-			
-			// Read Texture
-			{
-				bool succeeded = Resource::CreateTexture2DFromFile
-				(
-					pDevice,
-					filename,
-					pShaderResourceView.GetAddressOf(),
-					&texture2DDesc
-				);
-				if ( !succeeded )
-				{
-					_ASSERT_EXPR( 0, L"Failed : Create a texture of sprite." );
-				}
-			}
 		}
 		Batch::~Batch()
 		{
@@ -701,6 +729,18 @@ namespace Donya
 			if ( width  ) { *width  = GetTextureWidthF();  }
 			if ( height ) { *height = GetTextureHeightF(); }
 		}
+		const D3D11_TEXTURE2D_DESC &Batch::GetTextureDesc() const
+		{
+			return texture2DDesc;
+		}
+		ID3D11ShaderResourceView *Batch::GetShaderResourceView() const
+		{
+			return pShaderResourceView.Get();
+		}
+		size_t			Batch::GetMaxInstanceCount() const
+		{
+			return MAX_INSTANCES;
+		}
 
 		XMFLOAT2 Batch::MakeSpriteCenter( Origin center, float scaleX, float scaleY ) const
 		{
@@ -1617,6 +1657,15 @@ namespace Donya
 
 	#pragma region Agent
 
+		/// <summary>
+		/// Where a sprite was packed in an atlas page.
+		/// </summary>
+		struct AtlasEntry
+		{
+			size_t			pageIdentifier = NULL;
+			Donya::Vector2	texOffset;	// Left-top of the sprite in the page, texture space
+		};
+
 		struct Agent
 		{
 			// Note: container's type isn't need std::unique_ptr, but Sprite::Batch can not copy, so I wrapped by pointer.
@@ -1630,6 +1679,13 @@ namespace Donya
 
 			std::unordered_map<size_t, std::unique_ptr<Sprite::Batch>> pSprites;
 
+			std::unordered_map<size_t, AtlasEntry>	atlasEntries;	// Key is a packed sprite's identifier
+			std::vector<size_t>						atlasPages;		// The identifiers of the pages, these are stored in "pSprites"
+			TextureAtlas::Report					atlasReport;
+
+			size_t batchRenderCount;
+			size_t lastFrameBatchRenderCount;
+
 			bool nowBatchingPrimitive;	// Used to associate Rect and Batch.
 		public:
 			Agent( unsigned int maxInstanceCntOfPrim, unsigned int vertexCntOfCirclePerQuad ) :
@@ -1637,6 +1693,8 @@ namespace Donya
 				pRect( std::make_unique<Sprite::Rect>( maxInstanceCntOfPrim ) ),
 				pCircle( std::make_unique<Sprite::Circle>( vertexCntOfCirclePerQuad, maxInstanceCntOfPrim ) ),
 				ppDrawList(), pSprites(),
+				atlasEntries(), atlasPages(), atlasReport(),
+				batchRenderCount( 0 ), lastFrameBatchRenderCount( 0 ),
 				nowBatchingPrimitive( false )
 			{
 			
@@ -1728,6 +1786,195 @@ namespace Donya
 			return pAgent->pSprites.find( spriteIdentifier );
 		}
 
+	#pragma region Atlas
+
+		namespace
+		{
+			/// <summary>
+			/// Creates a page texture that is cleared by transparent, for hiding the padding.
+			/// </summary>
+			bool CreateAtlasPage( ID3D11Device *pDevice, ID3D11DeviceContext *pImmediateContext, UINT pageSize, DXGI_FORMAT format, Microsoft::WRL::ComPtr<ID3D11Texture2D> *pTexture, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> *pSRV )
+			{
+				D3D11_TEXTURE2D_DESC desc{};
+				desc.Width				= pageSize;
+				desc.Height				= pageSize;
+				desc.MipLevels			= 1;
+				desc.ArraySize			= 1;
+				desc.Format				= format;
+				desc.SampleDesc.Count	= 1;
+				desc.SampleDesc.Quality	= 0;
+				desc.Usage				= D3D11_USAGE_DEFAULT;
+				desc.BindFlags			= D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+				desc.CPUAccessFlags		= 0;
+				desc.MiscFlags			= 0;
+
+				HRESULT hr = pDevice->CreateTexture2D( &desc, nullptr, pTexture->ReleaseAndGetAddressOf() );
+				if ( FAILED( hr ) ) { return false; }
+				// else
+
+				Microsoft::WRL::ComPtr<ID3D11RenderTargetView> pRTV;
+				hr = pDevice->CreateRenderTargetView( pTexture->Get(), nullptr, pRTV.GetAddressOf() );
+				if ( FAILED( hr ) ) { return false; }
+				// else
+
+				constexpr FLOAT transparent[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+				pImmediateContext->ClearRenderTargetView( pRTV.Get(), transparent );
+
+				hr = pDevice->CreateShaderResourceView( pTexture->Get(), nullptr, pSRV->ReleaseAndGetAddressOf() );
+				return SUCCEEDED( hr );
+			}
+			size_t MakeAtlasPageIdentifier( size_t pageIndex )
+			{
+				// The page should not be overlapped with the loaded sprites, those are hashed by the file name
+				size_t hash = std::hash<std::wstring>()( L"Donya::Sprite::Atlas_" + std::to_wstring( pageIndex ) );
+				while ( hash == NULL || pAgent->pSprites.find( hash ) != pAgent->pSprites.end() )
+				{
+					hash++;
+				}
+				return hash;
+			}
+		}
+
+		bool BuildAtlas( const std::vector<size_t> &spriteIdentifiers, unsigned int pageSize, unsigned int padding )
+		{
+			if ( AssertIfNotInitialized() ) { return false; }
+			// else
+
+			ReleaseAtlas();
+
+			// Collect the packable sprites
+			std::vector<size_t>			targets{};
+			std::vector<Donya::Int2>	sizes{};
+			DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+			for ( const size_t id : spriteIdentifiers )
+			{
+				auto it = FindSpriteOrEnd( id );
+				if ( it == pAgent->pSprites.end() ) { continue; }
+				if ( std::find( targets.begin(), targets.end(), id ) != targets.end() ) { continue; }
+				// else
+
+				const D3D11_TEXTURE2D_DESC &desc = it->second->GetTextureDesc();
+				if ( !it->second->GetShaderResourceView() )				{ continue; }
+				if ( desc.ArraySize != 1 || desc.SampleDesc.Count != 1 )	{ continue; }
+				if ( format == DXGI_FORMAT_UNKNOWN )
+				{
+					format = desc.Format;
+				}
+				if ( desc.Format != format )							{ continue; }
+				// else
+
+				targets.emplace_back( id );
+				sizes.emplace_back( Donya::Int2{ scast<int>( desc.Width ), scast<int>( desc.Height ) } );
+			}
+
+			std::vector<TextureAtlas::Placement> placements{};
+			const Donya::Int2 pageSize2D{ scast<int>( pageSize ), scast<int>( pageSize ) };
+			pAgent->atlasReport = TextureAtlas::Pack( sizes, pageSize2D, scast<int>( padding ), &placements );
+
+			const size_t pageCount = pAgent->atlasReport.pageCount;
+			if ( !pageCount ) { return false; }
+			// else
+
+			ID3D11Device		*pDevice			= ::Donya::GetDevice();
+			ID3D11DeviceContext	*pImmediateContext	= ::Donya::GetImmediateContext();
+
+			std::vector<Microsoft::WRL::ComPtr<ID3D11Texture2D>>			pageTextures( pageCount );
+			std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>>	pageSRVs( pageCount );
+			for ( size_t i = 0; i < pageCount; ++i )
+			{
+				if ( !CreateAtlasPage( pDevice, pImmediateContext, pageSize, format, &pageTextures[i], &pageSRVs[i] ) )
+				{
+					_ASSERT_EXPR( 0, L"Failed : Create a page of sprite atlas." );
+					pAgent->atlasReport = TextureAtlas::Report{};
+					return false;
+				}
+			}
+
+			// Copy the top mip of the each sprite into the page
+			std::vector<size_t> instanceCounts( pageCount, 0U );
+			const size_t targetCount = targets.size();
+			for ( size_t i = 0; i < targetCount; ++i )
+			{
+				const auto &placement = placements[i];
+				if ( !placement.packed ) { continue; }
+				// else
+
+				const auto &pBatch = pAgent->pSprites.find( targets[i] )->second;
+
+				Microsoft::WRL::ComPtr<ID3D11Resource> pSource;
+				pBatch->GetShaderResourceView()->GetResource( pSource.GetAddressOf() );
+				pImmediateContext->CopySubresourceRegion
+				(
+					pageTextures[placement.pageIndex].Get(), 0,
+					scast<UINT>( placement.pos.x ), scast<UINT>( placement.pos.y ), 0,
+					pSource.Get(), D3D11CalcSubresource( 0, 0, pBatch->GetTextureDesc().MipLevels ),
+					nullptr
+				);
+
+				instanceCounts[placement.pageIndex] += pBatch->GetMaxInstanceCount();
+			}
+
+			for ( size_t i = 0; i < pageCount; ++i )
+			{
+				const size_t id = MakeAtlasPageIdentifier( i );
+				pAgent->pSprites.insert
+				(
+					std::make_pair
+					(
+						id,
+						std::make_unique<Sprite::Batch>( pageSRVs[i], ( instanceCounts[i] ) ? instanceCounts[i] : 1U )
+					)
+				);
+				pAgent->atlasPages.emplace_back( id );
+			}
+
+			for ( size_t i = 0; i < targetCount; ++i )
+			{
+				const auto &placement = placements[i];
+				if ( !placement.packed ) { continue; }
+				// else
+
+				AtlasEntry entry{};
+				entry.pageIdentifier	= pAgent->atlasPages[placement.pageIndex];
+				entry.texOffset			= placement.pos.Float();
+				pAgent->atlasEntries.insert( std::make_pair( targets[i], entry ) );
+			}
+
+			return true;
+		}
+		void ReleaseAtlas()
+		{
+			if ( AssertIfNotInitialized() ) { return; }
+			// else
+
+			// The draw list may refer the page
+			Flush();
+
+			for ( const size_t id : pAgent->atlasPages )
+			{
+				pAgent->pSprites.erase( id );
+			}
+			pAgent->atlasPages.clear();
+			pAgent->atlasEntries.clear();
+			pAgent->atlasReport = TextureAtlas::Report{};
+		}
+		TextureAtlas::Report GetAtlasReport()
+		{
+			if ( AssertIfNotInitialized() ) { return TextureAtlas::Report{}; }
+			// else
+
+			return pAgent->atlasReport;
+		}
+		size_t GetBatchRenderCountOfLastFrame()
+		{
+			if ( AssertIfNotInitialized() ) { return 0; }
+			// else
+
+			return pAgent->lastFrameBatchRenderCount;
+		}
+
+	#pragma endregion
+
 	#pragma region GetTextureSizes
 
 		int GetTexturWidth( size_t spriteIdentifier )
@@ -1807,11 +2054,16 @@ namespace Donya
 		Finally, register id of batching sprite, and reserve.
 		*/
 
+		void RenderLastBatch()
+		{
+			( *pAgent->ppDrawList.back() )->Render();
+			pAgent->batchRenderCount++;
+		}
 		void FlushBatch()
 		{
 			if ( pAgent->lastReservedIdentifier != NULL )
 			{
-				( *pAgent->ppDrawList.back() )->Render();
+				RenderLastBatch();
 			}
 
 			pAgent->lastReservedIdentifier = NULL;
@@ -1834,6 +2086,48 @@ namespace Donya
 			pAgent->nowBatchingPrimitive = true;
 		}
 
+		/// <summary>
+		/// Switches the current batch to the one that draws the "itSprite", then returns it.<para></para>
+		/// If the sprite was packed into an atlas page, the page is used, and the "pTexOffset" receives the sprite's place in the page. Otherwise the "pTexOffset" receives zero.
+		/// </summary>
+		std::unique_ptr<Sprite::Batch> &PrepareBatch( decltype( pAgent->pSprites )::iterator itSprite, Donya::Vector2 *pTexOffset )
+		{
+			size_t	batchIdentifier	= itSprite->first;
+			auto	itBatch			= itSprite;
+			*pTexOffset = Donya::Vector2::Zero();
+
+			const auto found = pAgent->atlasEntries.find( itSprite->first );
+			if ( found != pAgent->atlasEntries.end() )
+			{
+				const auto itPage = pAgent->pSprites.find( found->second.pageIdentifier );
+				if ( itPage != pAgent->pSprites.end() )
+				{
+					batchIdentifier	= itPage->first;
+					itBatch			= itPage;
+					*pTexOffset		= found->second.texOffset;
+				}
+			}
+
+			if ( pAgent->nowBatchingPrimitive )
+			{
+				SwitchBatchFromPrimitive();
+			}
+
+			if ( pAgent->lastReservedIdentifier != batchIdentifier )
+			{
+				if ( pAgent->lastReservedIdentifier != NULL )
+				{
+					RenderLastBatch();
+				}
+
+				pAgent->lastReservedIdentifier = batchIdentifier;
+
+				pAgent->ppDrawList.push_back( &itBatch->second );
+			}
+
+			return *pAgent->ppDrawList.back();
+		}
+
 	#pragma region Normal
 		bool Draw( size_t sprId, float scrX, float scrY, float degree, DirectX::XMFLOAT2 center, float alpha )
 		{
@@ -2103,27 +2397,13 @@ namespace Donya
 			if ( it == pAgent->pSprites.end() ) { return false; }
 			// else
 
-			if ( pAgent->nowBatchingPrimitive )
-			{
-				SwitchBatchFromPrimitive();
-			}
-
-			if ( pAgent->lastReservedIdentifier != sprId )
-			{
-				if ( pAgent->lastReservedIdentifier != NULL )
-				{
-					( *pAgent->ppDrawList.back() )->Render();
-				}
-
-				pAgent->lastReservedIdentifier = sprId;
-
-				pAgent->ppDrawList.push_back( &it->second );
-			}
+			Donya::Vector2 texOffset{};
+			auto &sprite = PrepareBatch( it, &texOffset );
 
-			return ( *pAgent->ppDrawList.back() )->ReserveGeneralExt
+			return sprite->ReserveGeneralExt
 			(
 				scrX, scrY, scrW, scrH,
-				texX, texY, texW, texH,
+				texX + texOffset.x, texY + texOffset.y, texW, texH,
 				scaleX, scaleY,
 				degree, center,
 				alpha, R, G, B
@@ -2146,6 +2426,53 @@ namespace Donya
 		}
 	#pragma endregion
 
+	#pragma region Quads
+		bool DrawQuads( size_t sprId, const Quad *pQuads, size_t quadCount, float scrX, float scrY, float scaleX, float scaleY, DirectX::XMFLOAT2 center, float alpha, float R, float G, float B )
+		{
+			if ( !pQuads || !quadCount ) { return true; }
+			// else
+
+			auto it = FindSpriteOrEnd( sprId );
+			if ( it == pAgent->pSprites.end() ) { return false; }
+			// else
+
+			Donya::Vector2 texOffset{};
+			auto &sprite = PrepareBatch( it, &texOffset );
+
+			bool succeeded = true;
+			for ( size_t i = 0; i < quadCount; ++i )
+			{
+				const Quad &quad = pQuads[i];
+				auto Reserve = [&]()
+				{
+					return sprite->ReserveGeneralExt
+					(
+						scrX + ( quad.ssPos.x * scaleX ),
+						scrY + ( quad.ssPos.y * scaleY ),
+						quad.ssSize.x, quad.ssSize.y,
+						quad.texPos.x + texOffset.x, quad.texPos.y + texOffset.y,
+						quad.texSize.x, quad.texSize.y,
+						scaleX, scaleY,
+						0.0f, center,
+						alpha, R, G, B
+					);
+				};
+
+				if ( Reserve() ) { continue; }
+				// else
+
+				// The batch is full, so render it and use it again
+				RenderLastBatch();
+				if ( !Reserve() )
+				{
+					succeeded = false;
+				}
+			}
+
+			return succeeded;
+		}
+	#pragma endregion
+
 	#pragma region String
 		Donya::Int2 CalcTextCharPlace( char character )
 		{
@@ -2190,33 +2517,18 @@ namespace Donya
 			if ( it == pAgent->pSprites.end() ) { return false; }
 			// else
 
-			if ( pAgent->nowBatchingPrimitive )
-			{
-				SwitchBatchFromPrimitive();
-			}
-
-			if ( pAgent->lastReservedIdentifier != sprId )
-			{
-				if ( pAgent->lastReservedIdentifier != NULL )
-				{
-					( *pAgent->ppDrawList.back() )->Render();
-				}
-
-				pAgent->lastReservedIdentifier = sprId;
-
-				pAgent->ppDrawList.push_back( &it->second );
-			}
+			Donya::Vector2 texOffset{};
+			auto &sprite = PrepareBatch( it, &texOffset );
 
 			Donya::Vector2 texPos{};
 			bool succeeded = true;
-			auto &sprite = ( *pAgent->ppDrawList.back() );
 
 			size_t end = str.size();
 			for ( size_t i = 0; i < end; ++i )
 			{
 				texPos = CalcTextCharPlace( str[i] ).Float();
-				texPos.x *= texW;
-				texPos.y *= texH;
+				texPos.x = ( texPos.x * texW ) + texOffset.x;
+				texPos.y = ( texPos.y * texH ) + texOffset.y;
 
 				bool result = sprite->ReserveGeneralExt
 				(
@@ -2385,6 +2697,9 @@ namespace Donya
 			// else
 
 			Flush();
+
+			pAgent->lastFrameBatchRenderCount	= pAgent->batchRenderCount;
+			pAgent->batchRenderCount			= 0;
 		}
 
 	#pragma endregion
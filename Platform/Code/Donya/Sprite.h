@@ -8,6 +8,7 @@
 #include <wrl.h>
 
 #include "Color.h"
+#include "TextureAtlas.h"	// Use for TextureAtlas::Report.
 #include "Vector.h"			// Use for Donya::Int2.
 
 namespace Donya
@@ -88,6 +89,10 @@ namespace Donya
 			ComPtr<ID3D11ShaderResourceView>	pShaderResourceView;
 		public:
 			Batch( const std::wstring spriteFilename, size_t maxInstancesCount = 32U );
+			/// <summary>
+			/// Use the texture that is already created(e.g. an atlas page). The texture must be a Texture2D.
+			/// </summary>
+			Batch( const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> &pTextureSRV, size_t maxInstancesCount = 32U );
 			~Batch();
 			Batch( const Batch & ) = delete;
 			Batch &operator = ( const Batch & ) = delete;
@@ -120,6 +125,9 @@ namespace Donya
 			/// You can ignore to setting nullptr.
 			/// </summary>
 			void GetTextureSize( float *width, float *height ) const;
+			const D3D11_TEXTURE2D_DESC &GetTextureDesc() const;
+			ID3D11ShaderResourceView *GetShaderResourceView() const;
+			size_t GetMaxInstanceCount() const;
 		public:
 			/// <summary>
 			/// Calculate center pos of sprite space by "center" bit, from whole size of sprite.
@@ -490,6 +498,8 @@ namespace Donya
 		#pragma endregion
 
 			void Render();
+		private:
+			void CreateBuffers();
 		};
 
 		/// <summary>
@@ -697,6 +707,27 @@ namespace Donya
 		/// </summary>
 		size_t Load( const std::wstring &spriteFileName, size_t maxInstancesCount = 32 );
 
+		/// <summary>
+		/// Packs the textures of the loaded sprites into the atlas pages, then the draws of these sprites are batched by the page.<para></para>
+		/// The identifiers and the texture sizes of the sprites are not changed, so you can use them as is.<para></para>
+		/// The sprites that have the different format from the first one, or larger than the page are not packed.<para></para>
+		/// The previous atlas is released. Please call from the thread that owns the immediate-context.<para></para>
+		/// Returns false if any page was not created.
+		/// </summary>
+		bool BuildAtlas( const std::vector<size_t> &spriteIdentifiers, unsigned int pageSize = 2048U, unsigned int padding = 2U );
+		/// <summary>
+		/// The packed sprites are drawn by their own texture again.
+		/// </summary>
+		void ReleaseAtlas();
+		/// <summary>
+		/// Returns the report of the last BuildAtlas().
+		/// </summary>
+		TextureAtlas::Report GetAtlasReport();
+		/// <summary>
+		/// Returns the count of the sprite batches that were rendered in the last frame(the counting is reset at PostDraw()).
+		/// </summary>
+		size_t GetBatchRenderCountOfLastFrame();
+
 	#pragma region GetTextureSizes
 
 		/// <summary>
@@ -1244,6 +1275,36 @@ namespace Donya
 		);
 	#pragma endregion
 
+	#pragma region Quads
+		/// <summary>
+		/// A part of a texture that is drawn at a place relative to the origin of drawing.
+		/// </summary>
+		struct Quad
+		{
+			Donya::Vector2 ssPos;	// Left-top, relative to the origin. It is scaled at drawing.
+			Donya::Vector2 ssSize;	// Whole size. It is scaled at drawing.
+			Donya::Vector2 texPos;	// Left-top in texture space
+			Donya::Vector2 texSize;	// Whole size in texture space
+		};
+		/// <summary>
+		/// Draws the quads of the same sprite by one lookup of the sprite. The "center" is subtracted from the origin, after the scaling.<para></para>
+		/// If the batch becomes full, it is rendered and the remaining quads are continued to reserve.<para></para>
+		/// In case of we can not drawing, returns false.
+		/// </summary>
+		bool DrawQuads
+		(
+			size_t spriteIdentifier,		// NULL is invalid identifier.
+			const Quad *pQuads, size_t quadCount,
+			float  screenOriginX, float screenOriginY,
+			float  scaleX, float scaleY,	// Magnification.
+			DirectX::XMFLOAT2 center,
+			float  alpha = 1.0f,
+			float  R = 1.0f,
+			float  G = 1.0f,
+			float  B = 1.0f
+		);
+	#pragma endregion
+
 	#pragma region Text
 		/// <summary>
 		/// Calculate place(0-based) of specified character in texture.<para></para>
@@ -0,0 +1,211 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>		// Use std::sort.
+#include <numeric>			// Use std::iota.
+
+#include "Constant.h"		// Use scast macro.
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace TextureAtlas
+	{
+		SkylinePacker::SkylinePacker( const Donya::Int2 &pageSize ) :
+			pageSize( pageSize ), skyline(), usedArea( 0 )
+		{
+			// The first segment covers the whole width
+			skyline.emplace_back( Segment{ 0, 0, pageSize.x } );
+		}
+		bool SkylinePacker::Insert( const Donya::Int2 &rectSize, Donya::Int2 *pOutputPos )
+		{
+			if ( rectSize.x <= 0 || rectSize.y <= 0 ) { return false; }
+			if ( pageSize.x < rectSize.x || pageSize.y < rectSize.y ) { return false; }
+			// else
+
+			// Choose the position that the bottom is the highest, and the segment is the narrowest if it is same
+			bool	found		= false;
+			size_t	bestIndex	= 0;
+			int		bestBottom	= 0;
+			int		bestWidth	= 0;
+			int		bestY		= 0;
+
+			const size_t segmentCount = skyline.size();
+			for ( size_t i = 0; i < segmentCount; ++i )
+			{
+				const int y = FitAt( i, rectSize );
+				if ( y < 0 ) { continue; }
+				// else
+
+				const int bottom = y + rectSize.y;
+				if ( !found || bottom < bestBottom || ( bottom == bestBottom && skyline[i].width < bestWidth ) )
+				{
+					found		= true;
+					bestIndex	= i;
+					bestBottom	= bottom;
+					bestWidth	= skyline[i].width;
+					bestY		= y;
+				}
+			}
+
+			if ( !found ) { return false; }
+			// else
+
+			const Donya::Int2 pos{ skyline[bestIndex].x, bestY };
+			AddLevel( bestIndex, pos, rectSize );
+			usedArea += scast<long long>( rectSize.x ) * rectSize.y;
+
+			if ( pOutputPos ) { *pOutputPos = pos; }
+			return true;
+		}
+		float SkylinePacker::CalcOccupancy() const
+		{
+			const long long pageArea = scast<long long>( pageSize.x ) * pageSize.y;
+			if ( pageArea <= 0 ) { return 0.0f; }
+			// else
+
+			return scast<float>( scast<double>( usedArea ) / scast<double>( pageArea ) );
+		}
+		int  SkylinePacker::FitAt( size_t segmentIndex, const Donya::Int2 &rectSize ) const
+		{
+			const int x = skyline[segmentIndex].x;
+			if ( pageSize.x < x + rectSize.x ) { return -1; }
+			// else
+
+			// The rectangle lies on the highest segment of the covered segments
+			int widthLeft	= rectSize.x;
+			int y			= skyline[segmentIndex].y;
+			const size_t segmentCount = skyline.size();
+			for ( size_t i = segmentIndex; 0 < widthLeft && i < segmentCount; ++i )
+			{
+				y = std::max( y, skyline[i].y );
+				if ( pageSize.y < y + rectSize.y ) { return -1; }
+				// else
+
+				widthLeft -= skyline[i].width;
+			}
+
+			return y;
+		}
+		void SkylinePacker::AddLevel( size_t segmentIndex, const Donya::Int2 &pos, const Donya::Int2 &rectSize )
+		{
+			skyline.insert( skyline.begin() + segmentIndex, Segment{ pos.x, pos.y + rectSize.y, rectSize.x } );
+
+			// Cut off the segments that are hidden under the new one
+			for ( size_t i = segmentIndex + 1; i < skyline.size(); )
+			{
+				const Segment &prev = skyline[i - 1];
+				Segment &current = skyline[i];
+				const int prevRight = prev.x + prev.width;
+				if ( prevRight <= current.x ) { break; }
+				// else
+
+				const int shrink = prevRight - current.x;
+				current.x		+= shrink;
+				current.width	-= shrink;
+				if ( 0 < current.width ) { break; }
+				// else
+
+				skyline.erase( skyline.begin() + i );
+			}
+
+			MergeSameLevels();
+		}
+		void SkylinePacker::MergeSameLevels()
+		{
+			for ( size_t i = 0; i + 1 < skyline.size(); )
+			{
+				if ( skyline[i].y != skyline[i + 1].y )
+				{
+					++i;
+					continue;
+				}
+				// else
+
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase( skyline.begin() + i + 1 );
+			}
+		}
+
+		float Report::CalcEfficiency() const
+		{
+			const long long pageArea = scast<long long>( pageSize.x ) * pageSize.y * scast<long long>( pageCount );
+			if ( pageArea <= 0 ) { return 0.0f; }
+			// else
+
+			return scast<float>( scast<double>( usedArea ) / scast<double>( pageArea ) );
+		}
+
+		Report Pack( const std::vector<Donya::Int2> &rectSizes, const Donya::Int2 &pageSize, int padding, std::vector<Placement> *pOutput )
+		{
+			Report report{};
+			report.rectCount	= rectSizes.size();
+			report.pageSize		= pageSize;
+			if ( !pOutput ) { return report; }
+			// else
+
+			pOutput->assign( rectSizes.size(), Placement{} );
+			padding = std::max( 0, padding );
+
+			// Inserting the taller one first makes the skyline flat
+			std::vector<size_t> order( rectSizes.size() );
+			std::iota( order.begin(), order.end(), 0U );
+			std::sort
+			(
+				order.begin(), order.end(),
+				[&rectSizes]( size_t L, size_t R )
+				{
+					const Donya::Int2 &sizeL = rectSizes[L];
+					const Donya::Int2 &sizeR = rectSizes[R];
+					if ( sizeL.y != sizeR.y ) { return sizeR.y < sizeL.y; }
+					if ( sizeL.x != sizeR.x ) { return sizeR.x < sizeL.x; }
+					return L < R;
+				}
+			);
+
+			std::vector<SkylinePacker> pages{};
+			for ( const size_t index : order )
+			{
+				const Donya::Int2 &size = rectSizes[index];
+				// The padding surrounds all sides, so the neighbors are separated by twice the padding
+				const Donya::Int2 paddedSize{ size.x + ( padding * 2 ), size.y + ( padding * 2 ) };
+				if ( size.x <= 0 || size.y <= 0 ) { continue; }
+				if ( pageSize.x < paddedSize.x || pageSize.y < paddedSize.y ) { continue; }
+				// else
+
+				Placement &dest = ( *pOutput )[index];
+				const size_t pageCount = pages.size();
+				for ( size_t i = 0; i < pageCount; ++i )
+				{
+					if ( pages[i].Insert( paddedSize, &dest.pos ) )
+					{
+						dest.pageIndex	= i;
+						dest.packed		= true;
+						break;
+					}
+				}
+
+				if ( !dest.packed )
+				{
+					pages.emplace_back( pageSize );
+					dest.pageIndex	= pages.size() - 1;
+					dest.packed		= pages.back().Insert( paddedSize, &dest.pos );
+				}
+
+				if ( dest.packed )
+				{
+					// The inserted position is the left-top of the padding
+					dest.pos.x += padding;
+					dest.pos.y += padding;
+
+					report.packedCount++;
+					report.usedArea += scast<long long>( size.x ) * size.y;
+				}
+			}
+
+			report.pageCount = pages.size();
+			return report;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+
+#include "Vector.h"		// Use Donya::Int2.
+
+namespace Donya
+{
+	/// <summary>
+	/// The rectangle packer for merging some textures into the atlas pages.
+	/// It only calculates the placements, so it does not use GPU.
+	/// </summary>
+	namespace TextureAtlas
+	{
+		/// <summary>
+		/// Packs the rectangles into a page by the skyline bottom-left method.
+		/// </summary>
+		class SkylinePacker
+		{
+		private:
+			struct Segment
+			{
+				int x		= 0;
+				int y		= 0;	// The top of the segment, it grows to downward
+				int width	= 0;
+			};
+		private:
+			Donya::Int2				pageSize;
+			std::vector<Segment>	skyline;
+			long long				usedArea = 0;
+		public:
+			SkylinePacker( const Donya::Int2 &pageSize );
+		public:
+			/// <summary>
+			/// Returns false if there is no space for the "rectSize", in that case the "pOutputPos" is not changed.
+			/// </summary>
+			bool Insert( const Donya::Int2 &rectSize, Donya::Int2 *pOutputPos );
+			/// <summary>
+			/// Returns the ratio of the area of inserted rectangles per the page area.
+			/// </summary>
+			float CalcOccupancy() const;
+		private:
+			/// <summary>
+			/// Returns the y coordinate if the rectangle is placed on the "segmentIndex", or returns -1 if it can not place.
+			/// </summary>
+			int  FitAt( size_t segmentIndex, const Donya::Int2 &rectSize ) const;
+			void AddLevel( size_t segmentIndex, const Donya::Int2 &pos, const Donya::Int2 &rectSize );
+			void MergeSameLevels();
+		};
+
+		struct Placement
+		{
+			size_t		pageIndex	= 0;
+			Donya::Int2	pos;				// Left-top in the page
+			bool		packed		= false;
+		};
+		struct Report
+		{
+			size_t		rectCount	= 0;
+			size_t		packedCount	= 0;
+			size_t		pageCount	= 0;
+			long long	usedArea	= 0;	// Without the padding
+			Donya::Int2	pageSize;
+		public:
+			/// <summary>
+			/// Returns the ratio of the "usedArea" per the area of all pages. Returns 0.0f if there is no page.
+			/// </summary>
+			float CalcEfficiency() const;
+		};
+
+		/// <summary>
+		/// Packs the "rectSizes" into the pages. A new page is added if the current pages are full.
+		/// The "padding" surrounds all sides of each rectangle, for preventing the bleeding of texture filtering.
+		/// The "pOutput" has the placements in the same order as the "rectSizes". A rectangle that is larger than the page with the padding is not packed.
+		/// </summary>
+		Report Pack( const std::vector<Donya::Int2> &rectSizes, const Donya::Int2 &pageSize, int padding, std::vector<Placement> *pOutput );
+	}
+}
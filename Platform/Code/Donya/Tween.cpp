@@ -0,0 +1,345 @@
+#include "Tween.h"
+
+#include <algorithm>
+#include <array>
+
+#include "Constant.h"		// Use scast macro
+#include "Profiler.h"		// Use PROFILE_SCOPE, Now() and the benchmark helpers
+
+#undef max
+#undef min
+
+namespace Donya
+{
+	namespace
+	{
+		constexpr std::uint32_t invalidDense = ~0U;
+
+		float ToMilliSeconds( std::int64_t nanoSeconds )
+		{
+			return scast<float>( nanoSeconds ) * 0.000001f;
+		}
+	}
+
+	Tweener::Handle Tweener::Add( const Description &desc )
+	{
+		if ( !desc.pTarget ) { return Handle{}; }
+		// else
+
+		const Easing::Function function = ( desc.useTable )
+			? Easing::GetTableFunction( desc.kind, desc.type )
+			: Easing::GetFunction( desc.kind, desc.type );
+		if ( desc.durationSecond <= 0.0f || !function )
+		{
+			*desc.pTarget = desc.to;
+			return Handle{};
+		}
+		// else
+
+		*desc.pTarget = desc.from;
+
+		std::uint32_t slot = 0;
+		if ( freeSlots.empty() )
+		{
+			slot = scast<std::uint32_t>( denseOfSlot.size() );
+			denseOfSlot.emplace_back( invalidDense );
+			generations.emplace_back( 0U );
+		}
+		else
+		{
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+
+		const std::uint32_t dense = scast<std::uint32_t>( targets.size() );
+		denseOfSlot[slot] = dense;
+
+		targets.emplace_back		( desc.pTarget );
+		froms.emplace_back			( desc.from );
+		deltas.emplace_back			( desc.to - desc.from );
+		starts.emplace_back			( clock + std::max( 0.0f, desc.delaySecond ) );
+		invDurations.emplace_back	( 1.0f / desc.durationSecond );
+		kinds.emplace_back			( desc.kind );
+		types.emplace_back			( desc.type );
+		functions.emplace_back		( function );
+		usesTable.emplace_back		( scast<std::uint8_t>( desc.useTable && Easing::IsExpensive( desc.kind ) ) );
+		slotOfDense.emplace_back	( slot );
+
+		peakCount = std::max( peakCount, targets.size() );
+
+		Handle handle{};
+		handle.slot			= slot;
+		handle.generation	= generations[slot];
+		return handle;
+	}
+	void Tweener::Remove( const Handle &handle )
+	{
+		if ( !IsActive( handle ) ) { return; }
+		// else
+
+		RemoveDense( denseOfSlot[handle.slot] );
+	}
+	void Tweener::Finish( const Handle &handle )
+	{
+		if ( !IsActive( handle ) ) { return; }
+		// else
+
+		const std::uint32_t dense = denseOfSlot[handle.slot];
+		*targets[dense] = froms[dense] + deltas[dense];
+		RemoveDense( dense );
+	}
+	bool Tweener::IsActive( const Handle &handle ) const
+	{
+		return IsValidSlot( handle ) && denseOfSlot[handle.slot] != invalidDense;
+	}
+	void Tweener::Update( float elapsedTime )
+	{
+		const std::int64_t beginNS = Donya::Profiler::Now();
+
+		const size_t count = targets.size();
+		if ( count == 0 )
+		{
+			// Reset the clock for keeping the precision of float
+			clock = 0.0f;
+			lastUpdateMS = 0.0f;
+			return;
+		}
+		// else
+
+		clock += elapsedTime;
+
+		finishedDenses.clear();
+		for ( size_t i = 0; i < count; ++i )
+		{
+			float t = ( clock - starts[i] ) * invDurations[i];
+			if ( t < 0.0f ) { continue; } // Delaying
+			// else
+
+			if ( 1.0f <= t )
+			{
+				t = 1.0f;
+				finishedDenses.emplace_back( scast<std::uint32_t>( i ) );
+			}
+
+			*targets[i] = froms[i] + deltas[i] * functions[i]( t );
+		}
+
+		// Remove from the back, because the removing moves the last element to the removed place
+		for ( auto it = finishedDenses.rbegin(); it != finishedDenses.rend(); ++it )
+		{
+			RemoveDense( *it );
+		}
+
+		lastUpdateMS = ToMilliSeconds( Donya::Profiler::Now() - beginNS );
+	}
+	void Tweener::Clear()
+	{
+		for ( std::uint32_t slot = 0; slot < denseOfSlot.size(); ++slot )
+		{
+			if ( denseOfSlot[slot] == invalidDense ) { continue; }
+			// else
+
+			denseOfSlot[slot] = invalidDense;
+			generations[slot]++;
+			freeSlots.emplace_back( slot );
+		}
+
+		targets.clear();
+		froms.clear();
+		deltas.clear();
+		starts.clear();
+		invDurations.clear();
+		kinds.clear();
+		types.clear();
+		functions.clear();
+		usesTable.clear();
+		slotOfDense.clear();
+		clock = 0.0f;
+	}
+	Tweener::Statistics Tweener::GetStatistics() const
+	{
+		Statistics statistics{};
+		statistics.activeCount	= targets.size();
+		statistics.peakCount	= peakCount;
+		statistics.lastUpdateMS	= lastUpdateMS;
+		for ( const auto &it : usesTable )
+		{
+			if ( it ) { statistics.tableUserCount++; }
+		}
+		for ( const auto &it : kinds )
+		{
+			statistics.kindCounts[scast<size_t>( it )]++;
+		}
+		return statistics;
+	}
+	bool Tweener::IsValidSlot( const Handle &handle ) const
+	{
+		if ( denseOfSlot.size() <= handle.slot ) { return false; }
+		// else
+		return ( generations[handle.slot] == handle.generation );
+	}
+	void Tweener::RemoveDense( std::uint32_t dense )
+	{
+		const std::uint32_t last		= scast<std::uint32_t>( targets.size() - 1 );
+		const std::uint32_t removedSlot	= slotOfDense[dense];
+
+		// Move the last element to the removed place
+		if ( dense != last )
+		{
+			targets[dense]		= targets[last];
+			froms[dense]		= froms[last];
+			deltas[dense]		= deltas[last];
+			starts[dense]		= starts[last];
+			invDurations[dense]	= invDurations[last];
+			kinds[dense]		= kinds[last];
+			types[dense]		= types[last];
+			functions[dense]	= functions[last];
+			usesTable[dense]	= usesTable[last];
+			slotOfDense[dense]	= slotOfDense[last];
+			denseOfSlot[slotOfDense[dense]] = dense;
+		}
+
+		targets.pop_back();
+		froms.pop_back();
+		deltas.pop_back();
+		starts.pop_back();
+		invDurations.pop_back();
+		kinds.pop_back();
+		types.pop_back();
+		functions.pop_back();
+		usesTable.pop_back();
+		slotOfDense.pop_back();
+
+		denseOfSlot[removedSlot] = invalidDense;
+		generations[removedSlot]++;
+		freeSlots.emplace_back( removedSlot );
+	}
+
+	namespace Tween
+	{
+		namespace
+		{
+			static Tweener shared{};
+		}
+
+		Tweener::Handle	Add( const Tweener::Description &description )
+		{
+			return shared.Add( description );
+		}
+		void			Remove( const Tweener::Handle &handle )
+		{
+			shared.Remove( handle );
+		}
+		void			Finish( const Tweener::Handle &handle )
+		{
+			shared.Finish( handle );
+		}
+		bool			IsActive( const Tweener::Handle &handle )
+		{
+			return shared.IsActive( handle );
+		}
+		void			Update( float elapsedTime )
+		{
+			PROFILE_SCOPE( "Donya::Tween::Update" );
+			shared.Update( elapsedTime );
+		}
+		void			Clear()
+		{
+			shared.Clear();
+		}
+		Tweener::Statistics GetStatistics()
+		{
+			return shared.GetStatistics();
+		}
+
+	#if USE_IMGUI
+		namespace
+		{
+			struct Benchmark
+			{
+				int		tweenCount		= 0;
+				float	directMS		= 0.0f;
+				float	tableMS			= 0.0f;
+			};
+			/// <summary>
+			/// Measures the average time of an update of the "tweenCount" tweens, that use the expensive kinds.
+			/// </summary>
+			Benchmark MeasureUpdate( int tweenCount, int loopCount )
+			{
+				constexpr std::array<Easing::Kind, 4> expensiveKinds
+				{
+					Easing::Kind::Bounce,
+					Easing::Kind::Circular,
+					Easing::Kind::Exponential,
+					Easing::Kind::Sinusoidal,
+				};
+
+				Benchmark result{};
+				result.tweenCount = tweenCount;
+
+				std::vector<float> values( scast<size_t>( tweenCount ) );
+				auto Measure = [&]( bool useTable )
+				{
+					// Enough long for not finishing in the loop
+					constexpr float duration = 1000.0f;
+
+					Tweener tweener{};
+					for ( int i = 0; i < tweenCount; ++i )
+					{
+						Tweener::Description desc{};
+						desc.pTarget		= &values[i];
+						desc.durationSecond	= duration;
+						desc.kind			= expensiveKinds[i % expensiveKinds.size()];
+						desc.type			= scast<Easing::Type>( i % Easing::GetTypeCount() );
+						desc.useTable		= useTable;
+						tweener.Add( desc );
+					}
+
+					const float step = duration / scast<float>( loopCount + 1 );
+					return Donya::Profiler::MeasureAverageSeconds( loopCount, [&]( int ) { tweener.Update( step ); } ) * 1000.0f;
+				};
+
+				result.directMS	= Measure( /* useTable = */ false );
+				result.tableMS	= Measure( /* useTable = */ true  );
+				return result;
+			}
+		}
+
+		void ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			const auto statistics = GetStatistics();
+			ImGui::Text( "Active:[%d], Peak:[%d], Using table:[%d]",
+				scast<int>( statistics.activeCount ),
+				scast<int>( statistics.peakCount ),
+				scast<int>( statistics.tableUserCount )
+			);
+			ImGui::Text( "Last update:[%6.3f ms]", statistics.lastUpdateMS );
+			for ( int i = 0; i < Easing::GetKindCount(); ++i )
+			{
+				const size_t &count = statistics.kindCounts[i];
+				if ( count == 0 ) { continue; }
+				// else
+
+				ImGui::Text( "%s:[%d]", Easing::KindName( i ), scast<int>( count ) );
+			}
+
+			static Donya::Profiler::BenchmarkCounts counts{ 10000, 100 };
+			static Benchmark benchmark{};
+			if ( counts.ShowControls( "Tween count", "Loop count", "Measure the update" ) )
+			{
+				benchmark = MeasureUpdate( counts.elementCount, counts.loopCount );
+			}
+			if ( 0 < benchmark.tweenCount )
+			{
+				ImGui::Text( "%d tweens of the expensive kinds:", benchmark.tweenCount );
+				ImGui::Text( "Direct:[%6.3f ms], Table:[%6.3f ms]", benchmark.directMS, benchmark.tableMS );
+			}
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
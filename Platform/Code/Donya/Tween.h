@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Easing.h"
+#include "UseImGui.h"	// Use for USE_IMGUI macro.
+
+namespace Donya
+{
+	/// <summary>
+	/// Animates the registered floats from a value to a value by the easing.<para></para>
+	/// The tweens are stored as the structure of arrays, and Update() advances all of them in one pass.
+	/// The ease function is resolved at the registration, so the update does not dispatch by the kind.<para></para>
+	/// A finished tween writes the destination value to the target, then it is removed.
+	/// </summary>
+	class Tweener
+	{
+	public:
+		/// <summary>
+		/// It becomes inactive when the tween has been finished or removed. A default constructed handle is always inactive.
+		/// </summary>
+		struct Handle
+		{
+			std::uint32_t slot			= ~0U;
+			std::uint32_t generation	= 0;
+		};
+		struct Description
+		{
+			float			*pTarget		= nullptr;	// Must be alive until the tween finishes, or remove the tween before it dies.
+			float			from			= 0.0f;
+			float			to				= 1.0f;
+			float			delaySecond		= 0.0f;		// The target keeps the "from" while delaying
+			float			durationSecond	= 1.0f;		// If it is zero or less, the target becomes the "to" immediately
+			Easing::Kind	kind			= Easing::Kind::Linear;
+			Easing::Type	type			= Easing::Type::In;
+			bool			useTable		= true;		// Uses the precomputed table if the kind is expensive
+		};
+		struct Statistics
+		{
+			size_t	activeCount		= 0;
+			size_t	peakCount		= 0;
+			size_t	tableUserCount	= 0;	// The active tweens that use the table
+			float	lastUpdateMS	= 0.0f;
+			std::array<size_t, Easing::GetKindCount()> kindCounts{};	// The active tweens of each kind
+		};
+	private:
+		// The dense arrays, their index is changed by the removing.
+		std::vector<float *>			targets;
+		std::vector<float>				froms;
+		std::vector<float>				deltas;			// "to" - "from"
+		std::vector<float>				starts;			// The time of the tweener's clock
+		std::vector<float>				invDurations;
+		std::vector<Easing::Kind>		kinds;
+		std::vector<Easing::Type>		types;
+		std::vector<Easing::Function>	functions;
+		std::vector<std::uint8_t>		usesTable;
+		std::vector<std::uint32_t>		slotOfDense;
+
+		// The slots for the handles, their index is not changed.
+		std::vector<std::uint32_t>		denseOfSlot;
+		std::vector<std::uint32_t>		generations;
+		std::vector<std::uint32_t>		freeSlots;
+
+		std::vector<std::uint32_t>		finishedDenses;	// Reuse the memory
+		float							clock			= 0.0f;
+		size_t							peakCount		= 0;
+		float							lastUpdateMS	= 0.0f;
+	public:
+		/// <summary>
+		/// Writes the "from" to the target immediately. Returns an inactive handle if the target is nullptr or the duration is zero.
+		/// </summary>
+		Handle	Add( const Description &description );
+		/// <summary>
+		/// Stops the tween. The target keeps the current value. It is safe to pass an inactive handle.
+		/// </summary>
+		void	Remove( const Handle &handle );
+		/// <summary>
+		/// Writes the destination value to the target, then removes the tween.
+		/// </summary>
+		void	Finish( const Handle &handle );
+		bool	IsActive( const Handle &handle ) const;
+		/// <summary>
+		/// Advances all tweens.
+		/// </summary>
+		void	Update( float elapsedTime );
+		void	Clear();
+	public:
+		size_t		GetActiveCount() const { return targets.size(); }
+		Statistics	GetStatistics() const;
+	private:
+		bool	IsValidSlot( const Handle &handle ) const;
+		void	RemoveDense( std::uint32_t dense );
+	};
+
+	/// <summary>
+	/// The tweener that is shared by the game. Framework::Update() advances it at the beginning of a frame.
+	/// </summary>
+	namespace Tween
+	{
+		Tweener::Handle	Add( const Tweener::Description &description );
+		/// <summary>
+		/// Please remove the tweens when the owner is released, the target pointers would dangle.
+		/// </summary>
+		void			Remove( const Tweener::Handle &handle );
+		void			Finish( const Tweener::Handle &handle );
+		bool			IsActive( const Tweener::Handle &handle );
+		void			Update( float elapsedTime );
+		void			Clear();
+		Tweener::Statistics GetStatistics();
+
+	#if USE_IMGUI
+		/// <summary>
+		/// Shows the statistics of the shared tweener, and the benchmark of the update with/without the tables.
+		/// </summary>
+		void ShowImGuiNode( const std::string &nodeCaption );
+	#endif // USE_IMGUI
+	}
+}
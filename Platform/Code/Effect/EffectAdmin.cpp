@@ -14,11 +14,9 @@ namespace FxRenderer	= EffekseerRendererDX11;
 
 namespace
 {
-	static constexpr size_t kindCount = scast<size_t>( Effect::Kind::KindCount );
-
 	constexpr bool IsOutOfRange( Effect::Kind kind )
 	{
-		return scast<size_t>( Effect::Kind::KindCount ) < scast<size_t>( kind );
+		return Effect::Admin::kindCount <= scast<size_t>( kind );
 	}
 
 	static ParamOperator<Effect::Param> effectParam{ "Effect" };
@@ -34,10 +32,10 @@ namespace Effect
 #if USE_IMGUI
 	void Param::ShowImGuiNode()
 	{
-		if ( effectScales.size() != kindCount )
+		if ( effectScales.size() != Admin::kindCount )
 		{
 			constexpr float defaultScale = 1.0f;
-			effectScales.resize( kindCount, defaultScale );
+			effectScales.resize( Admin::kindCount, defaultScale );
 		}
 
 		if ( ImGui::TreeNode( u8"XP[" ) )
@@ -45,7 +43,7 @@ namespace Effect
 			ImGui::Text( u8"ɓKp܂" );
 			
 			std::string caption{};
-			for ( size_t i = 0; i < kindCount; ++i )
+			for ( size_t i = 0; i < Admin::kindCount; ++i )
 			{
 				caption = GetEffectName( scast<Effect::Kind>( i ) );
 				ImGui::DragFloat( caption.c_str(), &effectScales[i], 0.01f );
@@ -87,7 +85,7 @@ namespace Effect
 
 	bool Admin::Init( ID3D11Device *pDevice, ID3D11DeviceContext *pContext )
 	{
-		instances.clear();
+		UnloadEffectAll();
 		LoadParameter();
 
 		if ( wasInitialized ) { return true; }
@@ -170,7 +168,7 @@ namespace Effect
 	}
 	void Admin::Uninit()
 	{
-		instances.clear();
+		UnloadEffectAll();
 
 		pManager->Destroy();
 		pRenderer->Destroy();
@@ -310,23 +308,29 @@ namespace Effect
 		}
 		// else
 
-		const stdEfkString filePath = GetEffectPath( attr );
+		if ( IsOutOfRange( attr ) ) { return false; }
+		// else
 
-		const auto find = instances.find( filePath );
-		if ( find != instances.end() ) { return true; }
+		auto &pInstance = instances[scast<size_t>( attr )];
+		if ( pInstance ) { return true; }
 		// else
 
-		auto pointer = std::make_shared<Instance>( pManager, filePath );
-		auto result  = instances.insert( std::make_pair( filePath, std::move( pointer ) ) );
-		return result.second;
+		pInstance = std::make_shared<Instance>( pManager, GetEffectPath( attr ) );
+		return true;
 	}
 	void Admin::UnloadEffect( Effect::Kind attr )
 	{
-		instances.erase( GetEffectPath( attr ) );
+		if ( IsOutOfRange( attr ) ) { return; }
+		// else
+
+		instances[scast<size_t>( attr )].reset();
 	}
 	void Admin::UnloadEffectAll()
 	{
-		instances.clear();
+		for ( auto &it : instances )
+		{
+			it.reset();
+		}
 	}
 
 	void Admin::GenerateInstance( Kind kind, const Donya::Vector3 &position, int32_t startFrame )
@@ -353,21 +357,22 @@ namespace Effect
 		if ( IsOutOfRange( attr ) ) { return 1.0f; }
 		// else
 		
-		const auto scales = FetchParameter().effectScales;
+		// Refer the parameter directly, it is called at every generation
+		const auto &scales = FetchParameter().effectScales;
 		// Check the array's range
 		if ( scales.empty() )				{ return 1.0f; }
 		if ( scales.size() != kindCount )	{ return scales.front(); }
 		// else
 
-		return ( scales.empty() ) ? 1.0f : scales[scast<size_t>( attr )];
+		return scales[scast<size_t>( attr )];
 	}
 	Effekseer::Effect *Admin::GetEffectOrNullptr( Effect::Kind attr )
 	{
-		const auto find = instances.find( GetEffectPath( attr ) );
-		if ( find == instances.end() ) { return nullptr; }
+		if ( IsOutOfRange( attr ) ) { return nullptr; }
 		// else
 
-		return find->second->GetEffectOrNullptr();
+		const auto &pInstance = instances[scast<size_t>( attr )];
+		return ( pInstance ) ? pInstance->GetEffectOrNullptr() : nullptr;
 	}
 
 #if USE_IMGUI
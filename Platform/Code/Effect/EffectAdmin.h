@@ -1,13 +1,15 @@
 #pragma once
 
+#include <array>
 #include <d3d11.h>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "Effekseer.h"
 #include "EffekseerRendererDX11.h"
 
+#include "../Donya/Constant.h"	// Use scast macro
 #include "../Donya/Template.h"
 #include "../Donya/UseImGui.h"	// Use USE_IMGUI macro
 #include "../Donya/Vector.h"
@@ -21,6 +23,8 @@ namespace Effect
 	class Admin final : public Donya::Singleton<Admin>
 	{
 		friend Donya::Singleton<Admin>;
+	public:
+		static constexpr size_t			kindCount			= scast<size_t>( Kind::KindCount );
 	private:
 		static constexpr int			maxInstanceCount	= 4096;
 		static constexpr int32_t		maxSpriteCount		= 8192;
@@ -41,7 +45,7 @@ namespace Effect
 			bool IsValid() const;
 			Effekseer::Effect *GetEffectOrNullptr();
 		};
-		std::unordered_map<stdEfkString, std::shared_ptr<Instance>> instances; // The source effects
+		std::array<std::shared_ptr<Instance>, kindCount> instances; // The source effects, indexed by Effect::Kind. The file path is resolved only at loading.
 		std::vector<Effect::Handle> handles; // The instances of some effect
 	private:
 		Admin() = default;
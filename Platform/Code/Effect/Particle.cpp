@@ -0,0 +1,451 @@
+#include "Particle.h"
+
+#include <algorithm>				// Use std::min, std::copy, std::sort
+#include <cmath>
+#include <cstddef>					// Use offsetof
+
+#include "../Donya/Profiler.h"		// Use Now() and the benchmark helpers
+#include "../Donya/Useful.h"		// Use ToRadian()
+
+#include "../Parameter.h"
+#include "../Renderer.h"
+
+#undef max
+#undef min
+
+namespace
+{
+	static ParamOperator<Effect::Particle::Param> particleParam{ "Particle" };
+	const Effect::Particle::Param &FetchParameter()
+	{
+		return particleParam.Get();
+	}
+
+	constexpr float Lerp( float from, float to, float percent )
+	{
+		return from + ( ( to - from ) * percent );
+	}
+}
+
+namespace Effect
+{
+	namespace Particle
+	{
+	#if USE_IMGUI
+		void EmitterParam::ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			ImGui::DragInt		( u8"ő吔",							&capacity,		1.0f, 1, 65536 );
+			ImGui::DragInt		( u8"DxiႢ̂j",	&priority );
+			ImGui::DragInt		( u8"xɏo",						&burstCount,	1.0f, 0, 65536 );
+			ImGui::DragFloat	( u8"Eŏ[b]",					&lifeMin,		0.01f, 0.0f );
+			ImGui::DragFloat	( u8"Eő[b]",					&lifeMax,		0.01f, 0.0f );
+			ImGui::DragFloat	( u8"Eŏ[m/s]",					&speedMin,		0.01f );
+			ImGui::DragFloat	( u8"Eő[m/s]",					&speedMax,		0.01f );
+			ImGui::SliderFloat3	( u8"",								&direction.x,	-1.0f, 1.0f );
+			ImGui::DragFloat	( u8"̍L[x]",				&spreadDegree,	0.1f, 0.0f, 180.0f );
+			ImGui::DragFloat3	( u8"d[m/s^2]",						&gravity.x,		0.01f );
+			ImGui::DragFloat	( u8"[b]",						&drag,			0.01f, 0.0f );
+			ImGui::DragFloat	( u8"傫EJn",						&sizeBegin,		0.01f, 0.0f );
+			ImGui::DragFloat	( u8"傫EI",						&sizeEnd,		0.01f, 0.0f );
+			ImGui::ColorEdit4	( u8"FEJn",							&colorBegin.x );
+			ImGui::ColorEdit4	( u8"FEI",							&colorEnd.x );
+
+			lifeMin		= std::max( 0.0f, lifeMin	);
+			lifeMax		= std::max( lifeMin, lifeMax );
+			speedMax	= std::max( speedMin, speedMax );
+
+			ImGui::TreePop();
+		}
+		void Param::ShowImGuiNode()
+		{
+			if ( emitters.size() != kindCount )
+			{
+				emitters.resize( kindCount );
+			}
+
+			ImGui::DragInt( u8"Ŝ̍ő吔", &globalBudget, 1.0f, 0, 1000000 );
+
+			std::string caption{};
+			for ( size_t i = 0; i < kindCount; ++i )
+			{
+				caption = GetKindName( scast<Kind>( i ) );
+				emitters[i].ShowImGuiNode( caption );
+			}
+		}
+	#endif // USE_IMGUI
+
+		void System::Init( const EmitterParam &initParam, unsigned int randomSeed )
+		{
+			param		= initParam;
+			capacity	= scast<size_t>( std::max( 0, param.capacity ) );
+			aliveCount	= 0;
+
+			for ( auto *pArray : { &posX, &posY, &posZ, &velX, &velY, &velZ, &age, &life } )
+			{
+				pArray->assign( capacity, 0.0f );
+			}
+
+			// The xorshift requires the non-zero state
+			randomState = ( randomSeed ) ? randomSeed : 1U;
+		}
+		void System::SetParameter( const EmitterParam &newParam )
+		{
+			if ( scast<size_t>( std::max( 0, newParam.capacity ) ) != capacity )
+			{
+				Init( newParam, randomState );
+				return;
+			}
+			// else
+
+			param = newParam;
+		}
+		size_t System::Emit( size_t count, const Donya::Vector3 &wsOrigin, const Donya::Vector3 &direction )
+		{
+			count = std::min( count, GetFreeCount() );
+			if ( !count ) { return 0; }
+			// else
+
+			const Donya::Vector3 axis = ( direction.IsZero() ) ? param.direction : direction;
+			const Donya::Vector3 unitAxis = ( axis.IsZero() ) ? Donya::Vector3::Up() : axis.Unit();
+
+			Donya::Vector3 velocity;
+			for ( size_t i = aliveCount; i < aliveCount + count; ++i )
+			{
+				velocity = MakeDirection( unitAxis ) * RandomFloat( param.speedMin, param.speedMax );
+
+				posX[i] = wsOrigin.x;
+				posY[i] = wsOrigin.y;
+				posZ[i] = wsOrigin.z;
+				velX[i] = velocity.x;
+				velY[i] = velocity.y;
+				velZ[i] = velocity.z;
+				age[i]	= 0.0f;
+				life[i]	= RandomFloat( param.lifeMin, param.lifeMax );
+			}
+
+			aliveCount += count;
+			return count;
+		}
+		void System::Update( float elapsedTime )
+		{
+			if ( !aliveCount ) { return; }
+			// else
+
+			Integrate( elapsedTime );
+			Age( elapsedTime );
+			Kill();
+		}
+		size_t System::EvictOldest( size_t count )
+		{
+			count = std::min( count, aliveCount );
+			if ( !count ) { return 0; }
+			// else
+
+			for ( auto *pArray : { &posX, &posY, &posZ, &velX, &velY, &velZ, &age, &life } )
+			{
+				std::copy( pArray->begin() + count, pArray->begin() + aliveCount, pArray->begin() );
+			}
+
+			aliveCount -= count;
+			return count;
+		}
+		void System::Clear()
+		{
+			aliveCount = 0;
+		}
+		void System::AppendInstances( std::vector<Instance> *pDest ) const
+		{
+			Instance instance{};
+			instance.matWorld = Donya::Vector4x4::Identity();
+			for ( size_t i = 0; i < aliveCount; ++i )
+			{
+				const float percent = ( 0.0f < life[i] ) ? std::min( 1.0f, age[i] / life[i] ) : 1.0f;
+				const float size = Lerp( param.sizeBegin, param.sizeEnd, percent );
+
+				instance.matWorld._11 = size;
+				instance.matWorld._22 = size;
+				instance.matWorld._33 = size;
+				instance.matWorld._41 = posX[i];
+				instance.matWorld._42 = posY[i];
+				instance.matWorld._43 = posZ[i];
+				instance.color.x = Lerp( param.colorBegin.x, param.colorEnd.x, percent );
+				instance.color.y = Lerp( param.colorBegin.y, param.colorEnd.y, percent );
+				instance.color.z = Lerp( param.colorBegin.z, param.colorEnd.z, percent );
+				instance.color.w = Lerp( param.colorBegin.w, param.colorEnd.w, percent );
+				pDest->emplace_back( instance );
+			}
+		}
+		void System::Integrate( float elapsedTime )
+		{
+			// These loops are written per component without branches, so the compiler can vectorize them
+			const float dragFactor = std::max( 0.0f, 1.0f - ( param.drag * elapsedTime ) );
+			auto IntegrateAxis = [&]( float *pPos, float *pVel, float acceleration )
+			{
+				const float velocityDelta = acceleration * elapsedTime;
+				for ( size_t i = 0; i < aliveCount; ++i )
+				{
+					pVel[i] = ( pVel[i] * dragFactor ) + velocityDelta;
+					pPos[i] += pVel[i] * elapsedTime;
+				}
+			};
+			IntegrateAxis( posX.data(), velX.data(), param.gravity.x );
+			IntegrateAxis( posY.data(), velY.data(), param.gravity.y );
+			IntegrateAxis( posZ.data(), velZ.data(), param.gravity.z );
+		}
+		void System::Age( float elapsedTime )
+		{
+			float *pAge = age.data();
+			for ( size_t i = 0; i < aliveCount; ++i )
+			{
+				pAge[i] += elapsedTime;
+			}
+		}
+		void System::Kill()
+		{
+			// Skip the front particles that are alive, they do not need to move
+			size_t write = 0;
+			while ( write < aliveCount && age[write] < life[write] )
+			{
+				write++;
+			}
+
+			// Compact the alive particles with keeping the order
+			for ( size_t read = write + 1; read < aliveCount; ++read )
+			{
+				if ( life[read] <= age[read] ) { continue; }
+				// else
+
+				posX[write]	= posX[read];
+				posY[write]	= posY[read];
+				posZ[write]	= posZ[read];
+				velX[write]	= velX[read];
+				velY[write]	= velY[read];
+				velZ[write]	= velZ[read];
+				age[write]	= age[read];
+				life[write]	= life[read];
+				write++;
+			}
+
+			aliveCount = write;
+		}
+		Donya::Vector3 System::MakeDirection( const Donya::Vector3 &unitAxis )
+		{
+			// Make a basis that the z axis is the "unitAxis"
+			const Donya::Vector3 helper = ( fabsf( unitAxis.y ) < 0.99f ) ? Donya::Vector3::Up() : Donya::Vector3::Right();
+			const Donya::Vector3 tangent	= Donya::Vector3::Cross( helper, unitAxis ).Unit();
+			const Donya::Vector3 bitangent	= Donya::Vector3::Cross( unitAxis, tangent );
+
+			// Choose a direction in the cone uniformly
+			const float cosSpread	= cosf( ToRadian( std::max( 0.0f, std::min( 180.0f, param.spreadDegree ) ) ) );
+			const float cosTheta	= Lerp( 1.0f, cosSpread, RandomFloat( 0.0f, 1.0f ) );
+			const float sinTheta	= sqrtf( std::max( 0.0f, 1.0f - ( cosTheta * cosTheta ) ) );
+			const float phi			= RandomFloat( 0.0f, ToRadian( 360.0f ) );
+
+			return	( unitAxis	* cosTheta )
+				+	( tangent	* ( cosf( phi ) * sinTheta ) )
+				+	( bitangent	* ( sinf( phi ) * sinTheta ) );
+		}
+		float System::RandomFloat( float min, float max )
+		{
+			// xorshift32. It is faster than the Donya::Random, and the result is reproducible by the seed.
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 17;
+			randomState ^= randomState << 5;
+
+			const float percent = scast<float>( randomState >> 8 ) / scast<float>( 1U << 24 );
+			return Lerp( min, max, percent );
+		}
+
+
+		void Admin::Init()
+		{
+			LoadParameter();
+		}
+		void Admin::Uninit()
+		{
+			ClearInstances();
+			instances.clear();
+			instances.shrink_to_fit();
+		}
+		void Admin::Update( float elapsedTime )
+		{
+			const auto beginNS = Donya::Profiler::Now();
+
+			for ( auto &it : systems )
+			{
+				it.Update( elapsedTime );
+			}
+
+			statistics.aliveCount		= CalcAliveCount();
+			statistics.updateSeconds	= scast<float>( Donya::Profiler::Now() - beginNS ) * 0.000000001f;
+		}
+		void Admin::Draw( RenderingHelper *pRenderer, const Donya::Vector4x4 &VP, const Donya::Vector3 &lightDirection )
+		{
+			if ( !pRenderer ) { return; }
+			// else
+
+			instances.clear();
+			for ( const auto &it : systems )
+			{
+				it.AppendInstances( &instances );
+			}
+			if ( instances.empty() ) { return; }
+			// else
+
+			using RendererInstance = Donya::Model::InstancedPrimitiveRenderer::Instance;
+			static_assert( sizeof( Instance ) == sizeof( RendererInstance ), "The instance layouts must be same!" );
+			static_assert( offsetof( Instance, color ) == offsetof( RendererInstance, drawColor ), "The instance layouts must be same!" );
+
+			const auto *pInstances = reinterpret_cast<const RendererInstance *>( instances.data() );
+			constexpr float lightBias = 0.0f; // Do not shade the particles
+			pRenderer->DrawInstancedCubes( pInstances, instances.size(), VP, lightDirection, lightBias );
+		}
+
+		void Admin::LoadParameter()
+		{
+			particleParam.LoadParameter();
+			ApplyParameter( FetchParameter() );
+		}
+		size_t Admin::Emit( Kind kind, const Donya::Vector3 &wsPos, const Donya::Vector3 &direction )
+		{
+			const size_t index = scast<size_t>( kind );
+			if ( kindCount <= index ) { return 0; }
+			// else
+
+			auto &system = systems[index];
+			const size_t request = scast<size_t>( std::max( 0, system.GetParameter().burstCount ) );
+			if ( !request ) { return 0; }
+			// else
+
+			// The new particles take the place of the old ones
+			const size_t aliveCount = CalcAliveCount();
+			const size_t budgetFree	= ( aliveCount < globalBudget ) ? globalBudget - aliveCount : 0;
+			if ( budgetFree < request )
+			{
+				statistics.evictedCount += Evict( request - budgetFree, system.GetPriority() );
+			}
+			if ( system.GetFreeCount() < request )
+			{
+				statistics.evictedCount += system.EvictOldest( request - system.GetFreeCount() );
+			}
+
+			const size_t currentFree = globalBudget - std::min( globalBudget, CalcAliveCount() );
+			const size_t emitted = system.Emit( std::min( request, currentFree ), wsPos, direction );
+			statistics.emittedCount += emitted;
+			statistics.droppedCount += request - emitted;
+			return emitted;
+		}
+		void Admin::ClearInstances()
+		{
+			for ( auto &it : systems )
+			{
+				it.Clear();
+			}
+			statistics.aliveCount = 0;
+		}
+		void Admin::ResetStatistics()
+		{
+			statistics = Statistics{};
+			statistics.aliveCount = CalcAliveCount();
+		}
+		size_t Admin::CalcAliveCount() const
+		{
+			size_t sum = 0;
+			for ( const auto &it : systems )
+			{
+				sum += it.GetAliveCount();
+			}
+			return sum;
+		}
+		void Admin::ApplyParameter( const Param &param )
+		{
+			globalBudget = scast<size_t>( std::max( 0, param.globalBudget ) );
+
+			for ( size_t i = 0; i < kindCount; ++i )
+			{
+				const EmitterParam emitter = ( i < param.emitters.size() ) ? param.emitters[i] : EmitterParam{};
+				systems[i].SetParameter( emitter );
+				evictionOrder[i] = i;
+			}
+
+			std::stable_sort
+			(
+				evictionOrder.begin(), evictionOrder.end(),
+				[&]( size_t L, size_t R )
+				{
+					return systems[L].GetPriority() < systems[R].GetPriority();
+				}
+			);
+		}
+		size_t Admin::Evict( size_t count, int requestorPriority )
+		{
+			size_t evicted = 0;
+			for ( const size_t index : evictionOrder )
+			{
+				if ( count <= evicted ) { break; }
+				if ( requestorPriority < systems[index].GetPriority() ) { break; }
+				// else
+
+				evicted += systems[index].EvictOldest( count - evicted );
+			}
+			return evicted;
+		}
+
+	#if USE_IMGUI
+		void Admin::ShowImGuiNode( const std::string &nodeCaption )
+		{
+			if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+			// else
+
+			ImGui::Text( u8"F%d^%d", scast<int>( statistics.aliveCount ), scast<int>( globalBudget ) );
+			for ( size_t i = 0; i < kindCount; ++i )
+			{
+				ImGui::Text
+				(
+					u8"%sF%d^%d",
+					GetKindName( scast<Kind>( i ) ),
+					scast<int>( systems[i].GetAliveCount() ),
+					scast<int>( systems[i].GetCapacity() )
+				);
+			}
+			ImGui::Text( u8"oF%dCǂoF%dCjF%d", scast<int>( statistics.emittedCount ), scast<int>( statistics.evictedCount ), scast<int>( statistics.droppedCount ) );
+			ImGui::Text( u8"XVԁF%6.3f ms", statistics.updateSeconds * 1000.0f );
+			if ( ImGui::Button( u8"vZbg" ) ) { ResetStatistics(); }
+			if ( ImGui::Button( u8"Sď" ) ) { ClearInstances(); }
+
+			if ( ImGui::TreeNode( u8"V~[V̌v" ) )
+			{
+				static Donya::Profiler::BenchmarkCounts counts{ 100000, 60 };
+				static float secondsPerFrame = 0.0f;
+
+				if ( counts.ShowControls( u8"q̐", u8"t[", u8"v" ) )
+				{
+					EmitterParam benchmarkParam{};
+					benchmarkParam.capacity	= counts.elementCount;
+					benchmarkParam.lifeMin	= 1000.0f; // Keep the all particles alive while measuring
+					benchmarkParam.lifeMax	= 1000.0f;
+					benchmarkParam.drag		= 0.5f;
+
+					System system{};
+					system.Init( benchmarkParam );
+					system.Emit( scast<size_t>( counts.elementCount ), Donya::Vector3::Zero() );
+
+					constexpr float deltaTime = 1.0f / 60.0f;
+					secondsPerFrame = Donya::Profiler::MeasureAverageSeconds( counts.loopCount, [&]( int ) { system.Update( deltaTime ); } );
+				}
+				ImGui::Text( u8"1t[̍XVԁF%6.3f ms", secondsPerFrame * 1000.0f );
+
+				ImGui::TreePop();
+			}
+
+			particleParam.ShowImGuiNode( u8"p[^" );
+			ApplyParameter( FetchParameter() );
+
+			ImGui::TreePop();
+		}
+	#endif // USE_IMGUI
+	}
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "../Donya/Constant.h"		// Use scast macro
+#include "../Donya/Template.h"
+#include "../Donya/UseImGui.h"		// Use USE_IMGUI macro
+#include "../Donya/Vector.h"
+
+#include "ParticleParam.h"
+
+class RenderingHelper;
+
+namespace Effect
+{
+	/// <summary>
+	/// The particles that are simulated by our own code, instead of the Effekseer.
+	/// The simulation does not use GPU, so you can simulate and benchmark it without a device.
+	/// </summary>
+	namespace Particle
+	{
+		static constexpr size_t kindCount = scast<size_t>( Kind::KindCount );
+
+		/// <summary>
+		/// Same layout as the Donya::Model::InstancedPrimitiveRenderer::Instance.
+		/// </summary>
+		struct Instance
+		{
+			Donya::Vector4x4	matWorld;
+			Donya::Vector4		color;
+		};
+
+		/// <summary>
+		/// Stores the particles of an emitter as the structure of arrays.
+		/// The capacity is fixed at the Init(), so it does not allocate while emitting and simulating.
+		/// The alive particles are kept in the emitted order, so the front one is the oldest.
+		/// </summary>
+		class System
+		{
+		private:
+			EmitterParam		param;
+			size_t				capacity	= 0;
+			size_t				aliveCount	= 0;
+			std::vector<float>	posX, posY, posZ;
+			std::vector<float>	velX, velY, velZ;
+			std::vector<float>	age;		// Elapsed second
+			std::vector<float>	life;		// Second
+			unsigned int		randomState	= 1;
+		public:
+			/// <summary>
+			/// Allocates the arrays by the "param.capacity", and removes the all particles.
+			/// </summary>
+			void Init( const EmitterParam &param, unsigned int randomSeed = 1U );
+			/// <summary>
+			/// The particles are kept if the capacity was not changed, otherwise it is same as the Init().
+			/// </summary>
+			void SetParameter( const EmitterParam &param );
+			/// <summary>
+			/// Emits the particles at the "wsOrigin". If the "direction" is zero, the direction of the parameter is used.<para></para>
+			/// The count is clipped by the free space of the capacity. Returns the emitted count.
+			/// </summary>
+			size_t Emit( size_t count, const Donya::Vector3 &wsOrigin, const Donya::Vector3 &direction = Donya::Vector3::Zero() );
+			/// <summary>
+			/// Integrates, ages, and kills the particles.
+			/// </summary>
+			void Update( float elapsedTime );
+			/// <summary>
+			/// Removes the oldest particles. Returns the removed count.
+			/// </summary>
+			size_t EvictOldest( size_t count );
+			void Clear();
+		public:
+			size_t GetCapacity()	const { return capacity;		}
+			size_t GetAliveCount()	const { return aliveCount;		}
+			size_t GetFreeCount()	const { return capacity - aliveCount; }
+			int    GetPriority()	const { return param.priority;	}
+			const EmitterParam &GetParameter() const { return param; }
+			/// <summary>
+			/// Appends the alive particles as the cubes. The size and the color are interpolated by the age.
+			/// </summary>
+			void AppendInstances( std::vector<Instance> *pDestination ) const;
+		private:
+			void Integrate( float elapsedTime );
+			void Age( float elapsedTime );
+			void Kill();
+			Donya::Vector3 MakeDirection( const Donya::Vector3 &unitAxis );
+			float RandomFloat( float min, float max );
+		};
+
+		/// <summary>
+		/// Holds a system per kind, and keeps the count of alive particles within the global budget.
+		/// If an emission exceeds the budget, the oldest particles of the systems that have lower or same priority are evicted.
+		/// </summary>
+		class Admin final : public Donya::Singleton<Admin>
+		{
+			friend Donya::Singleton<Admin>;
+		public:
+			struct Statistics
+			{
+				size_t aliveCount		= 0;
+				size_t emittedCount		= 0;	// Accumulated until the ResetStatistics()
+				size_t evictedCount		= 0;	// Accumulated until the ResetStatistics()
+				size_t droppedCount		= 0;	// The count that could not emit. Accumulated until the ResetStatistics()
+				float  updateSeconds	= 0.0f;	// The last Update()
+			};
+		private:
+			std::array<System, kindCount>	systems;
+			std::array<size_t, kindCount>	evictionOrder{};	// The indices of "systems", sorted by ascending priority
+			size_t							globalBudget = 0;
+			Statistics						statistics;
+			std::vector<Instance>			instances;			// Workspace for drawing
+		private:
+			Admin() = default;
+		public:
+			void Init();
+			void Uninit();
+
+			void Update( float elapsedTime );
+			/// <summary>
+			/// Draws the particles by the instanced cubes. Please call while the depth buffer of the scene is bound.
+			/// </summary>
+			void Draw( RenderingHelper *pRenderer, const Donya::Vector4x4 &matViewProj, const Donya::Vector3 &lightDirection );
+		public:
+			/// <summary>
+			/// Loads the parameter, then applies it to the systems.
+			/// </summary>
+			void LoadParameter();
+			/// <summary>
+			/// Emits the "burstCount" particles of the "kind". If the "direction" is zero, the direction of the parameter is used.<para></para>
+			/// The "burstCount" is zero by default, then this does nothing. Returns the emitted count.
+			/// </summary>
+			size_t Emit( Kind kind, const Donya::Vector3 &wsPosition, const Donya::Vector3 &direction = Donya::Vector3::Zero() );
+			/// <summary>
+			/// Removes the all particles.
+			/// </summary>
+			void ClearInstances();
+			void ResetStatistics();
+		public:
+			size_t CalcAliveCount() const;
+			const Statistics &GetStatistics() const { return statistics; }
+		private:
+			void ApplyParameter( const Param &param );
+			/// <summary>
+			/// Evicts the oldest particles of the systems whose priority is lower than or same as the "requestorPriority". Returns the evicted count.
+			/// </summary>
+			size_t Evict( size_t count, int requestorPriority );
+		public:
+		#if USE_IMGUI
+			void ShowImGuiNode( const std::string &nodeCaption );
+		#endif // USE_IMGUI
+		};
+	}
+}
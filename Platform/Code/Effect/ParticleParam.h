@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include "../Donya/Serializer.h"
+#include "../Donya/UseImGui.h"		// Use USE_IMGUI macro
+#include "../Donya/Vector.h"
+
+namespace Effect
+{
+	namespace Particle
+	{
+		enum class Kind
+		{
+			HitSpark,
+			DefeatDebris,
+			MuzzleFlash,
+
+			KindCount
+		};
+		constexpr const char *GetKindName( Kind kind )
+		{
+			switch ( kind )
+			{
+			case Kind::HitSpark:		return "HitSpark";
+			case Kind::DefeatDebris:	return "DefeatDebris";
+			case Kind::MuzzleFlash:		return "MuzzleFlash";
+			default: break;
+			}
+
+			// Fail safe
+			return "ERROR_KIND";
+		}
+
+		/// <summary>
+		/// The parameter of an emitter. A particle system is made per emitter.
+		/// </summary>
+		struct EmitterParam
+		{
+		public:
+			int				capacity		= 256;		// The count of particles that the system can hold at once
+			int				priority		= 0;		// The system that has lower priority is evicted first when the global budget is full
+			int				burstCount		= 0;		// The count of particles per one emission. Zero disables the emitter, so the particles appear only if the parameter file enables them
+			float			lifeMin			= 0.2f;		// Second
+			float			lifeMax			= 0.4f;		// Second
+			float			speedMin		= 4.0f;		// [m/s]
+			float			speedMax		= 8.0f;		// [m/s]
+			Donya::Vector3	direction		{ 0.0f, 1.0f, 0.0f };
+			float			spreadDegree	= 180.0f;	// The angle from the "direction". 180 degree emits to all directions.
+			Donya::Vector3	gravity			{ 0.0f, -20.0f, 0.0f };
+			float			drag			= 0.0f;		// The velocity decreases by this ratio per second
+			float			sizeBegin		= 0.2f;
+			float			sizeEnd			= 0.0f;
+			Donya::Vector4	colorBegin		{ 1.0f, 1.0f, 1.0f, 1.0f };
+			Donya::Vector4	colorEnd		{ 1.0f, 1.0f, 1.0f, 0.0f };
+		private:
+			friend class cereal::access;
+			template<class Archive>
+			void serialize( Archive &archive, std::uint32_t version )
+			{
+				archive
+				(
+					CEREAL_NVP( capacity		),
+					CEREAL_NVP( priority		),
+					CEREAL_NVP( burstCount		),
+					CEREAL_NVP( lifeMin			),
+					CEREAL_NVP( lifeMax			),
+					CEREAL_NVP( speedMin		),
+					CEREAL_NVP( speedMax		),
+					CEREAL_NVP( direction		),
+					CEREAL_NVP( spreadDegree	),
+					CEREAL_NVP( gravity			),
+					CEREAL_NVP( drag			),
+					CEREAL_NVP( sizeBegin		),
+					CEREAL_NVP( sizeEnd			),
+					CEREAL_NVP( colorBegin		),
+					CEREAL_NVP( colorEnd		)
+				);
+
+				if ( 1 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+			}
+		public:
+		#if USE_IMGUI
+			void ShowImGuiNode( const std::string &nodeCaption ); // Implement at Particle.cpp
+		#endif // USE_IMGUI
+		};
+
+		struct Param
+		{
+		public:
+			int							globalBudget = 4096;	// The upper limit of alive particles of all systems
+			std::vector<EmitterParam>	emitters;				// size() == Particle::Kind::KindCount
+		private:
+			friend class cereal::access;
+			template<class Archive>
+			void serialize( Archive &archive, std::uint32_t version )
+			{
+				archive
+				(
+					CEREAL_NVP( globalBudget	),
+					CEREAL_NVP( emitters		)
+				);
+
+				if ( 1 <= version )
+				{
+					// archive( CEREAL_NVP( x ) );
+				}
+			}
+		public:
+		#if USE_IMGUI
+			void ShowImGuiNode(); // Implement at Particle.cpp
+		#endif // USE_IMGUI
+		};
+	}
+}
+CEREAL_CLASS_VERSION( Effect::Particle::EmitterParam,	0 )
+CEREAL_CLASS_VERSION( Effect::Particle::Param,			0 )
@@ -90,7 +90,9 @@ namespace Enemy
 		const size_t currentMotionIndex	= scast<size_t>( currentMotion );
 		const size_t playSpeedCount		= playSpeeds.size();
 		const float  motionAcceleration	= ( playSpeedCount <= currentMotionIndex ) ? 1.0f : playSpeeds[currentMotionIndex];
-		UpdateMotionIfCan( elapsedTime * motionAcceleration, currentMotionIndex );
+		// The end of Fire motion returns to Ready, so I do not throttle it.
+		const bool   fullRate			= ( currentMotion == MotionKind::Fire );
+		UpdateMotionIfCan( elapsedTime * motionAcceleration, currentMotionIndex, fullRate );
 	}
 	Kind SuperBallMachine::GetKind() const { return Kind::SuperBallMachine; }
 	Definition::Damage SuperBallMachine::GetTouchDamage() const
@@ -2,12 +2,15 @@
 
 #include <array>
 
+#include "Donya/Profiler.h"	// Use Now() for the statistics
+
 #if USE_IMGUI
 #include "Donya/Useful.h"	// Use ShowMessageBox()
 #endif // USE_IMGUI
 
 #include "Common.h"
 #include "Effect/EffectAdmin.h"
+#include "Effect/Particle.h"
 #include "Enemies/SuperBallMachine.h"
 #include "Enemies/Togehero.h"
 #include "FilePath.h"
@@ -32,39 +35,42 @@ namespace Enemy
 
 		static std::array<std::shared_ptr<ModelHelper::SkinningSet>, kindCount> modelPtrs{ nullptr };
 
-		bool LoadModels()
+		// Many enemies of the same kind play the same motion, so they share the poses baked at this rate
+		constexpr float poseBakeStep = 1.0f / 60.0f;
+
+		// The waiting enemies in the blocks around the screen are updated.
+		// The margin must be larger than the camera movement of a frame, for updating the enemies at out of the screen before they come in.
+		constexpr float activationBlockSize	= Tile::unitWholeSize * scast<float>( ActivationGrid::defaultBlockTileCount );
+		constexpr float activationMargin	= activationBlockSize;
+
+		std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeLoads()
 		{
 			const std::string folderName = modelFolderName;
-			bool succeeded = true;
-			std::string filePath{};
+			std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> loads{};
 			for ( size_t i = 0; i < kindCount; ++i )
 			{
 				if ( modelPtrs[i] ) { continue; }
 				// else
 
-				filePath = MakeModelPath( folderName + modelNames[i] );
-
-				if ( !Donya::IsExistFile( filePath ) )
-				{
-					const std::string msg = "Error: File is not found: " + filePath + "\n";
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
-
-				modelPtrs[i] = std::make_shared<ModelHelper::SkinningSet>();
-				const bool result = ModelHelper::Load( filePath, modelPtrs[i].get() );
-				if ( !result )
+				auto StoreModel = [i]( const std::shared_ptr<ModelHelper::SkinningSet> &pModel )
 				{
-					modelPtrs[i].reset(); // Make not loaded state
+					pModel->poseCache.Bake( pModel->motionHolder, poseBakeStep );
+					modelPtrs[i] = pModel;
+				};
+				loads.emplace_back
+				(
+					std::make_shared<ModelHelper::StagedSkinningLoad>( MakeModelPath( folderName + modelNames[i] ), StoreModel )
+				);
+			}
 
-					const std::string msg = "Failed: Loading failed: " + filePath;
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
+			return loads;
+		}
+		bool LoadModels()
+		{
+			bool succeeded = true;
+			for ( const auto &pLoad : MakeLoads() )
+			{
+				if ( !pLoad->LoadAll() ) { succeeded = false; }
 			}
 
 			return succeeded;
@@ -124,6 +130,10 @@ namespace Enemy
 		Parameter::Load();
 		return LoadModels();
 	}
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads()
+	{
+		return MakeLoads();
+	}
 
 #if USE_IMGUI
 	void InitializeParam::ShowImGuiNode( const std::string &nodeCaption )
@@ -234,6 +244,7 @@ namespace Enemy
 		// Update wait/alive state
 
 		UpdateOutSideState( wsScreen );
+		motionThrottle.SetLevel( AnimationLOD::Judge( body, wsScreen ) );
 		const bool nowWaiting = NowWaiting();
 		const bool onOutSide  = OnOutSide();
 		if ( nowWaiting != onOutSide )
@@ -385,12 +396,21 @@ namespace Enemy
 	{
 		return waitForRespawn;
 	}
-	void Base::UpdateMotionIfCan( float elapsedTime, int motionIndex )
+	void Base::UpdateMotionIfCan( float elapsedTime, int motionIndex, bool fullRate )
 	{
 		if ( !model.IsAssignableIndex( motionIndex ) ) { return; }
 		// else
 
-		model.UpdateMotion( elapsedTime, motionIndex );
+		if ( fullRate )
+		{
+			motionThrottle.SetLevel( AnimationLOD::Level::Full );
+		}
+
+		float motionElapsedTime = 0.0f;
+		if ( !motionThrottle.Consume( elapsedTime, &motionElapsedTime ) ) { return; }
+		// else
+
+		model.UpdateMotion( motionElapsedTime, motionIndex );
 	}
 	void Base::UpdateOutSideState( const Donya::Collision::Box3F &wsScreen )
 	{
@@ -433,6 +453,7 @@ namespace Enemy
 		{
 			// Generate the effect before resetting the position
 			Effect::Admin::Get().GenerateInstance( Effect::Kind::DefeatEnemy_Small, GetPosition() );
+			Effect::Particle::Admin::Get().Emit( Effect::Particle::Kind::DefeatDebris, GetPosition() );
 
 			BeginWaitIfActive();
 		}
@@ -488,12 +509,42 @@ namespace Enemy
 	}
 	void Admin::Update( float elapsedTime, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreen )
 	{
-		for ( auto &pIt : enemyPtrs )
+		const std::int64_t beginNS = Donya::Profiler::Now();
+
+		if ( needRebuild ) { RebuildActivation(); }
+		// else
+
+		updateStamp++;
+		updateIndices.clear();
+		const size_t visitedBlockCount = spawnGrid.Select( wsScreen, activationMargin, &updateIndices );
+		updateIndices.insert( updateIndices.end(), awakeIndices.begin(), awakeIndices.end() );
+		awakeIndices.clear();
+
+		size_t updatedCount = 0;
+		for ( const size_t &index : updateIndices )
 		{
-			if ( pIt ) { pIt->Update( elapsedTime, wsTargetPos, wsScreen ); }
+			if ( updatedStamps[index] == updateStamp ) { continue; }
+			// else
+			updatedStamps[index] = updateStamp;
+
+			auto &pIt = enemyPtrs[index];
+			if ( !pIt ) { continue; }
+			// else
+
+			pIt->Update( elapsedTime, wsTargetPos, wsScreen );
+			updatedCount++;
+
+			if ( !pIt->NowWaiting() ) { awakeIndices.emplace_back( index ); }
+			if ( pIt->ShouldRemove() ) { needRemove = true; }
 		}
 
 		RemoveEnemiesIfNeeded();
+
+		updateStatistics.enemyCount			= enemyPtrs.size();
+		updateStatistics.updatedCount		= updatedCount;
+		updateStatistics.visitedBlockCount	= visitedBlockCount;
+		updateStatistics.blockCount			= spawnGrid.GetBlockCount();
+		updateStatistics.lastSeconds		= scast<float>( Donya::Profiler::Now() - beginNS ) * 0.000000001f;
 	}
 	void Admin::PhysicUpdate( float elapsedTime, const Map &terrain )
 	{
@@ -529,14 +580,19 @@ namespace Enemy
 			if ( pIt ) { pIt->Uninit(); }
 		}
 		enemyPtrs.clear();
+		needRebuild = true;
+	}
+	std::string Admin::MakeStageFilePath( int stageNumber, bool fromBinary )
+	{
+		return	( fromBinary )
+				? MakeStageParamPathBinary( ID, stageNumber )
+				: MakeStageParamPathJson  ( ID, stageNumber );
 	}
 	bool Admin::LoadEnemies( int stageNumber, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreen, bool fromBinary )
 	{
 		ClearInstances();
 
-		const std::string filePath	= ( fromBinary )
-									? MakeStageParamPathBinary( ID, stageNumber )
-									: MakeStageParamPathJson  ( ID, stageNumber );
+		const std::string filePath	= MakeStageFilePath( stageNumber, fromBinary );
 		Donya::Serializer tmp;
 		const bool succeeded		= ( fromBinary )
 									? tmp.LoadBinary( *this, filePath.c_str(), ID )
@@ -548,6 +604,7 @@ namespace Enemy
 			if ( pIt ) { pIt->Init( pIt->GetInitializer(), wsTargetPos, wsScreen ); }
 		}
 
+		needRebuild = true;
 		return succeeded;
 	}
 	size_t Admin::GetInstanceCount() const
@@ -564,8 +621,39 @@ namespace Enemy
 		// else
 		return enemyPtrs[instanceIndex];
 	}
+	const Admin::UpdateStatistics &Admin::GetUpdateStatistics() const
+	{
+		return updateStatistics;
+	}
+	void Admin::RebuildActivation()
+	{
+		const size_t enemyCount = enemyPtrs.size();
+
+		std::vector<Donya::Vector3> spawnPoints( enemyCount, Donya::Vector3::Zero() );
+		awakeIndices.clear();
+		for ( size_t i = 0; i < enemyCount; ++i )
+		{
+			const auto &pIt = enemyPtrs[i];
+			if ( !pIt ) { continue; }
+			// else
+
+			spawnPoints[i] = pIt->GetInitializer().wsPos;
+			if ( !pIt->NowWaiting() ) { awakeIndices.emplace_back( i ); }
+		}
+
+		spawnGrid.Build( spawnPoints, activationBlockSize );
+		updatedStamps.assign( enemyCount, 0 );
+		updateStamp = 0;
+		needRebuild = false;
+	}
 	void Admin::RemoveEnemiesIfNeeded()
 	{
+		if ( !needRemove ) { return; }
+		// else
+		needRemove = false;
+
+		const size_t oldCount = enemyPtrs.size();
+
 		auto itr = std::remove_if
 		(
 			enemyPtrs.begin(), enemyPtrs.end(),
@@ -575,6 +663,9 @@ namespace Enemy
 			}
 		);
 		enemyPtrs.erase( itr, enemyPtrs.end() );
+
+		// The indices are changed
+		if ( enemyPtrs.size() != oldCount ) { needRebuild = true; }
 	}
 #if USE_IMGUI
 	void Admin::AppendEnemy( Kind kind, const InitializeParam &parameter, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreen )
@@ -602,6 +693,7 @@ namespace Enemy
 
 		instance->Init( parameter, wsTargetPos, wsScreen );
 		enemyPtrs.emplace_back( std::move( instance ) );
+		needRebuild = true;
 	}
 	void Admin::RemakeByCSV( const CSVLoader &loadedData, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreen )
 	{
@@ -648,6 +740,7 @@ namespace Enemy
 			if ( pIt ) { pIt->Uninit(); }
 		}
 		enemyPtrs.clear();
+		needRebuild = true;
 
 		const auto &data = loadedData.Get();
 		const size_t rowCount = data.size();
@@ -678,6 +771,93 @@ namespace Enemy
 		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
 		// else
 
+		ImGui::Text
+		(
+			u8"XVGF%d/%d́CubNF%d/%dC%6.3f ms",
+			scast<int>( updateStatistics.updatedCount		),
+			scast<int>( updateStatistics.enemyCount			),
+			scast<int>( updateStatistics.visitedBlockCount	),
+			scast<int>( updateStatistics.blockCount			),
+			updateStatistics.lastSeconds * 1000.0f
+		);
+		if ( ImGui::TreeNode( u8"̌v" ) )
+		{
+			// Compares the whole sweep and the block selection by the screen test, with the synthetic spawn points.
+			// The screen test is same as the Base::UpdateOutSideState().
+
+			static Donya::Profiler::BenchmarkCounts counts{ 10000, 600 };
+			static float	sweepSeconds			= 0.0f;	// Per frame
+			static float	selectSeconds			= 0.0f;	// Per frame
+			static float	averageSelectedCount	= 0.0f;
+
+			if ( counts.ShowControls( u8"oʒu̐", u8"t[", u8"v" ) )
+			{
+				const int frameCountOfBenchmark = counts.loopCount;
+
+				// Place the points along the stage like a long horizontal level
+				constexpr float pointInterval = Tile::unitWholeSize * 2.0f;
+				const float stageWidth = pointInterval * scast<float>( counts.elementCount );
+				std::vector<Donya::Vector3> points( scast<size_t>( counts.elementCount ) );
+				std::vector<Donya::Collision::Box3F> bodies( points.size() );
+				for ( size_t i = 0; i < points.size(); ++i )
+				{
+					points[i] = Donya::Vector3{ pointInterval * scast<float>( i ), Tile::unitWholeSize * scast<float>( i % 13 ), 0.0f };
+					bodies[i].pos	= points[i];
+					bodies[i].size	= Donya::Vector3{ 0.5f, 0.5f, 0.5f };
+					bodies[i].exist	= true;
+				}
+
+				ActivationGrid grid;
+				grid.Build( points, activationBlockSize );
+
+				Donya::Collision::Box3F screen = wsScreen;
+				auto MoveScreen = [&]( int frame )
+				{
+					screen.pos.x = stageWidth * scast<float>( frame ) / scast<float>( frameCountOfBenchmark );
+				};
+
+				size_t insideCount = 0; // Prevent the optimization
+				sweepSeconds = Donya::Profiler::MeasureAverageSeconds
+				(
+					frameCountOfBenchmark,
+					[&]( int f )
+					{
+						MoveScreen( f );
+						for ( const auto &body : bodies )
+						{
+							if ( Donya::Collision::IsHit( body, screen, /* considerExistFlag = */ false ) ) { insideCount++; }
+						}
+					}
+				);
+
+				std::vector<size_t> selected;
+				size_t selectedCount = 0;
+				selectSeconds = Donya::Profiler::MeasureAverageSeconds
+				(
+					frameCountOfBenchmark,
+					[&]( int f )
+					{
+						MoveScreen( f );
+						selected.clear();
+						grid.Select( screen, activationMargin, &selected );
+						for ( const size_t &index : selected )
+						{
+							if ( Donya::Collision::IsHit( bodies[index], screen, /* considerExistFlag = */ false ) ) { insideCount--; }
+						}
+						selectedCount += selected.size();
+					}
+				);
+				averageSelectedCount = scast<float>( selectedCount ) / scast<float>( frameCountOfBenchmark );
+
+				// The both must find the same enemies in the screen
+				_ASSERT_EXPR( insideCount == 0, L"Error: The block selection missed some enemies!" );
+			}
+			ImGui::Text( u8"SđF%8.4f ms/frame",								sweepSeconds  * 1000.0f );
+			ImGui::Text( u8"ubNIF%8.4f ms/framei%5.1f́j",	selectSeconds * 1000.0f, averageSelectedCount );
+
+			ImGui::TreePop();
+		}
+
 		if ( ImGui::TreeNode( u8"̂" ) )
 		{
 			const size_t enemyCount = enemyPtrs.size();
@@ -719,6 +899,7 @@ namespace Enemy
 
 		std::string caption = Donya::MakeArraySuffix( index );
 		bool  treeIsOpen = pEnemy->ShowImGuiNode( caption );
+		if ( pEnemy->ShouldRemove() ) { needRemove = true; }
 		if ( !treeIsOpen )
 		{
 			caption = "[";
@@ -13,6 +13,8 @@
 #include "Donya/Template.h"		// Use Singleton<>
 #include "Donya/Vector.h"
 
+#include "ActivationGrid.h"
+#include "AnimationLOD.h"
 #include "CSVLoader.h"
 #include "Damage.h"
 #include "Map.h"
@@ -57,6 +59,11 @@ namespace Enemy
 	}
 
 	bool LoadResource();
+	/// <summary>
+	/// Makes the loads of the models that have not been loaded. Each load stores its model when it finishes.<para></para>
+	/// It is for loading by the stages, so please call Parameter::Load() also. LoadResource() does both.
+	/// </summary>
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads();
 
 	struct InitializeParam
 	{
@@ -100,6 +107,7 @@ namespace Enemy
 		InitializeParam initializer;
 	protected:
 		ModelHelper::SkinningOperator	model;
+		AnimationLOD::Throttle			motionThrottle;
 		using					 Actor::body;		// VS a terrain
 		Donya::Collision::Box3F			hurtBox;	// VS an attack
 		using					 Actor::orientation;
@@ -153,7 +161,11 @@ namespace Enemy
 	public:
 		bool NowWaiting() const;
 	protected:
-		void UpdateMotionIfCan( float elapsedTime, int motionIndex );
+		/// <summary>
+		/// Evaluates the motion through the motion throttle.
+		/// Please set true to "fullRate" when the gameplay waits the end of the motion(WasEnded()), then the throttle does not delay it.
+		/// </summary>
+		void UpdateMotionIfCan( float elapsedTime, int motionIndex, bool fullRate = false );
 		void UpdateOutSideState( const Donya::Collision::Box3F &wsScreenHitBox );
 		bool OnOutSide() const;
 		void BeginWaitIfActive();
@@ -182,8 +194,29 @@ namespace Enemy
 	class Admin : public Donya::Singleton<Admin>
 	{
 		friend Donya::Singleton<Admin>;
+	public:
+		struct UpdateStatistics
+		{
+			size_t	enemyCount			= 0;
+			size_t	updatedCount		= 0;	// The last Update()
+			size_t	visitedBlockCount	= 0;	// The last Update()
+			size_t	blockCount			= 0;
+			float	lastSeconds			= 0.0f;	// The time of last Update()
+		};
 	private: // shared_ptr<> make be able to copy
 		std::vector<std::shared_ptr<Base>> enemyPtrs;
+	private:
+		// Only the enemies around the screen and the awake enemies are updated.
+		// The waiting enemies are bucketed by their initial position.
+
+		ActivationGrid				spawnGrid;
+		std::vector<size_t>			updateIndices;		// Workspace of Update()
+		std::vector<size_t>			awakeIndices;		// The enemies that were not waiting at the last update. They are updated wherever they are.
+		std::vector<unsigned int>	updatedStamps;		// [enemy] The "updateStamp" of the last update, for skipping the duplicates
+		unsigned int				updateStamp			= 0;
+		bool						needRebuild			= true;
+		bool						needRemove			= false;
+		UpdateStatistics			updateStatistics;
 	private:
 		Admin() = default;
 	private:
@@ -207,11 +240,21 @@ namespace Enemy
 	public:
 		void ClearInstances();
 		bool LoadEnemies( int stageNumber, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreenHitBox, bool fromBinary );
+		/// <summary>
+		/// Returns the path of the file that LoadEnemies() reads.
+		/// </summary>
+		static std::string MakeStageFilePath( int stageNumber, bool fromBinary );
 	public:
 		size_t GetInstanceCount() const;
 		bool IsOutOfRange( size_t instanceIndex ) const;
 		std::shared_ptr<const Base> GetInstanceOrNullptr( size_t instanceIndex ) const;
+		const UpdateStatistics &GetUpdateStatistics() const;
 	private:
+		/// <summary>
+		/// Buckets the enemies by the initial position, and regards the not waiting enemies as awake.
+		/// Please call when the indices of enemies are changed.
+		/// </summary>
+		void RebuildActivation();
 		void RemoveEnemiesIfNeeded();
 	#if USE_IMGUI
 		void AppendEnemy( Kind appendKind, const InitializeParam &parameter, const Donya::Vector3 &wsTargetPos, const Donya::Collision::Box3F &wsScreenHitBox );
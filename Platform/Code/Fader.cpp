@@ -4,6 +4,7 @@
 
 #include "Common.h"
 #include "Donya/Sprite.h"
+#include "Donya/Tween.h"
 #include "Donya/Useful.h"
 #include "Donya/Vector.h"
 
@@ -123,16 +124,21 @@ public:
 class GraduallyFade : public BaseFade
 {
 private:
-	float			alpha;		// 0.0f ~ 1.0f.
-	float			fadeSpeed;
+	float			alpha;		// 0.0f ~ 1.0f. It is advanced by the tween.
+	float			fadeSecond;
 	unsigned int	color;		// ARGB.
+	Donya::Tweener::Handle alphaTween;
 public:
 	GraduallyFade( unsigned int color ) : BaseFade(),
-		alpha( 0.0f ), fadeSpeed( 0.0f ),
-		color( color )
+		alpha( 0.0f ), fadeSecond( 0.0f ),
+		color( color ), alphaTween()
 	{
 		
 	}
+	~GraduallyFade()
+	{
+		Donya::Tween::Remove( alphaTween );
+	}
 public:
 	void Init( float wholeCloseSecond ) override
 	{
@@ -141,16 +147,10 @@ public:
 		timer		= wholeCloseSecond;
 		closeSecond	= wholeCloseSecond;
 
-		if ( wholeCloseSecond <= 0 )
-		{
-			// Prevent zero-divide and minus value.
+		// Prevent minus value. It takes 10 seconds as same as the old speed(0.1f per second).
+		fadeSecond = ( wholeCloseSecond <= 0 ) ? 10.0f : wholeCloseSecond;
 
-			fadeSpeed = 0.1f;
-			return;
-		}
-		// else
-		
-		fadeSpeed = 1.0f / scast<float>( wholeCloseSecond );
+		StartAlphaTween( 0.0f, 1.0f );
 	}
 
 	void Update( float elapsedTime ) override
@@ -158,25 +158,19 @@ public:
 		timer -= elapsedTime;
 		isClosed = false;
 
+		// Wait until the alpha reaches the destination
+		if ( Donya::Tween::IsActive( alphaTween ) ) { return; }
+		// else
+
 		switch ( status )
 		{
 		case BaseFade::State::FADE_IN:
-			alpha += fadeSpeed * elapsedTime;
-			if ( 1.0f <= alpha )
-			{
-				alpha = 1.0f;
-
-				isClosed = true;
-				status = State::FADE_OUT;
-			}
+			isClosed = true;
+			status = State::FADE_OUT;
+			StartAlphaTween( 1.0f, 0.0f );
 			break;
 		case BaseFade::State::FADE_OUT:
-			alpha -= fadeSpeed * elapsedTime;
-			if ( alpha <= 0.0f )
-			{
-				alpha = 0.0f;
-				nowHidden = true;
-			}
+			nowHidden = true;
 			break;
 		default: break;
 		}
@@ -192,6 +186,16 @@ public:
 			scast<Donya::Color::Code>( color ), alpha
 		);
 	}
+private:
+	void StartAlphaTween( float from, float to )
+	{
+		Donya::Tweener::Description desc{};
+		desc.pTarget		= &alpha;
+		desc.from			= from;
+		desc.to				= to;
+		desc.durationSecond	= fadeSecond;
+		alphaTween = Donya::Tween::Add( desc );
+	}
 };
 
 void Fader::Configuration::SetDefault( Type fadeType )
@@ -0,0 +1,261 @@
+#include "FrameTimeMonitor.h"
+
+#include <algorithm>	// Use std::min, std::max, std::nth_element
+
+#undef max
+#undef min
+
+namespace
+{
+	float CalcPercentile( std::vector<float> *pValues, float ratio )
+	{
+		if ( pValues->empty() ) { return 0.0f; }
+		// else
+
+		const size_t last  = pValues->size() - 1;
+		const size_t index = std::min( last, scast<size_t>( ratio * scast<float>( pValues->size() ) ) );
+		std::nth_element( pValues->begin(), pValues->begin() + index, pValues->end() );
+		return ( *pValues )[index];
+	}
+}
+
+constexpr size_t FrameTimeMonitor::historyCapacity;
+constexpr size_t FrameTimeMonitor::sceneTypeCount;
+
+float FrameTimeMonitor::Sample::Get( Channel channel ) const
+{
+	switch ( channel )
+	{
+	case Channel::Update:	return updateMS;
+	case Channel::Draw:		return drawMS;
+	case Channel::Present:	return presentMS;
+	case Channel::CPU:		return updateMS + drawMS;
+	case Channel::Total:	return updateMS + drawMS + presentMS;
+	default: break;
+	}
+
+	return 0.0f;
+}
+
+const FrameTimeMonitor::Percentiles &FrameTimeMonitor::Report::Get( Channel channel ) const
+{
+	const size_t index = std::min( scast<size_t>( channel ), channels.size() - 1 );
+	return channels[index];
+}
+
+const char *FrameTimeMonitor::GetSceneName( Scene::Type type )
+{
+	switch ( type )
+	{
+	case Scene::Type::Null:		return "Null";
+	case Scene::Type::Logo:		return "Logo";
+	case Scene::Type::Load:		return "Load";
+	case Scene::Type::Title:	return "Title";
+	case Scene::Type::Game:		return "Game";
+	case Scene::Type::Over:		return "Over";
+	case Scene::Type::Result:	return "Result";
+	default: break;
+	}
+
+	return "ERROR_TYPE";
+}
+
+void FrameTimeMonitor::SetConfig( const Config &newConfig )
+{
+	config = newConfig;
+	config.budgetMS			= std::max( 0.0f, config.budgetMS		);
+	config.dumpFrameCount	= std::max( 1,    config.dumpFrameCount	);
+	config.cooldownFrames	= std::max( 0,    config.cooldownFrames	);
+}
+const FrameTimeMonitor::Config &FrameTimeMonitor::GetConfig() const
+{
+	return config;
+}
+
+bool FrameTimeMonitor::Push( Scene::Type sceneType, const Sample &sample )
+{
+	framesFromLastAlarm = std::min( INT_MAX / 2, framesFromLastAlarm + 1 );
+
+	const size_t sceneIndex = scast<size_t>( sceneType );
+	if ( sceneTypeCount <= sceneIndex ) { return false; }
+	// else
+
+	History &history = histories[sceneIndex];
+	history.samples[history.nextIndex] = sample;
+	history.nextIndex	= ( history.nextIndex + 1 ) % historyCapacity;
+	history.sampleCount	= std::min( history.sampleCount + 1, historyCapacity );
+
+	const bool isSpike = ( config.budgetMS < sample.Get( Channel::CPU ) );
+	if ( !isSpike ) { return false; }
+	// else
+
+	history.totalSpikeCount++;
+
+	if ( !config.enableAlarm ) { return false; }
+	if ( framesFromLastAlarm <= config.cooldownFrames ) { return false; }
+	// else
+
+	framesFromLastAlarm = 0;
+	alarmCount++;
+	return true;
+}
+void FrameTimeMonitor::Clear()
+{
+	for ( auto &it : histories )
+	{
+		it.sampleCount		= 0;
+		it.nextIndex		= 0;
+		it.totalSpikeCount	= 0;
+	}
+	framesFromLastAlarm	= INT_MAX / 2;
+	alarmCount			= 0;
+}
+
+size_t FrameTimeMonitor::GetSampleCount( Scene::Type sceneType ) const
+{
+	const History *pHistory = FindHistoryOrNullptr( sceneType );
+	return ( pHistory ) ? pHistory->sampleCount : 0;
+}
+size_t FrameTimeMonitor::GetTotalSpikeCount( Scene::Type sceneType ) const
+{
+	const History *pHistory = FindHistoryOrNullptr( sceneType );
+	return ( pHistory ) ? pHistory->totalSpikeCount : 0;
+}
+size_t FrameTimeMonitor::GetAlarmCount() const
+{
+	return alarmCount;
+}
+FrameTimeMonitor::Report FrameTimeMonitor::MakeReport( Scene::Type sceneType ) const
+{
+	Report report{};
+
+	const std::vector<Sample> samples = CollectSamples( sceneType );
+	if ( samples.empty() ) { return report; }
+	// else
+
+	report.frameCount = samples.size();
+	for ( const auto &it : samples )
+	{
+		if ( config.budgetMS < it.Get( Channel::CPU ) )
+		{
+			report.spikeCount++;
+		}
+	}
+
+	std::vector<float> values( samples.size() );
+	constexpr size_t channelCount = scast<size_t>( Channel::ChannelCount );
+	for ( size_t c = 0; c < channelCount; ++c )
+	{
+		const Channel channel = scast<Channel>( c );
+		for ( size_t i = 0; i < samples.size(); ++i )
+		{
+			values[i] = samples[i].Get( channel );
+		}
+
+		Percentiles &dest = report.channels[c];
+		dest.max = *std::max_element( values.begin(), values.end() );
+		dest.p50 = CalcPercentile( &values, 0.50f );
+		dest.p95 = CalcPercentile( &values, 0.95f );
+		dest.p99 = CalcPercentile( &values, 0.99f );
+	}
+
+	return report;
+}
+std::vector<float> FrameTimeMonitor::MakeHistogram( Scene::Type sceneType, Channel channel, size_t binCount, float rangeMaxMS ) const
+{
+	if ( !binCount || rangeMaxMS <= 0.0f ) { return std::vector<float>{}; }
+	// else
+
+	std::vector<float> bins( binCount, 0.0f );
+
+	const float binWidth = rangeMaxMS / scast<float>( binCount );
+	const std::vector<Sample> samples = CollectSamples( sceneType );
+	for ( const auto &it : samples )
+	{
+		const float  value = std::max( 0.0f, it.Get( channel ) );
+		const size_t index = std::min( binCount - 1, scast<size_t>( value / binWidth ) );
+		bins[index] += 1.0f;
+	}
+
+	return bins;
+}
+std::vector<FrameTimeMonitor::Sample> FrameTimeMonitor::CollectSamples( Scene::Type sceneType ) const
+{
+	const History *pHistory = FindHistoryOrNullptr( sceneType );
+	if ( !pHistory ) { return std::vector<Sample>{}; }
+	// else
+
+	std::vector<Sample> samples;
+	samples.reserve( pHistory->sampleCount );
+
+	const size_t oldest = ( pHistory->nextIndex + historyCapacity - pHistory->sampleCount ) % historyCapacity;
+	for ( size_t i = 0; i < pHistory->sampleCount; ++i )
+	{
+		samples.emplace_back( pHistory->samples[( oldest + i ) % historyCapacity] );
+	}
+
+	return samples;
+}
+
+const FrameTimeMonitor::History *FrameTimeMonitor::FindHistoryOrNullptr( Scene::Type sceneType ) const
+{
+	const size_t sceneIndex = scast<size_t>( sceneType );
+	return ( sceneIndex < sceneTypeCount ) ? &histories[sceneIndex] : nullptr;
+}
+
+#if USE_IMGUI
+void FrameTimeMonitor::ShowImGuiNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	Config tmp = config;
+	ImGui::DragFloat( u8"\Z[ms]",						&tmp.budgetMS,			0.1f, 0.0f );
+	ImGui::Checkbox	( u8"\ZߎɋL^o͂",	&tmp.enableAlarm );
+	ImGui::DragInt	( u8"o͂t[",			&tmp.dumpFrameCount,	1.0f, 1 );
+	ImGui::DragInt	( u8"ďo͂܂ł̑ҋ@t[",	&tmp.cooldownFrames,	1.0f, 0 );
+	SetConfig( tmp );
+
+	ImGui::Text( u8"x̉񐔁F%d", scast<int>( alarmCount ) );
+	if ( ImGui::Button( u8"L^NA" ) )
+	{
+		Clear();
+	}
+
+	static int selectedScene = scast<int>( Scene::Type::Game );
+	ImGui::SliderInt( u8"V[", &selectedScene, 0, scast<int>( sceneTypeCount ) - 1, GetSceneName( scast<Scene::Type>( selectedScene ) ) );
+	const Scene::Type sceneType = scast<Scene::Type>( selectedScene );
+
+	const Report report = MakeReport( sceneType );
+	ImGui::Text( u8"t[F%d", scast<int>( report.frameCount ) );
+	ImGui::Text( u8"\Z߁F%di݌vF%dj", scast<int>( report.spikeCount ), scast<int>( GetTotalSpikeCount( sceneType ) ) );
+
+	constexpr std::array<const char *, scast<size_t>( Channel::ChannelCount )> channelNames
+	{
+		"Update",
+		"Draw",
+		"Present",
+		"CPU",
+		"Total",
+	};
+	ImGui::Text( "[Channel] P50 | P95 | P99 | Max (ms)" );
+	for ( size_t i = 0; i < channelNames.size(); ++i )
+	{
+		const auto &it = report.channels[i];
+		ImGui::Text( "[%s] %6.3f | %6.3f | %6.3f | %6.3f", channelNames[i], it.p50, it.p95, it.p99, it.max );
+	}
+
+	constexpr size_t binCount = 32;
+	const float rangeMaxMS = std::max( 1.0f, config.budgetMS * 2.0f );
+	const std::vector<float> bins = MakeHistogram( sceneType, Channel::CPU, binCount, rangeMaxMS );
+	const float highestBin = ( bins.empty() ) ? 1.0f : std::max( 1.0f, *std::max_element( bins.begin(), bins.end() ) );
+	const std::string overlay = "0 - " + std::to_string( scast<int>( rangeMaxMS ) ) + " ms";
+	ImGui::PlotHistogram
+	(
+		u8"CPUԂ̕z", bins.data(), scast<int>( bins.size() ),
+		0, overlay.c_str(), 0.0f, highestBin, ImVec2{ 0.0f, 80.0f }
+	);
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <climits>		// Use INT_MAX
+#include <string>
+#include <vector>
+
+#include "Donya/Constant.h"		// Use scast macro.
+#include "Donya/UseImGui.h"		// Use USE_IMGUI macro.
+
+#include "Scene.h"				// Use Scene::Type.
+
+/// <summary>
+/// Keeps the recent frame times per scene, and reports the percentiles and the spikes.
+/// It only receives the measured times, so you can use it without a window.
+/// </summary>
+class FrameTimeMonitor
+{
+public:
+	enum class Channel
+	{
+		Update,
+		Draw,
+		Present,	// The waiting time of the Present()
+		CPU,		// Update + Draw. The spikes are judged by it, because the Present() includes the waiting of v-sync
+		Total,		// Update + Draw + Present
+
+		ChannelCount
+	};
+	struct Sample
+	{
+		float updateMS	= 0.0f;	// [milli second]
+		float drawMS	= 0.0f;	// [milli second]
+		float presentMS	= 0.0f;	// [milli second]
+	public:
+		float Get( Channel channel ) const;
+	};
+	struct Percentiles
+	{
+		float p50 = 0.0f;	// [milli second]
+		float p95 = 0.0f;	// [milli second]
+		float p99 = 0.0f;	// [milli second]
+		float max = 0.0f;	// [milli second]
+	};
+	struct Report
+	{
+		size_t		frameCount	= 0;	// The count of frames in the rolling buffer
+		size_t		spikeCount	= 0;	// The count of frames that exceeded the budget in the rolling buffer
+		std::array<Percentiles, scast<size_t>( Channel::ChannelCount )> channels{};
+	public:
+		const Percentiles &Get( Channel channel ) const;
+	};
+	struct Config
+	{
+		float	budgetMS		= 1000.0f / 60.0f;	// [milli second] A frame is a spike if its CPU time exceeds it
+		bool	enableAlarm		= false;
+		int		dumpFrameCount	= 120;	// The count of recent frames that the alarm dumps
+		int		cooldownFrames	= 180;	// The alarm does not fire again until this count of frames passed
+	};
+public:
+	static constexpr size_t historyCapacity	= 600;	// The size of rolling buffer per scene
+	static constexpr size_t sceneTypeCount	= scast<size_t>( Scene::Type::Result ) + 1;
+	static const char *GetSceneName( Scene::Type type );
+private:
+	struct History
+	{
+		std::array<Sample, historyCapacity> samples{};
+		size_t	sampleCount		= 0;
+		size_t	nextIndex		= 0;
+		size_t	totalSpikeCount	= 0;	// Since the last Clear()
+	};
+private:
+	std::array<History, sceneTypeCount>	histories{};
+	Config	config;
+	int		framesFromLastAlarm	= INT_MAX / 2;
+	size_t	alarmCount			= 0;
+public:
+	void SetConfig( const Config &newConfig );
+	const Config &GetConfig() const;
+	/// <summary>
+	/// Stores the "sample" into the rolling buffer of the "sceneType".
+	/// Returns true if the alarm fired, then the caller should dump the recent "GetConfig().dumpFrameCount" frames.
+	/// </summary>
+	bool Push( Scene::Type sceneType, const Sample &sample );
+	/// <summary>
+	/// Removes the samples of all scenes. The config is kept.
+	/// </summary>
+	void Clear();
+public:
+	size_t GetSampleCount( Scene::Type sceneType ) const;
+	/// <summary>
+	/// Returns the count of spikes since the last Clear().
+	/// </summary>
+	size_t GetTotalSpikeCount( Scene::Type sceneType ) const;
+	size_t GetAlarmCount() const;
+	/// <summary>
+	/// Calculates the statistics of the rolling buffer of the "sceneType".
+	/// </summary>
+	Report MakeReport( Scene::Type sceneType ) const;
+	/// <summary>
+	/// Counts the frames of the "sceneType" into the "binCount" bins of [0, rangeMaxMS).
+	/// The frames over the "rangeMaxMS" are counted into the last bin.
+	/// The counts are float, for the ImGui::PlotHistogram().
+	/// </summary>
+	std::vector<float> MakeHistogram( Scene::Type sceneType, Channel channel, size_t binCount, float rangeMaxMS ) const;
+	/// <summary>
+	/// Returns the samples of the "sceneType" from the old one.
+	/// </summary>
+	std::vector<Sample> CollectSamples( Scene::Type sceneType ) const;
+private:
+	const History *FindHistoryOrNullptr( Scene::Type sceneType ) const;
+public:
+#if USE_IMGUI
+	void ShowImGuiNode( const std::string &nodeCaption );
+#endif // USE_IMGUI
+};
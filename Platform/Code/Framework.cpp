@@ -2,10 +2,14 @@
 
 #include <array>
 
+#include "Donya/AssetRegistry.h"
 #include "Donya/Blend.h"
 #include "Donya/Donya.h"
 #include "Donya/Keyboard.h"	// Use for some debug function.
+#include "Donya/Profiler.h"
+#include "Donya/Resource.h"		// Use CompareObjLoaders()
 #include "Donya/Sound.h"
+#include "Donya/Tween.h"
 #include "Donya/Useful.h"
 #include "Donya/UseImgui.h"
 
@@ -16,6 +20,14 @@
 #undef max
 #undef min
 
+namespace
+{
+	float ToMilliSeconds( std::int64_t nanoSeconds )
+	{
+		return scast<float>( nanoSeconds ) * 0.000001f;
+	}
+}
+
 bool Framework::Init()
 {
 	bool succeeded = true;
@@ -41,6 +53,11 @@ void Framework::Uninit()
 
 void Framework::Update( float elapsedTime )
 {
+	PROFILE_SCOPE( "Framework::Update" );
+	const std::int64_t beginNS = Donya::Profiler::Now();
+
+	frameSceneType = pSceneMng->GetFrontSceneType();
+
 #if DEBUG_MODE
 	if ( Donya::Keyboard::Press( VK_MENU ) )
 	{
@@ -66,14 +83,61 @@ void Framework::Update( float elapsedTime )
 	// Prevent the elapsedTime will be very larging
 	elapsedTime = std::min( Common::LargestDeltaTime(), elapsedTime );
 
+	// Advance the tweens before the scenes use their values
+	Donya::Tween::Update( elapsedTime );
+
 	pSceneMng->Update( elapsedTime );
+
+	frameSample.updateMS = ToMilliSeconds( Donya::Profiler::Now() - beginNS );
 }
 
 void Framework::Draw( float elapsedTime )
 {
+	PROFILE_SCOPE( "Framework::Draw" );
+	const std::int64_t beginNS = Donya::Profiler::Now();
+
 	Donya::Blend::Activate( Donya::Blend::Mode::ALPHA_NO_ATC );
 
 	pSceneMng->Draw( elapsedTime );
+
+	frameSample.drawMS = ToMilliSeconds( Donya::Profiler::Now() - beginNS );
+}
+
+void Framework::Present( unsigned int syncInterval )
+{
+	const std::int64_t beginNS = Donya::Profiler::Now();
+	{
+		PROFILE_SCOPE( "Present" );
+		Donya::Present( syncInterval );
+	}
+	frameSample.presentMS = ToMilliSeconds( Donya::Profiler::Now() - beginNS );
+
+	// Gather the scopes of this frame before the dumping
+	Donya::Profiler::EndFrame();
+
+	const bool alarmed = frameMonitor.Push( frameSceneType, frameSample );
+	if ( alarmed )
+	{
+		DumpRecentFrames();
+	}
+
+	frameSample = FrameTimeMonitor::Sample{};
+}
+
+void Framework::DumpRecentFrames()
+{
+	// The PROFILE_SCOPE is empty if the USE_PROFILER is false(e.g. Release), then the dump does not contain the scope timings.
+	const size_t frameCount = scast<size_t>( frameMonitor.GetConfig().dumpFrameCount );
+	const std::string filePath
+		= "FrameAlarm_"
+		+ std::string{ FrameTimeMonitor::GetSceneName( frameSceneType ) } + "_"
+		+ std::to_string( frameMonitor.GetAlarmCount() )
+		+ ".json";
+
+	if ( Donya::Profiler::ExportChromeTrace( filePath, frameCount ) )
+	{
+		lastDumpPath = filePath;
+	}
 }
 
 #if USE_IMGUI
@@ -102,6 +166,16 @@ void Framework::DebugShowInformation()
 	ImGui::Text( u8"@usL[vŁCImGui̕\̗LC؂ւ܂B" );
 	ImGui::Text( "" );
 
+	Donya::Profiler::ShowImGuiNode( u8"vt@C" );
+	frameMonitor.ShowImGuiNode( u8"t[Ԃ̕z" );
+#if !USE_PROFILER
+	ImGui::TextDisabled( u8"vt@CȂ߁Co͂ɃXR[v̌v͊܂܂܂B" );
+#endif // !USE_PROFILER
+	if ( !lastDumpPath.empty() )
+	{
+		ImGui::Text( u8"Ō̏óF%s", lastDumpPath.c_str() );
+	}
+
 	if ( ImGui::TreeNode( u8"}EX" ) )
 	{
 		int x = 0, y = 0;
@@ -117,7 +191,41 @@ void Framework::DebugShowInformation()
 
 		ImGui::TreePop();
 	}
+
+	Donya::Asset::ShowImGuiNode( u8"AZbgLbV" );
+
+	if ( ImGui::TreeNode( u8"OBJǂݍ݂̌v" ) )
+	{
+		static char		filePath[256]	= "";
+		static Donya::Profiler::BenchmarkCounts		counts{ 1, 10 };
+		static Donya::Resource::ObjLoaderComparison	result{};
+
+		ImGui::InputText( u8"t@CpX", filePath, sizeof( filePath ) );
+		if ( counts.ShowControls( nullptr, u8"", u8"v" ) )
+		{
+			result = Donya::Resource::CompareObjLoaders( Donya::GetDevice(), Donya::UTF8ToWide( filePath ), counts.loopCount );
+		}
+
+		if ( result.succeeded )
+		{
+			ImGui::Text( u8"TCYF%d bytes", scast<int>( result.fileBytes ) );
+			ImGui::Text( u8"]F%8.3f msi%7.2f MB/sjC_%d", result.legacySeconds * 1000.0f, result.CalcLegacyMBPerSecond(), scast<int>( result.legacyVertexCount ) );
+			ImGui::Text( u8"F%8.3f msi%7.2f MB/sjC_%dCCfbNX%di%d bitj",
+				result.fastSeconds * 1000.0f, result.CalcFastMBPerSecond(),
+				scast<int>( result.fastVertexCount ), scast<int>( result.fastIndexCount ),
+				( result.fastUses16BitIndex ) ? 16 : 32
+			);
+		}
+		else
+		{
+			ImGui::Text( u8"vCǂݍ݂Ɏs܂B" );
+		}
+
+		ImGui::TreePop();
+	}
 		
+	Donya::Tween::ShowImGuiNode( u8"gDC[" );
+
 	if ( ImGui::TreeNode( u8"C[WOTv" ) )
 	{
 		using namespace Donya;
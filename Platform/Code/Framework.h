@@ -1,15 +1,22 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "Donya/UseImGui.h"	// Use for USE_IMGUI macro.
 
+#include "FrameTimeMonitor.h"
 #include "SceneManager.h"
 
 class Framework
 {
 private:
 	std::unique_ptr<SceneMng> pSceneMng = nullptr;
+
+	FrameTimeMonitor			frameMonitor;
+	FrameTimeMonitor::Sample	frameSample;						// The times of current frame
+	Scene::Type					frameSceneType = Scene::Type::Null;	// The front scene at the beginning of current frame
+	std::string					lastDumpPath;
 public:
 	Framework()  = default;
 	~Framework() = default;
@@ -26,6 +33,17 @@ public:
 
 	// The "elapsedTime" is elapsed seconds from last frame.
 	void Draw( float elapsedTime );
+
+	/// <summary>
+	/// Presents the back buffer, then records the frame times and the profiler's frame.
+	/// Please call it at the end of a frame instead of Donya::Present().
+	/// </summary>
+	void Present( unsigned int syncInterval );
+private:
+	/// <summary>
+	/// Writes the scope timings of recent frames into a file. The budget alarm calls it.
+	/// </summary>
+	void DumpRecentFrames();
 private:
 #if USE_IMGUI
 	void DebugShowInformation();
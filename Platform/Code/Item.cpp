@@ -25,39 +25,38 @@ namespace Item
 
 		static std::array<std::shared_ptr<ModelHelper::SkinningSet>, kindCount> modelPtrs{ nullptr };
 
-		bool LoadModels()
+		std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeLoads()
 		{
 			const std::string folderName = modelFolderName;
-			bool succeeded = true;
-			std::string filePath{};
+			std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> loads{};
 			for ( size_t i = 0; i < kindCount; ++i )
 			{
 				if ( modelPtrs[i] ) { continue; }
 				// else
 
-				filePath = MakeModelPath( folderName + modelNames[i] );
-
-				if ( !Donya::IsExistFile( filePath ) )
-				{
-					const std::string msg = "Error: File is not found: " + filePath + "\n";
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
-
-				modelPtrs[i] = std::make_shared<ModelHelper::SkinningSet>();
-				const bool result = ModelHelper::Load( filePath, modelPtrs[i].get() );
-				if ( !result )
+				auto StoreModel = [i]( const std::shared_ptr<ModelHelper::SkinningSet> &pModel )
 				{
-					modelPtrs[i].reset(); // Make not loaded state
+					// Each item samples its motion every frame, so it samples from the compressed motions
+					if ( pModel->compressedMotions.empty() )
+					{
+						ModelHelper::CompressMotions( pModel.get() );
+					}
+					modelPtrs[i] = pModel;
+				};
+				loads.emplace_back
+				(
+					std::make_shared<ModelHelper::StagedSkinningLoad>( MakeModelPath( folderName + modelNames[i] ), StoreModel )
+				);
+			}
 
-					const std::string msg = "Failed: Loading failed: " + filePath;
-					Donya::OutputDebugStr( msg.c_str() );
-					succeeded = false;
-					continue;
-				}
-				// else
+			return loads;
+		}
+		bool LoadModels()
+		{
+			bool succeeded = true;
+			for ( const auto &pLoad : MakeLoads() )
+			{
+				if ( !pLoad->LoadAll() ) { succeeded = false; }
 			}
 
 			return succeeded;
@@ -167,6 +166,10 @@ namespace Item
 		Parameter::Load();
 		return LoadModels();
 	}
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads()
+	{
+		return MakeLoads();
+	}
 
 #if USE_IMGUI
 	constexpr const char *GetKindName( Kind kind )
@@ -552,13 +555,17 @@ namespace Item
 	{
 		generateRequests.emplace_back( initializer );
 	}
+	std::string Admin::MakeStageFilePath( int stageNumber, bool fromBinary )
+	{
+		return	( fromBinary )
+				? MakeStageParamPathBinary( ID, stageNumber )
+				: MakeStageParamPathJson  ( ID, stageNumber );
+	}
 	bool Admin::LoadItems( int stageNumber, bool fromBinary )
 	{
 		ClearInstances();
 
-		const std::string filePath	= ( fromBinary )
-									? MakeStageParamPathBinary( ID, stageNumber )
-									: MakeStageParamPathJson  ( ID, stageNumber );
+		const std::string filePath	= MakeStageFilePath( stageNumber, fromBinary );
 		Donya::Serializer tmp;
 		const bool succeeded		= ( fromBinary )
 									? tmp.LoadBinary( *this, filePath.c_str(), ID )
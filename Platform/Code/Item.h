@@ -47,6 +47,11 @@ namespace Item
 
 
 	bool LoadResource();
+	/// <summary>
+	/// Makes the loads of the models that have not been loaded. Each load stores its model when it finishes.<para></para>
+	/// It is for loading by the stages, so please call Parameter::Load() also. LoadResource() does both.
+	/// </summary>
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads();
 
 
 	struct InitializeParam
@@ -169,6 +174,10 @@ namespace Item
 		void ClearInstances();
 		void RequestGeneration( const InitializeParam &initializer );
 		bool LoadItems( int stageNumber, bool fromBinary );
+		/// <summary>
+		/// Returns the path of the file that LoadItems() reads.
+		/// </summary>
+		static std::string MakeStageFilePath( int stageNumber, bool fromBinary );
 	public:
 		size_t GetInstanceCount() const;
 		bool IsOutOfRange( size_t instanceIndex ) const;
@@ -1,18 +1,25 @@
 #include "Map.h"
 
-#include <algorithm>		// Use remove_if
+#include <algorithm>		// Use remove_if, min, max
 
+#include "Donya/AsyncIO.h"	// Release the prefetched model
 #include "Donya/Constant.h"	// Use scast macro
+#include "Donya/Loader.h"
 #include "Donya/Mouse.h"
+#include "Donya/Profiler.h"	// Use MeasureAverageSeconds()
 #include "Donya/Sprite.h"
 
 #include "Common.h"			// Use LargestDeltaTime(), IsShowCollision()
 #include "FilePath.h"
+#include "MapChunk.h"
 #include "Parameter.h"		// Use ParameterHelper
 #if USE_IMGUI
 #include "StageFormat.h"
 #endif // USE_IMGUI
 
+#undef max
+#undef min
+
 
 void Tile::Init( StageFormat::ID identifier, const Donya::Vector3 &wsTilePos, const Donya::Vector3 &wsTileWholeSize )
 {
@@ -236,38 +243,84 @@ namespace
 {
 	constexpr const char *modelPrefix	= "Map/Stage";
 	constexpr const char *modelName		= "World";
-	bool LoadStageModel( std::unique_ptr<ModelHelper::StaticSet> *pTarget, int stageNumber )
+
+	// The stage model will be split per this size block
+	constexpr float chunkWholeSize	= Tile::unitWholeSize * MapChunk::defaultBlockTileCount;
+	// The screen plane is placed at Z:0, but the geometry that placed at far is visible in a wider area
+	constexpr float chunkCullMargin	= chunkWholeSize * 0.5f;
+}
+bool Map::LoadModelImpl( int stageNumber )
+{
+	ReleaseModel();
+
+	const std::string filePath = MakeModelFilePath( stageNumber );
+	if ( !Donya::IsExistFile( filePath ) )
 	{
-		if ( !pTarget ) { return false; }
-		// else
+		const std::string msg = "Error: Model of Stage[" + std::to_string( stageNumber ) + "] is not found.\n";
+		Donya::OutputDebugStr( msg.c_str() );
+		return false;
+	}
+	// else
+
+	Donya::Loader loader{};
+	const bool loaded = loader.Load( filePath );
+	// The model is not reloaded by the retry of the stage, so I do not need to hold the prefetched file
+	Donya::AsyncIO::Release( filePath );
+	if ( !loaded )
+	{
+		const std::string msg = "Failed: Loading Map model: " + filePath;
+		Donya::OutputDebugStr( msg.c_str() );
+		return false;
+	}
+	// else
 
-		auto &ptr = *pTarget;
-		ptr.reset();
+	const auto &source			= loader.GetModelSource();
+	const auto &fileDirectory	= loader.GetFileDirectory();
 
-		const std::string folderName	= modelPrefix + Donya::MakeArraySuffix( stageNumber ) + "/";
-		const std::string filePath		= MakeModelPath( folderName + modelName );
-		if ( !Donya::IsExistFile( filePath ) )
+	const auto chunks = MapChunk::Split( source, chunkWholeSize );
+	if ( chunks.empty() )
+	{
+		// Use the whole model as fail safe
+		pModel = std::make_unique<ModelHelper::StaticSet>();
+		pModel->model = Donya::Model::StaticModel::Create( source, fileDirectory );
+		pModel->pose.AssignSkeletal( source.skeletal );
+		if ( !pModel->model.WasInitializeSucceeded() )
 		{
-			const std::string msg = "Error: Model of Stage[" + std::to_string( stageNumber ) + "] is not found.\n";
+			pModel.reset(); // Make not loaded state
+
+			const std::string msg = "Failed: Creating Map model: " + filePath;
 			Donya::OutputDebugStr( msg.c_str() );
 			return false;
 		}
 		// else
 
-		ptr = std::make_unique<ModelHelper::StaticSet>();
-		const bool result = ModelHelper::Load( filePath, ptr.get() );;
-		if ( !result )
+		return true;
+	}
+	// else
+
+	chunkModels.reserve( chunks.size() );
+	chunkAreas.reserve( chunks.size() );
+	for ( const auto &it : chunks )
+	{
+		ModelHelper::StaticSet chunkModel{};
+		chunkModel.model = Donya::Model::StaticModel::Create( it.source, fileDirectory );
+		chunkModel.pose.AssignSkeletal( it.source.skeletal );
+		if ( !chunkModel.model.WasInitializeSucceeded() )
 		{
-			ptr.reset(); // Make not loaded state
+			ReleaseModel(); // Make not loaded state
 
-			const std::string msg = "Failed: Loading Map model: " + filePath;
+			const std::string msg = "Failed: Creating Map model chunk: " + filePath;
 			Donya::OutputDebugStr( msg.c_str() );
 			return false;
 		}
 		// else
 
-		return true;
+		chunkModels.emplace_back( std::move( chunkModel ) );
+		chunkAreas.emplace_back( it.area );
 	}
+	visibleChunkIndices.reserve( chunkModels.size() );
+
+	return true;
 }
 bool Map::Init( int stageNumber, bool reloadModel )
 {
@@ -278,7 +331,7 @@ bool Map::Init( int stageNumber, bool reloadModel )
 
 	if ( reloadModel )
 	{
-		result = LoadStageModel( &pModel, stageNumber );
+		result = LoadModelImpl( stageNumber );
 		if ( !result ) { succeeded = false; }
 	}
 
@@ -346,9 +399,10 @@ void Map::Update( float elapsedTime )
 		}
 	);
 }
-void Map::Draw( RenderingHelper *pRenderer ) const
+void Map::Draw( const Donya::Collision::Box3F &wsScreen, RenderingHelper *pRenderer ) const
 {
-	if ( !pModel || !pRenderer ) { return; }
+	if ( !pRenderer ) { return; }
+	if ( !pModel && chunkModels.empty() ) { return; }
 	// else
 
 	Donya::Model::Constants::PerModel::Common modelConstant{};
@@ -357,29 +411,60 @@ void Map::Draw( RenderingHelper *pRenderer ) const
 	pRenderer->UpdateConstant( modelConstant );
 	pRenderer->ActivateConstantModel();
 
-	pRenderer->Render( pModel->model, pModel->pose );
+	if ( pModel )
+	{
+		pRenderer->Render( pModel->model, pModel->pose );
+	}
+	else
+	{
+		MapChunk::SelectVisibles( chunkAreas, wsScreen, chunkCullMargin, &visibleChunkIndices );
+		for ( const size_t index : visibleChunkIndices )
+		{
+			const auto &chunk = chunkModels[index];
+			pRenderer->Render( chunk.model, chunk.pose );
+		}
+	}
 
 	pRenderer->DeactivateConstantModel();
 }
 void Map::DrawHitBoxes( const Donya::Collision::Box3F &wsScreen, RenderingHelper *pRenderer, const Donya::Vector4x4 &matVP ) const
 {
-	ForEach
-	(
-		[&]( const ElementType &pElement )
+	if ( tilePtrs.empty() ) { return; }
+	// else
+
+	// Visit only the tiles around the screen instead of all tiles.
+	// The ToTilePos() discards the decimal point, so I extend the range by one tile.
+	const Donya::Vector3 wsMin = wsScreen.Min();
+	const Donya::Vector3 wsMax = wsScreen.Max();
+	const Donya::Int2 ssLeftTop		= ToTilePos( Donya::Vector3{ wsMin.x, wsMax.y, 0.0f } );
+	const Donya::Int2 ssRightBottom	= ToTilePos( Donya::Vector3{ wsMax.x, wsMin.y, 0.0f } );
+
+	const int rowCount	= scast<int>( tilePtrs.size() );
+	const int rowBegin	= std::max( 0, ssLeftTop.y - 1 );
+	const int rowEnd	= std::min( rowCount, ssRightBottom.y + 2 );
+	for ( int y = rowBegin; y < rowEnd; ++y )
+	{
+		const auto &row = tilePtrs[y];
+
+		const int columnCount	= scast<int>( row.size() );
+		const int columnBegin	= std::max( 0, ssLeftTop.x - 1 );
+		const int columnEnd		= std::min( columnCount, ssRightBottom.x + 2 );
+		for ( int x = columnBegin; x < columnEnd; ++x )
 		{
-			if ( !pElement ) { return; }
+			const auto &pElement = row[x];
+			if ( !pElement ) { continue; }
 			// else
 
-			if ( !Donya::Collision::IsHit( pElement->GetHitBox(), wsScreen ) ) { return; }
+			if ( !Donya::Collision::IsHit( pElement->GetHitBox(), wsScreen ) ) { continue; }
 			// else
 
 			pElement->DrawHitBox( pRenderer, matVP );
 		}
-	);
+	}
 }
 bool Map::LoadModel( int loadStageNumber )
 {
-	const bool loadResult = LoadStageModel( &pModel, loadStageNumber );
+	const bool loadResult = LoadModelImpl( loadStageNumber );
 	if ( !loadResult )
 	{
 		std::string msg = u8"}bv̓ǂݍ݂Ɏs܂B\n";
@@ -396,6 +481,17 @@ bool Map::LoadModel( int loadStageNumber )
 void Map::ReleaseModel()
 {
 	pModel.reset();
+	chunkModels.clear();
+	chunkAreas.clear();
+	visibleChunkIndices.clear();
+}
+size_t Map::GetDrawnChunkCount() const
+{
+	return ( pModel ) ? 1U : visibleChunkIndices.size();
+}
+size_t Map::GetChunkCount() const
+{
+	return ( pModel ) ? 1U : chunkModels.size();
 }
 const std::vector<std::vector<Map::ElementType>> &Map::GetTiles() const
 {
@@ -481,11 +577,20 @@ std::vector<std::shared_ptr<const Tile>> Map::GetPlaceTiles( const Donya::Collis
 
 	return std::move( results );
 }
+std::string Map::MakeModelFilePath( int stageNumber )
+{
+	const std::string folderName = modelPrefix + Donya::MakeArraySuffix( stageNumber ) + "/";
+	return MakeModelPath( folderName + modelName );
+}
+std::string Map::MakeStageFilePath( int stageNumber, bool fromBinary )
+{
+	return	( fromBinary )
+			? MakeStageParamPathBinary( ID, stageNumber )
+			: MakeStageParamPathJson  ( ID, stageNumber );
+}
 bool Map::LoadMap( int stageNumber, bool fromBinary )
 {
-	const std::string filePath	= ( fromBinary )
-								? MakeStageParamPathBinary( ID, stageNumber )
-								: MakeStageParamPathJson  ( ID, stageNumber );
+	const std::string filePath = MakeStageFilePath( stageNumber, fromBinary );
 	Donya::Serializer tmp;
 	return	( fromBinary )
 			? tmp.LoadBinary( *this, filePath.c_str(), ID )
@@ -561,6 +666,37 @@ void Map::ShowImGuiNode( const std::string &nodeCaption, int stageNo )
 	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
 	// else
 
+	if ( ImGui::TreeNode( u8"``N" ) )
+	{
+		ImGui::Text( u8"`搔F[%d/%d]", scast<int>( GetDrawnChunkCount() ), scast<int>( GetChunkCount() ) );
+
+		// Measure the selection by placing the screen on each chunk
+		static float	selectionSecond	= 0.0f;
+		static int		visibleSum		= 0;
+		if ( ImGui::Button( u8"Iv" ) && !chunkAreas.empty() )
+		{
+			constexpr int loopCount = 1000;
+			std::vector<size_t> indices;
+			indices.reserve( chunkAreas.size() );
+
+			visibleSum = 0;
+			selectionSecond = Donya::Profiler::MeasureAverageSeconds
+			(
+				loopCount,
+				[&]( int i )
+				{
+					const auto &screen = chunkAreas[i % chunkAreas.size()];
+					visibleSum += scast<int>( MapChunk::SelectVisibles( chunkAreas, screen, chunkCullMargin, &indices ) );
+				}
+			);
+			visibleSum /= loopCount;
+		}
+		ImGui::Text( u8"I񂠂F[%5.3f s]", selectionSecond * 1000000.0f );
+		ImGui::Text( u8"ϕ`搔F[%d]", visibleSum );
+
+		ImGui::TreePop();
+	}
+
 	if ( ImGui::TreeNode( u8"̑" ) )
 	{
 		// Resize
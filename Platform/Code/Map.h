@@ -107,7 +107,10 @@ private: // shared_ptr<> make be able to copy
 	using ElementType = std::shared_ptr<Tile>;
 	std::vector<std::vector<ElementType>> tilePtrs; // [Row][Column], [Y][X]. "nullptr" means that placing coordinate is space(empty).
 private:
-	std::unique_ptr<ModelHelper::StaticSet> pModel = nullptr;
+	std::unique_ptr<ModelHelper::StaticSet>	pModel = nullptr;		// Whole stage model. It is used only when the stage model could not be split.
+	std::vector<ModelHelper::StaticSet>		chunkModels;			// Parts of the stage model per block of tiles.
+	std::vector<Donya::Collision::Box3F>	chunkAreas;				// World space area of each "chunkModels".
+	mutable std::vector<size_t>				visibleChunkIndices;	// The buffer of Draw(). Keep it as member for avoiding an allocation per frame.
 private:
 	friend class cereal::access;
 	template<class Archive>
@@ -124,12 +127,28 @@ public:
 	bool Init( int stageNumber, bool reloadModel );
 	void Uninit();
 	void Update( float elapsedTime );
-	void Draw( RenderingHelper *pRenderer ) const;
+	/// <summary>
+	/// Draws only the chunks of stage model that overlaps the "wsScreenHitBox".
+	/// </summary>
+	void Draw( const Donya::Collision::Box3F &wsScreenHitBox, RenderingHelper *pRenderer ) const;
 	void DrawHitBoxes( const Donya::Collision::Box3F &wsScreenHitBox, RenderingHelper *pRenderer, const Donya::Vector4x4 &matVP ) const;
 public:
 	bool LoadModel( int loadStageNumber );
 	void ReleaseModel();
 	/// <summary>
+	/// Returns the path of the model file that LoadModel() reads.
+	/// </summary>
+	static std::string MakeModelFilePath( int stageNumber );
+	/// <summary>
+	/// Returns the path of the tiles file that Init() reads.
+	/// </summary>
+	static std::string MakeStageFilePath( int stageNumber, bool fromBinary );
+	/// <summary>
+	/// Returns the count of chunks that the latest Draw() has drawn.
+	/// </summary>
+	size_t GetDrawnChunkCount() const;
+	size_t GetChunkCount() const;
+	/// <summary>
 	/// Returns tiles forming as: [Row][Column], [Y][X]. "nullptr" means that placing coordinate is space(empty).
 	/// </summary>
 	const std::vector<std::vector<std::shared_ptr<Tile>>> &GetTiles() const;
@@ -176,6 +195,7 @@ private:
 		}
 	}
 	bool LoadMap( int stageNumber, bool fromBinary );
+	bool LoadModelImpl( int stageNumber );
 #if USE_IMGUI
 public:
 	void RemakeByCSV( const CSVLoader &loadedData );
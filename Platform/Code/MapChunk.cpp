@@ -0,0 +1,276 @@
+#include "MapChunk.h"
+
+#include <algorithm>		// Use std::min, std::max
+#include <cfloat>			// Use FLT_MAX
+#include <cmath>			// Use std::floor
+#include <unordered_map>
+
+#include "Donya/Constant.h"	// Use scast macro
+
+#undef max
+#undef min
+
+namespace MapChunk
+{
+	namespace
+	{
+		using Source = Donya::Model::Source;
+
+		struct TriangleRef
+		{
+			size_t meshIndex;
+			size_t subsetIndex;
+			size_t firstIndex; // Index of Mesh::indices
+		};
+		struct Bucket
+		{
+			Donya::Int2					blockIndex;
+			std::vector<TriangleRef>	triangles;
+		};
+
+		Donya::Vector4x4 MakeMeshToWorld( const Source &source, const Source::Mesh &mesh )
+		{
+			const bool validBone = ( 0 <= mesh.boneIndex && mesh.boneIndex < scast<int>( source.skeletal.size() ) );
+			const Donya::Vector4x4 boneGlobal = ( validBone ) ? source.skeletal[mesh.boneIndex].global : Donya::Vector4x4::Identity();
+			return boneGlobal * source.coordinateConversion * source.extraTransform;
+		}
+		std::vector<std::vector<Donya::Vector3>> MakeWorldPositions( const Source &source )
+		{
+			std::vector<std::vector<Donya::Vector3>> results;
+			results.resize( source.meshes.size() );
+
+			const size_t meshCount = source.meshes.size();
+			for ( size_t i = 0; i < meshCount; ++i )
+			{
+				const auto &mesh	= source.meshes[i];
+				const auto toWorld	= MakeMeshToWorld( source, mesh );
+
+				auto &dest = results[i];
+				dest.reserve( mesh.positions.size() );
+				for ( const auto &v : mesh.positions )
+				{
+					dest.emplace_back( toWorld.Mul( v.position, 1.0f ).XYZ() );
+				}
+			}
+
+			return results;
+		}
+		long long MakeBlockKey( const Donya::Int2 &blockIndex )
+		{
+			return ( scast<long long>( blockIndex.y ) << 32 ) | scast<unsigned int>( blockIndex.x );
+		}
+		Donya::Int2 CalcBlockIndex( const Donya::Vector3 &wsPos, float blockWholeSize )
+		{
+			// The row is positive to down, same as Map::ToTilePos()
+			return Donya::Int2
+			{
+				scast<int>( std::floor(  wsPos.x / blockWholeSize ) ),
+				scast<int>( std::floor( -wsPos.y / blockWholeSize ) ),
+			};
+		}
+
+		Chunk BuildChunk( const Source &source, const std::vector<std::vector<Donya::Vector3>> &wsPositions, const Bucket &bucket )
+		{
+			Chunk chunk{};
+			chunk.blockIndex = bucket.blockIndex;
+
+			Source &dest = chunk.source;
+			dest.skeletal				= source.skeletal;
+			dest.coordinateConversion	= source.coordinateConversion;
+			dest.extraTransform			= source.extraTransform;
+			dest.extraScale				= source.extraScale;
+			dest.extraRotation			= source.extraRotation;
+			dest.extraTranslation		= source.extraTranslation;
+
+			Donya::Vector3 wsMin{ FLT_MAX, FLT_MAX, FLT_MAX };
+			Donya::Vector3 wsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			auto Expand = [&]( const Donya::Vector3 &p )
+			{
+				wsMin.x = std::min( wsMin.x, p.x );	wsMax.x = std::max( wsMax.x, p.x );
+				wsMin.y = std::min( wsMin.y, p.y );	wsMax.y = std::max( wsMax.y, p.y );
+			};
+
+			// Old vertex index -> New vertex index, of current mesh
+			std::unordered_map<unsigned int, unsigned int> remap;
+
+			constexpr size_t invalid = scast<size_t>( -1 );
+			size_t currentMesh   = invalid;
+			size_t currentSubset = invalid;
+			for ( const auto &tri : bucket.triangles )
+			{
+				const auto &srcMesh = source.meshes[tri.meshIndex];
+				if ( tri.meshIndex != currentMesh )
+				{
+					currentMesh		= tri.meshIndex;
+					currentSubset	= invalid;
+					remap.clear();
+
+					Source::Mesh mesh{};
+					mesh.name			= srcMesh.name;
+					mesh.boneIndex		= srcMesh.boneIndex;
+					mesh.boneIndices	= srcMesh.boneIndices;
+					mesh.boneOffsets	= srcMesh.boneOffsets;
+					dest.meshes.emplace_back( std::move( mesh ) );
+				}
+
+				auto &dstMesh = dest.meshes.back();
+				if ( tri.subsetIndex != currentSubset )
+				{
+					currentSubset = tri.subsetIndex;
+
+					Source::Subset subset = srcMesh.subsets[tri.subsetIndex];
+					subset.indexStart = scast<unsigned int>( dstMesh.indices.size() );
+					subset.indexCount = 0U;
+					dstMesh.subsets.emplace_back( std::move( subset ) );
+				}
+
+				auto &dstSubset = dstMesh.subsets.back();
+				for ( size_t i = 0; i < 3; ++i )
+				{
+					const unsigned int oldIndex = srcMesh.indices[tri.firstIndex + i];
+
+					auto found = remap.find( oldIndex );
+					if ( found == remap.end() )
+					{
+						const unsigned int newIndex = scast<unsigned int>( dstMesh.positions.size() );
+						dstMesh.positions.emplace_back( srcMesh.positions[oldIndex] );
+						if ( oldIndex < srcMesh.texCoords.size() )
+						{
+							dstMesh.texCoords.emplace_back( srcMesh.texCoords[oldIndex] );
+						}
+						if ( oldIndex < srcMesh.boneInfluences.size() )
+						{
+							dstMesh.boneInfluences.emplace_back( srcMesh.boneInfluences[oldIndex] );
+						}
+
+						found = remap.emplace( oldIndex, newIndex ).first;
+						Expand( wsPositions[tri.meshIndex][oldIndex] );
+					}
+
+					dstMesh.indices.emplace_back( found->second );
+				}
+				dstSubset.indexCount += 3U;
+			}
+
+			chunk.area.pos		= ( wsMin + wsMax ) * 0.5f;
+			chunk.area.pos.z	= 0.0f;
+			chunk.area.size		= ( wsMax - wsMin ) * 0.5f;
+			chunk.area.size.z	= FLT_MAX;
+			chunk.area.exist	= true;
+
+			return chunk;
+		}
+	}
+
+	std::vector<Chunk> Split( const Donya::Model::Source &source, float blockWholeSize )
+	{
+		if ( blockWholeSize <= 0.0f ) { return {}; }
+		// else
+
+		const auto wsPositions = MakeWorldPositions( source );
+
+		std::vector<Bucket> buckets;
+		std::unordered_map<long long, size_t> bucketIndices; // Block key -> Index of buckets
+
+		const size_t meshCount = source.meshes.size();
+		for ( size_t m = 0; m < meshCount; ++m )
+		{
+			const auto &mesh		= source.meshes[m];
+			const auto &positions	= wsPositions[m];
+			const size_t subsetCount = mesh.subsets.size();
+			for ( size_t s = 0; s < subsetCount; ++s )
+			{
+				const auto &subset	= mesh.subsets[s];
+				const size_t first	= subset.indexStart;
+				const size_t last	= std::min( mesh.indices.size(), first + subset.indexCount );
+				for ( size_t i = first; i + 2 < last; i += 3 )
+				{
+					const Donya::Vector3 centroid =
+					(
+						positions[mesh.indices[i + 0]] +
+						positions[mesh.indices[i + 1]] +
+						positions[mesh.indices[i + 2]]
+					) / 3.0f;
+
+					const Donya::Int2 blockIndex = CalcBlockIndex( centroid, blockWholeSize );
+					const long long   key = MakeBlockKey( blockIndex );
+
+					auto found = bucketIndices.find( key );
+					if ( found == bucketIndices.end() )
+					{
+						found = bucketIndices.emplace( key, buckets.size() ).first;
+						buckets.emplace_back( Bucket{ blockIndex, {} } );
+					}
+
+					buckets[found->second].triangles.emplace_back( TriangleRef{ m, s, i } );
+				}
+			}
+		}
+
+		std::vector<Chunk> results;
+		results.reserve( buckets.size() );
+		for ( const auto &it : buckets )
+		{
+			results.emplace_back( BuildChunk( source, wsPositions, it ) );
+		}
+		return results;
+	}
+
+	size_t SelectVisibles( const std::vector<Donya::Collision::Box3F> &chunkAreas, const Donya::Collision::Box3F &wsScreen, float wsMargin, std::vector<size_t> *pOutIndices )
+	{
+		if ( !pOutIndices ) { return 0; }
+		// else
+
+		pOutIndices->clear();
+
+		Donya::Collision::Box3F extended = wsScreen;
+		extended.size.x += wsMargin;
+		extended.size.y += wsMargin;
+		extended.exist   = true;
+
+		const size_t chunkCount = chunkAreas.size();
+		for ( size_t i = 0; i < chunkCount; ++i )
+		{
+			if ( Donya::Collision::IsHit( chunkAreas[i], extended ) )
+			{
+				pOutIndices->emplace_back( i );
+			}
+		}
+
+		return pOutIndices->size();
+	}
+
+	Donya::Collision::Box3F CalcProjectedArea( const Donya::Vector4x4 &viewProjection )
+	{
+		const Donya::Vector4x4 toWorld = viewProjection.Inverse();
+
+		// Bound the corners of the view volume
+		Donya::Vector3 wsMin{ +FLT_MAX, +FLT_MAX, +FLT_MAX };
+		Donya::Vector3 wsMax{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for ( int i = 0; i < 8; ++i )
+		{
+			const Donya::Vector3 ndcCorner
+			{
+				( i & 1 ) ? 1.0f : -1.0f,
+				( i & 2 ) ? 1.0f : -1.0f,
+				( i & 4 ) ? 1.0f :  0.0f,
+			};
+			Donya::Vector4 wsCorner = toWorld.Mul( ndcCorner, 1.0f );
+			wsCorner /= wsCorner.w;
+
+			wsMin.x = std::min( wsMin.x, wsCorner.x );
+			wsMin.y = std::min( wsMin.y, wsCorner.y );
+			wsMax.x = std::max( wsMax.x, wsCorner.x );
+			wsMax.y = std::max( wsMax.y, wsCorner.y );
+		}
+
+		Donya::Collision::Box3F area;
+		area.pos.x  = ( wsMin.x + wsMax.x ) * 0.5f;
+		area.pos.y  = ( wsMin.y + wsMax.y ) * 0.5f;
+		area.pos.z  = 0.0f;
+		area.size.x = ( wsMax.x - wsMin.x ) * 0.5f;
+		area.size.y = ( wsMax.y - wsMin.y ) * 0.5f;
+		area.size.z = FLT_MAX; // Same as the screen plane
+		return area;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+#include "Donya/Collision.h"
+#include "Donya/ModelSource.h"
+
+/// <summary>
+/// Splits a stage model into some blocks of tiles, and selects the blocks that should be drawn.
+/// These functions do not use GPU, so you can use them without a window.
+/// </summary>
+namespace MapChunk
+{
+	/// <summary>
+	/// The default side length of a block, in tile count.
+	/// </summary>
+	static constexpr int defaultBlockTileCount = 16;
+
+	/// <summary>
+	/// A part of the stage model that is belonging to a block.
+	/// </summary>
+	struct Chunk
+	{
+		Donya::Int2					blockIndex;	// X:Column, Y:Row of the block.
+		Donya::Collision::Box3F		area;		// World space bounds of the contained triangles. The Z size is FLT_MAX.
+		Donya::Model::Source		source;		// Contains only the triangles of the block. The skeletal and the transforms are same as the original.
+	};
+
+	/// <summary>
+	/// Splits the "source" per block by the world space centroid of each triangle.
+	/// The "blockWholeSize" is a side length of the block in world space.
+	/// Returns an empty vector if the "source" has no triangles or the "blockWholeSize" is invalid.
+	/// </summary>
+	std::vector<Chunk> Split( const Donya::Model::Source &source, float blockWholeSize );
+
+	/// <summary>
+	/// Stores the indices of "chunkAreas" that overlaps the "wsScreen" extended by "wsMargin" into "pOutIndices"(it will be cleared).
+	/// Returns the stored count.
+	/// </summary>
+	size_t SelectVisibles( const std::vector<Donya::Collision::Box3F> &chunkAreas, const Donya::Collision::Box3F &wsScreen, float wsMargin, std::vector<size_t> *pOutIndices );
+
+	/// <summary>
+	/// Returns the world space area on the XY plane that the "viewProjection" projects. The Z size is FLT_MAX, same as the screen.
+	/// It can be used as the "wsScreen" of another camera(e.g. the light camera of the shadow pass, it sees the objects out of the screen).
+	/// </summary>
+	Donya::Collision::Box3F CalcProjectedArea( const Donya::Vector4x4 &viewProjection );
+}
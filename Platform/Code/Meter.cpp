@@ -156,9 +156,10 @@ namespace Meter
 		const Donya::Vector2 ssPos = sprite.pos + data.remainNumberPosOffset;
 		const float oldDepth = Donya::Sprite::GetDrawDepth();
 		Donya::Sprite::SetDrawDepth( drawDepth );
+		remainsText.SetText( std::to_wstring( amount ) );
 		pFontRenderer->DrawExt
 		(
-			std::to_wstring( amount ),
+			remainsText,
 			ssPos, sprite.origin,
 			data.remainNumberScale
 		);
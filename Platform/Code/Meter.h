@@ -40,6 +40,7 @@ namespace Meter
 		float	destination	= 0.0f;
 		float	maxAmount	= 1.0f;
 		mutable UIObject sprite;
+		mutable Donya::Font::Layout remainsText;	// Shaped only when the amount is changed
 	public:
 		void Init( float maxAmount, float startAmount, float destinationAmount );
 		void Update( float elapsedTime );
@@ -1,12 +1,165 @@
 #include "ModelHelper.h"
 
+#include <algorithm>	// Use std::min, std::max
+#include <cmath>		// Use std::round, std::ceil, std::fmod
+
+#include "Donya/AssetRegistry.h"
+#include "Donya/Benchmark.h"
 #include "Donya/Loader.h"
+#include "Donya/Profiler.h"
+#include "Donya/Useful.h"	// Use ReadByteCode()
+
+#undef max
+#undef min
 
 namespace ModelHelper
 {
+	namespace
+	{
+		/// <summary>
+		/// Makes the shared pose with the updated matrices, because the Pose does not update a shared skeletal.
+		/// </summary>
+		PoseCache::SharedPose MakeSharedPose( const Donya::Model::Animation::KeyFrame &keyFrame )
+		{
+			Donya::Model::Pose pose{};
+			pose.AssignSkeletal( keyFrame );
+			pose.UpdateTransformMatrices();
+			return std::make_shared<const std::vector<Donya::Model::Animation::Node>>( pose.GetCurrentPose() );
+		}
+		/// <summary>
+		/// Wraps the "seconds" into [0, wholeSeconds] by the length of motion.
+		/// The negative time is regarded as the reverse playing from the end, same as the Animator::CalcCurrentPose().
+		/// </summary>
+		float WrapSeconds( float seconds, float wholeSeconds )
+		{
+			if ( wholeSeconds <= 0.0f ) { return 0.0f; }
+			if ( 0.0f <= seconds && seconds <= wholeSeconds ) { return seconds; }
+			// else
+
+			const float wrapped = std::fmod( seconds, wholeSeconds );
+			return ( wrapped < 0.0f ) ? wrapped + wholeSeconds : wrapped;
+		}
+	}
+
+	void PoseCache::Enable( float quantizeStepSeconds )
+	{
+		Disable();
+		if ( quantizeStepSeconds <= 0.0f ) { return; }
+		// else
+
+		timeStep = quantizeStepSeconds;
+	}
+	void PoseCache::Bake( const Donya::Model::MotionHolder &holder, float sampleStepSeconds )
+	{
+		Disable();
+		if ( sampleStepSeconds <= 0.0f ) { return; }
+		// else
+
+		timeStep = sampleStepSeconds;
+		wasBaked = true;
+
+		Donya::Model::Animator sampler{};
+		sampler.DisableLoop(); // Take the last key-frame at the end of motion
+
+		const size_t motionCount = holder.GetMotionCount();
+		bakedPoses.resize( motionCount );
+		for ( size_t i = 0; i < motionCount; ++i )
+		{
+			const auto &motion = holder.GetMotion( scast<int>( i ) );
+			auto &frames = bakedPoses[i];
+			if ( motion.keyFrames.empty() ) { continue; }
+			// else
+
+			const float wholeSeconds = motion.keyFrames.back().seconds;
+			const int   frameCount   = scast<int>( std::ceil( wholeSeconds / timeStep ) ) + 1;
+			frames.reserve( frameCount );
+			for ( int f = 0; f < frameCount; ++f )
+			{
+				sampler.SetInternalElapsedTime( std::min( wholeSeconds, timeStep * f ) );
+				frames.emplace_back( MakeSharedPose( sampler.CalcCurrentPose( motion ) ) );
+			}
+		}
+	}
+	void PoseCache::Disable()
+	{
+		timeStep = 0.0f;
+		wasBaked = false;
+		cachedPoses.clear();
+		bakedPoses.clear();
+		ResetCounters();
+	}
+	bool PoseCache::IsEnabled() const { return ( 0.0f < timeStep ); }
+	bool PoseCache::WasBaked() const { return wasBaked; }
+	PoseCache::SharedPose PoseCache::Fetch( const Donya::Model::MotionHolder &holder, int motionIndex, const Donya::Model::Animator &animator )
+	{
+		if ( !IsEnabled() || holder.IsOutOfRange( motionIndex ) ) { return nullptr; }
+		// else
+
+		const auto &keyFrames = holder.GetMotion( motionIndex ).keyFrames;
+		if ( keyFrames.empty() ) { return nullptr; }
+		// else
+
+		const float currentSeconds	= WrapSeconds( animator.GetInternalElapsedTime(), keyFrames.back().seconds );
+		const int   frameIndex		= scast<int>( std::round( currentSeconds / timeStep ) );
+
+		if ( wasBaked )
+		{
+			const auto &frames = bakedPoses[motionIndex];
+			if ( frames.empty() ) { return nullptr; }
+			// else
+
+			hitCount++;
+			const size_t clamped = std::min( frames.size() - 1, scast<size_t>( frameIndex ) );
+			return frames[clamped];
+		}
+		// else
+
+		const unsigned long long key = MakeKey( motionIndex, frameIndex );
+		const auto found = cachedPoses.find( key );
+		if ( found != cachedPoses.end() )
+		{
+			hitCount++;
+			return found->second;
+		}
+		// else
+
+		missCount++;
+
+		Donya::Model::Animator sampler = animator;
+		sampler.SetInternalElapsedTime( timeStep * frameIndex );
+
+		SharedPose pPose = MakeSharedPose( sampler.CalcCurrentPose( keyFrames ) );
+		cachedPoses.emplace( key, pPose );
+		return pPose;
+	}
+	size_t PoseCache::GetStoredPoseCount() const
+	{
+		if ( !wasBaked ) { return cachedPoses.size(); }
+		// else
+
+		size_t sum = 0;
+		for ( const auto &it : bakedPoses )
+		{
+			sum += it.size();
+		}
+		return sum;
+	}
+	size_t PoseCache::GetHitCount() const { return hitCount; }
+	size_t PoseCache::GetMissCount() const { return missCount; }
+	void PoseCache::ResetCounters()
+	{
+		hitCount  = 0;
+		missCount = 0;
+	}
+	unsigned long long PoseCache::MakeKey( int motionIndex, int frameIndex )
+	{
+		return ( scast<unsigned long long>( scast<unsigned int>( motionIndex ) ) << 32 ) | scast<unsigned int>( frameIndex );
+	}
+
 	void SkinningOperator::Initialize( const std::shared_ptr<ModelHelper::SkinningSet> &pAssignResource )
 	{
 		pResource = pAssignResource;
+		assignedMotionIndex = -1;
 		if ( pResource )
 		{
 			pose.AssignSkeletal( pResource->skeletal );
@@ -27,6 +180,8 @@ namespace ModelHelper
 		if ( !pResource ) { return; }
 		// else
 
+		PROFILE_SCOPE( "SkinningOperator::AssignMotion" );
+
 		if ( motionIndex < 0 || GetMotionCount() <= motionIndex )
 		{
 			_ASSERT_EXPR( 0, L"Error: Passed motion index is out of range!" );
@@ -37,6 +192,31 @@ namespace ModelHelper
 		const auto &motion = pResource->motionHolder.GetMotion( motionIndex );
 
 		animator.SetRepeatRange( motion );
+		assignedMotionIndex = motionIndex;
+
+		if ( pResource->poseCache.IsEnabled() )
+		{
+			const auto pCachedPose = pResource->poseCache.Fetch( pResource->motionHolder, motionIndex, animator );
+			if ( pCachedPose )
+			{
+				pose.AssignSharedSkeletal( pCachedPose );
+				return;
+			}
+		}
+		// else
+
+		const auto &compressions = pResource->compressedMotions;
+		if ( scast<size_t>( motionIndex ) < compressions.size() )
+		{
+			// The time is wrapped already, so the sampling does not need to loop
+			if ( compressions[motionIndex].Sample( CalcMotionSeconds(), /* loop = */ false, &sampledSkeletal ) )
+			{
+				pose.AssignSkeletal( sampledSkeletal );
+				return;
+			}
+		}
+		// else
+
 		pose.AssignSkeletal( animator.CalcCurrentPose( motion ) );
 	}
 	void SkinningOperator::UpdateMotion( float elapsedTime, int motionIndex )
@@ -47,6 +227,25 @@ namespace ModelHelper
 		animator.Update( elapsedTime );
 		AssignMotion( motionIndex );
 	}
+	bool  SkinningOperator::CanDrawByPalette() const
+	{
+		if ( !pResource || !IsAssignableIndex( assignedMotionIndex ) ) { return false; }
+		// else
+
+		const auto &palette = pResource->palette;
+		return ( palette.IsBaked() && scast<size_t>( assignedMotionIndex ) < palette.GetMotionCount() );
+	}
+	float SkinningOperator::CalcMotionSeconds() const
+	{
+		if ( !IsAssignableIndex( assignedMotionIndex ) ) { return 0.0f; }
+		// else
+
+		const auto &keyFrames = pResource->motionHolder.GetMotion( assignedMotionIndex ).keyFrames;
+		if ( keyFrames.empty() ) { return 0.0f; }
+		// else
+
+		return WrapSeconds( animator.GetInternalElapsedTime(), keyFrames.back().seconds );
+	}
 
 	bool Load( const std::string &filePath, StaticSet *pOut )
 	{
@@ -81,6 +280,327 @@ namespace ModelHelper
 
 		return pOut->model.WasInitializeSucceeded();
 	}
+	bool CompressMotions( SkinningSet *pTarget )
+	{
+		if ( !pTarget ) { return false; }
+		// else
+
+		const auto &motions = pTarget->motionHolder.GetAllMotions();
+		auto &compressions = pTarget->compressedMotions;
+		compressions.resize( motions.size() );
+		for ( size_t i = 0; i < motions.size(); ++i )
+		{
+			if ( !compressions[i].Compress( motions[i] ) )
+			{
+				compressions.clear();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	namespace
+	{
+		static Donya::Asset::Cache<SkinningSet> skinningCache{ Donya::Asset::Type::SkinningModel };
+	}
+
+	StagedSkinningLoad::StagedSkinningLoad( const std::string &filePath, const Callback &onLoaded, bool useCache )
+		: filePath( filePath ), onLoaded( onLoaded ), useCache( useCache )
+	{}
+	StagedSkinningLoad::~StagedSkinningLoad() = default;
+	bool StagedSkinningLoad::Read()
+	{
+		if ( useCache )
+		{
+			pResult = skinningCache.Acquire( filePath );
+			if ( pResult ) { return true; }
+			// else
+		}
+
+		const long readLength = Donya::ReadByteCode( &binary, filePath );
+		if ( readLength < 0 )
+		{
+			const std::string msg = "Error: File is not found: " + filePath + "\n";
+			Donya::OutputDebugStr( msg.c_str() );
+			return false;
+		}
+		// else
+
+		byteLength = scast<size_t>( readLength );
+		return true;
+	}
+	bool StagedSkinningLoad::Decode()
+	{
+		if ( pResult ) { return true; } // Cached
+		// else
+
+		if ( !binary ) { return false; }
+		// else
+
+		pLoader = std::make_unique<Donya::Loader>();
+		const bool succeeded = pLoader->LoadFromMemory( filePath, binary.get(), byteLength );
+		binary.reset();
+
+		return succeeded;
+	}
+	bool StagedSkinningLoad::Upload()
+	{
+		if ( pResult ) // Cached
+		{
+			if ( onLoaded ) { onLoaded( pResult ); }
+			return true;
+		}
+		// else
+
+		if ( !pLoader ) { return false; }
+		// else
+
+		const auto &source	= pLoader->GetModelSource();
+		pResult				= std::make_shared<SkinningSet>();
+		pResult->model		= Donya::Model::SkinningModel::Create( source, pLoader->GetFileDirectory() );
+		pResult->skeletal	= source.skeletal;
+		pResult->motionHolder.AppendSource( source );
+		pLoader.reset();
+
+		if ( !pResult->model.WasInitializeSucceeded() )
+		{
+			pResult.reset();
+
+			const std::string msg = "Failed: Loading failed: " + filePath + "\n";
+			Donya::OutputDebugStr( msg.c_str() );
+			return false;
+		}
+		// else
+
+		// The file size is enough as the estimate for the budget
+		if ( useCache )
+		{
+			skinningCache.Store( filePath, pResult, byteLength );
+		}
+
+		if ( onLoaded ) { onLoaded( pResult ); }
+		return true;
+	}
+	bool StagedSkinningLoad::LoadAll()
+	{
+		return Read() && Decode() && Upload();
+	}
+
+	void PaletteBenchmark::Measure( SkinningSet *pResource, int sampleCount )
+	{
+		if ( !pResource || sampleCount <= 0 ) { return; }
+		// else
+
+		auto &resource = *pResource;
+		if ( !resource.palette.IsBaked() )
+		{
+			resource.palette.Bake( resource.model, resource.motionHolder, defaultBakeStep );
+		}
+
+		const auto &motions = resource.motionHolder.GetAllMotions();
+		const auto &meshes  = resource.model.GetMeshes();
+		const int motionCount = scast<int>( motions.size() );
+
+		motionBytes = 0;
+		for ( const auto &motion : motions )
+		{
+			for ( const auto &keyFrame : motion.keyFrames )
+			{
+				motionBytes += sizeof( Donya::Model::Animation::Node ) * keyFrame.keyPose.size();
+			}
+		}
+		paletteBytes = resource.palette.CalcMemoryBytes();
+
+		using Bone = Donya::Model::Constants::PerMesh::Bone;
+		Bone					constants{};
+		Donya::Model::Animator	animator{};
+		Donya::Model::Pose		pose{};
+		Benchmark				timer{};
+		int						evaluatedCount = 0;
+		auto CalcSeconds = [&]( int motionIndex, int sampleIndex )
+		{
+			const auto &keyFrames = motions[motionIndex].keyFrames;
+			return keyFrames.back().seconds * scast<float>( sampleIndex ) / scast<float>( sampleCount );
+		};
+
+		// Same as the SkinningRenderer does per draw
+		timer.Begin();
+		for ( int m = 0; m < motionCount; ++m )
+		{
+			if ( motions[m].keyFrames.empty() ) { continue; }
+			// else
+
+			for ( int s = 0; s < sampleCount; ++s )
+			{
+				animator.SetInternalElapsedTime( CalcSeconds( m, s ) );
+				pose.AssignSkeletal( animator.CalcCurrentPose( motions[m] ) );
+
+				const auto &currentPose = pose.GetCurrentPose();
+				for ( const auto &mesh : meshes )
+				{
+					const size_t boneCount = std::min( mesh.boneIndices.size(), scast<size_t>( Bone::MAX_BONE_COUNT ) );
+					for ( size_t i = 0; i < boneCount; ++i )
+					{
+						constants.boneTransforms[i] = mesh.boneOffsets[i].global * currentPose[mesh.boneIndices[i]].global;
+					}
+				}
+
+				evaluatedCount++;
+			}
+		}
+		poseSeconds = ( evaluatedCount ) ? timer.EndF() / scast<float>( evaluatedCount ) : 0.0f;
+
+		evaluatedCount = 0;
+		const size_t meshCount = meshes.size();
+		timer.Begin();
+		for ( int m = 0; m < motionCount; ++m )
+		{
+			if ( motions[m].keyFrames.empty() ) { continue; }
+			// else
+
+			for ( int s = 0; s < sampleCount; ++s )
+			{
+				const float seconds = CalcSeconds( m, s );
+				for ( size_t i = 0; i < meshCount; ++i )
+				{
+					resource.palette.Sample( m, seconds, i, /* interpolate = */ true, &constants );
+				}
+
+				evaluatedCount++;
+			}
+		}
+		paletteSeconds = ( evaluatedCount ) ? timer.EndF() / scast<float>( evaluatedCount ) : 0.0f;
+	}
+#if USE_IMGUI
+	void PaletteBenchmark::ShowImGuiNode( const std::string &nodeCaption, SkinningSet *pResource )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		if ( !pResource )
+		{
+			ImGui::TextDisabled( u8"fǂݍ܂Ă܂" );
+			ImGui::TreePop();
+			return;
+		}
+		// else
+
+		if ( ImGui::Button( u8"v" ) )
+		{
+			Measure( pResource );
+		}
+
+		constexpr float toKB = 1.0f / 1024.0f;
+		constexpr float toUS = 1000000.0f;
+		ImGui::Text( u8"L[t[̗eʁF[%8.2f KB]",	scast<float>( motionBytes  ) * toKB );
+		ImGui::Text( u8"pbg̗eʁF[%8.2f KB]",		scast<float>( paletteBytes ) * toKB );
+		ImGui::Text( u8"|[Y񂠂F[%8.3f s]",	poseSeconds    * toUS );
+		ImGui::Text( u8"pbg񂠂F[%8.3f s]",	paletteSeconds * toUS );
+
+		ImGui::TreePop();
+	}
+#endif // USE_IMGUI
+
+	void CompressionBenchmark::Measure( const SkinningSet &resource, int sampleCount )
+	{
+		if ( sampleCount <= 0 ) { return; }
+		// else
+
+		const auto &motions = resource.motionHolder.GetAllMotions();
+		const size_t motionCount = motions.size();
+
+		std::vector<Donya::Model::CompressedMotion> compressions( motionCount );
+		motionBytes			= 0;
+		compressedBytes		= 0;
+		trackCount			= 0;
+		constantTrackCount	= 0;
+		for ( size_t m = 0; m < motionCount; ++m )
+		{
+			compressions[m].Compress( motions[m] );
+
+			motionBytes			+= Donya::Model::CompressedMotion::CalcMemoryBytes( motions[m] );
+			compressedBytes		+= compressions[m].CalcMemoryBytes();
+			trackCount			+= compressions[m].GetBoneCount() * 3U;
+			constantTrackCount	+= compressions[m].GetConstantTrackCount();
+		}
+
+		Donya::Model::Animator	animator{};
+		Donya::Model::Pose		pose{};
+		Benchmark				timer{};
+		int						evaluatedCount = 0;
+		auto CalcSeconds = [&]( size_t motionIndex, int sampleIndex )
+		{
+			const auto &keyFrames = motions[motionIndex].keyFrames;
+			return keyFrames.back().seconds * scast<float>( sampleIndex ) / scast<float>( sampleCount );
+		};
+
+		timer.Begin();
+		for ( size_t m = 0; m < motionCount; ++m )
+		{
+			if ( motions[m].keyFrames.empty() ) { continue; }
+			// else
+
+			for ( int s = 0; s < sampleCount; ++s )
+			{
+				animator.SetInternalElapsedTime( CalcSeconds( m, s ) );
+				pose.AssignSkeletal( animator.CalcCurrentPose( motions[m] ) );
+				evaluatedCount++;
+			}
+		}
+		poseSeconds = ( evaluatedCount ) ? timer.EndF() / scast<float>( evaluatedCount ) : 0.0f;
+
+		// Decode into the reused buffer, then assign it to the pose as same as above
+		std::vector<Donya::Model::Animation::Node> skeletal{};
+		evaluatedCount = 0;
+		timer.Begin();
+		for ( size_t m = 0; m < motionCount; ++m )
+		{
+			if ( compressions[m].IsEmpty() ) { continue; }
+			// else
+
+			skeletal.clear();
+			for ( int s = 0; s < sampleCount; ++s )
+			{
+				compressions[m].Sample( CalcSeconds( m, s ), /* loop = */ true, &skeletal );
+				pose.AssignSkeletal( skeletal );
+				evaluatedCount++;
+			}
+		}
+		decodeSeconds = ( evaluatedCount ) ? timer.EndF() / scast<float>( evaluatedCount ) : 0.0f;
+	}
+#if USE_IMGUI
+	void CompressionBenchmark::ShowImGuiNode( const std::string &nodeCaption, const SkinningSet *pResource )
+	{
+		if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+		// else
+
+		if ( !pResource )
+		{
+			ImGui::TextDisabled( u8"fǂݍ܂Ă܂" );
+			ImGui::TreePop();
+			return;
+		}
+		// else
+
+		if ( ImGui::Button( u8"v" ) )
+		{
+			Measure( *pResource );
+		}
+
+		constexpr float toKB = 1.0f / 1024.0f;
+		constexpr float toUS = 1000000.0f;
+		const float ratio = ( compressedBytes ) ? scast<float>( motionBytes ) / scast<float>( compressedBytes ) : 0.0f;
+		ImGui::Text( u8"L[t[̗eʁF[%8.2f KB]",	scast<float>( motionBytes		) * toKB );
+		ImGui::Text( u8"k̗eʁF[%8.2f KB]",		scast<float>( compressedBytes	) * toKB );
+		ImGui::Text( u8"kF[%6.2f {]",				ratio );
+		ImGui::Text( u8"萔gbNF[%d / %d]",			scast<int>( constantTrackCount ), scast<int>( trackCount ) );
+		ImGui::Text( u8"|[Y񂠂F[%8.3f s]",	poseSeconds   * toUS );
+		ImGui::Text( u8"񂠂F[%8.3f s]",		decodeSeconds * toUS );
+
+		ImGui::TreePop();
+	}
+#endif // USE_IMGUI
 
 #if USE_IMGUI
 	void PartApply::ShowImGuiNode( const std::string &nodeCaption )
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #undef max
@@ -10,12 +12,19 @@
 #include <cereal/types/vector.hpp>
 
 #include "Donya/Model.h"
+#include "Donya/ModelBonePalette.h"
 #include "Donya/ModelCommon.h"
 #include "Donya/ModelMotion.h"
+#include "Donya/ModelMotionCompressed.h"
 #include "Donya/ModelPose.h"
 #include "Donya/Serializer.h"
 #include "Donya/UseImGui.h"		// Use USE_IMGUI macro
 
+namespace Donya
+{
+	class Loader;
+}
+
 namespace ModelHelper
 {
 	struct StaticSet
@@ -23,12 +32,61 @@ namespace ModelHelper
 		Donya::Model::StaticModel	model;
 		Donya::Model::Pose			pose;
 	};
+	/// <summary>
+	/// Stores the poses that are calculated from the motions of one resource, and shares them as read-only.
+	/// The instances that play the same motion at nearly the same time can share one pose evaluation.
+	/// </summary>
+	class PoseCache
+	{
+	public:
+		using SharedPose = Donya::Model::Pose::SharedSkeletal;
+	private:
+		float	timeStep	= 0.0f;		// The quantize step of time. Zero means disabled.
+		bool	wasBaked	= false;
+		std::unordered_map<unsigned long long, SharedPose>	cachedPoses;	// Key is made by MakeKey(). Used if not baked.
+		std::vector<std::vector<SharedPose>>				bakedPoses;		// [Motion][Frame]. Used if baked.
+		size_t	hitCount	= 0;
+		size_t	missCount	= 0;
+	public:
+		/// <summary>
+		/// Enable the cache that stores a pose when it is required at first.
+		/// The time of a motion is quantized by "quantizeStepSeconds".
+		/// </summary>
+		void Enable( float quantizeStepSeconds );
+		/// <summary>
+		/// Calculate all poses of all motions at the fixed sample rate, then enable the cache.
+		/// </summary>
+		void Bake( const Donya::Model::MotionHolder &motionHolder, float sampleStepSeconds );
+		/// <summary>
+		/// Disable the cache, and release all stored poses.
+		/// </summary>
+		void Disable();
+		bool IsEnabled() const;
+		bool WasBaked() const;
+	public:
+		/// <summary>
+		/// Returns the pose that is nearest to the current time of the "animator".
+		/// Returns nullptr if the cache is disabled or the "motionIndex" is invalid.
+		/// </summary>
+		SharedPose Fetch( const Donya::Model::MotionHolder &motionHolder, int motionIndex, const Donya::Model::Animator &animator );
+	public:
+		size_t GetStoredPoseCount() const;
+		size_t GetHitCount() const;
+		size_t GetMissCount() const;
+		void ResetCounters();
+	private:
+		static unsigned long long MakeKey( int motionIndex, int frameIndex );
+	};
+
 	struct SkinningSet
 	{
 		using Node = Donya::Model::Animation::Node;
 		Donya::Model::SkinningModel	model;
 		std::vector<Node>			skeletal;	// Represents an initial pose(like a T-pose)
 		Donya::Model::MotionHolder	motionHolder;
+		PoseCache					poseCache;	// Disabled by default
+		Donya::Model::BonePalette	palette;	// Not baked by default
+		std::vector<Donya::Model::CompressedMotion> compressedMotions;	// Empty by default. Made by CompressMotions()
 	};
 	class  SkinningOperator
 	{
@@ -36,6 +94,8 @@ namespace ModelHelper
 		std::shared_ptr<ModelHelper::SkinningSet> pResource = nullptr;
 		Donya::Model::Pose			pose;
 		Donya::Model::Animator		animator;
+		int							assignedMotionIndex = -1;	// The motion of the last AssignMotion()
+		std::vector<Donya::Model::Animation::Node> sampledSkeletal;	// The reused buffer for sampling the compressed motion
 	public:
 		void Initialize( const std::shared_ptr<ModelHelper::SkinningSet> &pAssignResource );
 	public:
@@ -46,12 +106,24 @@ namespace ModelHelper
 		bool IsAssignableIndex( int motionIndex ) const;
 		/// <summary>
 		/// Assign the specified motion to model.pose.
+		/// If the pose cache of the resource is enabled, the pose will refer the cached pose.
+		/// Else if the resource has the compressed motions, the pose will be sampled from them instead of the key-frames.
 		/// </summary>
 		void AssignMotion( int motionIndex );
 		/// <summary>
 		/// Update the animator then call AssignMotion().
 		/// </summary>
 		void UpdateMotion( float elapsedTime, int motionIndex );
+	public:
+		/// <summary>
+		/// Returns true if the palette of the resource is baked and the assigned motion can be sampled from it.
+		/// You can draw by the palette instead of the pose if you only assign the motions(the pose is not modified).
+		/// </summary>
+		bool  CanDrawByPalette() const;
+		/// <summary>
+		/// Returns the current time of the assigned motion, that is wrapped into the motion's range. It is used for sampling the palette.
+		/// </summary>
+		float CalcMotionSeconds() const;
 	};
 
 	/// <summary>
@@ -62,6 +134,107 @@ namespace ModelHelper
 	/// Returns true if the load process was succeed.
 	/// </summary>
 	bool Load( const std::string &filePath, SkinningSet *pOut );
+	/// <summary>
+	/// Compresses the all motions of the "pTarget" into its compressedMotions, then the SkinningOperator samples them.
+	/// The key-frames are kept, because the Animator uses the length of them.
+	/// Returns false if some motion could not be compressed, then the compressedMotions will be empty.
+	/// </summary>
+	bool CompressMotions( SkinningSet *pTarget );
+
+	/// <summary>
+	/// Loads a skinning model by the separated stages, for running them on the different threads.<para></para>
+	/// Read() and Decode() do not use GPU. Upload() creates the buffers by the device(it does not use the immediate-context).<para></para>
+	/// Upload() also creates the textures through the texture cache that is not thread-safe, so do not run it concurrently with another texture creation.<para></para>
+	/// Please call them in order. The "onLoaded" is called at the end of Upload() with the loaded model.<para></para>
+	/// The loaded model is registered to Donya::Asset. If the same file is cached, Read() takes it and the other stages only call the "onLoaded".
+	/// </summary>
+	class StagedSkinningLoad
+	{
+	public:
+		using Callback = std::function<void( const std::shared_ptr<SkinningSet> & )>;
+	private:
+		std::string						filePath;
+		Callback						onLoaded;
+		std::unique_ptr<char[]>			binary;
+		size_t							byteLength = 0;
+		std::unique_ptr<Donya::Loader>	pLoader;
+		std::shared_ptr<SkinningSet>	pResult;
+		bool							useCache = true;
+	public:
+		/// <summary>
+		/// If the "useCache" is false, the cache is neither referred nor stored(e.g. for measuring the loading).
+		/// </summary>
+		explicit StagedSkinningLoad( const std::string &filePath, const Callback &onLoaded = nullptr, bool useCache = true );
+		~StagedSkinningLoad();
+		StagedSkinningLoad( const StagedSkinningLoad & ) = delete;
+		StagedSkinningLoad & operator = ( const StagedSkinningLoad & ) = delete;
+	public:
+		/// <summary>
+		/// Reads the whole file into the memory. If the model is cached, the later stages use it instead of loading.
+		/// </summary>
+		bool Read();
+		/// <summary>
+		/// Decodes the read binary, then releases it.
+		/// </summary>
+		bool Decode();
+		/// <summary>
+		/// Creates the model from the decoded source, then releases the source.
+		/// </summary>
+		bool Upload();
+		/// <summary>
+		/// Calls the all stages in order.
+		/// </summary>
+		bool LoadAll();
+	public:
+		const std::string				&GetFilePath()	const { return filePath;	}
+		size_t							GetByteLength()	const { return byteLength;	}
+		std::shared_ptr<SkinningSet>	GetResult()		const { return pResult;		}
+	};
+
+	/// <summary>
+	/// Compares the cost of making the bone constants between the pose(interpolate key-frames then multiply bone-offsets) and the baked palette.
+	/// </summary>
+	struct PaletteBenchmark
+	{
+	public:
+		static constexpr float defaultBakeStep = 1.0f / 60.0f;
+	public:
+		size_t	motionBytes		= 0;	// Byte size of the key-frames' nodes
+		size_t	paletteBytes	= 0;	// Byte size of the baked palette
+		float	poseSeconds		= 0.0f;	// Average seconds per one sample
+		float	paletteSeconds	= 0.0f;	// Average seconds per one sample
+	public:
+		/// <summary>
+		/// Evaluates every motion at "sampleCount" timings by both ways. The palette will be baked if it has not been baked.
+		/// This does not use GPU.
+		/// </summary>
+		void Measure( SkinningSet *pResource, int sampleCount = 256 );
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption, SkinningSet *pResource );
+	#endif // USE_IMGUI
+	};
+	/// <summary>
+	/// Compresses the all motions of a resource, then compares the size and the decoding cost with the key-frames.
+	/// </summary>
+	struct CompressionBenchmark
+	{
+	public:
+		size_t	motionBytes			= 0;	// Byte size of the key-frames
+		size_t	compressedBytes		= 0;	// Byte size of the compressed motions
+		size_t	trackCount			= 0;
+		size_t	constantTrackCount	= 0;
+		float	poseSeconds			= 0.0f;	// Average seconds per one sample of Animator::CalcCurrentPose()
+		float	decodeSeconds		= 0.0f;	// Average seconds per one sample of CompressedMotion::Sample()
+	public:
+		/// <summary>
+		/// Evaluates every motion at "sampleCount" timings by both ways.
+		/// This does not use GPU.
+		/// </summary>
+		void Measure( const SkinningSet &resource, int sampleCount = 256 );
+	#if USE_IMGUI
+		void ShowImGuiNode( const std::string &nodeCaption, const SkinningSet *pResource );
+	#endif // USE_IMGUI
+	};
 
 	struct PartApply
 	{
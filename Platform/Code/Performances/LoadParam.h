@@ -81,6 +81,10 @@ namespace Performer
 		Icon	partIcon;
 		String	partString;
 		float	fadeSecond = 0.5f;
+		Donya::Vector2	progressBarOffset{ 0.0f, 64.0f };	// From the base position
+		Donya::Vector2	progressBarSize{ 320.0f, 8.0f };	// Whole size
+		Donya::Vector3	progressBarColor{ 1.0f, 1.0f, 1.0f };
+		float			progressBarBackAlpha = 0.3f;		// Multiplied to the alpha of the remaining part
 	private:
 		friend class cereal::access;
 		template<class Archive>
@@ -97,6 +101,16 @@ namespace Performer
 				archive( CEREAL_NVP( fadeSecond ) );
 			}
 			if ( 2 <= version )
+			{
+				archive
+				(
+					CEREAL_NVP( progressBarOffset		),
+					CEREAL_NVP( progressBarSize			),
+					CEREAL_NVP( progressBarColor		),
+					CEREAL_NVP( progressBarBackAlpha	)
+				);
+			}
+			if ( 3 <= version )
 			{
 				// archive( CEREAL_NVP( x ) );
 			}
@@ -107,6 +121,6 @@ namespace Performer
 	#endif // USE_IMGUI
 	};
 }
-CEREAL_CLASS_VERSION( Performer::LoadParam,			1 )
+CEREAL_CLASS_VERSION( Performer::LoadParam,			2 )
 CEREAL_CLASS_VERSION( Performer::LoadParam::Icon,	0 )
 CEREAL_CLASS_VERSION( Performer::LoadParam::String,	0 )
@@ -10,6 +10,11 @@
 
 namespace Performer
 {
+	namespace
+	{
+		constexpr float progressFollowSecond = 0.25f;
+	}
+
 	namespace Parameter
 	{
 		static ParamOperator<LoadParam> parameter{ "Load", "Performance/" };
@@ -79,6 +84,18 @@ namespace Performer
 		partString.ShowImGuiNode( u8"ݒ"		);
 		ImGui::DragFloat( u8"tF[hAEgɂb", &fadeSecond, 0.01f );;
 		fadeSecond = std::max( 0.0f, fadeSecond );
+
+		if ( ImGui::TreeNode( u8"io[ݒ" ) )
+		{
+			ImGui::DragFloat2	( u8"ʒũItZbg",	&progressBarOffset.x,	1.0f	);
+			ImGui::DragFloat2	( u8"S̃TCY",				&progressBarSize.x,		1.0f	);
+			ImGui::ColorEdit3	( u8"F",						&progressBarColor.x				);
+			ImGui::SliderFloat	( u8"c蕔̃At@",		&progressBarBackAlpha,	0.0f, 1.0f );
+			progressBarSize.x = std::max( 0.0f, progressBarSize.x );
+			progressBarSize.y = std::max( 0.0f, progressBarSize.y );
+
+			ImGui::TreePop();
+		}
 	}
 #endif // USE_IMGUI
 
@@ -314,9 +331,14 @@ namespace Performer
 
 	void LoadPart::Init()
 	{
+		RemoveTweens();
+
 		timer		= 0.0f;
 		alpha		= 1.0f;
+		progress	= 0.0f;
+		progressDest = 0.0f;
 		active		= false;
+		showsProgress = false;
 		maskColor	= { 0.0f, 0.0f, 0.0f };
 
 		partIcon.Init();
@@ -324,23 +346,13 @@ namespace Performer
 	}
 	void LoadPart::Uninit()
 	{
-		// No op
+		RemoveTweens();
 	}
 	void LoadPart::UpdateIfActive( float elapsedTime )
 	{
 		if ( !active )
 		{
-			const auto &fadeSec = Parameter::Get().fadeSecond;
-			if ( IsZero( fadeSec ) )
-			{
-				alpha = 0.0f;
-			}
-			else
-			{
-				const float toOpaque = 1.0f / fadeSec;
-				alpha -= toOpaque * elapsedTime;
-			}
-
+			// The alpha is faded by the tween that was started at Stop()
 			if ( alpha <= 0.0f )
 			{
 				alpha = 0.0f;
@@ -372,12 +384,19 @@ namespace Performer
 
 		partIcon.Draw	( drawDepth, alpha );
 		partString.Draw	( drawDepth, alpha );
+		DrawProgressBar	( drawDepth );
 	}
 	void LoadPart::Start( const Donya::Vector2 &ssBasePos, const Donya::Color::Code &color )
 	{
+		RemoveTweens();
+
 		timer		= 0.0f;
 		alpha		= 1.0f;
+		progress	= 0.0f;
+		progressDest = 0.0f;
 		active		= true;
+		showsProgress = false;
+		basePos		= ssBasePos;
 		maskColor	= Donya::Color::MakeColor( color );
 
 		partIcon.Start( ssBasePos );
@@ -388,5 +407,76 @@ namespace Performer
 		active = false;
 
 		// The parts is still update until completely fade-outed(alpha <= 0.0f)
+		Donya::Tweener::Description desc{};
+		desc.pTarget		= &alpha;
+		desc.from			= alpha;
+		desc.to				= 0.0f;
+		desc.durationSecond	= Parameter::Get().fadeSecond * alpha; // Keep the speed if it is fading already
+		Donya::Tween::Remove( alphaTween );
+		alphaTween = Donya::Tween::Add( desc );
+	}
+	void LoadPart::SetProgress( float ratio )
+	{
+		showsProgress = true;
+
+		const float destination = std::max( 0.0f, std::min( 1.0f, ratio ) );
+		if ( destination == progressDest ) { return; }
+		// else
+
+		progressDest = destination;
+
+		Donya::Tweener::Description desc{};
+		desc.pTarget		= &progress;
+		desc.from			= progress;
+		desc.to				= destination;
+		desc.durationSecond	= progressFollowSecond;
+		desc.kind			= Donya::Easing::Kind::Cubic;
+		desc.type			= Donya::Easing::Type::Out;
+		Donya::Tween::Remove( progressTween );
+		progressTween = Donya::Tween::Add( desc );
+	}
+	void LoadPart::RemoveTweens()
+	{
+		Donya::Tween::Remove( alphaTween	);
+		Donya::Tween::Remove( progressTween	);
+	}
+	void LoadPart::DrawProgressBar( float drawDepth )
+	{
+		if ( !showsProgress ) { return; }
+		// else
+
+		const auto &data = Parameter::Get();
+		if ( IsZero( data.progressBarSize.x ) || IsZero( data.progressBarSize.y ) ) { return; }
+		// else
+
+		const Donya::Vector2 center	= basePos + data.progressBarOffset;
+		const float left			= center.x - ( data.progressBarSize.x * 0.5f );
+		const float filledWidth		= data.progressBarSize.x * progress;
+		const float remainingWidth	= data.progressBarSize.x - filledWidth;
+		const auto  &color			= data.progressBarColor;
+
+		const float oldDepth = Donya::Sprite::GetDrawDepth();
+		Donya::Sprite::SetDrawDepth( drawDepth );
+
+		if ( !IsZero( filledWidth ) )
+		{
+			Donya::Sprite::DrawRect
+			(
+				left + ( filledWidth * 0.5f ),	center.y,
+				filledWidth,					data.progressBarSize.y,
+				color.x, color.y, color.z, alpha
+			);
+		}
+		if ( !IsZero( remainingWidth ) )
+		{
+			Donya::Sprite::DrawRect
+			(
+				left + filledWidth + ( remainingWidth * 0.5f ),	center.y,
+				remainingWidth,									data.progressBarSize.y,
+				color.x, color.y, color.z, alpha * data.progressBarBackAlpha
+			);
+		}
+
+		Donya::Sprite::SetDrawDepth( oldDepth );
 	}
 }
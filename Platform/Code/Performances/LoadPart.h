@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Donya/Color.h"
+#include "../Donya/Tween.h"
 #include "../Donya/Vector.h"
 
 #include "../UI.h"
@@ -53,9 +54,15 @@ namespace Performer
 	private:
 		float	timer		= 0.0f;
 		float	alpha		= 1.0f;
+		float	progress	= 0.0f;	// 0.0f ~ 1.0f, it follows the "progressDest" by the tween
+		float	progressDest = 0.0f;
+		Donya::Tweener::Handle alphaTween;
+		Donya::Tweener::Handle progressTween;
+		Donya::Vector2 basePos{};
 		Icon	partIcon;
 		String	partString;
 		bool	active		= false;
+		bool	showsProgress = false;	// The bar is shown after the SetProgress() is called
 		Donya::Vector3 maskColor{ 0.0f, 0.0f, 0.0f };
 	public:
 		void Init();
@@ -65,5 +72,13 @@ namespace Performer
 	public:
 		void Start( const Donya::Vector2 &ssBasePos, const Donya::Color::Code &color );
 		void Stop();
+		/// <summary>
+		/// Set the ratio of the loading, 0.0f ~ 1.0f. It is shown as a bar, that follows the ratio smoothly.
+		/// The bar is not shown until this is called after the Start(), so the loading that does not report the progress has no bar.
+		/// </summary>
+		void SetProgress( float ratio );
+	private:
+		void RemoveTweens();
+		void DrawProgressBar( float drawDepth );
 	};
 }
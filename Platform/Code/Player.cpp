@@ -46,34 +46,27 @@ namespace
 
 	static std::shared_ptr<ModelHelper::SkinningSet> pModel{};
 
-	bool LoadModel()
+	std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeLoads()
 	{
 		// Already has loaded.
-		if ( pModel ) { return true; }
+		if ( pModel ) { return {}; }
 		// else
 
-		const auto filePath = MakeModelPath( MODEL_NAME );
-
-		if ( !Donya::IsExistFile( filePath ) )
+		auto StoreModel = []( const std::shared_ptr<ModelHelper::SkinningSet> &pLoaded )
 		{
-			Donya::OutputDebugStr( "Error : The Player's model file does not exist." );
-			return false;
-		}
-		// else
-
-		pModel = std::make_shared<ModelHelper::SkinningSet>();
-		const bool result = ModelHelper::Load( filePath, pModel.get() );
-		if ( !result )
+			pModel = pLoaded;
+		};
+		return { std::make_shared<ModelHelper::StagedSkinningLoad>( MakeModelPath( MODEL_NAME ), StoreModel ) };
+	}
+	bool LoadModel()
+	{
+		bool succeeded = true;
+		for ( const auto &pLoad : MakeLoads() )
 		{
-			pModel.reset(); // Make not loaded state
-
-			const std::string msg = "Failed: Loading failed: " + filePath;
-			Donya::OutputDebugStr( msg.c_str() );
-			return false;
+			if ( !pLoad->LoadAll() ) { succeeded = false; }
 		}
-		// else
 
-		return true;
+		return succeeded;
 	}
 	bool IsOutOfRange( Player::MotionKind kind )
 	{
@@ -123,15 +116,21 @@ void PlayerInitializer::LoadParameter( int stageNo )
 	LoadBin( stageNo );
 #endif // DEBUG_MODE
 }
+std::string PlayerInitializer::MakeStageFilePath( int stageNo, bool fromBinary )
+{
+	return	( fromBinary )
+			? MakeStageParamPathBinary( ID, stageNo )
+			: MakeStageParamPathJson  ( ID, stageNo );
+}
 void PlayerInitializer::LoadBin( int stageNo )
 {
 	Donya::Serializer tmp;
-	tmp.LoadBinary( *this, MakeStageParamPathBinary( ID, stageNo ).c_str(), ID );
+	tmp.LoadBinary( *this, MakeStageFilePath( stageNo, /* fromBinary = */ true ).c_str(), ID );
 }
 void PlayerInitializer::LoadJson( int stageNo )
 {
 	Donya::Serializer tmp;
-	tmp.LoadJSON( *this, MakeStageParamPathJson( ID, stageNo ).c_str(), ID );
+	tmp.LoadJSON( *this, MakeStageFilePath( stageNo, /* fromBinary = */ false ).c_str(), ID );
 }
 #if USE_IMGUI
 void PlayerInitializer::RemakeByCSV( const CSVLoader &loadedData )
@@ -324,6 +323,14 @@ bool Player::LoadResource()
 	paramInstance.LoadParameter();
 	return LoadModel();
 }
+void Player::LoadParameter()
+{
+	paramInstance.LoadParameter();
+}
+std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> Player::MakeModelLoads()
+{
+	return MakeLoads();
+}
 const ParamOperator<PlayerParam> &Player::Parameter()
 {
 	return paramInstance;
@@ -3044,6 +3051,12 @@ void Player::ShowImGuiNode( const std::string &nodeCaption )
 
 	inputManager.ShowImGuiNode( u8"͏" );
 
+	static ModelHelper::PaletteBenchmark paletteBenchmark{};
+	paletteBenchmark.ShowImGuiNode( u8"pbgĂ݂̌v", pModel.get() );
+
+	static ModelHelper::CompressionBenchmark compressionBenchmark{};
+	compressionBenchmark.ShowImGuiNode( u8"[Vǩv", pModel.get() );
+
 	if ( ImGui::Button( u8"oꉉoĐ" ) )
 	{
 		AssignMover<Appear>();
@@ -55,6 +55,10 @@ public:
 public:
 	void AssignParameter( const Donya::Vector3 &wsInitialFootPos, bool lookingRight = true );
 	void LoadParameter( int stageNo );
+	/// <summary>
+	/// Returns the path of the file that LoadParameter() reads.
+	/// </summary>
+	static std::string MakeStageFilePath( int stageNo, bool fromBinary );
 private:
 	void LoadBin( int stageNo );
 	void LoadJson( int stageNo );
@@ -88,6 +92,14 @@ private:
 	static ParamOperator<PlayerParam> paramInstance;
 public:
 	static bool LoadResource();
+	/// <summary>
+	/// LoadResource() does the both of LoadParameter() and the loading of the models.
+	/// </summary>
+	static void LoadParameter();
+	/// <summary>
+	/// Makes the load of the model if it has not been loaded. The load stores the model when it finishes.
+	/// </summary>
+	static std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> MakeModelLoads();
 	static const ParamOperator<PlayerParam> &Parameter();
 #if USE_IMGUI
 	static void UpdateParameter( const std::string &nodeCaption );
@@ -0,0 +1,403 @@
+#include "RenderQueue.h"
+
+#include <algorithm>			// Use std::sort
+#include <cstring>				// Use std::memcmp, std::memcpy
+
+#include "Donya/Profiler.h"		// Use the benchmark helpers
+#include "Donya/Random.h"
+
+#undef max
+#undef min
+
+RenderQueue::Payload RenderQueue::Payload::Make( const Constant &constant, const Donya::Model::StaticModel &model, const Donya::Model::Pose &pose )
+{
+	Payload tmp{};
+	tmp.constant	= constant;
+	tmp.kind		= ModelKind::Static;
+	tmp.pModel		= &model;
+	tmp.pPose		= &pose;
+	return tmp;
+}
+RenderQueue::Payload RenderQueue::Payload::Make( const Constant &constant, const Donya::Model::SkinningModel &model, const Donya::Model::Pose &pose )
+{
+	Payload tmp{};
+	tmp.constant	= constant;
+	tmp.kind		= ModelKind::Skinning;
+	tmp.pModel		= &model;
+	tmp.pPose		= &pose;
+	return tmp;
+}
+RenderQueue::Payload RenderQueue::Payload::Make( const Constant &constant, const Donya::Model::SkinningModel &model, const Donya::Model::BonePalette &palette, int motionIndex, float motionSeconds )
+{
+	Payload tmp{};
+	tmp.constant		= constant;
+	tmp.kind			= ModelKind::SkinningBaked;
+	tmp.pModel			= &model;
+	tmp.pPalette		= &palette;
+	tmp.motionIndex		= motionIndex;
+	tmp.motionSeconds	= motionSeconds;
+	return tmp;
+}
+
+void RenderQueue::Statistics::Add( const Statistics &other )
+{
+	packetCount			+= other.packetCount;
+	shaderChangeCount	+= other.shaderChangeCount;
+	modelChangeCount	+= other.modelChangeCount;
+	constantUpdateCount	+= other.constantUpdateCount;
+	drawCallCount		+= other.drawCallCount;
+	instancedBatchCount	+= other.instancedBatchCount;
+	instancedModelCount	+= other.instancedModelCount;
+}
+
+constexpr unsigned int	RenderQueue::passBitCount;
+constexpr unsigned int	RenderQueue::translucentBitCount;
+constexpr unsigned int	RenderQueue::shaderBitCount;
+constexpr unsigned int	RenderQueue::modelBitCount;
+constexpr unsigned int	RenderQueue::depthBitCount;
+constexpr unsigned int	RenderQueue::maxPass;
+constexpr uint32_t		RenderQueue::maxModelID;
+constexpr size_t		RenderQueue::maxInstanceCount;
+
+namespace
+{
+	constexpr unsigned int passShift		= 64U			- RenderQueue::passBitCount;
+	constexpr unsigned int translucentShift	= passShift		- RenderQueue::translucentBitCount;
+
+	// The opaque key is: [pass][0][shader][model][depth]
+	constexpr unsigned int depthShift		= 0;
+	constexpr unsigned int modelShift		= depthShift	+ RenderQueue::depthBitCount;
+	constexpr unsigned int shaderShift		= modelShift	+ RenderQueue::modelBitCount;
+	static_assert( shaderShift + RenderQueue::shaderBitCount == translucentShift, "The key must use all bits of 64-bit!" );
+
+	// The translucent key is: [pass][1][depth][shader][model]
+	constexpr unsigned int translucentModelShift	= 0;
+	constexpr unsigned int translucentShaderShift	= translucentModelShift		+ RenderQueue::modelBitCount;
+	constexpr unsigned int translucentDepthShift	= translucentShaderShift	+ RenderQueue::shaderBitCount;
+	static_assert( translucentDepthShift + RenderQueue::depthBitCount == translucentShift, "The key must use all bits of 64-bit!" );
+
+	/// <summary>
+	/// Converts the float to the unsigned int that keeps the order of the float.
+	/// </summary>
+	uint32_t ToOrderedBits( float value )
+	{
+		uint32_t bits = 0;
+		std::memcpy( &bits, &value, sizeof( bits ) );
+		return ( bits & 0x80000000U ) ? ~bits : ( bits | 0x80000000U );
+	}
+
+	unsigned int ExtractPass( uint64_t key )
+	{
+		return scast<unsigned int>( key >> passShift );
+	}
+	bool IsTranslucent( uint64_t key )
+	{
+		return ( ( key >> translucentShift ) & 1U ) ? true : false;
+	}
+	RenderQueue::Shader ExtractShader( uint64_t key )
+	{
+		constexpr uint64_t mask = ( 1U << RenderQueue::shaderBitCount ) - 1U;
+		const unsigned int shift = ( IsTranslucent( key ) ) ? translucentShaderShift : shaderShift;
+		return scast<RenderQueue::Shader>( ( key >> shift ) & mask );
+	}
+	/// <summary>
+	/// Returns true if the pass, shader and model are the same.
+	/// The translucent keys must also have the same depth, because merging the different depths breaks the order of far to near.
+	/// </summary>
+	bool IsSameGroup( uint64_t keyA, uint64_t keyB )
+	{
+		if ( IsTranslucent( keyA ) || IsTranslucent( keyB ) ) { return keyA == keyB; }
+		// else
+		return ( keyA >> modelShift ) == ( keyB >> modelShift );
+	}
+}
+
+uint64_t RenderQueue::MakeKey( unsigned int pass, Shader shader, uint32_t modelID, float depth, bool translucent )
+{
+	const uint64_t validPass	= ( pass	< maxPass	) ? pass	: maxPass;
+	const uint64_t validModel	= ( modelID	< maxModelID) ? modelID	: maxModelID;
+	const uint64_t validShader	= scast<uint64_t>( shader ) & ( ( 1U << shaderBitCount ) - 1U );
+
+	if ( translucent )
+	{
+		// Invert the depth for sorting as far to near
+		const uint64_t farToNear = scast<uint64_t>( ~ToOrderedBits( depth ) );
+		return
+			( validPass		<< passShift				) |
+			( 1ULL			<< translucentShift			) |
+			( farToNear		<< translucentDepthShift	) |
+			( validShader	<< translucentShaderShift	) |
+			( validModel	<< translucentModelShift	);
+	}
+	// else
+
+	return
+		( validPass		<< passShift	) |
+		( validShader	<< shaderShift	) |
+		( validModel	<< modelShift	) |
+		( scast<uint64_t>( ToOrderedBits( depth ) ) << depthShift );
+}
+
+void RenderQueue::Push( unsigned int pass, Shader shader, float depth, const Payload &payload )
+{
+	const bool translucent = ( payload.constant.drawColor.w < 1.0f );
+
+	Packet packet{};
+	packet.key			= MakeKey( pass, shader, FetchModelID( payload.pModel ), depth, translucent );
+	packet.payloadIndex	= scast<uint32_t>( payloads.size() );
+
+	payloads.emplace_back( payload );
+	packets.emplace_back( packet );
+	sorted = false;
+}
+void RenderQueue::Sort()
+{
+	if ( sorted ) { return; }
+	// else
+
+	std::sort
+	(
+		packets.begin(), packets.end(),
+		[]( const Packet &L, const Packet &R )
+		{
+			return ( L.key == R.key ) ? ( L.payloadIndex < R.payloadIndex ) : ( L.key < R.key );
+		}
+	);
+	sorted = true;
+}
+RenderQueue::Statistics RenderQueue::Execute( Backend *pBackend, bool useInstancing ) const
+{
+	Statistics stat{};
+	stat.packetCount = packets.size();
+	if ( !pBackend || packets.empty() ) { return stat; }
+	// else
+
+	bool			activated		= false;
+	unsigned int	currentPass		= 0;
+	Shader			currentShader	= Shader::Static;
+	const void		*pCurrentModel	= nullptr;
+	const Constant	*pLastConstant	= nullptr;
+	std::vector<const Payload *> instances{};
+
+	const size_t packetCount = packets.size();
+	for ( size_t i = 0; i < packetCount; )
+	{
+		const Packet		&packet	= packets[i];
+		const unsigned int	pass	= ExtractPass( packet.key );
+		const Shader		shader	= ExtractShader( packet.key );
+		if ( !activated || pass != currentPass || shader != currentShader )
+		{
+			if ( activated )
+			{
+				pBackend->DeactivateShader( currentPass, currentShader );
+			}
+
+			pBackend->ActivateShader( pass, shader );
+			activated		= true;
+			currentPass		= pass;
+			currentShader	= shader;
+			stat.shaderChangeCount++;
+		}
+
+		const Payload &payload = GetPayload( packet );
+		if ( payload.pModel != pCurrentModel || !stat.drawCallCount )
+		{
+			pCurrentModel = payload.pModel;
+			stat.modelChangeCount++;
+		}
+
+		const size_t instanceCount = ( useInstancing ) ? CountInstanceable( i ) : 1U;
+		if ( 2U <= instanceCount )
+		{
+			// The instanced draw fetches the constants per instance, so the model constant is not changed
+			instances.clear();
+			for ( size_t j = 0; j < instanceCount; ++j )
+			{
+				instances.emplace_back( &GetPayload( packets[i + j] ) );
+			}
+
+			pBackend->DrawInstances( instances.data(), instanceCount );
+			stat.drawCallCount++;
+			stat.instancedBatchCount++;
+			stat.instancedModelCount += instanceCount;
+
+			i += instanceCount;
+			continue;
+		}
+		// else
+
+		// The constant buffer keeps the last uploaded data, so I can skip the same one
+		if ( !pLastConstant || std::memcmp( pLastConstant, &payload.constant, sizeof( Constant ) ) != 0 )
+		{
+			pBackend->UpdateModelConstant( payload.constant );
+			pLastConstant = &payload.constant;
+			stat.constantUpdateCount++;
+		}
+
+		pBackend->Draw( payload );
+		stat.drawCallCount++;
+		++i;
+	}
+
+	if ( activated )
+	{
+		pBackend->DeactivateShader( currentPass, currentShader );
+	}
+
+	return stat;
+}
+void RenderQueue::Clear()
+{
+	packets.clear();
+	payloads.clear();
+	modelIDs.clear();
+	sorted = true;
+}
+
+bool RenderQueue::IsEmpty() const
+{
+	return packets.empty();
+}
+bool RenderQueue::IsSorted() const
+{
+	return sorted;
+}
+size_t RenderQueue::GetCount() const
+{
+	return packets.size();
+}
+const std::vector<RenderQueue::Packet> &RenderQueue::GetPackets() const
+{
+	return packets;
+}
+const RenderQueue::Payload &RenderQueue::GetPayload( const Packet &packet ) const
+{
+	_ASSERT_EXPR( packet.payloadIndex < payloads.size(), L"Error: Out of range!" );
+	return payloads[packet.payloadIndex];
+}
+
+uint32_t RenderQueue::FetchModelID( const void *pModel )
+{
+	const auto found = modelIDs.find( pModel );
+	if ( found != modelIDs.end() ) { return found->second; }
+	// else
+
+	const size_t   count	= modelIDs.size();
+	const uint32_t newID	= ( count < maxModelID ) ? scast<uint32_t>( count ) : maxModelID;
+	modelIDs.emplace( pModel, newID );
+	return newID;
+}
+size_t RenderQueue::CountInstanceable( size_t first ) const
+{
+	const Packet	&head			= packets[first];
+	const Payload	&headPayload	= GetPayload( head );
+	// The baked palette is sampled per model, so it can not be shared
+	if ( headPayload.kind == ModelKind::SkinningBaked ) { return 1U; }
+	// else
+
+	size_t count = 1U;
+	while ( first + count < packets.size() && count < maxInstanceCount )
+	{
+		const Packet	&next			= packets[first + count];
+		const Payload	&nextPayload	= GetPayload( next );
+		if ( !IsSameGroup( head.key, next.key ) )		{ break; }
+		if ( nextPayload.pModel	!= headPayload.pModel )	{ break; } // The model ID may be saturated
+		if ( nextPayload.kind	!= headPayload.kind )	{ break; }
+		// The static instances share the pose of the first one
+		if ( headPayload.kind == ModelKind::Static && nextPayload.pPose != headPayload.pPose ) { break; }
+		// else
+
+		count++;
+	}
+	return count;
+}
+
+#if USE_IMGUI
+namespace
+{
+	void ShowStatistics( const char *caption, const RenderQueue::Statistics &stat )
+	{
+		ImGui::Text
+		(
+			u8"%sF`%dCVF[_ؑ%dCfؑ%dC萔XV%d", caption,
+			scast<int>( stat.drawCallCount		),
+			scast<int>( stat.shaderChangeCount	),
+			scast<int>( stat.modelChangeCount	),
+			scast<int>( stat.constantUpdateCount)
+		);
+		if ( stat.instancedBatchCount )
+		{
+			ImGui::Text
+			(
+				u8"@CX^X`%di%d̂܂Ƃ߂j",
+				scast<int>( stat.instancedBatchCount ),
+				scast<int>( stat.instancedModelCount )
+			);
+		}
+	}
+}
+void RenderQueue::ShowImGuiNode( const std::string &nodeCaption, const Statistics &submitted, const Statistics &sorted, bool *pMeasureSubmitted )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	if ( pMeasureSubmitted )
+	{
+		ImGui::Checkbox( u8"o^łv", pMeasureSubmitted );
+	}
+	if ( !pMeasureSubmitted || *pMeasureSubmitted )
+	{
+		ShowStatistics( u8"o^", submitted );
+	}
+	ShowStatistics( u8"", sorted );
+
+	if ( ImGui::TreeNode( u8"̌v" ) )
+	{
+		static Donya::Profiler::BenchmarkCounts counts{ 2000, 1 };
+		static int			modelCount		= 16;
+		static float		sortSeconds		= 0.0f;
+		static Statistics	benchSubmitted{};
+		static Statistics	benchSorted{};
+		static Statistics	benchInstanced{};
+
+		ImGui::DragInt( u8"f̎",	&modelCount,	1.0f,	1, 1024		);
+		if ( counts.ShowControls( u8"`̐", nullptr, u8"v" ) )
+		{
+			const int packetCount = counts.elementCount;
+
+			// The pointers are used as the identifiers only, so these are not need to be a valid model
+			std::vector<char> dummyModels( scast<size_t>( modelCount ) );
+
+			RenderQueue queue{};
+			for ( int i = 0; i < packetCount; ++i )
+			{
+				const int		modelIndex	= scast<int>( Donya::Random::GenerateInt( modelCount ) );
+				const Shader	shader		= ( modelIndex % 2 ) ? Shader::Skinning : Shader::Static;
+
+				Payload payload{};
+				payload.pModel = &dummyModels[modelIndex];
+				payload.constant.drawColor = Donya::Vector4{ 1.0f, 1.0f, 1.0f, 1.0f };
+				payload.constant.worldMatrix._41 = scast<float>( i );
+				queue.Push( 0, shader, Donya::Random::GenerateFloat( 100.0f ), payload );
+			}
+
+			NullBackend backend{};
+			benchSubmitted = queue.Execute( &backend, /* useInstancing = */ false );
+
+			// Sorting the sorted queue again is not fair, so it measures only once
+			sortSeconds = Donya::Profiler::MeasureAverageSeconds( 1, [&]( int ) { queue.Sort(); } );
+
+			benchSorted		= queue.Execute( &backend, /* useInstancing = */ false );
+			benchInstanced	= queue.Execute( &backend, /* useInstancing = */ true  );
+		}
+		ImGui::Text( u8"񎞊ԁF%6.3f ms", sortSeconds * 1000.0f );
+		ShowStatistics( u8"o^", benchSubmitted	);
+		ShowStatistics( u8"", benchSorted		);
+		ShowStatistics( u8"CX^X", benchInstanced );
+
+		ImGui::TreePop();
+	}
+
+	ImGui::TreePop();
+}
+#endif // USE_IMGUI
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Donya/Constant.h"		// Use scast macro.
+#include "Donya/ModelCommon.h"	// Use Constants::PerModel::Common.
+#include "Donya/UseImGui.h"		// Use USE_IMGUI macro.
+
+namespace Donya
+{
+	namespace Model
+	{
+		class StaticModel;
+		class SkinningModel;
+		class Pose;
+		class BonePalette;
+	}
+}
+
+/// <summary>
+/// Accumulates the model draws of a frame as the compact packets, then executes them in order of the sort key.
+/// The sort key is consisted of: pass, translucency, shader, model and depth. So the same states are drawn continuously.
+/// The translucent draws are ordered by the depth before the states, because these must be drawn from far to near.
+/// The continuous draws of the same model can be merged into an instanced draw.
+/// It does not use GPU directly, the drawing is done through a Backend. So you can use it without a device by the NullBackend.
+/// </summary>
+class RenderQueue
+{
+public:
+	using Constant = Donya::Model::Constants::PerModel::Common;
+	enum class Shader
+	{
+		Static,
+		Skinning,
+
+		ShaderCount
+	};
+	enum class ModelKind
+	{
+		Static,
+		Skinning,
+		SkinningBaked,	// Skinning with the baked BonePalette
+	};
+	/// <summary>
+	/// The parameters for a draw. The pointers must be alive until the Execute().
+	/// </summary>
+	struct Payload
+	{
+		Constant							constant;
+		ModelKind							kind		= ModelKind::Static;
+		const void							*pModel		= nullptr;	// StaticModel or SkinningModel, it depends on the "kind"
+		const Donya::Model::Pose			*pPose		= nullptr;	// Used when the "kind" is not SkinningBaked
+		const Donya::Model::BonePalette		*pPalette	= nullptr;	// Used when the "kind" is SkinningBaked
+		int									motionIndex		= 0;	// Used when the "kind" is SkinningBaked
+		float								motionSeconds	= 0.0f;	// Used when the "kind" is SkinningBaked
+	public:
+		static Payload Make( const Constant &constant, const Donya::Model::StaticModel		&model, const Donya::Model::Pose &pose );
+		static Payload Make( const Constant &constant, const Donya::Model::SkinningModel	&model, const Donya::Model::Pose &pose );
+		static Payload Make( const Constant &constant, const Donya::Model::SkinningModel	&model, const Donya::Model::BonePalette &palette, int motionIndex, float motionSeconds );
+	};
+	/// <summary>
+	/// The sorted element. The payload is not moved by sorting.
+	/// </summary>
+	struct Packet
+	{
+		uint64_t key			= 0;
+		uint32_t payloadIndex	= 0;
+	};
+	struct Statistics
+	{
+		size_t packetCount			= 0;
+		size_t shaderChangeCount	= 0;	// Includes the first activation
+		size_t modelChangeCount		= 0;	// Includes the first model
+		size_t constantUpdateCount	= 0;
+		size_t drawCallCount		= 0;	// An instanced draw is counted as one
+		size_t instancedBatchCount	= 0;
+		size_t instancedModelCount	= 0;	// The count of the models that are drawn by the instanced draws
+	public:
+		void Add( const Statistics &other );
+	};
+	/// <summary>
+	/// The interface for executing the packets.
+	/// </summary>
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+	public:
+		virtual void ActivateShader( unsigned int pass, Shader shader ) = 0;
+		virtual void DeactivateShader( unsigned int pass, Shader shader ) = 0;
+		virtual void UpdateModelConstant( const Constant &constant ) = 0;
+		virtual void Draw( const Payload &payload ) = 0;
+		/// <summary>
+		/// Draw the "count" payloads that have the same pass, shader, model and kind by one instanced draw.
+		/// The model constant is not updated before this, so use the constants of the each payload.
+		/// </summary>
+		virtual void DrawInstances( const Payload *const *ppPayloads, size_t count ) = 0;
+	};
+	/// <summary>
+	/// Does nothing, for counting the state changes without a device.
+	/// </summary>
+	class NullBackend : public Backend
+	{
+	public:
+		void ActivateShader( unsigned int, Shader ) override {}
+		void DeactivateShader( unsigned int, Shader ) override {}
+		void UpdateModelConstant( const Constant & ) override {}
+		void Draw( const Payload & ) override {}
+		void DrawInstances( const Payload *const *, size_t ) override {}
+	};
+public:
+	static constexpr unsigned int	passBitCount		= 4;
+	static constexpr unsigned int	translucentBitCount	= 1;
+	static constexpr unsigned int	shaderBitCount		= 4;
+	static constexpr unsigned int	modelBitCount		= 23;
+	static constexpr unsigned int	depthBitCount	= 32;
+	static constexpr unsigned int	maxPass			= ( 1U << passBitCount ) - 1U;
+	static constexpr uint32_t		maxModelID		= ( 1U << modelBitCount ) - 1U;
+	static constexpr size_t			maxInstanceCount= 256U;	// The upper limit of the models of an instanced draw
+	/// <summary>
+	/// The order of priority is: pass, translucency, then shader, model, depth if opaque, or depth, shader, model if translucent.
+	/// The "depth" is sorted as near to far if opaque, far to near if translucent. The translucent keys are placed after the opaque keys of the same pass.
+	/// </summary>
+	static uint64_t MakeKey( unsigned int pass, Shader shader, uint32_t modelID, float depth, bool translucent = false );
+private:
+	std::vector<Packet>							packets;
+	std::vector<Payload>						payloads;
+	std::unordered_map<const void *, uint32_t>	modelIDs;	// Assigned by the order of first push
+	bool sorted = true;
+public:
+	/// <summary>
+	/// The "depth" should be the view-space depth of the model.
+	/// The payload is treated as translucent if the alpha of its draw color is less than 1.
+	/// </summary>
+	void Push( unsigned int pass, Shader shader, float depth, const Payload &payload );
+	/// <summary>
+	/// Sorts the packets by the key. The packets that have the same key keep the pushed order.
+	/// </summary>
+	void Sort();
+	/// <summary>
+	/// Executes the packets by current order(call Sort() before this if you want to sort). The state changes are skipped if it is not necessary.
+	/// If the "useInstancing" is true, the continuous packets of the same model are drawn by the Backend::DrawInstances(). The baked skinning models are not instanced.
+	/// Returns the count of the state changes.
+	/// </summary>
+	Statistics Execute( Backend *pBackend, bool useInstancing = true ) const;
+	/// <summary>
+	/// Removes the all packets. The reserved memories are kept.
+	/// </summary>
+	void Clear();
+public:
+	bool IsEmpty() const;
+	bool IsSorted() const;
+	size_t GetCount() const;
+	const std::vector<Packet> &GetPackets() const;
+	const Payload &GetPayload( const Packet &packet ) const;
+private:
+	uint32_t FetchModelID( const void *pModel );
+	/// <summary>
+	/// Returns the count of the continuous packets that can be drawn with the packets[first] by an instanced draw. It is 1 at least.
+	/// </summary>
+	size_t CountInstanceable( size_t first ) const;
+public:
+#if USE_IMGUI
+	/// <summary>
+	/// Shows the "submitted" and the "sorted" statistics, and a benchmark of the sorting.
+	/// If the "pMeasureSubmitted" is not nullptr, shows a checkbox of it, and the "submitted" is shown only when it is true.
+	/// </summary>
+	static void ShowImGuiNode( const std::string &nodeCaption, const Statistics &submitted, const Statistics &sorted, bool *pMeasureSubmitted = nullptr );
+#endif // USE_IMGUI
+};
@@ -1,5 +1,7 @@
 #include "Renderer.h"
 
+#include <cstddef>					// Use offsetof
+
 #include "Donya/RenderingStates.h"
 #include "Donya/Template.h"			// Use AppendVector()
 
@@ -24,6 +26,8 @@ namespace Config
 		DiffuseMap = 0,
 		NormalMap,
 		ShadowMap,
+		InstanceData,
+		InstanceBones,
 
 		TextureCount
 	};
@@ -33,6 +37,11 @@ namespace Config
 		SamplerNormal,
 		SamplerShadow,
 	};
+	enum QueuePass : unsigned int
+	{
+		PassShadow = 0,	// Draw the shadow casters first
+		PassNormal,
+	};
 
 	using RegisterDesc = Donya::Model::RegisterDesc;
 	static constexpr RegisterDesc constants[ConstantName::ConstantCount]
@@ -50,6 +59,8 @@ namespace Config
 		/* DiffuseMap	*/	RegisterDesc::Make( 0, /* setVS = */ false,	/* setPS = */ true	),
 		/* NormalMap	*/	RegisterDesc::Make( 1, /* setVS = */ false,	/* setPS = */ true	),
 		/* ShadowMap	*/	RegisterDesc::Make( 2, /* setVS = */ false,	/* setPS = */ true	),
+		/* InstanceData	*/	RegisterDesc::Make( 3, /* setVS = */ true,	/* setPS = */ false	),
+		/* InstanceBones*/	RegisterDesc::Make( 4, /* setVS = */ true,	/* setPS = */ false	),
 	};
 }
 
@@ -70,6 +81,7 @@ bool RenderingHelper::PrimitiveSet::Create()
 	if ( !rendererCube.Create()		) { succeeded = false; }
 	if ( !modelSphere.Create()		) { succeeded = false; }
 	if ( !rendererSphere.Create()	) { succeeded = false; }
+	if ( !rendererInstanced.Create()) { succeeded = false; }
 	return succeeded;
 }
 
@@ -106,6 +118,10 @@ bool RenderingHelper::ShaderSet::Create()
 	constexpr const char *shadowVSFilePathStatic	= "./Data/Shaders/CastShadowModelStaticVS.cso";
 	constexpr const char *shadowVSFilePathSkinning	= "./Data/Shaders/CastShadowModelSkinningVS.cso";
 	constexpr const char *shadowPSFilePath			= "./Data/Shaders/CastShadowModelPS.cso";
+	constexpr const char *normalVSFilePathStaticInstanced	= "./Data/Shaders/ModelStaticInstancedVS.cso";
+	constexpr const char *normalVSFilePathSkinningInstanced	= "./Data/Shaders/ModelSkinningInstancedVS.cso";
+	constexpr const char *shadowVSFilePathStaticInstanced	= "./Data/Shaders/CastShadowModelStaticInstancedVS.cso";
+	constexpr const char *shadowVSFilePathSkinningInstanced	= "./Data/Shaders/CastShadowModelSkinningInstancedVS.cso";
 	constexpr auto IEDescsPos	= Donya::Model::Vertex::Pos::GenerateInputElements( 0 );
 	constexpr auto IEDescsTex	= Donya::Model::Vertex::Tex::GenerateInputElements( 1 );
 	constexpr auto IEDescsBone	= Donya::Model::Vertex::Bone::GenerateInputElements( 2 );
@@ -121,6 +137,10 @@ bool RenderingHelper::ShaderSet::Create()
 	if ( !normalSkinning.Create( IEDescsSkinning,	normalVSFilePathSkinning,	normalPSFilePath ) ) { succeeded = false; }
 	if ( !shadowStatic	.Create( IEDescsStatic,		shadowVSFilePathStatic,		shadowPSFilePath ) ) { succeeded = false; }
 	if ( !shadowSkinning.Create( IEDescsSkinning,	shadowVSFilePathSkinning,	shadowPSFilePath ) ) { succeeded = false; }
+	if ( !normalStaticInstanced		.CreateByCSO( normalVSFilePathStaticInstanced,		IEDescsStatic	) ) { succeeded = false; }
+	if ( !normalSkinningInstanced	.CreateByCSO( normalVSFilePathSkinningInstanced,	IEDescsSkinning	) ) { succeeded = false; }
+	if ( !shadowStaticInstanced		.CreateByCSO( shadowVSFilePathStaticInstanced,		IEDescsStatic	) ) { succeeded = false; }
+	if ( !shadowSkinningInstanced	.CreateByCSO( shadowVSFilePathSkinningInstanced,	IEDescsSkinning	) ) { succeeded = false; }
 	return succeeded;
 }
 
@@ -181,6 +201,9 @@ void RenderingHelper::ActivateConstantPointLight()
 }
 void RenderingHelper::ActivateConstantModel()
 {
+	if ( queueingModels ) { return; } // The queue activates it at the execution
+	// else
+
 	constexpr auto desc = Config::constants[Config::Model];
 	pCBuffer->model.Activate( desc.setSlot, desc.setVS, desc.setPS );
 }
@@ -207,6 +230,9 @@ void RenderingHelper::DeactivateConstantPointLight()
 }
 void RenderingHelper::DeactivateConstantModel()
 {
+	if ( queueingModels ) { return; }
+	// else
+
 	pCBuffer->model.Deactivate();
 }
 void RenderingHelper::DeactivateConstantShadow()
@@ -224,45 +250,110 @@ void RenderingHelper::DeactivateConstantSphere()
 
 void RenderingHelper::ActivateShaderNormalStatic()
 {
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
+	if ( queueingModels )
+	{
+		queuePass	= Config::PassNormal;
+		queueShader	= RenderQueue::Shader::Static;
+		return;
+	}
+	// else
+
 	pShader->normalStatic.Activate();
+	pActiveInstancedVS = &pShader->normalStaticInstanced;
 }
 void RenderingHelper::ActivateShaderNormalSkinning()
 {
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
+	if ( queueingModels )
+	{
+		queuePass	= Config::PassNormal;
+		queueShader	= RenderQueue::Shader::Skinning;
+		return;
+	}
+	// else
+
 	pShader->normalSkinning.Activate();
+	pActiveInstancedVS = &pShader->normalSkinningInstanced;
 }
 void RenderingHelper::ActivateShaderShadowStatic()
 {
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
+	if ( queueingModels )
+	{
+		queuePass	= Config::PassShadow;
+		queueShader	= RenderQueue::Shader::Static;
+		return;
+	}
+	// else
+
 	pShader->shadowStatic.Activate();
+	pActiveInstancedVS = &pShader->shadowStaticInstanced;
 }
 void RenderingHelper::ActivateShaderShadowSkinning()
 {
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
+	if ( queueingModels )
+	{
+		queuePass	= Config::PassShadow;
+		queueShader	= RenderQueue::Shader::Skinning;
+		return;
+	}
+	// else
+
 	pShader->shadowSkinning.Activate();
+	pActiveInstancedVS = &pShader->shadowSkinningInstanced;
 }
 void RenderingHelper::ActivateShaderCube()
 {
+	// The accumulated debug shapes must be drawn before this drawing, for keeping the order
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
 	pPrimitive->rendererCube.ActivateVertexShader();
 	pPrimitive->rendererCube.ActivatePixelShader();
 }
 void RenderingHelper::ActivateShaderSphere()
 {
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
 	pPrimitive->rendererSphere.ActivateVertexShader();
 	pPrimitive->rendererSphere.ActivatePixelShader();
 }
 void RenderingHelper::DeactivateShaderNormalStatic()
 {
+	if ( queueingModels ) { return; }
+	// else
+
 	pShader->normalStatic.Deactivate();
+	pActiveInstancedVS = nullptr;
 }
 void RenderingHelper::DeactivateShaderNormalSkinning()
 {
+	if ( queueingModels ) { return; }
+	// else
+
 	pShader->normalSkinning.Deactivate();
+	pActiveInstancedVS = nullptr;
 }
 void RenderingHelper::DeactivateShaderShadowStatic()
 {
+	if ( queueingModels ) { return; }
+	// else
+
 	pShader->shadowStatic.Deactivate();
+	pActiveInstancedVS = nullptr;
 }
 void RenderingHelper::DeactivateShaderShadowSkinning()
 {
+	if ( queueingModels ) { return; }
+	// else
+
 	pShader->shadowSkinning.Deactivate();
+	pActiveInstancedVS = nullptr;
 }
 void RenderingHelper::DeactivateShaderCube()
 {
@@ -343,8 +434,27 @@ void RenderingHelper::DeactivateShadowMap( const Donya::Surface &shadowMap )
 	shadowMap.ResetShaderResourcePS( desc.setSlot );
 }
 
+namespace
+{
+	float CalcViewDepth( const Donya::Model::Constants::PerScene::Common &scene, const Donya::Model::Constants::PerModel::Common &model )
+	{
+		// The z of ( translation * viewMatrix )
+		const Donya::Vector4x4 &W = model.worldMatrix;
+		const Donya::Vector4x4 &V = scene.viewMatrix;
+		return ( W._41 * V._13 ) + ( W._42 * V._23 ) + ( W._43 * V._33 ) + V._43;
+	}
+}
+
 void RenderingHelper::Render( const Donya::Model::StaticModel	&model, const Donya::Model::Pose &pose )
 {
+	if ( queueingModels )
+	{
+		const auto &constant = pCBuffer->model.data;
+		modelQueue.Push( queuePass, queueShader, CalcViewDepth( pCBuffer->scene.data, constant ), RenderQueue::Payload::Make( constant, model, pose ) );
+		return;
+	}
+	// else
+
 	pRenderer->pStatic->Render
 	(
 		model,
@@ -357,6 +467,14 @@ void RenderingHelper::Render( const Donya::Model::StaticModel	&model, const Dony
 }
 void RenderingHelper::Render( const Donya::Model::SkinningModel	&model, const Donya::Model::Pose &pose )
 {
+	if ( queueingModels )
+	{
+		const auto &constant = pCBuffer->model.data;
+		modelQueue.Push( queuePass, queueShader, CalcViewDepth( pCBuffer->scene.data, constant ), RenderQueue::Payload::Make( constant, model, pose ) );
+		return;
+	}
+	// else
+
 	pRenderer->pSkinning->Render
 	(
 		model,
@@ -367,6 +485,77 @@ void RenderingHelper::Render( const Donya::Model::SkinningModel	&model, const Do
 		Config::textures[Config::NormalMap]
 	);
 }
+void RenderingHelper::Render( const Donya::Model::SkinningModel	&model, const Donya::Model::BonePalette &palette, int motionIndex, float motionSeconds )
+{
+	if ( queueingModels )
+	{
+		const auto &constant = pCBuffer->model.data;
+		modelQueue.Push( queuePass, queueShader, CalcViewDepth( pCBuffer->scene.data, constant ), RenderQueue::Payload::Make( constant, model, palette, motionIndex, motionSeconds ) );
+		return;
+	}
+	// else
+
+	pRenderer->pSkinning->Render
+	(
+		model,
+		palette,
+		motionIndex,
+		motionSeconds,
+		Config::constants[Config::Mesh],
+		Config::constants[Config::Subset],
+		Config::textures[Config::DiffuseMap],
+		Config::textures[Config::NormalMap]
+	);
+}
+void RenderingHelper::RenderInstanced( const Donya::Model::StaticModel	&model, const Donya::Model::Pose &pose, const Donya::Model::Constants::PerInstance::Common *pInstances, size_t instanceCount )
+{
+	if ( !pActiveInstancedVS )
+	{
+		_ASSERT_EXPR( 0, L"Error: The model shader is not activated!" );
+		return;
+	}
+	// else
+
+	pActiveInstancedVS->Activate();
+	pRenderer->pStatic->RenderInstanced
+	(
+		model,
+		pose,
+		pInstances,
+		instanceCount,
+		Config::constants[Config::Mesh],
+		Config::constants[Config::Subset],
+		Config::textures[Config::DiffuseMap],
+		Config::textures[Config::NormalMap],
+		Config::textures[Config::InstanceData]
+	);
+	pActiveInstancedVS->Deactivate();
+}
+void RenderingHelper::RenderInstanced( const Donya::Model::SkinningModel	&model, const Donya::Model::Pose *const *ppPoses, const Donya::Model::Constants::PerInstance::Common *pInstances, size_t instanceCount )
+{
+	if ( !pActiveInstancedVS )
+	{
+		_ASSERT_EXPR( 0, L"Error: The model shader is not activated!" );
+		return;
+	}
+	// else
+
+	pActiveInstancedVS->Activate();
+	pRenderer->pSkinning->RenderInstanced
+	(
+		model,
+		ppPoses,
+		pInstances,
+		instanceCount,
+		Config::constants[Config::Mesh],
+		Config::constants[Config::Subset],
+		Config::textures[Config::DiffuseMap],
+		Config::textures[Config::NormalMap],
+		Config::textures[Config::InstanceData],
+		Config::textures[Config::InstanceBones]
+	);
+	pActiveInstancedVS->Deactivate();
+}
 
 void RenderingHelper::CallDrawCube()
 {
@@ -408,15 +597,285 @@ namespace
 		renderer.DeactivatePixelShader();
 		renderer.DeactivateVertexShader();
 	}
+
+	template<class PrimitiveConstant>
+	DebugDrawQueue::View ToDebugView( const PrimitiveConstant &constant )
+	{
+		DebugDrawQueue::View view{};
+		view.matViewProj	= constant.matViewProj;
+		view.lightDirection	= constant.lightDirection;
+		view.lightBias		= constant.lightBias;
+		return view;
+	}
 }
 
 void RenderingHelper::ProcessDrawingCube( const Donya::Model::Cube::Constant &constant )
 {
+	if ( batchingDebugShapes )
+	{
+		debugQueue.PushCube( ToDebugView( constant ), constant.matWorld, constant.drawColor );
+		return;
+	}
+	// else
+
 	auto Draw = [&]() { DrawCube(); };
 	ProcessDrawingImpl( pPrimitive->rendererCube, constant, Draw );
 }
 void RenderingHelper::ProcessDrawingSphere( const Donya::Model::Sphere::Constant &constant )
 {
+	if ( batchingDebugShapes )
+	{
+		debugQueue.PushSphere( ToDebugView( constant ), constant.matWorld, constant.drawColor );
+		return;
+	}
+	// else
+
 	auto Draw = [&]() { DrawSphere(); };
 	ProcessDrawingImpl( pPrimitive->rendererSphere, constant, Draw );
 }
+
+namespace
+{
+	// The DebugDrawQueue does not depend on the Donya::Model, so I check the compatibility of the instance layout here.
+	using RendererInstance = Donya::Model::InstancedPrimitiveRenderer::Instance;
+	static_assert( sizeof( DebugDrawQueue::Instance ) == sizeof( RendererInstance ), "The instance layouts must be same!" );
+	static_assert( offsetof( DebugDrawQueue::Instance, color ) == offsetof( RendererInstance, drawColor ), "The instance layouts must be same!" );
+}
+
+void RenderingHelper::BeginDebugBatch()
+{
+	debugQueue.Clear();
+	lastDebugStatistics = DebugDrawQueue::Statistics{};
+	batchingDebugShapes = true;
+}
+void RenderingHelper::EndDebugBatch()
+{
+	FlushDebugBatch();
+	batchingDebugShapes = false;
+}
+void RenderingHelper::FlushDebugBatch()
+{
+	if ( debugQueue.IsEmpty() ) { return; }
+	// else
+
+	// Accumulate the statistics, because a batch may be flushed several times
+	const auto statistics = debugQueue.MakeStatistics();
+	for ( size_t i = 0; i < DebugDrawQueue::shapeCount; ++i )
+	{
+		lastDebugStatistics.shapeCounts[i] += statistics.shapeCounts[i];
+		lastDebugStatistics.batchCounts[i] += statistics.batchCounts[i];
+	}
+
+	auto &renderer = pPrimitive->rendererInstanced;
+	renderer.ActivateDepthStencil();
+	renderer.ActivateRasterizer();
+	renderer.ActivateVertexShader();
+	renderer.ActivatePixelShader();
+
+	// The cubes and the spheres use the same shader, so I can draw the batches in the submitted order
+	for ( const auto &batch : debugQueue.GetBatches() )
+	{
+		const auto &view = debugQueue.GetView( batch.viewIndex );
+		Donya::Model::InstancedPrimitiveRenderer::Constant constant{};
+		constant.matViewProj	= view.matViewProj;
+		constant.lightDirection	= view.lightDirection;
+		constant.lightBias		= view.lightBias;
+		renderer.UpdateConstant( constant );
+		renderer.ActivateConstant();
+
+		const Donya::Model::Impl::PrimitiveModel *pModel = &pPrimitive->modelCube;
+		if ( batch.shape == DebugDrawQueue::Shape::Sphere ) { pModel = &pPrimitive->modelSphere; }
+
+		const auto *pInstances = reinterpret_cast<const RendererInstance *>( debugQueue.GetInstances( batch.shape ).data() + batch.first );
+		lastDebugStatistics.drawCallCount += renderer.Draw( *pModel, pInstances, batch.count );
+
+		renderer.DeactivateConstant();
+	}
+
+	renderer.DeactivatePixelShader();
+	renderer.DeactivateVertexShader();
+	renderer.DeactivateRasterizer();
+	renderer.DeactivateDepthStencil();
+
+	debugQueue.Clear();
+}
+size_t RenderingHelper::DrawInstancedCubes( const Donya::Model::InstancedPrimitiveRenderer::Instance *pInstances, size_t instanceCount, const Donya::Vector4x4 &VP, const Donya::Vector3 &lightDirection, float lightBias )
+{
+	if ( !pInstances || !instanceCount ) { return 0; }
+	// else
+
+	if ( batchingDebugShapes ) { FlushDebugBatch(); }
+
+	auto &renderer = pPrimitive->rendererInstanced;
+	renderer.ActivateDepthStencil();
+	renderer.ActivateRasterizer();
+	renderer.ActivateVertexShader();
+	renderer.ActivatePixelShader();
+
+	Donya::Model::InstancedPrimitiveRenderer::Constant constant{};
+	constant.matViewProj	= VP;
+	constant.lightDirection	= lightDirection;
+	constant.lightBias		= lightBias;
+	renderer.UpdateConstant( constant );
+	renderer.ActivateConstant();
+
+	const size_t drawCallCount = renderer.Draw( pPrimitive->modelCube, pInstances, instanceCount );
+
+	renderer.DeactivateConstant();
+	renderer.DeactivatePixelShader();
+	renderer.DeactivateVertexShader();
+	renderer.DeactivateRasterizer();
+	renderer.DeactivateDepthStencil();
+
+	return drawCallCount;
+}
+const DebugDrawQueue::Statistics &RenderingHelper::GetDebugDrawStatistics() const
+{
+	return lastDebugStatistics;
+}
+
+class RenderingHelper::QueueBackend : public RenderQueue::Backend
+{
+private:
+	RenderingHelper *pHelper = nullptr;
+public:
+	QueueBackend( RenderingHelper *pHelper ) : pHelper( pHelper ) {}
+public:
+	void ActivateShader( unsigned int pass, RenderQueue::Shader shader ) override
+	{
+		const bool isStatic = ( shader == RenderQueue::Shader::Static );
+		if ( pass == Config::PassShadow )
+		{
+			( isStatic ) ? pHelper->ActivateShaderShadowStatic() : pHelper->ActivateShaderShadowSkinning();
+		}
+		else
+		{
+			( isStatic ) ? pHelper->ActivateShaderNormalStatic() : pHelper->ActivateShaderNormalSkinning();
+		}
+	}
+	void DeactivateShader( unsigned int pass, RenderQueue::Shader shader ) override
+	{
+		const bool isStatic = ( shader == RenderQueue::Shader::Static );
+		if ( pass == Config::PassShadow )
+		{
+			( isStatic ) ? pHelper->DeactivateShaderShadowStatic() : pHelper->DeactivateShaderShadowSkinning();
+		}
+		else
+		{
+			( isStatic ) ? pHelper->DeactivateShaderNormalStatic() : pHelper->DeactivateShaderNormalSkinning();
+		}
+	}
+	void UpdateModelConstant( const RenderQueue::Constant &constant ) override
+	{
+		pHelper->UpdateConstant( constant );
+		pHelper->ActivateConstantModel();
+	}
+	void Draw( const RenderQueue::Payload &payload ) override
+	{
+		using Kind = RenderQueue::ModelKind;
+		switch ( payload.kind )
+		{
+		case Kind::Static:
+			pHelper->Render( *static_cast<const Donya::Model::StaticModel *>( payload.pModel ), *payload.pPose );
+			return;
+		case Kind::Skinning:
+			pHelper->Render( *static_cast<const Donya::Model::SkinningModel *>( payload.pModel ), *payload.pPose );
+			return;
+		case Kind::SkinningBaked:
+			pHelper->Render( *static_cast<const Donya::Model::SkinningModel *>( payload.pModel ), *payload.pPalette, payload.motionIndex, payload.motionSeconds );
+			return;
+		default: break;
+		}
+
+		_ASSERT_EXPR( 0, L"Error: Unexpected model kind!" );
+	}
+	void DrawInstances( const RenderQueue::Payload *const *ppPayloads, size_t count ) override
+	{
+		if ( !count ) { return; }
+		// else
+
+		auto &instances	= pHelper->instanceWorkspace;
+		auto &poses		= pHelper->poseWorkspace;
+		instances.resize( count );
+		poses.resize( count );
+		for ( size_t i = 0; i < count; ++i )
+		{
+			instances[i].drawColor		= ppPayloads[i]->constant.drawColor;
+			instances[i].worldMatrix	= ppPayloads[i]->constant.worldMatrix;
+			poses[i]					= ppPayloads[i]->pPose;
+		}
+
+		// The RenderQueue gathers the same kind only
+		const RenderQueue::Payload &head = *ppPayloads[0];
+		using Kind = RenderQueue::ModelKind;
+		switch ( head.kind )
+		{
+		case Kind::Static:
+			pHelper->RenderInstanced( *static_cast<const Donya::Model::StaticModel *>( head.pModel ), *head.pPose, instances.data(), count );
+			return;
+		case Kind::Skinning:
+			pHelper->RenderInstanced( *static_cast<const Donya::Model::SkinningModel *>( head.pModel ), poses.data(), instances.data(), count );
+			return;
+		default: break;
+		}
+
+		_ASSERT_EXPR( 0, L"Error: Unexpected model kind!" );
+	}
+};
+
+void RenderingHelper::BeginModelQueue( bool keepSubmittedOrder )
+{
+	modelQueue.Clear();
+	queuePass		= Config::PassNormal;
+	queueShader		= RenderQueue::Shader::Static;
+	queueingModels	= true;
+	queueKeepsOrder	= keepSubmittedOrder;
+}
+void RenderingHelper::EndModelQueue()
+{
+	queueingModels = false;
+	if ( modelQueue.IsEmpty() ) { return; }
+	// else
+
+	if ( measuresSubmittedOrder )
+	{
+		RenderQueue::NullBackend nullBackend{};
+		modelQueueSubmitted.Add( modelQueue.Execute( &nullBackend, /* useInstancing = */ false ) );
+	}
+
+	if ( !queueKeepsOrder )
+	{
+		modelQueue.Sort();
+	}
+
+	QueueBackend backend{ this };
+	const RenderQueue::Statistics executed = modelQueue.Execute( &backend );
+	if ( executed.constantUpdateCount )
+	{
+		DeactivateConstantModel();
+	}
+	modelQueueSorted.Add( executed );
+
+	modelQueue.Clear();
+}
+void RenderingHelper::ClearModelQueueStatistics()
+{
+	modelQueueSubmitted	= RenderQueue::Statistics{};
+	modelQueueSorted	= RenderQueue::Statistics{};
+}
+const RenderQueue::Statistics &RenderingHelper::GetModelQueueStatisticsSubmitted() const
+{
+	return modelQueueSubmitted;
+}
+const RenderQueue::Statistics &RenderingHelper::GetModelQueueStatisticsSorted() const
+{
+	return modelQueueSorted;
+}
+void RenderingHelper::SetMeasuringSubmittedOrder( bool enable )
+{
+	measuresSubmittedOrder = enable;
+}
+bool RenderingHelper::IsMeasuringSubmittedOrder() const
+{
+	return measuresSubmittedOrder;
+}
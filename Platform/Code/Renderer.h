@@ -13,6 +13,9 @@
 #include "Donya/ModelPrimitive.h"
 #include "Donya/ModelRenderer.h"
 
+#include "DebugDrawQueue.h"
+#include "RenderQueue.h"
+
 class RenderingHelper
 {
 public:
@@ -42,6 +45,7 @@ private:
 		Donya::Model::CubeRenderer		rendererCube;
 		Donya::Model::Sphere			modelSphere;
 		Donya::Model::SphereRenderer	rendererSphere;
+		Donya::Model::InstancedPrimitiveRenderer	rendererInstanced{ 1024U };
 	public:
 		bool Create();
 	};
@@ -68,14 +72,34 @@ private:
 		Shader	normalSkinning;
 		Shader	shadowStatic;
 		Shader	shadowSkinning;
+		// The instanced versions. These are used with the pixel shader of above
+		Donya::VertexShader	normalStaticInstanced;
+		Donya::VertexShader	normalSkinningInstanced;
+		Donya::VertexShader	shadowStaticInstanced;
+		Donya::VertexShader	shadowSkinningInstanced;
 	public:
 		bool Create();
 	};
+	class QueueBackend;	// Executes the RenderQueue by this helper
 private:
 	std::unique_ptr<CBuffer>		pCBuffer;
 	std::unique_ptr<ShaderSet>		pShader;
 	std::unique_ptr<Renderer>		pRenderer;
 	std::unique_ptr<PrimitiveSet>	pPrimitive;
+	DebugDrawQueue					debugQueue;
+	DebugDrawQueue::Statistics		lastDebugStatistics;
+	bool batchingDebugShapes = false;
+	RenderQueue						modelQueue;
+	RenderQueue::Statistics			modelQueueSubmitted;	// The statistics if the models are drawn by the submitted order. Measured only when the "measuresSubmittedOrder" is true
+	RenderQueue::Statistics			modelQueueSorted;
+	RenderQueue::Shader				queueShader	= RenderQueue::Shader::Static;
+	unsigned int					queuePass	= 0;
+	bool queueingModels = false;
+	bool queueKeepsOrder = false;	// Do not sort the queue at the EndModelQueue()
+	bool measuresSubmittedOrder = false;	// Executes the queue by the NullBackend before sorting, for the debug statistics
+	const Donya::VertexShader		*pActiveInstancedVS = nullptr;	// The instanced version of current model shader
+	std::vector<Donya::Model::Constants::PerInstance::Common>	instanceWorkspace;
+	std::vector<const Donya::Model::Pose *>						poseWorkspace;
 	bool wasCreated = false;
 public:
 	bool Init();
@@ -132,6 +156,20 @@ public:
 public:
 	void Render( const Donya::Model::StaticModel	&model, const Donya::Model::Pose &pose );
 	void Render( const Donya::Model::SkinningModel	&model, const Donya::Model::Pose &pose );
+	/// <summary>
+	/// Render with the baked palette that sampled at "motionSeconds" of "motionIndex".
+	/// </summary>
+	void Render( const Donya::Model::SkinningModel	&model, const Donya::Model::BonePalette &palette, int motionIndex, float motionSeconds );
+	/// <summary>
+	/// Render the instances by one draw call per subset. The world matrix and the draw color are fetched from the "pInstances" instead of the model constant.<para></para>
+	/// Call this between the ActivateShader***() and the DeactivateShader***() of the same model type, it switches the vertex shader to the instanced version while drawing.
+	/// </summary>
+	void RenderInstanced( const Donya::Model::StaticModel	&model, const Donya::Model::Pose &pose, const Donya::Model::Constants::PerInstance::Common *pInstances, size_t instanceCount );
+	/// <summary>
+	/// Render the instances by one draw call per subset. The "ppPoses" must have the "instanceCount" poses.<para></para>
+	/// Call this between the ActivateShader***() and the DeactivateShader***() of the same model type, it switches the vertex shader to the instanced version while drawing.
+	/// </summary>
+	void RenderInstanced( const Donya::Model::SkinningModel	&model, const Donya::Model::Pose *const *ppPoses, const Donya::Model::Constants::PerInstance::Common *pInstances, size_t instanceCount );
 public:
 	/// <summary>
 	/// Call the draw method of a Cube only.
@@ -159,4 +197,54 @@ public:
 	/// Doing the set and reset of: Shader(VS, PS), State(DS, RS), CBuffer.
 	/// </summary>
 	void ProcessDrawingSphere( const Donya::Model::Sphere::Constant &constant );
+	/// <summary>
+	/// Draw the cubes by the instanced draw calls. The "pInstances" must have the "instanceCount" instances.<para></para>
+	/// Doing the set and reset of: Shader(VS, PS), State(DS, RS), CBuffer.<para></para>
+	/// Returns the count of the draw calls.
+	/// </summary>
+	size_t DrawInstancedCubes( const Donya::Model::InstancedPrimitiveRenderer::Instance *pInstances, size_t instanceCount, const Donya::Vector4x4 &matViewProj, const Donya::Vector3 &lightDirection, float lightBias = 0.5f );
+public:
+	/// <summary>
+	/// After this, the ProcessDrawingCube() and ProcessDrawingSphere() only accumulate the shapes.
+	/// The accumulated shapes are drawn before a drawing that does not use the batch(e.g. ActivateShaderSphere(), ActivateShaderNormalStatic()),
+	/// so the drawing order is the same as the submitted order.
+	/// </summary>
+	void BeginDebugBatch();
+	/// <summary>
+	/// Draw the accumulated shapes by the instanced draw calls in the submitted order, then disable the debug batching.
+	/// </summary>
+	void EndDebugBatch();
+	/// <summary>
+	/// Returns the statistics of the last debug batch.
+	/// </summary>
+	const DebugDrawQueue::Statistics &GetDebugDrawStatistics() const;
+private:
+	/// <summary>
+	/// Draw the accumulated shapes, then clear them. The debug batching is kept.
+	/// </summary>
+	void FlushDebugBatch();
+public:
+	/// <summary>
+	/// After this, the Render() only accumulates the draw with current model constant and current model shader, until the EndModelQueue().
+	/// The activation and deactivation of the model shaders and the model constant are also deferred.
+	/// The models and the poses must be alive until the EndModelQueue().
+	/// If the "keepSubmittedOrder" is true, the draws are not sorted(e.g. the models that are drawn without the depth test).
+	/// </summary>
+	void BeginModelQueue( bool keepSubmittedOrder = false );
+	/// <summary>
+	/// Sorts the accumulated draws by the pass, shader, model and depth, then draws them. The translucent draws are sorted as far to near after the opaque draws.
+	/// The continuous draws of the same model are drawn by the RenderInstanced(), so the instancing also works without the sorting.
+	/// </summary>
+	void EndModelQueue();
+	/// <summary>
+	/// The statistics of the model queue are accumulated until this call.
+	/// </summary>
+	void ClearModelQueueStatistics();
+	const RenderQueue::Statistics &GetModelQueueStatisticsSubmitted() const;
+	const RenderQueue::Statistics &GetModelQueueStatisticsSorted() const;
+	/// <summary>
+	/// The statistics of the submitted order costs an extra execution of the queue, so it is measured only when enabled. It is disabled by default.
+	/// </summary>
+	void SetMeasuringSubmittedOrder( bool enable );
+	bool IsMeasuringSubmittedOrder() const;
 };
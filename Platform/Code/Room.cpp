@@ -203,11 +203,15 @@ int House::CalcBelongRoomID( const Donya::Vector3 &wsSearchPoint ) const
 
 	return -1;
 }
+std::string House::MakeStageFilePath( int stageNo, bool fromBinary )
+{
+	return	( fromBinary )
+			? MakeStageParamPathBinary( serializeID, stageNo )
+			: MakeStageParamPathJson  ( serializeID, stageNo );
+}
 bool House::LoadRooms( int stageNo, bool fromBinary )
 {
-	const std::string filePath	= ( fromBinary )
-								? MakeStageParamPathBinary( serializeID, stageNo )
-								: MakeStageParamPathJson  ( serializeID, stageNo );
+	const std::string filePath = MakeStageFilePath( stageNo, fromBinary );
 	Donya::Serializer tmp;
 	return	( fromBinary )
 			? tmp.LoadBinary( *this, filePath.c_str(), serializeID )
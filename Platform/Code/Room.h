@@ -106,6 +106,10 @@ public:
 	/// </summary>
 	int CalcBelongRoomID( const Donya::Vector3 &wsSearchPoint ) const;
 	bool LoadRooms( int stageNo, bool fromBinary );
+	/// <summary>
+	/// Returns the path of the file that LoadRooms() reads.
+	/// </summary>
+	static std::string MakeStageFilePath( int stageNo, bool fromBinary );
 #if USE_IMGUI
 public:
 	void RemakeByCSV( const CSVLoader &loadedData );
@@ -7,9 +7,11 @@
 #undef min
 #include <cereal/types/vector.hpp>
 
+#include "Donya/AsyncIO.h"
 #include "Donya/Blend.h"
 #include "Donya/Color.h"			// Use ClearBackGround(), StartFade().
 #include "Donya/Keyboard.h"			// Make an input of player.
+#include "Donya/Profiler.h"
 #include "Donya/Serializer.h"
 #include "Donya/Sound.h"
 #include "Donya/Sprite.h"
@@ -22,18 +24,22 @@
 #include "Donya/Random.h"
 #endif // DEBUG_MODE
 
+#include "AnimationLOD.h"
 #include "Bosses/Skull.h"			// Use SkullParam
 #include "Bullet.h"
+#include "CollisionPass.h"
 #include "Common.h"
 #include "Enemy.h"
 #include "Effect/EffectAdmin.h"
 #include "Effect/EffectKind.h"
+#include "Effect/Particle.h"
 #include "Fader.h"
 #include "FilePath.h"
 #include "FontHelper.h"
 #include "Input.h"
 #include "Item.h"
 #include "ItemParam.h"				// Use a recovery amount
+#include "MapChunk.h"				// Use CalcProjectedArea()
 #include "Meter.h"
 #include "ModelHelper.h"			// Use serialize methods
 #include "Music.h"
@@ -41,6 +47,7 @@
 #include "PlayerParam.h"
 #include "PointLightStorage.h"
 #include "StageNumber.h"
+#include "StagePrefetch.h"
 
 #if DEBUG_MODE
 #include "CSVLoader.h"
@@ -403,9 +410,25 @@ namespace
 CEREAL_CLASS_VERSION( SceneParam,				15 )
 CEREAL_CLASS_VERSION( SceneParam::ShadowMap,	0  )
 
+namespace
+{
+	void AssignCollisionPairs( CollisionWorld *pWorld )
+	{
+		using Layer = CollisionWorld::Layer;
+		pWorld->SetPairFilter( Layer::PlayerBullet,	Layer::EnemyBullet,		true );
+		pWorld->SetPairFilter( Layer::PlayerBullet,	Layer::BossHurtBox,		true );
+		pWorld->SetPairFilter( Layer::PlayerBullet,	Layer::EnemyHurtBox,	true );
+		pWorld->SetPairFilter( Layer::EnemyBullet,	Layer::PlayerHurtBox,	true );
+		pWorld->SetPairFilter( Layer::BossHitBox,	Layer::PlayerHurtBox,	true );
+		pWorld->SetPairFilter( Layer::EnemyHitBox,	Layer::PlayerHurtBox,	true );
+		pWorld->SetPairFilter( Layer::PlayerHurtBox,Layer::Item,			true );
+	}
+}
+
 void SceneGame::Init()
 {
 	sceneParam.LoadParameter();
+	AssignCollisionPairs( &collisionWorld );
 
 	status		= State::FirstInitialize;
 	stageNumber	= Definition::StageNumber::Game();
@@ -413,12 +436,18 @@ void SceneGame::Init()
 	loadPerformer.Init();
 	loadPerformer.Start( FetchParameter().ssLoadingDrawPos, Donya::Color::Code::BLACK );
 
+	// Usually the previous scene has requested it. The reading runs while creating the renderers.
+	StagePrefetch::Request( stageNumber );
+
 	constexpr auto coInitValue = COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE;
 	auto InitObjects	= [coInitValue]( SceneGame *pScene, Thread::Result *pResult )
 	{
 		if ( !pScene || !pResult ) { assert( !"HUMAN ERROR" ); return; }
 		// else
 
+		Donya::Profiler::SetThreadName( "SceneGame::InitObjects" );
+		PROFILE_SCOPE( "SceneGame::InitObjects" );
+
 		HRESULT hr = CoInitializeEx( NULL, coInitValue );
 		if ( FAILED( hr ) )
 		{
@@ -451,6 +480,9 @@ void SceneGame::Init()
 		if ( !pScene || !pResult ) { assert( !"HUMAN ERROR" ); return; }
 		// else
 
+		Donya::Profiler::SetThreadName( "SceneGame::InitRenderers" );
+		PROFILE_SCOPE( "SceneGame::InitRenderers" );
+
 		HRESULT hr = CoInitializeEx( NULL, coInitValue );
 		if ( FAILED( hr ) )
 		{
@@ -491,15 +523,21 @@ void SceneGame::Uninit()
 	if ( pMap ) { pMap->ReleaseModel(); }
 	pMap.reset();
 
+	// I hold it until here because the retry of the stage reads it again
+	StagePrefetch::Release( stageNumber );
+
 	loadPerformer.Uninit();
 
 	Effect::Admin::Get().ClearInstances();
+	Effect::Particle::Admin::Get().ClearInstances();
 
 	Donya::Sound::Stop( currentPlayingBGM, /* isEnableForAll = */ true );
 }
 
 Scene::Result SceneGame::Update( float elapsedTime )
 {
+	PROFILE_SCOPE( "SceneGame::Update" );
+
 #if DEBUG_MODE
 	if ( status != State::FirstInitialize )
 	{
@@ -645,14 +683,20 @@ Scene::Result SceneGame::Update( float elapsedTime )
 	}
 
 	const Donya::Vector3 playerPos = GetPlayerPosition();
-	Bullet::Admin::Get().Update( deltaTimeForMove, currentScreen );
-	Enemy::Admin::Get().Update( deltaTimeForMove, playerPos, currentScreen );
-	BossUpdate( deltaTimeForMove, playerPos );
-	Item::Admin::Get().Update( deltaTimeForMove, currentScreen );
+	{
+		PROFILE_SCOPE( "SceneGame::ObjectUpdate" );
+
+		Bullet::Admin::Get().Update( deltaTimeForMove, currentScreen );
+		Enemy::Admin::Get().Update( deltaTimeForMove, playerPos, currentScreen );
+		BossUpdate( deltaTimeForMove, playerPos );
+		Item::Admin::Get().Update( deltaTimeForMove, currentScreen );
+	}
 
 
 	// PhysicUpdates
 	{
+		PROFILE_SCOPE( "SceneGame::PhysicUpdate" );
+
 		using Dir = Definition::Direction;
 
 		const auto currentRoomArea	= ( pCurrentRoom )
@@ -751,6 +795,8 @@ Scene::Result SceneGame::Update( float elapsedTime )
 	}
 
 
+	// Each pass regenerates the contacts, because the previous pass may change the objects
+	collisionWorld.BeginFrame();
 	Collision_PlayerVSItem();
 	Collision_BulletVSBullet();
 	Collision_BulletVSBoss();
@@ -789,6 +835,8 @@ namespace
 }
 void SceneGame::Draw( float elapsedTime )
 {
+	PROFILE_SCOPE( "SceneGame::Draw" );
+
 	ClearBackGround();
 
 	if ( status == State::FirstInitialize )
@@ -801,6 +849,8 @@ void SceneGame::Draw( float elapsedTime )
 	if ( !AreRenderersReady() ) { return; }
 	// else
 
+	pRenderer->ClearModelQueueStatistics();
+
 	auto UpdateSceneConstant	= [&]( const Donya::Model::Constants::PerScene::DirectionalLight &directionalLight, const Donya::Vector4 &eyePos, const Donya::Vector4x4 &viewMatrix, const Donya::Vector4x4 &viewProjectionMatrix, bool applyToEffect )
 	{
 		Donya::Model::Constants::PerScene::Common constant{};
@@ -819,6 +869,8 @@ void SceneGame::Draw( float elapsedTime )
 			effectAdmin.SetLightDirection	( directionalLight.direction.XYZ() );
 		}
 	};
+	// The light camera sees the objects out of the screen, so the shadow pass culls the map by its own area
+	const Donya::Collision::Box3F shadowCasterArea = CalcShadowCasterArea();
 	auto DrawObjects			= [&]( DrawTarget option, bool castShadow )
 	{
 		using Kind = DrawTarget;
@@ -829,11 +881,16 @@ void SceneGame::Draw( float elapsedTime )
 
 		// The drawing priority is determined by the priority of the information.
 
+		// The bullets are drawn without the depth test, so I keep their submitted order.
+		// The continuous bullets of the same model are still drawn by the instancing.
+		const bool keepOrder = ( option == Kind::Bullet );
+		pRenderer->BeginModelQueue( keepOrder );
+
 		( castShadow )
 		? pRenderer->ActivateShaderShadowStatic()
 		: pRenderer->ActivateShaderNormalStatic();
 
-		if ( Drawable( Kind::Map ) && pMap ) { pMap->Draw( pRenderer.get() ); }
+		if ( Drawable( Kind::Map ) && pMap ) { pMap->Draw( ( castShadow ) ? shadowCasterArea : currentScreen, pRenderer.get() ); }
 
 		( castShadow )
 		? pRenderer->DeactivateShaderShadowStatic()
@@ -853,6 +910,8 @@ void SceneGame::Draw( float elapsedTime )
 		( castShadow )
 		? pRenderer->DeactivateShaderShadowSkinning()
 		: pRenderer->DeactivateShaderNormalSkinning();
+
+		pRenderer->EndModelQueue();
 	};
 	
 #if DEBUG_MODE
@@ -957,6 +1016,8 @@ void SceneGame::Draw( float elapsedTime )
 		DrawObjects( DrawTarget::Bullet, /* castShadow = */ false );
 		Donya::DepthStencil::Activate( Donya::DepthStencil::Defined::Write_PassLess );
 
+		Effect::Particle::Admin::Get().Draw( pRenderer.get(), VP, data.directionalLight.direction.XYZ() );
+
 		pRenderer->DeactivateShadowMap( *pShadowMap );
 		pRenderer->DeactivateSamplerShadow();
 		pRenderer->DeactivateConstantShadow();
@@ -1046,6 +1107,7 @@ void SceneGame::Draw( float elapsedTime )
 	// Object's hit/hurt boxes
 	if ( Common::IsShowCollision() )
 	{
+		pRenderer->BeginDebugBatch();
 		if ( pPlayer		) { pPlayer->DrawHitBox( pRenderer.get(), VP );					}
 		if ( pBossContainer	) { pBossContainer->DrawHitBoxes( pRenderer.get(), VP );		}
 		if ( pClearEvent	) { pClearEvent->DrawHitBoxes( pRenderer.get(), VP );			}
@@ -1055,6 +1117,7 @@ void SceneGame::Draw( float elapsedTime )
 		Item  ::Admin::Get().DrawHitBoxes( pRenderer.get(), VP );
 		checkPoint.DrawHitBoxes( pRenderer.get(), VP );
 		if ( pHouse			) { pHouse->DrawHitBoxes( pRenderer.get(), VP );				}
+		pRenderer->EndDebugBatch();
 	}
 #endif // DEBUG_MODE
 
@@ -1343,6 +1406,7 @@ void SceneGame::InitStage( Music::ID nextBGM, int stageNo, bool reloadMapModel,
 	}
 
 	Effect::Admin::Get().ClearInstances();
+	Effect::Particle::Admin::Get().ClearInstances();
 
 	// Remove the player relates
 	if ( pPlayer )
@@ -1661,6 +1725,9 @@ void SceneGame::ClearStateInit()
 	wantLeave	= false;
 
 	FadeOutBGM();
+
+	// The result scene is next. Read its files while the clear event is playing.
+	StagePrefetch::Request( Definition::StageNumber::Result() );
 }
 void SceneGame::ClearStateUpdate( float elapsedTime )
 {
@@ -1800,6 +1867,8 @@ void SceneGame::AssignCameraPos()
 }
 void SceneGame::CameraUpdate( float elapsedTime )
 {
+	PROFILE_SCOPE( "SceneGame::CameraUpdate" );
+
 	const auto &data = FetchParameter();
 
 #if USE_IMGUI
@@ -1920,6 +1989,10 @@ Donya::Vector4x4 SceneGame::CalcLightViewMatrix() const
 {
 	return lightCamera.CalcViewMatrix();
 }
+Donya::Collision::Box3F SceneGame::CalcShadowCasterArea() const
+{
+	return MapChunk::CalcProjectedArea( CalcLightViewMatrix() * lightCamera.GetProjectionMatrix() );
+}
 
 void SceneGame::ReadyPlayer()
 {
@@ -1969,6 +2042,8 @@ void SceneGame::PlayerInit( const PlayerInitializer &initializer, const Map &ter
 }
 void SceneGame::PlayerUpdate( float elapsedTime, const Map &terrain )
 {
+	PROFILE_SCOPE( "SceneGame::PlayerUpdate" );
+
 	if ( !pPlayer ) { return; }
 	// else
 
@@ -2110,6 +2185,8 @@ void SceneGame::UpdatePlayerIniter()
 
 void SceneGame::BossUpdate( float elapsedTime, const Donya::Vector3 &wsTargetPos )
 {
+	PROFILE_SCOPE( "SceneGame::BossUpdate" );
+
 	if ( !pBossContainer ) { return; }
 	// else
 
@@ -2128,6 +2205,7 @@ void SceneGame::BossUpdate( float elapsedTime, const Donya::Vector3 &wsTargetPos
 
 	Boss::Input input{};
 	input.wsTargetPos					= wsTargetPos;
+	input.wsScreenHitBox				= currentScreen;
 	if ( status == State::VSBoss )
 	{
 		input.controllerInputDirection	= currentInput.moveVelocity;
@@ -2174,233 +2252,87 @@ namespace
 	{
 		return ( pPlayer ) ? pPlayer->GetHurtBox().id : Donya::Collision::invalidID;
 	}
-	bool IsPlayerBullet( const Donya::Collision::IDType playerCollisionID, const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		if ( playerCollisionID == Donya::Collision::invalidID ) { return false; }
-		// else
-
-		const auto bulletAABB	= pBullet->GetHitBox();
-		const auto bulletSphere	= pBullet->GetHitSphere();
-		const auto activeOwnerID= ( bulletSphere.exist ) ? bulletSphere.ownerID : bulletAABB.ownerID;
-		return ( activeOwnerID == playerCollisionID ) ? true : false;
-	}
-	bool IsEnemyBullet( const Donya::Collision::IDType playerCollisionID, const std::shared_ptr<const Bullet::Base> &pBullet )
+	bool Contains( CollisionWorld::LayerMask layers, CollisionWorld::Layer layer )
 	{
-		return !IsPlayerBullet( playerCollisionID, pBullet );
+		return ( layers & CollisionWorld::ToMask( layer ) ) ? true : false;
 	}
+}
+void SceneGame::Collision_GenerateContacts( CollisionWorld::LayerMask layers )
+{
+	PROFILE_SCOPE( "SceneGame::Collision_GenerateContacts" );
 
-	enum class SubtractorState
-	{
-		Not,
-		HasBox,
-		HasSphere
-	};
-	SubtractorState HasSubtractor( const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		using State = SubtractorState;
-
-		if ( !pBullet ) { return State::Not; }
-		// else
-
-		if ( pBullet->GetHitBoxSubtractor().exist ) { return State::HasBox; }
-		// else
+	using Layer		= CollisionWorld::Layer;
+	using Volume	= CollisionWorld::Volume;
 
-		if ( pBullet->GetHitSphereSubtractor().exist ) { return State::HasSphere; }
-		// else
+	collisionWorld.Clear();
 
-		return State::Not;
-	}
+	// The bullets must be registered before the other objects,
+	// because the CollisionPass::BulletVSEnemy() expects the contacts are ordered by the bullet.
+	CollisionPass::RegisterBullets( &collisionWorld, ExtractPlayerID( pPlayer ), layers );
 
-	template<typename ObjectHitBox, typename BulletHitBox>
-	bool IsHit( const ObjectHitBox &objHitBox, const std::shared_ptr<const Bullet::Base> &pBullet, const BulletHitBox &bulletHitBox, bool considerExistFlag = true )
+	const bool useEnemyHurtBox	= Contains( layers, Layer::EnemyHurtBox	);
+	const bool useEnemyHitBox	= Contains( layers, Layer::EnemyHitBox	);
+	if ( useEnemyHurtBox || useEnemyHitBox )
 	{
-		namespace Col = Donya::Collision;
-
-		const SubtractorState hasSubtract = HasSubtractor( pBullet );
-
-		// Do not use subtraction version
-		if ( hasSubtract == SubtractorState::Not )
+		auto &enemyAdmin = Enemy::Admin::Get();
+		const size_t enemyCount = enemyAdmin.GetInstanceCount();
+		for ( size_t i = 0; i < enemyCount; ++i )
 		{
-			return Col::IsHit( objHitBox, bulletHitBox, considerExistFlag );
-		}
-		// else
+			const auto pEnemy = enemyAdmin.GetInstanceOrNullptr( i );
+			if ( !pEnemy ) { continue; }
+			// else
 
-		// Can not use subtraction version
-		if ( !pBullet )
-		{
-			return Col::IsHit( objHitBox, bulletHitBox, considerExistFlag );
+			if ( useEnemyHurtBox	) { collisionWorld.Register( Volume::Make( Layer::EnemyHurtBox,	i, pEnemy->GetHurtBox()	) ); }
+			if ( useEnemyHitBox		) { collisionWorld.Register( Volume::Make( Layer::EnemyHitBox,	i, pEnemy->GetHitBox()	) ); }
 		}
-		// else
-
-		auto IsHitImpl = [&]( const auto &hitBoxSubtractor )
-		{
-			const Col::Solid<BulletHitBox, decltype( hitBoxSubtractor )> a
-			{
-				bulletHitBox,
-				hitBoxSubtractor
-			};
-			return Col::IsHitVSSubtracted( objHitBox, a, considerExistFlag );
-		};
+	}
 
-		if ( hasSubtract == SubtractorState::HasBox )
-		{
-			return IsHitImpl( pBullet->GetHitBoxSubtractor() );
-		}
-		// else
-		if ( hasSubtract == SubtractorState::HasSphere )
+	if ( pBossContainer && isThereBoss )
+	{
+		const auto pBoss = pBossContainer->GetBossOrNullptr( currentRoomID );
+		if ( pBoss )
 		{
-			return IsHitImpl( pBullet->GetHitSphereSubtractor() );
+			if ( Contains( layers, Layer::BossHurtBox	) ) { collisionWorld.Register( Volume::Make( Layer::BossHurtBox,	0, pBoss->GetHurtBox()	) ); }
+			if ( Contains( layers, Layer::BossHitBox	) ) { collisionWorld.Register( Volume::Make( Layer::BossHitBox,		0, pBoss->GetHitBox()	) ); }
 		}
-		// else
-
-		_ASSERT_EXPR( 0, L"Error: Unexpected condition!" );
-		return false;
 	}
-	template<typename HitBoxA, typename HitBoxB>
-	bool IsHit( const std::shared_ptr<const Bullet::Base> &pBulletA, const HitBoxA &hitBoxA, const std::shared_ptr<const Bullet::Base> &pBulletB, const HitBoxB &hitBoxB, bool considerExistFlag = true )
-	{
-		if ( !pBulletA || !pBulletB ) { return false; }
-		// else
 
-		namespace Col = Donya::Collision;
-
-		const SubtractorState subA = HasSubtractor( pBulletA );
-		const SubtractorState subB = HasSubtractor( pBulletB );
+	if ( pPlayer && Contains( layers, Layer::PlayerHurtBox ) )
+	{
+		collisionWorld.Register( Volume::Make( Layer::PlayerHurtBox, 0, pPlayer->GetHurtBox() ) );
+	}
 
-		// Do not use subtraction version
-		if ( subA == SubtractorState::Not && subB == SubtractorState::Not )
-		{
-			return Col::IsHit( hitBoxA, hitBoxB );
-		}
-		// else
-		
-		// Do not support yet
-		if ( subA != SubtractorState::Not && subB != SubtractorState::Not )
+	if ( Contains( layers, Layer::Item ) )
+	{
+		auto &itemAdmin = Item::Admin::Get();
+		const size_t itemCount = itemAdmin.GetInstanceCount();
+		for ( size_t i = 0; i < itemCount; ++i )
 		{
-			return Col::IsHit( hitBoxA, hitBoxB );
-		}
-		// else
+			const Item::Item *pItem = itemAdmin.GetInstanceOrNullptr( i );
+			if ( !pItem ) { continue; }
+			// else
 
-		if ( subA != SubtractorState::Not )
-		{
-			return IsHit( hitBoxB, pBulletA, hitBoxA, considerExistFlag );
-		}
-		// else
-		if ( subB != SubtractorState::Not )
-		{
-			return IsHit( hitBoxA, pBulletB, hitBoxB, considerExistFlag );
+			Volume item = Volume::Make( Layer::Item, i, pItem->GetHitBox() );
+			item.ignoreExistFlag = true; // The player can catch an item regardless of the exist flag
+			collisionWorld.Register( item );
 		}
-		// else
-		_ASSERT_EXPR( 0, L"Error: Unexpected condition!" );
-		return false;
 	}
+
+	collisionWorld.GenerateContacts();
 }
 void SceneGame::Collision_BulletVSBullet()
 {
-	auto &bulletAdmin = Bullet::Admin::Get();
-	const size_t bulletCount = bulletAdmin.GetInstanceCount();
-
-	std::shared_ptr<const Bullet::Base> pA = nullptr;
-	std::shared_ptr<const Bullet::Base> pB = nullptr;
-	auto Protectible	= []( const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		using D = Definition::Damage;
-		return ( pBullet ) ? D::Contain( D::Type::Protection, pBullet->GetDamage().type ) : false;
-	};
-	auto HitProcess		= [&]( const auto &hitBoxA, const auto &hitBoxB )
-	{
-		if ( !pA || !pB ) { return; }
-		// else
+	PROFILE_SCOPE( "SceneGame::Collision_BulletVSBullet" );
 
-		const bool protectibleA = Protectible( pA );
-		const bool protectibleB = Protectible( pB );
-		if ( protectibleA ) { pB->ProtectedBy( hitBoxA ); }
-		if ( protectibleB ) { pA->ProtectedBy( hitBoxB ); }
-		if ( protectibleA || protectibleB ) { return; }
-		// else
-
-		const bool destructibleA = pA->Destructible();
-		const bool destructibleB = pB->Destructible();
-		pA->CollidedToObject( destructibleB );
-		pB->CollidedToObject( destructibleA );
-	};
-	
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pA = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pA ) { continue; }
-
-		// Disallow collision between a protected bullet.
-		// Because if allowed hitting to multiple objects in the same timing,
-		// the protection attribute does not affect to some another object that collided in the same timing.
-		// That bullet's collision will be disabled at next update, but I wanna apply immediately.
-		if ( pA->WasProtected() ) { continue; }
-		// else
-
-		const auto aabbA		= pA->GetHitBox();
-		const auto sphereA		= pA->GetHitSphere();
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerBullet ) | CollisionWorld::ToMask( Layer::EnemyBullet ) );
 
-		const bool ownerA		= IsPlayerBullet( playerID, pA );
-		const bool protectibleA	= Protectible( pA );
-
-		for ( size_t j = i + 1; j < bulletCount; ++j )
-		{
-			pB = bulletAdmin.GetInstanceOrNullptr( j );
-			if ( !pB ) { continue; }
-			// else
-			if ( pB->WasProtected() ) { continue; }
-			// else
-
-			const bool ownerB		= IsPlayerBullet( playerID, pB );
-			const bool protectibleB	= Protectible( pB );
-			if ( ownerA == ownerB ) { continue; }
-			// else
-
-			// Do collide if either one of bullet is destructible or protectible
-			const bool wantCollide	=  pA->Destructible()	|| pB->Destructible()
-									|| protectibleA			|| protectibleB;
-			if ( !wantCollide ) { continue; }
-			// else
-			
-			const auto aabbB	= pB->GetHitBox();
-			const auto sphereB	= pB->GetHitSphere();
-
-			if ( aabbA.exist )
-			{
-				if ( IsHit( pA, aabbA, pB, aabbB ) )
-				{
-					HitProcess( aabbA, aabbB );
-					continue;
-				}
-				// else
-				if ( IsHit( pA, aabbA, pB, sphereB ) )
-				{
-					HitProcess( aabbA, sphereB );
-					continue;
-				}
-			}
-			else
-			if ( sphereA.exist )
-			{
-				if ( IsHit( pA, sphereA, pB, aabbB ) )
-				{
-					HitProcess( sphereA, aabbB );
-					continue;
-				}
-				// else
-				if ( IsHit( pA, sphereA, pB, sphereB ) )
-				{
-					HitProcess( sphereA, sphereB );
-					continue;
-				}
-			}
-		}
-	}
+	CollisionPass::BulletVSBullet( collisionWorld );
 }
 void SceneGame::Collision_BulletVSBoss()
 {
+	PROFILE_SCOPE( "SceneGame::Collision_BulletVSBoss" );
+
 	if ( !pBossContainer || !isThereBoss ) { return; }
 	// else
 
@@ -2408,104 +2340,47 @@ void SceneGame::Collision_BulletVSBoss()
 	if ( !pBoss ) { return; }
 	// else
 
-	const auto bossBody = pBoss->GetHurtBox();
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerBullet ) | CollisionWorld::ToMask( Layer::BossHurtBox ) );
 
 	auto &bulletAdmin = Bullet::Admin::Get();
-	const size_t bulletCount = bulletAdmin.GetInstanceCount();
-
-	std::shared_ptr<const Bullet::Base> pBullet = nullptr;
-	auto HitProcess = [&]()
-	{
-		if ( !pBullet ) { return; }
-		// else
-
-		if ( pBoss->NowProtecting() )
-		{
-			pBullet->ProtectedBy( bossBody );
-		}
-		else
-		{
-			pBoss->GiveDamage( pBullet->GetDamage() );
-			pBullet->CollidedToObject( pBoss->WillDie() );
-		}
-	};
-
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pBullet = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pBullet ) { continue; }
-		// else
-		if ( pBullet->WasProtected() ) { continue; }
-		// else
-
-		if ( !IsPlayerBullet( playerID, pBullet ) ) { continue; }
-		// else
-
-		// The bullet's hit box is only either AABB or Sphere is valid
-		// (Invalid one's exist flag will false, so IsHit() will returns false)
 
-		if ( IsHit( bossBody, pBullet, pBullet->GetHitBox() ) )
-		{
-			HitProcess();
-			continue;
-		}
-		// else
-
-		if ( IsHit( bossBody, pBullet, pBullet->GetHitSphere() ) )
-		{
-			HitProcess();
-			continue;
-		}
-	}
-}
-void SceneGame::Collision_BulletVSEnemy()
-{
-	auto &enemyAdmin	= Enemy::Admin::Get();
-	auto &bulletAdmin	= Bullet::Admin::Get();
-	const size_t enemyCount		= enemyAdmin.GetInstanceCount();
-	const size_t bulletCount	= bulletAdmin.GetInstanceCount();
-
-	// Makes every call the "FindCollidingEnemyOrNullptr" returns another enemy
-	std::vector<size_t> collidedEnemyIndices{};
-	auto IsAlreadyCollided				= [&]( size_t enemyIndex )
-	{
-		const auto result = std::find( collidedEnemyIndices.begin(), collidedEnemyIndices.end(), enemyIndex );
-		return ( result != collidedEnemyIndices.end() );
-	};
-	auto FindCollidingEnemyOrNullptr	= [&]( const std::shared_ptr<const Bullet::Base> &pOtherBullet, const auto &otherHitBox )
-	{
-		std::shared_ptr<const Enemy::Base> pEnemy = nullptr;
-		for ( size_t i = 0; i < enemyCount; ++i )
+	collisionWorld.ForEachContact
+	(
+		Layer::PlayerBullet, Layer::BossHurtBox,
+		[&]( const CollisionWorld::Volume &bulletVolume, const CollisionWorld::Volume &bossVolume )
 		{
-			if ( IsAlreadyCollided( i ) ) { continue; }
+			const auto pBullet = bulletAdmin.GetInstanceOrNullptr( bulletVolume.userIndex );
+			if ( !pBullet ) { return; }
 			// else
-
-			pEnemy = enemyAdmin.GetInstanceOrNullptr( i );
-			if ( !pEnemy ) { continue; }
+			if ( pBullet->WasProtected() ) { return; }
 			// else
 
-			if ( IsHit( pEnemy->GetHurtBox(), pOtherBullet, otherHitBox ) )
+			if ( pBoss->NowProtecting() )
+			{
+				pBullet->ProtectedBy( bossVolume.aabb );
+			}
+			else
 			{
-				collidedEnemyIndices.emplace_back( i );
-				return pEnemy;
+				pBoss->GiveDamage( pBullet->GetDamage() );
+				pBullet->CollidedToObject( pBoss->WillDie() );
 			}
 		}
+	);
+}
+void SceneGame::Collision_BulletVSEnemy()
+{
+	PROFILE_SCOPE( "SceneGame::Collision_BulletVSEnemy" );
 
-		pEnemy = nullptr;
-		return pEnemy;
-	};
-
-	// The bullet's hit box is only either AABB or Sphere is valid
-	// (Invalid one's exist flag will false, so IsHit() will returns false)
-	Donya::Collision::Box3F		otherAABB;
-	Donya::Collision::Sphere3F	otherSphere;
-
-	std::shared_ptr<const Bullet::Base> pBullet = nullptr;
-	std::shared_ptr<const Enemy::Base>  pOther  = nullptr;
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerBullet ) | CollisionWorld::ToMask( Layer::EnemyHurtBox ) );
 
-	auto DropItemByLottery = []( const Donya::Vector3 &wsGeneratePos)
+	auto &enemyAdmin = Enemy::Admin::Get();
+	auto FetchEnemy = [&enemyAdmin]( size_t userIndex )
+	{
+		return enemyAdmin.GetInstanceOrNullptr( userIndex ).get();
+	};
+	auto DropItemByLottery = []( const Enemy::Base &defeatedEnemy )
 	{
 		const Item::Kind dropKind = Item::LotteryDropKind();
 		// If invalid is chosen
@@ -2515,125 +2390,52 @@ void SceneGame::Collision_BulletVSEnemy()
 		Item::InitializeParam tmp;
 		tmp.kind		= dropKind;
 		tmp.aliveSecond	= Item::Parameter::GetItem().disappearSecond;
-		tmp.wsPos		= wsGeneratePos;
+		tmp.wsPos		= defeatedEnemy.GetPosition();
 		Item::Admin::Get().RequestGeneration( tmp );
 	};
 
-	struct ProccessResult
-	{
-		bool collided	= false;
-		bool pierced	= false;
-	};
-	auto Process = [&]( const auto &bulletBody )
-	{
-		ProccessResult result{};
-		result.collided = false;
-		result.pierced  = false;
-
-		if ( !pBullet ) { return result; }
-		// else
-
-		result.pierced = true;
-
-		pOther = FindCollidingEnemyOrNullptr( pBullet, bulletBody );
-		while ( pOther )
-		{
-			result.collided = true;
-
-			pOther->GiveDamage( pBullet->GetDamage() );
-			if ( pOther->WillDie() )
-			{
-				DropItemByLottery( pOther->GetPosition() );
-			}
-			else
-			{
-				result.pierced = false;
-			}
-
-			pOther = FindCollidingEnemyOrNullptr( pBullet, bulletBody );
-		}
-
-		return result;
-	};
-
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pBullet = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pBullet ) { continue; }
-		// else
-		if ( pBullet->WasProtected() ) { continue; }
-		// else
-
-		if ( IsEnemyBullet( playerID, pBullet ) ) { continue; }
-		// else
-
-		otherAABB	= pBullet->GetHitBox();
-		otherSphere	= pBullet->GetHitSphere();
-		if ( !otherAABB.exist && !otherSphere.exist ) { continue; }
-		// else
-
-		const auto result	= ( otherAABB.exist )
-							? Process( otherAABB	)
-							: Process( otherSphere	);
-		if ( result.collided )
-		{
-			pBullet->CollidedToObject( result.pierced );
-		}
-
-		collidedEnemyIndices.clear();
-	}
+	CollisionPass::BulletVSEnemy( collisionWorld, FetchEnemy, DropItemByLottery );
 }
 void SceneGame::Collision_BulletVSPlayer()
 {
+	PROFILE_SCOPE( "SceneGame::Collision_BulletVSPlayer" );
+
 	if ( !pPlayer || pPlayer->NowMiss()	) { return; }
 	if ( !IsPlayingStatus( status )		) { return; } // Ignore if cleared
 	// else
 
-	const auto playerBody = pPlayer->GetHurtBox();
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::EnemyBullet ) | CollisionWorld::ToMask( Layer::PlayerHurtBox ) );
 
 	auto &bulletAdmin = Bullet::Admin::Get();
-	const size_t bulletCount = bulletAdmin.GetInstanceCount();
-
-	// The bullet's hit box is only either AABB or Sphere is valid
-	// (Invalid one's exist flag will false, so IsHit() will returns false)
-	Donya::Collision::Box3F		bulletAABB;
-	Donya::Collision::Sphere3F	bulletSphere;
-
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	std::shared_ptr<const Bullet::Base> pBullet = nullptr;
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pBullet = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pBullet ) { continue; }
-		// else
-		if ( pBullet->WasProtected() ) { continue; }
-		// else
-
-		if ( IsPlayerBullet( playerID, pBullet ) ) { continue; }
-		// else
 
-		bulletAABB = pBullet->GetHitBox();
-		if ( IsHit( playerBody, pBullet, bulletAABB ) )
+	collisionWorld.ForEachContact
+	(
+		Layer::EnemyBullet, Layer::PlayerHurtBox,
+		[&]( const CollisionWorld::Volume &bulletVolume, const CollisionWorld::Volume &playerVolume )
 		{
-			pPlayer->GiveDamage( pBullet->GetDamage(), bulletAABB );
-			pBullet->CollidedToObject( pPlayer->WillDie() );
-			continue;
-		}
-		// else
+			const auto pBullet = bulletAdmin.GetInstanceOrNullptr( bulletVolume.userIndex );
+			if ( !pBullet ) { return; }
+			// else
+			if ( pBullet->WasProtected() ) { return; }
+			// else
 
-		bulletSphere = pBullet->GetHitSphere();
-		if ( IsHit( playerBody, pBullet, bulletSphere ) )
-		{
-			pPlayer->GiveDamage( pBullet->GetDamage(), bulletSphere );
+			if ( bulletVolume.useSphere )
+			{
+				pPlayer->GiveDamage( pBullet->GetDamage(), bulletVolume.sphere );
+			}
+			else
+			{
+				pPlayer->GiveDamage( pBullet->GetDamage(), bulletVolume.aabb );
+			}
 			pBullet->CollidedToObject( pPlayer->WillDie() );
 		}
-	}
+	);
 }
 void SceneGame::Collision_BossVSPlayer()
 {
+	PROFILE_SCOPE( "SceneGame::Collision_BossVSPlayer" );
+
 	if ( !pPlayer || pPlayer->NowMiss()		)  { return; }
 	if ( !pBossContainer || !isThereBoss	) { return; }
 	if ( !IsPlayingStatus( status )			) { return; } // Ignore if cleared
@@ -2643,49 +2445,52 @@ void SceneGame::Collision_BossVSPlayer()
 	if ( !pBoss ) { return; }
 	// else
 
-	const auto playerBody	= pPlayer->GetHurtBox();
-	const auto bossBody		= pBoss->GetHitBox();
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::BossHitBox ) | CollisionWorld::ToMask( Layer::PlayerHurtBox ) );
 
-	if ( Donya::Collision::IsHit( playerBody, bossBody ) )
-	{
-		pPlayer->GiveDamage( pBoss->GetTouchDamage(), bossBody );
-	}
+	collisionWorld.ForEachContact
+	(
+		Layer::BossHitBox, Layer::PlayerHurtBox,
+		[&]( const CollisionWorld::Volume &bossVolume, const CollisionWorld::Volume &playerVolume )
+		{
+			pPlayer->GiveDamage( pBoss->GetTouchDamage(), bossVolume.aabb );
+		}
+	);
 }
 void SceneGame::Collision_EnemyVSPlayer()
 {
+	PROFILE_SCOPE( "SceneGame::Collision_EnemyVSPlayer" );
+
 	if ( !pPlayer					) { return; }
 	if ( !IsPlayingStatus( status )	) { return; } // Ignore if cleared
 	// else
 
-	const auto playerBody	= pPlayer->GetHurtBox();
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::EnemyHitBox ) | CollisionWorld::ToMask( Layer::PlayerHurtBox ) );
 
-	auto  &enemyAdmin		= Enemy::Admin::Get();
-	const size_t enemyCount	= enemyAdmin.GetInstanceCount();
-
-	Donya::Collision::Box3F other;
-	std::shared_ptr<const Enemy::Base> pEnemy = nullptr;
-	for ( size_t i = 0; i < enemyCount; ++i )
-	{
-		pEnemy = enemyAdmin.GetInstanceOrNullptr( i );
-		if ( !pEnemy ) { continue; }
-		// else
+	auto &enemyAdmin = Enemy::Admin::Get();
 
-		other = pEnemy->GetHitBox();
-		if ( Donya::Collision::IsHit( other, playerBody ) )
+	collisionWorld.ForEachContact
+	(
+		Layer::EnemyHitBox, Layer::PlayerHurtBox,
+		[&]( const CollisionWorld::Volume &enemyVolume, const CollisionWorld::Volume &playerVolume )
 		{
-			pPlayer->GiveDamage( pEnemy->GetTouchDamage(), other );
+			const auto pEnemy = enemyAdmin.GetInstanceOrNullptr( enemyVolume.userIndex );
+			if ( !pEnemy ) { return; }
+			// else
+
+			pPlayer->GiveDamage( pEnemy->GetTouchDamage(), enemyVolume.aabb );
 		}
-	}
+	);
 }
 void SceneGame::Collision_PlayerVSItem()
 {
+	PROFILE_SCOPE( "SceneGame::Collision_PlayerVSItem" );
+
 	if ( !pPlayer || pPlayer->NowMiss() ) { return; }
 	// else
 
-	const auto playerBody = pPlayer->GetHurtBox();
-
 	auto &itemAdmin = Item::Admin::Get();
-	const size_t itemCount = itemAdmin.GetInstanceCount();
 
 	auto CatchItem = [&]( const Item::Item *pItem )
 	{
@@ -2715,19 +2520,18 @@ void SceneGame::Collision_PlayerVSItem()
 		}
 	};
 
-	Donya::Collision::Box3F other;
-	for ( size_t i = 0; i < itemCount; ++i )
-	{
-		const Item::Item *pItem = itemAdmin.GetInstanceOrNullptr( i );
-		if ( !pItem ) { continue; }
-		// else
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerHurtBox ) | CollisionWorld::ToMask( Layer::Item ) );
 
-		other = pItem->GetHitBox();
-		if ( Donya::Collision::IsHit( other, playerBody, /* considerExistFlag = */ false ) )
+	// The item volumes ignore the exist flag
+	collisionWorld.ForEachContact
+	(
+		Layer::PlayerHurtBox, Layer::Item,
+		[&]( const CollisionWorld::Volume &playerVolume, const CollisionWorld::Volume &itemVolume )
 		{
-			CatchItem( pItem );
+			CatchItem( itemAdmin.GetInstanceOrNullptr( itemVolume.userIndex ) );
 		}
-	}
+	);
 }
 
 void SceneGame::ClearBackGround() const
@@ -3273,6 +3077,25 @@ void SceneGame::UseImGui( float elapsedTime )
 		ImGui::TreePop();
 	}
 
+	if ( ImGui::TreeNode( u8"Xe[Wt@C̐ǂ" ) )
+	{
+		const auto report = Donya::AsyncIO::GetReport();
+		ImGui::Text( u8"ǂݍݍς݁F%di%d KBj", scast<int>( report.residentCount ), scast<int>( report.residentBytes / 1024 ) );
+		ImGui::Text( u8"ǂݍݒF%d", scast<int>( report.pendingCount ) );
+		ImGui::Text( u8"gpꂽ񐔁F%diҋ@F%dj", scast<int>( report.hitCount ), scast<int>( report.waitCount ) );
+
+		if ( ImGui::Button( u8"݂̃Xe[Wǂ݂" ) )
+		{
+			StagePrefetch::Request( stageNumber );
+		}
+		if ( ImGui::Button( u8"݂̃Xe[W" ) )
+		{
+			StagePrefetch::Release( stageNumber );
+		}
+
+		ImGui::TreePop();
+	}
+
 	if ( ImGui::TreeNode( u8"eIuWFNg̒" ) )
 	{
 		ImGui::InputInt( u8"݂̃[ԍ", &currentRoomID );
@@ -3333,6 +3156,63 @@ void SceneGame::UseImGui( float elapsedTime )
 		ImGui::Text( "" );
 
 		Effect::Admin::Get().ShowImGuiNode( u8"GtFNg̃p[^" );
+		Effect::Particle::Admin::Get().ShowImGuiNode( u8"p[eBŇ" );
+		ImGui::Text( "" );
+
+		{
+			const auto coalesce = Donya::Sound::GetCoalesceStatistics();
+			ImGui::Text
+			(
+				u8"ʉ̓Fv%dCĐ%dC%d",
+				scast<int>( coalesce.requestedCount ),
+				scast<int>( coalesce.playedCount ),
+				scast<int>( coalesce.mergedCount )
+			);
+			if ( ImGui::Button( u8"ʉ̓̓vZbg" ) ) { Donya::Sound::ResetCoalesceStatistics(); }
+
+			const auto memory = Donya::Sound::GetMemoryReport();
+			ImGui::Text
+			(
+				u8"TEh̃F%dKBCő%dKBCWJ%dCXg[%diJnς%dj",
+				memory.currentBytes / 1024,
+				memory.maxBytes / 1024,
+				memory.sampleCount,
+				memory.streamCount,
+				memory.openedStreamCount
+			);
+
+			const auto audio = Donya::Sound::GetStatistics();
+			ImGui::Text
+			(
+				u8"TEh̍XVF%6.3f msCĐ%dCő%d",
+				audio.updateMilliseconds,
+				audio.playingVoiceCount,
+				audio.peakVoiceCount
+			);
+			ImGui::Text( "" );
+		}
+
+		AnimationLOD::ShowImGuiNode( u8"Aj[V̏ȗ" );
+		collisionWorld.ShowImGuiNode( u8"蔻̓v" );
+		if ( pRenderer )
+		{
+			DebugDrawQueue::ShowImGuiNode( u8"蔻̕`", pRenderer->GetDebugDrawStatistics() );
+			bool measureSubmitted = pRenderer->IsMeasuringSubmittedOrder();
+			RenderQueue::ShowImGuiNode( u8"f`̐", pRenderer->GetModelQueueStatisticsSubmitted(), pRenderer->GetModelQueueStatisticsSorted(), &measureSubmitted );
+			pRenderer->SetMeasuringSubmittedOrder( measureSubmitted );
+		}
+		{
+			const auto atlas = Donya::Sprite::GetAtlasReport();
+			ImGui::Text
+			(
+				u8"XvCg̃AgXF%dy[WC%d/%dC[U%5.1f%%",
+				scast<int>( atlas.pageCount ),
+				scast<int>( atlas.packedCount ),
+				scast<int>( atlas.rectCount ),
+				atlas.CalcEfficiency() * 100.0f
+			);
+			ImGui::Text( u8"XvCg̕`ob`iOt[jF%d", scast<int>( Donya::Sprite::GetBatchRenderCountOfLastFrame() ) );
+		}
 		ImGui::Text( "" );
 
 		if ( ImGui::Button( u8"[hoďI" ) )
@@ -18,6 +18,7 @@
 #include "Bloom.h"
 #include "CheckPoint.h"
 #include "ClearEvent.h"
+#include "CollisionWorld.h"
 #include "Effect/Effect.h"
 #include "Map.h"
 #include "Music.h"
@@ -67,6 +68,7 @@ private:
 	Music::ID							currentPlayingBGM	= Music::BGM_Game;
 	PlayerInitializer					playerIniter;
 	CheckPoint::Container				checkPoint;
+	CollisionWorld						collisionWorld;
 
 	Scene::Type							nextScene			= Scene::Type::Null;
 	State								status				= State::FirstInitialize;
@@ -164,6 +166,10 @@ private:
 	void	CameraUpdate( float elapsedTime );
 
 	Donya::Vector4x4 CalcLightViewMatrix() const;
+	/// <summary>
+	/// Returns the world space area that the light camera projects. The shadow casters out of it do not appear in the shadow map.
+	/// </summary>
+	Donya::Collision::Box3F CalcShadowCasterArea() const;
 
 	void	ReadyPlayer();
 	void	PlayerInit( const PlayerInitializer &initializer, const Map &terrain );
@@ -178,6 +184,7 @@ private:
 
 	int		CalcCurrentRoomID() const;
 
+	void	Collision_GenerateContacts( CollisionWorld::LayerMask layers );
 	void	Collision_BulletVSBullet();
 	void	Collision_BulletVSBoss();
 	void	Collision_BulletVSEnemy();
@@ -1,5 +1,6 @@
 #include "SceneLoad.h"
 
+#include <array>
 #include <vector>
 
 #undef max
@@ -10,6 +11,7 @@
 #include "Donya/Color.h"
 #include "Donya/Constant.h"
 #include "Donya/Donya.h"
+#include "Donya/Profiler.h"
 #include "Donya/Serializer.h"
 #include "Donya/Sound.h"
 #include "Donya/Sprite.h"
@@ -28,6 +30,7 @@
 #include "Effect/EffectAdmin.h"
 #include "Fader.h"
 #include "FilePath.h"
+#include "FontHelper.h"
 #include "Item.h"
 #include "Input.h"
 #include "Meter.h"
@@ -35,8 +38,6 @@
 #include "Parameter.h"
 #include "Player.h"
 
-#define LOAD_EFFECT_BY_ANOTHER_THREAD ( false )
-
 
 namespace
 {
@@ -73,6 +74,103 @@ namespace
 CEREAL_CLASS_VERSION( Member, 0 )
 
 
+namespace
+{
+	struct Bundle
+	{
+		Music::ID	id;
+		const char	*filePath;
+		bool		isEnableLoop;
+		bool		isStream;		// Decode while playing, for long BGM
+	public:
+		constexpr Bundle( Music::ID id, const char *filePath, bool isEnableLoop, bool isStream )
+			: id( id ), filePath( filePath ), isEnableLoop( isEnableLoop ), isStream( isStream ) {}
+	};
+	using Music::ID;
+	constexpr std::array<Bundle, ID::MUSIC_COUNT> soundBundles
+	{
+		// ID, FilePath, isEnableLoop, isStream
+
+		Bundle{ ID::BGM_Title,					"./Data/Sounds/BGM/Title.ogg",						true,	true	},
+		Bundle{ ID::BGM_Game,					"./Data/Sounds/BGM/Game.ogg",						true,	true	},
+		Bundle{ ID::BGM_Boss,					"./Data/Sounds/BGM/BossBattle.ogg",					true,	true	},
+		Bundle{ ID::BGM_Over,					"./Data/Sounds/BGM/GameOver.ogg",					false,	true	},
+		Bundle{ ID::BGM_Result,					"./Data/Sounds/BGM/Result.ogg",						true,	true	},
+
+		Bundle{ ID::Bullet_HitBuster,			"./Data/Sounds/SE/Bullet/Hit_Buster.wav",			false,	false	},
+		Bundle{ ID::Bullet_HitShield,			"./Data/Sounds/SE/Bullet/Hit_Shield.wav",			false,	false	},
+		Bundle{ ID::Bullet_Protected,			"./Data/Sounds/SE/Bullet/Protected.wav",			false,	false	},
+		Bundle{ ID::Bullet_ShotBuster,			"./Data/Sounds/SE/Bullet/Shot_Buster.wav",			false,	false	},
+		Bundle{ ID::Bullet_ShotShield_Expand,	"./Data/Sounds/SE/Bullet/Shot_Shield_Expand.wav",	false,	false	},
+		Bundle{ ID::Bullet_ShotShield_Throw,	"./Data/Sounds/SE/Bullet/Shot_Shield_Throw.wav",	false,	false	},
+		Bundle{ ID::Bullet_ShotSkullBuster,		"./Data/Sounds/SE/Bullet/Shot_Skull_Buster.wav",	false,	false	},
+		
+		Bundle{ ID::Charge_Complete,			"./Data/Sounds/SE/Effect/Charge_Complete.wav",		false,	false	},
+		Bundle{ ID::Charge_Loop,				"./Data/Sounds/SE/Effect/Charge_Loop.ogg",			true,	false	},
+		Bundle{ ID::Charge_Start,				"./Data/Sounds/SE/Effect/Charge_Start.wav",			false,	false	},
+		
+		Bundle{ ID::Performance_AppearBoss,		"./Data/Sounds/SE/Performance/AppearBoss.ogg",		false,	false	},
+		Bundle{ ID::Performance_ClearStage,		"./Data/Sounds/SE/Performance/ClearStage.ogg",		false,	false	},
+		
+		Bundle{ ID::Player_1UP,					"./Data/Sounds/SE/Player/ExtraLife.wav",			false,	false	},
+		Bundle{ ID::Player_Appear,				"./Data/Sounds/SE/Player/Appear.ogg",				false,	false	},
+		Bundle{ ID::Player_Damage,				"./Data/Sounds/SE/Player/Damage.wav",				false,	false	},
+		Bundle{ ID::Player_Dash,				"./Data/Sounds/SE/Player/Dash.wav",					false,	false	},
+		Bundle{ ID::Player_Jump,				"./Data/Sounds/SE/Player/Jump.wav",					false,	false	},
+		Bundle{ ID::Player_Landing,				"./Data/Sounds/SE/Player/Landing.wav",				false,	false	},
+		Bundle{ ID::Player_Leave,				"./Data/Sounds/SE/Player/Leave.ogg",				false,	false	},
+		Bundle{ ID::Player_Miss,				"./Data/Sounds/SE/Player/Miss.wav",					false,	false	},
+		Bundle{ ID::Player_ShiftGun,			"./Data/Sounds/SE/Player/ShiftGun.ogg",				false,	false	},
+		
+		Bundle{ ID::RecoverHP,					"./Data/Sounds/SE/Effect/RecoverHP.wav",			false,	false	},
+		
+		Bundle{ ID::Skull_Landing,				"./Data/Sounds/SE/Boss/Skull_Landing.wav",			false,	false	},
+		Bundle{ ID::Skull_Jump,					"./Data/Sounds/SE/Boss/Skull_Jump.wav",				false,	false	},
+		Bundle{ ID::Skull_Roar,					"./Data/Sounds/SE/Boss/Skull_Roar.wav",				false,	false	},
+		
+		Bundle{ ID::SuperBallMachine_Shot,		"./Data/Sounds/SE/Enemy/SBM_Shot.wav",				false,	false	},
+		
+		Bundle{ ID::UI_Choose,					"./Data/Sounds/SE/UI/Choose.ogg",					false,	false	},
+		Bundle{ ID::UI_Decide,					"./Data/Sounds/SE/UI/Decide.ogg",					false,	false	},
+		
+		#if DEBUG_MODE
+		Bundle{ ID::DEBUG_Strong,				"./Data/Sounds/SE/UI/Decide.ogg",					false,	false	},
+		Bundle{ ID::DEBUG_Weak,					"./Data/Sounds/SE/UI/Choose.ogg",					false,	false	},
+		#endif // DEBUG_MODE
+	};
+
+	// Keeps the frame rate of the loading screen
+	constexpr float mainThreadBudgetSecond = 0.008f;
+
+	// The flag for CoUninitialize()
+	static thread_local bool coInitialized = false;
+	void BeginWorker()
+	{
+		Donya::Profiler::SetThreadName( "SceneLoad::Worker" );
+
+		constexpr auto coInitValue = COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE;
+		HRESULT hr = CoInitializeEx( NULL, coInitValue );
+		coInitialized = SUCCEEDED( hr );
+		if ( !coInitialized )
+		{
+			// The loading by WIC will fail on this thread, and it is reported as the failure of that task
+			Donya::OutputDebugStr( "Error: CoInitializeEx() is failed at a loading worker.\n" );
+		}
+	}
+	void EndWorker()
+	{
+		if ( coInitialized ) { CoUninitialize(); }
+		coInitialized = false;
+	}
+
+	bool MakeTextureCache( SpriteAttribute attr )
+	{
+		const auto handle = Donya::Sprite::Load( GetSpritePath( attr ), GetSpriteInstanceCount( attr ) );
+		return  (  handle == NULL ) ? false : true;
+	}
+}
+
+
 #if USE_IMGUI
 namespace
 {
@@ -94,205 +192,141 @@ void SceneLoad::Init()
 	loadPerformer.Init();
 	loadPerformer.Start( FetchParameter().ssLoadingDrawPos, Donya::Color::Code::GRAY );
 	
-	constexpr auto coInitValue = COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE;
-	auto LoadingEffects	= [coInitValue]( Thread::Result *pResult )
+	MakeLoadGraph();
+	loadGraph.Start( TaskGraph::RecommendWorkerCount(), BeginWorker, EndWorker );
+}
+void SceneLoad::MakeLoadGraph()
+{
+	using Stage		= TaskGraph::Stage;
+	using Affinity	= TaskGraph::Affinity;
+	using Handle	= TaskGraph::Handle;
+
+	// Parameters
+	// The loading by cereal is guarded by the Loader, and each module has its own parameter
+	loadGraph.Add( "Boss::Parameter",	Stage::Other, Affinity::Worker, []() { Boss::Parameter::Load();		return true; } );
+	loadGraph.Add( "Bullet::Parameter",	Stage::Other, Affinity::Worker, []() { Bullet::Parameter::Load();	return true; } );
+	loadGraph.Add( "Enemy::Parameter",	Stage::Other, Affinity::Worker, []() { Enemy::Parameter::Load();	return true; } );
+	loadGraph.Add( "Item::Parameter",	Stage::Other, Affinity::Worker, []() { Item::Parameter::Load();		return true; } );
+	loadGraph.Add( "Player::Parameter",	Stage::Other, Affinity::Worker, []() { Player::LoadParameter();		return true; } );
+
+	// The cache of texture(Donya::Resource) is not thread-safe,
+	// so the tasks that create a texture are chained by this. The chain runs in parallel with the other tasks.
+	std::vector<Handle> textureChain{};
+
+	// Models
+	// Each model is loaded by three tasks, and the reading and decoding run in parallel.
+	// The upload does not use the immediate-context(the device is free-threaded), so it also runs on a worker.
+	// But it creates the textures of the model, so the uploads are chained.
 	{
-		if ( !pResult ) { assert( !"HUMAN ERROR" ); return; }
-		// else
-
-	#if LOAD_EFFECT_BY_ANOTHER_THREAD
-		HRESULT hr = CoInitializeEx( NULL, coInitValue );
-		if ( FAILED( hr ) )
+		std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> loads{};
+		auto Append = [&loads]( std::vector<std::shared_ptr<ModelHelper::StagedSkinningLoad>> &&source )
 		{
-			pResult->WriteResult( /* wasSucceeded = */ false );
-			return;
-		}
-		// else
-	#endif // LOAD_EFFECT_BY_ANOTHER_THREAD
+			loads.insert
+			(
+				loads.end(),
+				std::make_move_iterator( source.begin() ),
+				std::make_move_iterator( source.end() )
+			);
+		};
+		Append( Boss	::MakeModelLoads() );
+		Append( Bullet	::MakeModelLoads() );
+		Append( Enemy	::MakeModelLoads() );
+		Append( Item	::MakeModelLoads() );
+		Append( Player	::MakeModelLoads() );
 
-		bool succeeded = true;
-		constexpr size_t kindCount = scast<size_t>( Effect::Kind::KindCount );
-		for ( size_t i = 0; i < kindCount; ++i )
+		for ( const auto &pLoad : loads )
 		{
-			if ( !Effect::Admin::Get().LoadEffect( scast<Effect::Kind>( i ) ) )
-			{
-				succeeded = false;
-			}
-		}
-		
-		_ASSERT_EXPR( succeeded, L"Failed: Effects load is failed." );
-
-		pResult->WriteResult( succeeded );
-
-	#if LOAD_EFFECT_BY_ANOTHER_THREAD
-		CoUninitialize();
-	#endif // LOAD_EFFECT_BY_ANOTHER_THREAD
-	};
-	auto LoadingModels	= [coInitValue]( Thread::Result *pResult )
-	{
-		if ( !pResult ) { assert( !"HUMAN ERROR" ); return; }
-		// else
+			const std::string &path = pLoad->GetFilePath();
+		#if USE_IMGUI
+			modelPaths.emplace_back( path );
+		#endif // USE_IMGUI
 
-		HRESULT hr = CoInitializeEx( NULL, coInitValue );
-		if ( FAILED( hr ) )
-		{
-			pResult->WriteResult( /* wasSucceeded = */ false );
-			return;
+			const Handle read	= loadGraph.Add( "Read: "   + path, Stage::Read,   Affinity::Worker, [pLoad]() { return pLoad->Read();   } );
+			const Handle decode	= loadGraph.Add( "Decode: " + path, Stage::Decode, Affinity::Worker, [pLoad]() { return pLoad->Decode(); }, { read   } );
+			std::vector<Handle> uploadDependencies = textureChain;
+			uploadDependencies.emplace_back( decode );
+			textureChain = { loadGraph.Add( "Upload: " + path, Stage::Upload, Affinity::Worker, [pLoad]() { return pLoad->Upload(); }, uploadDependencies ) };
 		}
-		// else
-
-		bool succeeded = true;
-
-		if ( !Boss	::LoadResource()		) { succeeded = false; }
-		if ( !Bullet::LoadResource()		) { succeeded = false; }
-		if ( !Enemy	::LoadResource()		) { succeeded = false; }
-		if ( !Item	::LoadResource()		) { succeeded = false; }
-		if ( !Meter	::LoadResource()		) { succeeded = false; }
-		if ( !Player::LoadResource()		) { succeeded = false; }
-		
-		_ASSERT_EXPR( succeeded, L"Failed: Models load is failed." );
-
-		pResult->WriteResult( succeeded );
+	}
 
-		CoUninitialize();
-	};
-	auto LoadingSprites	= [coInitValue]( Thread::Result *pResult )
+	// Sounds
+	// The sound system is not thread-safe, so I chain them. The chain runs in parallel with the other assets.
 	{
-		if ( !pResult ) { assert( !"HUMAN ERROR" ); return; }
-		// else
+	#if DEBUG_MODE
+		const auto memoryBefore = Donya::Sound::GetMemoryReport();
+	#endif // DEBUG_MODE
 
-		HRESULT hr = CoInitializeEx( NULL, coInitValue );
-		if ( FAILED( hr ) )
+		std::vector<Handle> previous{};
+		for ( const auto &it : soundBundles )
 		{
-			pResult->WriteResult( /* wasSucceeded = */ false );
-			return;
+			const Bundle bundle = it;
+			auto Load = [bundle]()
+			{
+				return Donya::Sound::Load
+				(
+					bundle.id,
+					bundle.filePath,
+					bundle.isEnableLoop,
+					bundle.isStream
+				);
+			};
+			previous = { loadGraph.Add( bundle.filePath, Stage::Decode, Affinity::Worker, Load, previous ) };
 		}
-		// else
-
-		using Attr = SpriteAttribute;
 
-		auto MakeTextureCache = []( Attr attr )->bool
+	#if DEBUG_MODE
+		auto Report = [memoryBefore]()
 		{
-			const auto handle = Donya::Sprite::Load( GetSpritePath( attr ), GetSpriteInstanceCount( attr ) );
-			return  (  handle == NULL ) ? false : true;
+			const auto memoryAfter = Donya::Sound::GetMemoryReport();
+			std::wstring report = L"[Sound Memory] Before: ";
+			report += std::to_wstring( memoryBefore.currentBytes / 1024 );
+			report += L" KB, After: ";
+			report += std::to_wstring( memoryAfter.currentBytes / 1024 );
+			report += L" KB (Samples: ";
+			report += std::to_wstring( memoryAfter.sampleCount );
+			report += L", Streams: ";
+			report += std::to_wstring( memoryAfter.streamCount );
+			report += L")\n";
+			Donya::OutputDebugStr( report.c_str() );
+			return true;
 		};
+		loadGraph.Add( "Sound memory report", Stage::Other, Affinity::Worker, Report, previous );
+	#endif // DEBUG_MODE
+	}
 
-		bool succeeded = true;
-		if ( !MakeTextureCache( Attr::TitleLogo		) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::InputButtons	) ) { succeeded = false; }
-		if ( !MakeTextureCache( Attr::Meter			) ) { succeeded = false; }
-		
-		_ASSERT_EXPR( succeeded, L"Failed: Sprites load is failed." );
-
-		pResult->WriteResult( succeeded );
-
-		CoUninitialize();
-	};
-	auto LoadingSounds	= [coInitValue]( Thread::Result *pResult )
+	// Sprites
+	// The sprites continue the chain of texture, with the Meter that also loads a sprite.
+	std::vector<Handle> spriteTasks{};
 	{
-		if ( !pResult ) { assert( !"HUMAN ERROR" ); return; }
-		// else
-
-		HRESULT hr = CoInitializeEx( NULL, coInitValue );
-		if ( FAILED( hr ) )
-		{
-			pResult->WriteResult( /* wasSucceeded = */ false );
-			return;
-		}
-		// else
-
-		using Music::ID;
-
-		struct Bundle
+		using Attr = SpriteAttribute;
+		constexpr std::array<Attr, 3> attributes
 		{
-			ID			id;
-			const char	*filePath;
-			bool		isEnableLoop;
-		public:
-			constexpr Bundle( ID id, const char *filePath, bool isEnableLoop )
-				: id( id ), filePath( filePath ), isEnableLoop( isEnableLoop ) {}
+			Attr::TitleLogo,
+			Attr::InputButtons,
+			Attr::Meter,
 		};
 
-		constexpr std::array<Bundle, ID::MUSIC_COUNT> bundles
+		std::vector<Handle> &previous = textureChain;
+		for ( const auto &attr : attributes )
 		{
-			// ID, FilePath, isEnableLoop
-
-			Bundle{ ID::BGM_Title,					"./Data/Sounds/BGM/Title.ogg",						true	},
-			Bundle{ ID::BGM_Game,					"./Data/Sounds/BGM/Game.ogg",						true	},
-			Bundle{ ID::BGM_Boss,					"./Data/Sounds/BGM/BossBattle.ogg",					true	},
-			Bundle{ ID::BGM_Over,					"./Data/Sounds/BGM/GameOver.ogg",					false	},
-			Bundle{ ID::BGM_Result,					"./Data/Sounds/BGM/Result.ogg",						true	},
-
-			Bundle{ ID::Bullet_HitBuster,			"./Data/Sounds/SE/Bullet/Hit_Buster.wav",			false	},
-			Bundle{ ID::Bullet_HitShield,			"./Data/Sounds/SE/Bullet/Hit_Shield.wav",			false	},
-			Bundle{ ID::Bullet_Protected,			"./Data/Sounds/SE/Bullet/Protected.wav",			false	},
-			Bundle{ ID::Bullet_ShotBuster,			"./Data/Sounds/SE/Bullet/Shot_Buster.wav",			false	},
-			Bundle{ ID::Bullet_ShotShield_Expand,	"./Data/Sounds/SE/Bullet/Shot_Shield_Expand.wav",	false	},
-			Bundle{ ID::Bullet_ShotShield_Throw,	"./Data/Sounds/SE/Bullet/Shot_Shield_Throw.wav",	false	},
-			Bundle{ ID::Bullet_ShotSkullBuster,		"./Data/Sounds/SE/Bullet/Shot_Skull_Buster.wav",	false	},
-			
-			Bundle{ ID::Charge_Complete,			"./Data/Sounds/SE/Effect/Charge_Complete.wav",		false	},
-			Bundle{ ID::Charge_Loop,				"./Data/Sounds/SE/Effect/Charge_Loop.ogg",			true	},
-			Bundle{ ID::Charge_Start,				"./Data/Sounds/SE/Effect/Charge_Start.wav",			false	},
-			
-			Bundle{ ID::Performance_AppearBoss,		"./Data/Sounds/SE/Performance/AppearBoss.ogg",		false	},
-			Bundle{ ID::Performance_ClearStage,		"./Data/Sounds/SE/Performance/ClearStage.ogg",		false	},
-			
-			Bundle{ ID::Player_1UP,					"./Data/Sounds/SE/Player/ExtraLife.wav",			false	},
-			Bundle{ ID::Player_Appear,				"./Data/Sounds/SE/Player/Appear.ogg",				false	},
-			Bundle{ ID::Player_Damage,				"./Data/Sounds/SE/Player/Damage.wav",				false	},
-			Bundle{ ID::Player_Dash,				"./Data/Sounds/SE/Player/Dash.wav",					false	},
-			Bundle{ ID::Player_Jump,				"./Data/Sounds/SE/Player/Jump.wav",					false	},
-			Bundle{ ID::Player_Landing,				"./Data/Sounds/SE/Player/Landing.wav",				false	},
-			Bundle{ ID::Player_Leave,				"./Data/Sounds/SE/Player/Leave.ogg",				false	},
-			Bundle{ ID::Player_Miss,				"./Data/Sounds/SE/Player/Miss.wav",					false	},
-			Bundle{ ID::Player_ShiftGun,			"./Data/Sounds/SE/Player/ShiftGun.ogg",				false	},
-			
-			Bundle{ ID::RecoverHP,					"./Data/Sounds/SE/Effect/RecoverHP.wav",			false	},
-			
-			Bundle{ ID::Skull_Landing,				"./Data/Sounds/SE/Boss/Skull_Landing.wav",			false	},
-			Bundle{ ID::Skull_Jump,					"./Data/Sounds/SE/Boss/Skull_Jump.wav",				false	},
-			Bundle{ ID::Skull_Roar,					"./Data/Sounds/SE/Boss/Skull_Roar.wav",				false	},
-			
-			Bundle{ ID::SuperBallMachine_Shot,		"./Data/Sounds/SE/Enemy/SBM_Shot.wav",				false	},
-			
-			Bundle{ ID::UI_Choose,					"./Data/Sounds/SE/UI/Choose.ogg",					false	},
-			Bundle{ ID::UI_Decide,					"./Data/Sounds/SE/UI/Decide.ogg",					false	},
-			
-			#if DEBUG_MODE
-			Bundle{ ID::DEBUG_Strong,				"./Data/Sounds/SE/UI/Decide.ogg",					false	},
-			Bundle{ ID::DEBUG_Weak,					"./Data/Sounds/SE/UI/Choose.ogg",					false	},
-			#endif // DEBUG_MODE
-		};
-
-		bool succeeded = true;
-		for ( size_t i = 0; i < ID::MUSIC_COUNT; ++i )
-		{
-			bool result = Donya::Sound::Load
-			(
-				bundles[i].id,
-				bundles[i].filePath,
-				bundles[i].isEnableLoop
-			);
-			if ( !result ) { succeeded = false; }
+			previous = { loadGraph.Add( GetSpritePath( attr ), Stage::Upload, Affinity::Worker, [attr]() { return MakeTextureCache( attr ); }, previous ) };
+			spriteTasks.emplace_back( previous.front() );
 		}
 
-		_ASSERT_EXPR( succeeded, L"Failed: Sounds load is failed." );
-
-		pResult->WriteResult( succeeded );
-
-		CoUninitialize();
-	};
+		const Handle meter = loadGraph.Add( "Meter", Stage::Other, Affinity::Worker, []() { return Meter::LoadResource(); }, previous );
+		spriteTasks.emplace_back( meter );
+	}
 
-#if LOAD_EFFECT_BY_ANOTHER_THREAD
-	thEffects.pThread	= std::make_unique<std::thread>( LoadingModels, &thEffects.result );
-#else
-	LoadingEffects( &thEffects.result );
-#endif // LOAD_EFFECT_BY_ANOTHER_THREAD
+	// It uses the immediate-context, so it must run at main thread
+	loadGraph.Add( "Sprite atlas", Stage::Upload, Affinity::MainThread, [this]() { return BuildSpriteAtlas(); }, spriteTasks );
 
-	thModels.pThread	= std::make_unique<std::thread>( LoadingModels,		&thModels.result  );
-	thSounds.pThread	= std::make_unique<std::thread>( LoadingSounds,		&thSounds.result  );
-	thSprites.pThread	= std::make_unique<std::thread>( LoadingSprites,	&thSprites.result );
+	// Effects
+	// The effect system uses the immediate-context, so these are marshalled to main thread
+	constexpr size_t effectKindCount = scast<size_t>( Effect::Kind::KindCount );
+	for ( size_t i = 0; i < effectKindCount; ++i )
+	{
+		const Effect::Kind kind = scast<Effect::Kind>( i );
+		loadGraph.Add( "Effect " + std::to_string( i ), Stage::Upload, Affinity::MainThread, [kind]() { return Effect::Admin::Get().LoadEffect( kind ); } );
+	}
 }
 void SceneLoad::Uninit()
 {
@@ -312,6 +346,9 @@ Scene::Result SceneLoad::Update( float elapsedTime )
 	elapsedTimer += elapsedTime;
 #endif // DEBUG_MODE
 
+	loadGraph.RunMainThreadJobs( mainThreadBudgetSecond );
+
+	loadPerformer.SetProgress( loadGraph.GetProgress().Ratio() );
 	loadPerformer.UpdateIfActive( elapsedTime );
 
 	if ( !Fader::Get().IsExist() && AllFinished() )
@@ -325,6 +362,12 @@ Scene::Result SceneLoad::Update( float elapsedTime )
 		}
 		else
 		{
+			for ( const auto &name : loadGraph.GetFailedNames() )
+			{
+				const std::string msg = "Failed: The loading task is failed: " + name + "\n";
+				Donya::OutputDebugStr( msg.c_str() );
+			}
+
 			const HWND hWnd = Donya::GetHWnd();
 			MessageBox
 			(
@@ -354,28 +397,53 @@ void SceneLoad::Draw( float elapsedTime )
 
 void SceneLoad::ReleaseAllThread()
 {
-	thEffects.JoinThenRelease();
-	thModels.JoinThenRelease();
-	thSounds.JoinThenRelease();
-	thSprites.JoinThenRelease();
+	loadGraph.Join();
 }
 
 bool SceneLoad::AllFinished() const
 {
-	if ( !thEffects	.result.Finished() ) { return false; }
-	if ( !thModels	.result.Finished() ) { return false; }
-	if ( !thSounds	.result.Finished() ) { return false; }
-	if ( !thSprites	.result.Finished() ) { return false; }
-
-	return true;
+	return loadGraph.Finished();
 }
 bool SceneLoad::AllSucceeded() const
 {
-	if ( !thEffects	.result.Succeeded() ) { return false; }
-	if ( !thModels	.result.Succeeded() ) { return false; }
-	if ( !thSounds	.result.Succeeded() ) { return false; }
-	if ( !thSprites	.result.Succeeded() ) { return false; }
+	return loadGraph.Succeeded();
+}
+bool SceneLoad::BuildSpriteAtlas()
+{
+	PROFILE_SCOPE( "SceneLoad::BuildSpriteAtlas" );
 
+	// The UI sprites are drawn in a same frame, so packing them reduces the switching of the sprite batch.
+	// The pause menu and the result UI are drawn by the font, so the font textures are also packed.
+	// It uses the immediate-context, so I should do it at main thread.
+	using Attr = SpriteAttribute;
+	constexpr std::array<Attr, 3> packTargets
+	{
+		Attr::TitleLogo,
+		Attr::InputButtons,
+		Attr::Meter,
+	};
+
+	std::vector<size_t> identifiers{};
+	for ( const auto &attr : packTargets )
+	{
+		// It returns the cached identifier because these are already loaded
+		const size_t id = Donya::Sprite::Load( GetSpritePath( attr ), GetSpriteInstanceCount( attr ) );
+		if ( id != NULL )
+		{
+			identifiers.emplace_back( id );
+		}
+	}
+
+	// The font is loaded at the initialization of the framework
+	const auto pFontRenderer = FontHelper::GetRendererOrNullptr( FontAttribute::Main );
+	if ( pFontRenderer )
+	{
+		const auto fontHandles = pFontRenderer->GetTextureHandles();
+		identifiers.insert( identifiers.end(), fontHandles.begin(), fontHandles.end() );
+	}
+
+	// The failure is not fatal, the sprites are drawn by their own texture
+	Donya::Sprite::BuildAtlas( identifiers );
 	return true;
 }
 
@@ -427,15 +495,8 @@ void SceneLoad::UseImGui()
 
 			sceneParam.ShowImGuiNode( u8"p[^" );
 
-			auto GetBoolStr = []( bool v )->std::string
-			{
-				return ( v ) ? "True" : "False";
-			};
-
-			ImGui::Text( u8"ItOEGtFNg[%s]",	GetBoolStr( thEffects	.result.Finished() ).c_str() );
-			ImGui::Text( u8"ItOEf[%s]",		GetBoolStr( thModels	.result.Finished() ).c_str() );
-			ImGui::Text( u8"ItOEXvCg[%s]",	GetBoolStr( thSounds	.result.Finished() ).c_str() );
-			ImGui::Text( u8"ItOETEh[%s]",	GetBoolStr( thSprites	.result.Finished() ).c_str() );
+			ShowStatisticsNode( u8"ǂݍ݂̓v" );
+			ShowBenchmarkNode( u8"ǂݍ݂̌v" );
 			
 			ImGui::Text( u8"oߎԁF[%6.3f]", elapsedTimer );
 
@@ -445,4 +506,135 @@ void SceneLoad::UseImGui()
 		ImGui::End();
 	}
 }
+void SceneLoad::ShowStatisticsNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	const auto progress		= loadGraph.GetProgress();
+	const auto statistics	= loadGraph.GetStatistics();
+
+	ImGui::Text( u8"iF%d/%d", scast<int>( progress.finishedCount ), scast<int>( progress.wholeCount ) );
+	ImGui::Text( u8"[J[F%d", scast<int>( statistics.workerCount ) );
+	ImGui::Text( u8"sF%d", scast<int>( statistics.failedCount ) );
+	ImGui::Text( u8"oߎԁF%6.2f ms", statistics.wallSeconds * 1000.0f );
+	ImGui::Text( u8"xF%5.2f", statistics.CalcParallelism() );
+
+	constexpr std::array<const char *, TaskGraph::stageCount> stageNames
+	{
+		u8"ǂݍ",
+		u8"fR[h",
+		u8"Abv[h",
+		u8"̑",
+	};
+	for ( size_t i = 0; i < TaskGraph::stageCount; ++i )
+	{
+		ImGui::Text
+		(
+			u8"%sF%3d, v %6.2f ms",
+			stageNames[i],
+			scast<int>( statistics.stageCounts[i] ),
+			statistics.stageSeconds[i] * 1000.0f
+		);
+	}
+
+	const auto failedNames = loadGraph.GetFailedNames();
+	if ( !failedNames.empty() && ImGui::TreeNode( u8"s^XN" ) )
+	{
+		for ( const auto &it : failedNames )
+		{
+			ImGui::Text( "%s", it.c_str() );
+		}
+
+		ImGui::TreePop();
+	}
+
+	ImGui::TreePop();
+}
+namespace
+{
+	struct BenchmarkResult
+	{
+		unsigned int	workerCount		= 0;
+		float			wallMS			= 0.0f;
+		float			readMS			= 0.0f;	// Sum of all tasks
+		float			decodeMS		= 0.0f;	// Sum of all tasks
+		bool			succeeded		= false;
+	};
+	static std::vector<BenchmarkResult> benchmarkResults{};
+
+	/// <summary>
+	/// Measures the CPU-side stages(read and decode) of the models by a temporary graph. It does not store the models.
+	/// </summary>
+	BenchmarkResult MeasureCPUStages( const std::vector<std::string> &paths, unsigned int workerCount )
+	{
+		using Stage		= TaskGraph::Stage;
+		using Affinity	= TaskGraph::Affinity;
+
+		TaskGraph graph;
+		for ( const auto &path : paths )
+		{
+			// Bypass the cache, because the loaded models are cached and it measures only the lookups
+			auto pLoad = std::make_shared<ModelHelper::StagedSkinningLoad>( path, nullptr, /* useCache = */ false );
+			const auto read = graph.Add( "Read: " + path, Stage::Read, Affinity::Worker, [pLoad]() { return pLoad->Read(); } );
+			graph.Add( "Decode: " + path, Stage::Decode, Affinity::Worker, [pLoad]() { return pLoad->Decode(); }, { read } );
+		}
+
+		graph.Start( workerCount, BeginWorker, EndWorker );
+		graph.RunUntilFinished();
+		graph.Join();
+
+		const auto statistics = graph.GetStatistics();
+
+		BenchmarkResult result{};
+		result.workerCount	= statistics.workerCount;
+		result.wallMS		= statistics.wallSeconds * 1000.0f;
+		result.readMS		= statistics.stageSeconds[scast<size_t>( Stage::Read	)] * 1000.0f;
+		result.decodeMS		= statistics.stageSeconds[scast<size_t>( Stage::Decode	)] * 1000.0f;
+		result.succeeded	= graph.Succeeded();
+		return result;
+	}
+}
+void SceneLoad::ShowBenchmarkNode( const std::string &nodeCaption )
+{
+	if ( !ImGui::TreeNode( nodeCaption.c_str() ) ) { return; }
+	// else
+
+	ImGui::TextDisabled( u8"f̓ǂݍ݂ƃfR[hA[J[ςČv܂" );
+	ImGui::Text( u8"Ώۂ̃fF%d", scast<int>( modelPaths.size() ) );
+
+	// Measuring while the loading is running is not fair
+	if ( !loadGraph.Finished() )
+	{
+		ImGui::TextDisabled( u8"[hI܂Ōvł܂" );
+	}
+	else if ( ImGui::Button( u8"v" ) )
+	{
+		benchmarkResults.clear();
+		benchmarkResults.emplace_back( MeasureCPUStages( modelPaths, 1U ) );
+
+		const unsigned int recommended = TaskGraph::RecommendWorkerCount();
+		if ( 1U < recommended )
+		{
+			benchmarkResults.emplace_back( MeasureCPUStages( modelPaths, recommended ) );
+		}
+	}
+
+	for ( const auto &it : benchmarkResults )
+	{
+		ImGui::Text
+		(
+			u8"[J[%2dFS %7.2f msiǂݍݍv %7.2f ms, fR[hv %7.2f msj%s",
+			scast<int>( it.workerCount ),
+			it.wallMS, it.readMS, it.decodeMS,
+			( it.succeeded ) ? "" : u8"[s]"
+		);
+	}
+	if ( 2 <= benchmarkResults.size() && !IsZero( benchmarkResults.back().wallMS ) )
+	{
+		ImGui::Text( u8"xF%5.2f {", benchmarkResults.front().wallMS / benchmarkResults.back().wallMS );
+	}
+
+	ImGui::TreePop();
+}
 #endif // USE_IMGUI
@@ -1,25 +1,26 @@
 #pragma once
 
 #include <memory>
-#include <mutex>
-#include <thread>
+#include <string>
+#include <vector>
 
 #include "Donya/UseImGui.h"
 
 #include "Performances/LoadPart.h"
 #include "Scene.h"
-#include "Thread.h"
+#include "TaskGraph.h"
 
 class SceneLoad : public Scene
 {
 private:
-	Thread thEffects;
-	Thread thModels;
-	Thread thSounds;
-	Thread thSprites;
+	TaskGraph loadGraph;
 
 	Performer::LoadPart loadPerformer;
 
+#if USE_IMGUI
+	std::vector<std::string> modelPaths; // For the benchmark
+#endif // USE_IMGUI
+
 #if DEBUG_MODE
 	float elapsedTimer	= 0;
 #endif // DEBUG_MODE
@@ -41,6 +42,8 @@ private:
 private:
 	bool	AllFinished() const;
 	bool	AllSucceeded() const;
+	void	MakeLoadGraph();
+	bool	BuildSpriteAtlas();
 private:
 	void	ClearBackGround() const;
 	void	StartFade() const;
@@ -49,5 +52,7 @@ private:
 private:
 #if USE_IMGUI
 	void	UseImGui();
+	void	ShowStatisticsNode( const std::string &nodeCaption );
+	void	ShowBenchmarkNode( const std::string &nodeCaption );
 #endif // USE_IMGUI
 };
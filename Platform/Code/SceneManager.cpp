@@ -2,11 +2,14 @@
 
 #include <algorithm>
 
+#include "Donya/AssetRegistry.h"
 #include "Donya/Blend.h"	// Change the blend mode for fader object.
 #include "Donya/Sprite.h"	// For change the sprites depth.
 
+#include "AnimationLOD.h"
 #include "Fader.h"
 #include "Effect/EffectAdmin.h"
+#include "Effect/Particle.h"
 #include "SceneGame.h"
 #include "SceneLoad.h"
 #include "SceneLogo.h"
@@ -32,6 +35,7 @@ void SceneMng::Uninit()
 	}
 
 	pScenes.clear();
+	sceneTypes.clear();
 
 	Fader::Get().Init();
 }
@@ -45,6 +49,9 @@ void SceneMng::Update( float elapsedTime )
 		PushScene( Scene::Type::Title, true );
 	}
 
+	// The counts of the motion evaluation are per frame, and any scene can evaluate the motions.
+	AnimationLOD::ResetStatistics();
+
 	Scene::Result message{};
 
 	int updateCount = 1;
@@ -57,6 +64,7 @@ void SceneMng::Update( float elapsedTime )
 	}
 
 	Effect::Admin::Get().Update( elapsedTime );
+	Effect::Particle::Admin::Get().Update( elapsedTime );
 
 	Fader::Get().Update( elapsedTime );
 }
@@ -80,6 +88,11 @@ void SceneMng::Draw( float elapsedTime )
 	Fader::Get().Draw();
 }
 
+Scene::Type SceneMng::GetFrontSceneType() const
+{
+	return ( sceneTypes.empty() ) ? Scene::Type::Null : sceneTypes.front();
+}
+
 bool SceneMng::WillEmptyIfApplied( Scene::Result message ) const
 {
 	if ( message.request == Scene::Request::NONE ) { return false; }
@@ -147,6 +160,12 @@ void SceneMng::ProcessMessage( Scene::Result message, int &refUpdateCount, int &
 		PopAll();
 	}
 
+	if ( message.HasRequest( Scene::Request::REMOVE_ME ) || message.HasRequest( Scene::Request::REMOVE_ALL ) )
+	{
+		// The assets that only the removed scenes used have become evictable
+		Donya::Asset::Trim();
+	}
+
 	if ( message.HasRequest( Scene::Request::ADD_SCENE ) )
 	{
 		PushScene( message.sceneType, /* toFront = */ true );
@@ -177,12 +196,12 @@ void SceneMng::PushScene( Scene::Type type, bool toFront )
 {
 	switch ( type )
 	{
-	case Scene::Type::Logo:		PushSceneImpl<SceneLogo>  ( toFront ); return;
-	case Scene::Type::Load:		PushSceneImpl<SceneLoad>  ( toFront ); return;
-	case Scene::Type::Title:	PushSceneImpl<SceneTitle> ( toFront ); return;
-	case Scene::Type::Game:		PushSceneImpl<SceneGame>  ( toFront ); return;
-	case Scene::Type::Over:		PushSceneImpl<SceneOver>  ( toFront ); return;
-	case Scene::Type::Result:	PushSceneImpl<SceneResult>( toFront ); return;
+	case Scene::Type::Logo:		PushSceneImpl<SceneLogo>  ( type, toFront ); return;
+	case Scene::Type::Load:		PushSceneImpl<SceneLoad>  ( type, toFront ); return;
+	case Scene::Type::Title:	PushSceneImpl<SceneTitle> ( type, toFront ); return;
+	case Scene::Type::Game:		PushSceneImpl<SceneGame>  ( type, toFront ); return;
+	case Scene::Type::Over:		PushSceneImpl<SceneOver>  ( type, toFront ); return;
+	case Scene::Type::Result:	PushSceneImpl<SceneResult>( type, toFront ); return;
 	default: _ASSERT_EXPR( 0, L"Error: The scene does not exist."   ); return;
 	}
 }
@@ -193,11 +212,13 @@ void SceneMng::PopScene( bool fromFront )
 	{
 		pScenes.front()->Uninit();
 		pScenes.pop_front();
+		sceneTypes.pop_front();
 	}
 	else
 	{
 		pScenes.back()->Uninit();
 		pScenes.pop_back();
+		sceneTypes.pop_back();
 	}
 }
 
@@ -208,4 +229,5 @@ void SceneMng::PopAll()
 		it->Uninit();
 	}
 	pScenes.clear();
+	sceneTypes.clear();
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ class SceneMng
 {
 private:
 	std::list<std::unique_ptr<Scene>> pScenes;
+	std::list<Scene::Type> sceneTypes; // Same order as the "pScenes"
 public:
 	SceneMng()  = default;
 	~SceneMng() = default;
@@ -27,6 +28,11 @@ public:
 	void Update( float elapsedTime );
 
 	void Draw( float elapsedTime );
+public:
+	/// <summary>
+	/// Returns the type of the front scene, or Scene::Type::Null if the scene is empty.
+	/// </summary>
+	Scene::Type GetFrontSceneType() const;
 private:
 	bool WillEmptyIfApplied( Scene::Result message ) const;
 	/// <summary>
@@ -38,16 +44,18 @@ private:
 	void ProcessMessage( Scene::Result message, int &refUpdateCount, int &refLoopIndex );
 
 	template<class SceneName>
-	void PushSceneImpl( bool toFront )
+	void PushSceneImpl( Scene::Type type, bool toFront )
 	{
 		if ( toFront )
 		{
 			pScenes.push_front( std::make_unique<SceneName>() );
+			sceneTypes.push_front( type );
 			pScenes.front()->Init();
 		}
 		else
 		{
 			pScenes.push_back ( std::make_unique<SceneName>() );
+			sceneTypes.push_back ( type );
 			pScenes.back()->Init();
 		}
 	}
@@ -25,6 +25,8 @@
 #include "Parameter.h"
 #include "Player.h"
 #include "PlayerParam.h"
+#include "StageNumber.h"
+#include "StagePrefetch.h"
 
 namespace
 {
@@ -83,6 +85,9 @@ void SceneOver::Init()
 	Effect::Admin::Get().ClearInstances();
 
 	Donya::Sound::Play( Music::BGM_Over );
+
+	// The title scene is next
+	StagePrefetch::Request( Definition::StageNumber::Title() );
 }
 void SceneOver::Uninit()
 {
@@ -11,6 +11,7 @@
 #include "Donya/Color.h"			// Use ClearBackGround(), StartFade().
 #include "Donya/Constant.h"
 #include "Donya/Keyboard.h"			// Make an input of player.
+#include "Donya/Profiler.h"
 #include "Donya/Serializer.h"
 #include "Donya/Sound.h"
 #include "Donya/Sprite.h"
@@ -22,8 +23,10 @@
 #include "Donya/Random.h"
 #endif // DEBUG_MODE
 
+#include "CollisionPass.h"
 #include "Common.h"
 #include "Effect/EffectAdmin.h"
+#include "Effect/Particle.h"
 #include "Enemies/SuperBallMachine.h"
 #include "Fader.h"
 #include "FilePath.h"
@@ -32,6 +35,7 @@
 #include "Parameter.h"
 #include "PointLightStorage.h"
 #include "StageNumber.h"
+#include "StagePrefetch.h"
 
 #if DEBUG_MODE
 #include "CSVLoader.h"
@@ -343,6 +347,10 @@ CEREAL_CLASS_VERSION( SceneParam::ShiftInput,	0 )
 
 void SceneResult::Init()
 {
+	using Layer = CollisionWorld::Layer;
+	collisionWorld.SetPairFilter( Layer::PlayerBullet, Layer::EnemyBullet,	true );
+	collisionWorld.SetPairFilter( Layer::PlayerBullet, Layer::EnemyHurtBox,	true );
+
 	Donya::Sound::Play( Music::BGM_Result );
 #if DEBUG_MODE
 	// Donya::Sound::AppendFadePoint( Music::BGM_Result, 0.0f, 0.0f, true );
@@ -402,10 +410,15 @@ void SceneResult::Init()
 	effectAdmin.SetLightColorDiffuse( { 1.0f, 1.0f, 1.0f, 1.0f } );
 	effectAdmin.SetLightDirection	( data.directionalLight.direction.XYZ() );
 	effectAdmin.ClearInstances();
+
+	// The title scene is next. Read its files while the result is showing.
+	StagePrefetch::Request( Definition::StageNumber::Title() );
 }
 void SceneResult::Uninit()
 {
+	StagePrefetch::Release( Definition::StageNumber::Result() );
 	Effect::Admin::Get().ClearInstances();
+	Effect::Particle::Admin::Get().ClearInstances();
 	Donya::Sound::Stop( Music::BGM_Result );
 }
 
@@ -508,6 +521,8 @@ Scene::Result SceneResult::Update( float elapsedTime )
 	currentScreen = CalcCurrentScreenPlane();
 	CameraUpdate();
 
+	// Each pass regenerates the contacts, because the previous pass may change the objects
+	collisionWorld.BeginFrame();
 	Collision_BulletVSBullet();
 	Collision_BulletVSEnemy();
 
@@ -535,6 +550,8 @@ void SceneResult::Draw( float elapsedTime )
 	if ( !AreRenderersReady() ) { return; }
 	// else
 
+	pRenderer->ClearModelQueueStatistics();
+
 	auto UpdateSceneConstant	= [&]( const Donya::Model::Constants::PerScene::DirectionalLight &directionalLight, const Donya::Vector4 &eyePos, const Donya::Vector4x4 &viewMatrix, const Donya::Vector4x4 &viewProjectionMatrix )
 	{
 		Donya::Model::Constants::PerScene::Common constant{};
@@ -554,6 +571,11 @@ void SceneResult::Draw( float elapsedTime )
 
 		// The drawing priority is determined by the priority of the information.
 
+		// The bullets are drawn without the depth test, so I keep their submitted order.
+		// The continuous bullets of the same model are still drawn by the instancing.
+		const bool keepOrder = ( option == Kind::Bullet );
+		pRenderer->BeginModelQueue( keepOrder );
+
 		( castShadow )
 		? pRenderer->ActivateShaderShadowStatic()
 		: pRenderer->ActivateShaderNormalStatic();
@@ -574,6 +596,8 @@ void SceneResult::Draw( float elapsedTime )
 		( castShadow )
 		? pRenderer->DeactivateShaderShadowSkinning()
 		: pRenderer->DeactivateShaderNormalSkinning();
+
+		pRenderer->EndModelQueue();
 	};
 	
 	const Donya::Vector4   cameraPos = Donya::Vector4{ iCamera.GetPosition(), 1.0f };
@@ -652,6 +676,9 @@ void SceneResult::Draw( float elapsedTime )
 		DrawObjects( DrawTarget::Bullet, /* castShadow = */ false );
 		Donya::DepthStencil::Activate( Donya::DepthStencil::Defined::Write_PassLess );
 
+		// The bullets emit the particles in this scene also
+		Effect::Particle::Admin::Get().Draw( pRenderer.get(), VP, data.directionalLight.direction.XYZ() );
+
 		pRenderer->DeactivateShadowMap( *pShadowMap );
 		pRenderer->DeactivateSamplerShadow();
 		pRenderer->DeactivateConstantShadow();
@@ -727,10 +754,12 @@ void SceneResult::Draw( float elapsedTime )
 #if DEBUG_MODE
 	if ( Common::IsShowCollision() )
 	{
+		pRenderer->BeginDebugBatch();
 		if ( pPlayer	) { pPlayer->DrawHitBox( pRenderer.get(), VP );					}
 		if ( pMap		) { pMap->DrawHitBoxes( currentScreen, pRenderer.get(), VP );	}
 		Bullet::Admin::Get().DrawHitBoxes( pRenderer.get(), VP );
 		for ( const auto &pIt : enemies ) { if ( pIt ) { pIt->DrawHitBox( pRenderer.get(), VP ); } }
+		pRenderer->EndDebugBatch();
 	}
 #endif // DEBUG_MODE
 
@@ -745,7 +774,7 @@ void SceneResult::Draw( float elapsedTime )
 
 		pFontRenderer->Draw
 		(
-			L"YOU GOT A NEW WEAPON!",
+			newWeaponText,
 			center + Donya::Vector2{ 0.0f, -320.0f },
 			pivot
 		);
@@ -1304,335 +1333,58 @@ namespace
 	{
 		return ( pPlayer ) ? pPlayer->GetHurtBox().id : Donya::Collision::invalidID;
 	}
-	bool IsPlayerBullet( const Donya::Collision::IDType playerCollisionID, const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		if ( playerCollisionID == Donya::Collision::invalidID ) { return false; }
-		// else
-
-		const auto bulletAABB	= pBullet->GetHitBox();
-		const auto bulletSphere	= pBullet->GetHitSphere();
-		const auto activeOwnerID= ( bulletSphere.exist ) ? bulletSphere.ownerID : bulletAABB.ownerID;
-		return ( activeOwnerID == playerCollisionID ) ? true : false;
-	}
-	bool IsEnemyBullet( const Donya::Collision::IDType playerCollisionID, const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		return !IsPlayerBullet( playerCollisionID, pBullet );
-	}
-
-	enum class SubtractorState
-	{
-		Not,
-		HasBox,
-		HasSphere
-	};
-	SubtractorState HasSubtractor( const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		using State = SubtractorState;
-
-		if ( !pBullet ) { return State::Not; }
-		// else
+}
+void SceneResult::Collision_GenerateContacts( CollisionWorld::LayerMask layers )
+{
+	PROFILE_SCOPE( "SceneResult::Collision_GenerateContacts" );
 
-		if ( pBullet->GetHitBoxSubtractor().exist ) { return State::HasBox; }
-		// else
+	using Layer		= CollisionWorld::Layer;
+	using Volume	= CollisionWorld::Volume;
 
-		if ( pBullet->GetHitSphereSubtractor().exist ) { return State::HasSphere; }
-		// else
+	collisionWorld.Clear();
 
-		return State::Not;
-	}
+	// The bullets must be registered before the enemies,
+	// because the CollisionPass::BulletVSEnemy() expects the contacts are ordered by the bullet.
+	CollisionPass::RegisterBullets( &collisionWorld, ExtractPlayerID( pPlayer ), layers );
 
-	template<typename ObjectHitBox, typename BulletHitBox>
-	bool IsHit( const ObjectHitBox &objHitBox, const std::shared_ptr<const Bullet::Base> &pBullet, const BulletHitBox &bulletHitBox, bool considerExistFlag = true )
+	if ( layers & CollisionWorld::ToMask( Layer::EnemyHurtBox ) )
 	{
-		namespace Col = Donya::Collision;
-
-		const SubtractorState hasSubtract = HasSubtractor( pBullet );
-
-		// Do not use subtraction version
-		if ( hasSubtract == SubtractorState::Not )
-		{
-			return Col::IsHit( objHitBox, bulletHitBox, considerExistFlag );
-		}
-		// else
-
-		// Can not use subtraction version
-		if ( !pBullet )
-		{
-			return Col::IsHit( objHitBox, bulletHitBox, considerExistFlag );
-		}
-		// else
-
-		auto IsHitImpl = [&]( const auto &hitBoxSubtractor )
+		const size_t enemyCount = enemies.size();
+		for ( size_t i = 0; i < enemyCount; ++i )
 		{
-			const Col::Solid<BulletHitBox, decltype( hitBoxSubtractor )> a
-			{
-				bulletHitBox,
-				hitBoxSubtractor
-			};
-			return Col::IsHitVSSubtracted( objHitBox, a, considerExistFlag );
-		};
+			const auto &pEnemy = enemies[i];
+			if ( !pEnemy ) { continue; }
+			// else
 
-		if ( hasSubtract == SubtractorState::HasBox )
-		{
-			return IsHitImpl( pBullet->GetHitBoxSubtractor() );
-		}
-		// else
-		if ( hasSubtract == SubtractorState::HasSphere )
-		{
-			return IsHitImpl( pBullet->GetHitSphereSubtractor() );
+			collisionWorld.Register( Volume::Make( Layer::EnemyHurtBox, i, pEnemy->GetHurtBox() ) );
 		}
-		// else
-
-		_ASSERT_EXPR( 0, L"Error: Unexpected condition!" );
-		return false;
 	}
-	template<typename HitBoxA, typename HitBoxB>
-	bool IsHit( const std::shared_ptr<const Bullet::Base> &pBulletA, const HitBoxA &hitBoxA, const std::shared_ptr<const Bullet::Base> &pBulletB, const HitBoxB &hitBoxB, bool considerExistFlag = true )
-	{
-		if ( !pBulletA || !pBulletB ) { return false; }
-		// else
-
-		namespace Col = Donya::Collision;
-
-		const SubtractorState subA = HasSubtractor( pBulletA );
-		const SubtractorState subB = HasSubtractor( pBulletB );
-
-		// Do not use subtraction version
-		if ( subA == SubtractorState::Not && subB == SubtractorState::Not )
-		{
-			return Col::IsHit( hitBoxA, hitBoxB );
-		}
-		// else
-		
-		// Do not support yet
-		if ( subA != SubtractorState::Not && subB != SubtractorState::Not )
-		{
-			return Col::IsHit( hitBoxA, hitBoxB );
-		}
-		// else
 
-		if ( subA != SubtractorState::Not )
-		{
-			return IsHit( hitBoxB, pBulletA, hitBoxA, considerExistFlag );
-		}
-		// else
-		if ( subB != SubtractorState::Not )
-		{
-			return IsHit( hitBoxA, pBulletB, hitBoxB, considerExistFlag );
-		}
-		// else
-		_ASSERT_EXPR( 0, L"Error: Unexpected condition!" );
-		return false;
-	}
+	collisionWorld.GenerateContacts();
 }
 void SceneResult::Collision_BulletVSBullet()
 {
-	auto &bulletAdmin = Bullet::Admin::Get();
-	const size_t bulletCount = bulletAdmin.GetInstanceCount();
-
-	std::shared_ptr<const Bullet::Base> pA = nullptr;
-	std::shared_ptr<const Bullet::Base> pB = nullptr;
-	auto Protectible	= []( const std::shared_ptr<const Bullet::Base> &pBullet )
-	{
-		using D = Definition::Damage;
-		return ( pBullet ) ? D::Contain( D::Type::Protection, pBullet->GetDamage().type ) : false;
-	};
-	auto HitProcess		= [&]( const auto &hitBoxA, const auto &hitBoxB )
-	{
-		if ( !pA || !pB ) { return; }
-		// else
+	PROFILE_SCOPE( "SceneResult::Collision_BulletVSBullet" );
 
-		const bool protectibleA = Protectible( pA );
-		const bool protectibleB = Protectible( pB );
-		if ( protectibleA ) { pB->ProtectedBy( hitBoxA ); }
-		if ( protectibleB ) { pA->ProtectedBy( hitBoxB ); }
-		if ( protectibleA || protectibleB ) { return; }
-		// else
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerBullet ) | CollisionWorld::ToMask( Layer::EnemyBullet ) );
 
-		const bool destructibleA = pA->Destructible();
-		const bool destructibleB = pB->Destructible();
-		pA->CollidedToObject( destructibleB );
-		pB->CollidedToObject( destructibleA );
-	};
-	
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pA = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pA ) { continue; }
-
-		// Disallow collision between a protected bullet.
-		// Because if allowed hitting to multiple objects in the same timing,
-		// the protection attribute does not affect to some another object that collided in the same timing.
-		// That bullet's collision will be disabled at next update, but I wanna apply immediately.
-		if ( pA->WasProtected() ) { continue; }
-		// else
-
-		const auto aabbA		= pA->GetHitBox();
-		const auto sphereA		= pA->GetHitSphere();
-
-		const bool ownerA		= IsPlayerBullet( playerID, pA );
-		const bool protectibleA	= Protectible( pA );
-
-		for ( size_t j = i + 1; j < bulletCount; ++j )
-		{
-			pB = bulletAdmin.GetInstanceOrNullptr( j );
-			if ( !pB ) { continue; }
-			// else
-			if ( pB->WasProtected() ) { continue; }
-			// else
-
-			const bool ownerB		= IsPlayerBullet( playerID, pB );
-			const bool protectibleB	= Protectible( pB );
-			if ( ownerA == ownerB ) { continue; }
-			// else
-
-			// Do collide if either one of bullet is destructible or protectible
-			const bool wantCollide	=  pA->Destructible()	|| pB->Destructible()
-									|| protectibleA			|| protectibleB;
-			if ( !wantCollide ) { continue; }
-			// else
-			
-			const auto aabbB	= pB->GetHitBox();
-			const auto sphereB	= pB->GetHitSphere();
-
-			if ( aabbA.exist )
-			{
-				if ( IsHit( pA, aabbA, pB, aabbB ) )
-				{
-					HitProcess( aabbA, aabbB );
-					continue;
-				}
-				// else
-				if ( IsHit( pA, aabbA, pB, sphereB ) )
-				{
-					HitProcess( aabbA, sphereB );
-					continue;
-				}
-			}
-			else
-			if ( sphereA.exist )
-			{
-				if ( IsHit( pA, sphereA, pB, aabbB ) )
-				{
-					HitProcess( sphereA, aabbB );
-					continue;
-				}
-				// else
-				if ( IsHit( pA, sphereA, pB, sphereB ) )
-				{
-					HitProcess( sphereA, sphereB );
-					continue;
-				}
-			}
-		}
-	}
+	CollisionPass::BulletVSBullet( collisionWorld );
 }
 void SceneResult::Collision_BulletVSEnemy()
 {
-	auto &enemyAdmin	= Enemy::Admin::Get();
-	auto &bulletAdmin	= Bullet::Admin::Get();
-	const size_t enemyCount		= enemies.size();
-	const size_t bulletCount	= bulletAdmin.GetInstanceCount();
-
-	// Makes every call the "FindCollidingEnemyOrNullptr" returns another enemy
-	std::vector<size_t> collidedEnemyIndices{};
-	auto IsAlreadyCollided				= [&]( size_t enemyIndex )
-	{
-		const auto result = std::find( collidedEnemyIndices.begin(), collidedEnemyIndices.end(), enemyIndex );
-		return ( result != collidedEnemyIndices.end() );
-	};
-	auto FindCollidingEnemyOrNegative	= [&]( const std::shared_ptr<const Bullet::Base> &pOtherBullet, const auto &otherHitBox )
-	{
-		for ( size_t i = 0; i < enemyCount; ++i )
-		{
-			if ( IsAlreadyCollided( i ) ) { continue; }
-			// else
-
-			auto &pIt = enemies[i];
-			if ( !pIt ) { continue; }
-			// else
+	PROFILE_SCOPE( "SceneResult::Collision_BulletVSEnemy" );
 
-			if ( IsHit( pIt->GetHurtBox(), pOtherBullet, otherHitBox ) )
-			{
-				collidedEnemyIndices.emplace_back( i );
-				return scast<int>( i );
-			}
-		}
+	using Layer = CollisionWorld::Layer;
+	Collision_GenerateContacts( CollisionWorld::ToMask( Layer::PlayerBullet ) | CollisionWorld::ToMask( Layer::EnemyHurtBox ) );
 
-		return -1;
-	};
-
-	// The bullet's hit box is only either AABB or Sphere is valid
-	// (Invalid one's exist flag will false, so IsHit() will returns false)
-	Donya::Collision::Box3F		otherAABB;
-	Donya::Collision::Sphere3F	otherSphere;
-
-	std::shared_ptr<const Bullet::Base> pBullet = nullptr;
-
-	struct ProccessResult
-	{
-		bool collided	= false;
-		bool pierced	= false;
-	};
-	auto Process = [&]( const auto &bulletBody )
+	auto FetchEnemy = [&]( size_t userIndex ) -> const Enemy::Base *
 	{
-		ProccessResult result{};
-		result.collided = false;
-		result.pierced  = false;
-
-		if ( !pBullet ) { return result; }
-		// else
-
-		result.pierced = true;
-
-		int enemyIndex = FindCollidingEnemyOrNegative( pBullet, bulletBody );
-		while ( 0 <= enemyIndex )
-		{
-			result.collided = true;
-			auto &pEnemy = enemies[enemyIndex];
-
-			pEnemy->GiveDamage( pBullet->GetDamage() );
-			if ( !pEnemy->WillDie() )
-			{
-				result.pierced = false;
-			}
-
-			enemyIndex = FindCollidingEnemyOrNegative( pBullet, bulletBody );
-		}
-
-		return result;
+		return ( userIndex < enemies.size() ) ? enemies[userIndex].get() : nullptr;
 	};
 
-	const auto playerID = ExtractPlayerID( pPlayer );
-
-	for ( size_t i = 0; i < bulletCount; ++i )
-	{
-		pBullet = bulletAdmin.GetInstanceOrNullptr( i );
-		if ( !pBullet ) { continue; }
-		// else
-		if ( pBullet->WasProtected() ) { continue; }
-		// else
-
-		if ( IsEnemyBullet( playerID, pBullet ) ) { continue; }
-		// else
-
-		otherAABB	= pBullet->GetHitBox();
-		otherSphere	= pBullet->GetHitSphere();
-		if ( !otherAABB.exist && !otherSphere.exist ) { continue; }
-		// else
-
-		const auto result	= ( otherAABB.exist )
-							? Process( otherAABB	)
-							: Process( otherSphere	);
-		if ( result.collided )
-		{
-			pBullet->CollidedToObject( result.pierced );
-		}
-
-		collidedEnemyIndices.clear();
-	}
+	// The result scene does not drop any item
+	CollisionPass::BulletVSEnemy( collisionWorld, FetchEnemy, nullptr );
 }
 
 void SceneResult::ClearBackGround() const
@@ -1915,6 +1667,9 @@ void SceneResult::UseImGui()
 
 		Effect::Admin::Get().ShowImGuiNode( u8"GtFNg̃p[^" );
 		ImGui::Text( "" );
+
+		collisionWorld.ShowImGuiNode( u8"蔻̓v" );
+		ImGui::Text( "" );
 		
 		if ( pInputExplainer && ImGui::Button( u8"CvbgAs[" ) )
 		{
@@ -12,6 +12,7 @@
 #include "Donya/UseImGui.h"			// Use USE_IMGUI macro.
 
 #include "Bloom.h"
+#include "CollisionWorld.h"
 #include "Enemy.h"
 #include "Input.h"
 #include "Map.h"
@@ -43,6 +44,7 @@ private:
 	Donya::Collision::Box3F						currentScreen;	// It used for a bullet's lifespan
 	int											currentRoomID	= 0;
 	PlayerInitializer							playerIniter;
+	CollisionWorld								collisionWorld;
 
 	std::unique_ptr<RenderingHelper>			pRenderer;
 	std::unique_ptr<Donya::Displayer>			pDisplayer;
@@ -56,6 +58,7 @@ private:
 	std::unique_ptr<Meter::Drawer>				pMeter;
 
 	std::vector<std::unique_ptr<Enemy::Base>>	enemies;
+	Donya::Font::Layout							newWeaponText{ L"YOU GOT A NEW WEAPON!" };
 
 	float	currentTimer	= 0.0f;
 	float	previousTimer	= 0.0f;
@@ -104,6 +107,7 @@ private:
 	void	EnemyPhysicUpdate( float elapsedTime, const Map &terrain );
 	void	EnemyDraw( RenderingHelper *pRenderer );
 
+	void	Collision_GenerateContacts( CollisionWorld::LayerMask layers );
 	void	Collision_BulletVSBullet();
 	void	Collision_BulletVSEnemy();
 
@@ -10,6 +10,7 @@
 #include "Donya/Serializer.h"
 #include "Donya/Sound.h"
 #include "Donya/Sprite.h"
+#include "Donya/Tween.h"
 #include "Donya/Useful.h"
 #include "Donya/Vector.h"
 #if DEBUG_MODE
@@ -24,11 +25,13 @@
 #include "Common.h"
 #include "Enemy.h"
 #include "Effect/EffectAdmin.h"
+#include "Effect/Particle.h"
 #include "Fader.h"
 #include "FilePath.h"
 #include "FontHelper.h"
 #include "Input.h"
 #include "Item.h"
+#include "MapChunk.h"				// Use CalcProjectedArea()
 #include "Math.h"					// Use CalcBezierCurve()
 #include "ModelHelper.h"			// Use serialize methods
 #include "Music.h"
@@ -36,6 +39,7 @@
 #include "PlayerParam.h"			// Use for reset the remaining
 #include "PointLightStorage.h"
 #include "StageNumber.h"
+#include "StagePrefetch.h"
 
 #undef max
 #undef min
@@ -597,9 +601,17 @@ void SceneTitle::Init()
 	effectAdmin.SetLightDirection	( data.directionalLight.direction.XYZ() );
 
 	Donya::Sound::Play( Music::BGM_Title );
+
+	// The game scene is next. Read its files while the title is showing.
+	StagePrefetch::Request( Definition::StageNumber::Game() );
 }
 void SceneTitle::Uninit()
 {
+	Donya::Tween::Remove( cameraTween );
+	Donya::Tween::Remove( pressedItemFadeTween );
+
+	StagePrefetch::Release( Definition::StageNumber::Title() );
+
 	if ( pMap		) { pMap->Uninit();		}
 	if ( pHouse		) { pHouse->Uninit();	}
 	if ( pPlayer	) { pPlayer->Uninit();	}
@@ -611,6 +623,7 @@ void SceneTitle::Uninit()
 	Bullet::Admin::Get().ClearInstances();
 	Enemy::Admin::Get().ClearInstances();
 	Item::Admin::Get().ClearInstances();
+	Effect::Particle::Admin::Get().ClearInstances();
 
 	Donya::Sound::Stop( Music::BGM_Title );
 }
@@ -664,16 +677,10 @@ Scene::Result SceneTitle::Update( float elapsedTime )
 
 	UpdateInput();
 
-	if ( transCameraTime < 1.0f )
+	// The transCameraFactor is advanced by the tween
+	if ( beforeCameraStatus != currCameraStatus && !Donya::Tween::IsActive( cameraTween ) )
 	{
-		const float takeSecond = FetchCameraOrDefault( currCameraStatus ).lerpSecFromOther;
-		const float advance = 1.0f / takeSecond;
-		transCameraTime += advance * elapsedTime;
-		if ( 1.0f <= transCameraTime )
-		{
-			beforeCameraStatus = currCameraStatus;
-			transCameraTime = 1.0f;
-		}
+		beforeCameraStatus = currCameraStatus;
 	}
 	
 	UpdateChooseItem();
@@ -764,6 +771,8 @@ void SceneTitle::Draw( float elapsedTime )
 	if ( !AreRenderersReady() ) { return; }
 	// else
 
+	pRenderer->ClearModelQueueStatistics();
+
 	auto UpdateSceneConstant	= [&]( const Donya::Model::Constants::PerScene::DirectionalLight &directionalLight, const Donya::Vector4 &eyePos, const Donya::Vector4x4 &viewMatrix, const Donya::Vector4x4 &viewProjectionMatrix )
 	{
 		Donya::Model::Constants::PerScene::Common constant{};
@@ -773,6 +782,8 @@ void SceneTitle::Draw( float elapsedTime )
 		constant.viewProjMatrix		= viewProjectionMatrix;
 		pRenderer->UpdateConstant( constant );
 	};
+	// The light camera sees the objects out of the screen, so the shadow pass culls the map by its own area
+	const Donya::Collision::Box3F shadowCasterArea = CalcShadowCasterArea();
 	auto DrawObjects			= [&]( DrawTarget option, bool castShadow )
 	{
 		using Kind = DrawTarget;
@@ -783,11 +794,16 @@ void SceneTitle::Draw( float elapsedTime )
 
 		// The drawing priority is determined by the priority of the information.
 
+		// The bullets are drawn without the depth test, so I keep their submitted order.
+		// The continuous bullets of the same model are still drawn by the instancing.
+		const bool keepOrder = ( option == Kind::Bullet );
+		pRenderer->BeginModelQueue( keepOrder );
+
 		( castShadow )
 		? pRenderer->ActivateShaderShadowStatic()
 		: pRenderer->ActivateShaderNormalStatic();
 
-		if ( Drawable( Kind::Map ) && pMap ) { pMap->Draw( pRenderer.get() ); }
+		if ( Drawable( Kind::Map ) && pMap ) { pMap->Draw( ( castShadow ) ? shadowCasterArea : currentScreen, pRenderer.get() ); }
 
 		( castShadow )
 		? pRenderer->DeactivateShaderShadowStatic()
@@ -807,12 +823,14 @@ void SceneTitle::Draw( float elapsedTime )
 		( castShadow )
 		? pRenderer->DeactivateShaderShadowSkinning()
 		: pRenderer->DeactivateShaderNormalSkinning();
+
+		pRenderer->EndModelQueue();
 	};
 
 	Donya::Vector4   cameraPos{};
 	Donya::Vector4x4 V{};
 	Donya::Vector4x4 VP{};
-	if ( 1.0f <= transCameraTime ) // Lerp is not needed
+	if ( beforeCameraStatus == currCameraStatus ) // Lerp is not needed
 	{
 		const auto &camera = GetCurrentCamera( currCameraStatus );
 		cameraPos = Donya::Vector4{ camera.GetPosition(), 1.0f };
@@ -823,9 +841,8 @@ void SceneTitle::Draw( float elapsedTime )
 	{
 		const auto &old  = GetCurrentCamera( beforeCameraStatus		);
 		const auto &curr = GetCurrentCamera( currCameraStatus	);
-		const auto data  = FetchCameraOrDefault( currCameraStatus );
 
-		const float lerpFactor = Donya::Easing::Ease( data.easeKind, data.easeType, transCameraTime );
+		const float &lerpFactor = transCameraFactor;
 
 		// I prefer lerp-ed view matrix than slerp-ed view matrix
 		const auto oldV  = old.CalcViewMatrix();
@@ -937,6 +954,9 @@ void SceneTitle::Draw( float elapsedTime )
 		DrawObjects( DrawTarget::Bullet, /* castShadow = */ false );
 		Donya::DepthStencil::Activate( Donya::DepthStencil::Defined::Write_PassLess );
 
+		// The bullets emit the particles in this scene also
+		Effect::Particle::Admin::Get().Draw( pRenderer.get(), VP, data.directionalLight.direction.XYZ() );
+
 		pRenderer->DeactivateShadowMap( *pShadowMap );
 		pRenderer->DeactivateSamplerShadow();
 		pRenderer->DeactivateConstantShadow();
@@ -1052,12 +1072,7 @@ void SceneTitle::Draw( float elapsedTime )
 			Donya::Blend::Activate( Donya::Blend::Mode::ADD_NO_ATC );
 			if ( chooseItem == Choice::Start )
 			{
-				const float &fadeSec = data.pressedItemAddFadeSecond;
-				const float currFadeTime =
-					( IsZero( fadeSec ) )
-					? 1.0f
-					: Donya::Clamp( afterDecidedTimer / fadeSec, 0.0f, 1.0f );
-				const float easeFactor = Donya::Easing::Ease( data.pressedItemAddFadeEaseKind, data.pressedItemAddFadeEaseType, currFadeTime );
+				const float &easeFactor = pressedItemFadeFactor;
 				
 				const float additionScale = data.pressedItemAddDestScale * easeFactor + data.chooseItemMagni;
 
@@ -1116,6 +1131,7 @@ void SceneTitle::Draw( float elapsedTime )
 	// Object's hit/hurt boxes
 	if ( Common::IsShowCollision() )
 	{
+		pRenderer->BeginDebugBatch();
 		if ( pPlayer	) { pPlayer->DrawHitBox( pRenderer.get(), VP );					}
 		if ( pBoss		) { pBoss->DrawHitBox( pRenderer.get(), VP );					}
 		if ( pMap		) { pMap->DrawHitBoxes( currentScreen, pRenderer.get(), VP );	}
@@ -1123,6 +1139,7 @@ void SceneTitle::Draw( float elapsedTime )
 		Enemy ::Admin::Get().DrawHitBoxes( pRenderer.get(), VP );
 		Item  ::Admin::Get().DrawHitBoxes( pRenderer.get(), VP );
 		if ( pHouse		) { pHouse->DrawHitBoxes( pRenderer.get(), VP );				}
+		pRenderer->EndDebugBatch();
 	}
 #endif // DEBUG_MODE
 
@@ -1365,6 +1382,17 @@ void SceneTitle::UpdateChooseItem()
 	{
 		wasDecided = trgDecide;
 		Donya::Sound::Play( Music::UI_Decide );
+
+		const auto &data = FetchParameter();
+		Donya::Tweener::Description desc{};
+		desc.pTarget		= &pressedItemFadeFactor;
+		desc.from			= 0.0f;
+		desc.to				= 1.0f;
+		desc.durationSecond	= data.pressedItemAddFadeSecond;
+		desc.kind			= data.pressedItemAddFadeEaseKind;
+		desc.type			= data.pressedItemAddFadeEaseType;
+		Donya::Tween::Remove( pressedItemFadeTween );
+		pressedItemFadeTween = Donya::Tween::Add( desc );
 	}
 }
 
@@ -1440,7 +1468,17 @@ void SceneTitle::ChangeCameraState( CameraState next )
 {
 	beforeCameraStatus		= currCameraStatus;
 	currCameraStatus	= next;
-	transCameraTime	= 0.0f;
+
+	const auto data = FetchCameraOrDefault( next );
+	Donya::Tweener::Description desc{};
+	desc.pTarget		= &transCameraFactor;
+	desc.from			= 0.0f;
+	desc.to				= 1.0f;
+	desc.durationSecond	= data.lerpSecFromOther;
+	desc.kind			= data.easeKind;
+	desc.type			= data.easeType;
+	Donya::Tween::Remove( cameraTween );
+	cameraTween = Donya::Tween::Add( desc );
 }
 
 Donya::Vector4x4 SceneTitle::MakeScreenTransform() const
@@ -1713,6 +1751,10 @@ Donya::Vector4x4 SceneTitle::CalcLightViewMatrix() const
 {
 	return lightCamera.CalcViewMatrix();
 }
+Donya::Collision::Box3F SceneTitle::CalcShadowCasterArea() const
+{
+	return MapChunk::CalcProjectedArea( CalcLightViewMatrix() * lightCamera.GetProjectionMatrix() );
+}
 
 void SceneTitle::PlayerInit( const Map &terrain )
 {
@@ -1984,16 +2026,14 @@ void SceneTitle::UseImGui()
 		{
 			ImGui::SliderInt( u8"", &intCamStatus, 0, cameraStateCount - 1 );
 			intCamStatus = Donya::Clamp( intCamStatus, 0, cameraStateCount - 1 );
-			const auto prev = currCameraStatus;
-			currCameraStatus = scast<CameraState>( intCamStatus );
-			if ( currCameraStatus != prev )
+			const auto next = scast<CameraState>( intCamStatus );
+			if ( currCameraStatus != next )
 			{
-				beforeCameraStatus = prev;
-				transCameraTime = 0.0f;
+				ChangeCameraState( next );
 			}
 			ImGui::Text( GetCameraStateName( currCameraStatus ) );
 
-			ImGui::SliderFloat( u8"Jڎ", &transCameraTime, 0.0f, 1.0f );
+			ImGui::SliderFloat( u8"Jڂ̊", &transCameraFactor, 0.0f, 1.0f );
 			ImGui::Text( u8"OF" ); ImGui::SameLine();
 			ImGui::Text( GetCameraStateName( beforeCameraStatus ) );
 			ImGui::Text( u8"݁F" ); ImGui::SameLine();
@@ -2001,8 +2041,8 @@ void SceneTitle::UseImGui()
 
 			const auto &old  = GetCurrentCamera( beforeCameraStatus	);
 			const auto &curr = GetCurrentCamera( currCameraStatus	);
-			Donya::Vector3		lerpedPos = Donya::Lerp( old.GetPosition(), curr.GetPosition(), transCameraTime );
-			Donya::Quaternion	lerpedRot = Donya::Quaternion::Slerp( old.GetOrientation(), curr.GetOrientation(), transCameraTime );
+			Donya::Vector3		lerpedPos = Donya::Lerp( old.GetPosition(), curr.GetPosition(), transCameraFactor );
+			Donya::Quaternion	lerpedRot = Donya::Quaternion::Slerp( old.GetOrientation(), curr.GetOrientation(), transCameraFactor );
 			ImGui::DragFloat3( u8"ԒFW", &lerpedPos.x );
 			ImGui::DragFloat4( u8"ԒFp", &lerpedRot.x );
 
@@ -6,6 +6,7 @@
 #include "Donya/Camera.h"
 #include "Donya/Constant.h"			// Use DEBUG_MODE macro.
 #include "Donya/GamepadXInput.h"
+#include "Donya/Tween.h"
 #include "Donya/UseImGui.h"			// Use USE_IMGUI macro.
 
 #include "Boss.h"
@@ -71,7 +72,8 @@ private:
 	Scene::Type										nextScene			= Scene::Type::Null;
 	CameraState										currCameraStatus	= CameraState::Attract;
 	CameraState										beforeCameraStatus	= CameraState::Attract;
-	float											transCameraTime		= 1.0f; // 0.0f ~ 1.0f, Lerp( beforeCameraStatus -> currCameraStatus, time )
+	float											transCameraFactor	= 1.0f; // 0.0f ~ 1.0f(may overshoot by the easing), Lerp( beforeCameraStatus -> currCameraStatus, factor )
+	Donya::Tweener::Handle							cameraTween;
 
 	PerformanceState								performanceStatus	= PerformanceState::NotPerforming;
 
@@ -92,6 +94,8 @@ private:
 	int			horizDiffSignFromInitialPos = 0;
 	float		performTimer		= 0.0f;
 	float		afterDecidedTimer	= 0.0f;
+	float		pressedItemFadeFactor = 0.0f;	// Eased by the tween
+	Donya::Tweener::Handle pressedItemFadeTween;
 	Choice		chooseItem			= Choice::Start;
 	bool		wasDecided			= false;
 	bool		returnToAttract		= false; // It is valid when the performanceStatus == PerformanceState::NotPerforming
@@ -135,6 +139,10 @@ private:
 	const Donya::ICamera &GetCurrentCamera( CameraState key ) const;
 
 	Donya::Vector4x4 CalcLightViewMatrix() const;
+	/// <summary>
+	/// Returns the world space area that the light camera projects. The shadow casters out of it do not appear in the shadow map.
+	/// </summary>
+	Donya::Collision::Box3F CalcShadowCasterArea() const;
 
 	void	PlayerInit( const Map &terrain );
 	void	PlayerUpdate( float elapsedTime, const Map &terrain );
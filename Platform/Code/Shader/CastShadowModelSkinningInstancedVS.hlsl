@@ -0,0 +1,53 @@
+#include "CastShadowModel.hlsli"
+#include "ModelInstanced.hlsli"
+
+struct VS_IN
+{
+	float4	pos			: POSITION;
+	float4	normal		: NORMAL;
+	float4	tangent		: TANGENT;
+	float2	texCoord	: TEXCOORD0;
+	float4	weights		: WEIGHTS;
+	uint4	bones		: BONES;
+};
+
+cbuffer CBPerMesh : register( b2 )
+{
+	row_major
+	float4x4	cbAdjustMatrix;
+	uint		cbBoneCountPerInstance;
+	uint3		cb_paddings;
+};
+
+// Position only
+void ApplyBoneMatrices( uint instanceID, float4 boneWeights, uint4 boneIndices, inout float4 inoutPosition )
+{
+	const float4 inPosition	= float4( inoutPosition.xyz, 1.0f );
+	const uint   boneOffset	= instanceID * cbBoneCountPerInstance;
+	float3 resultPos		= { 0, 0, 0 };
+	float  weight			= 0;
+	row_major float4x4 transform = 0;
+	for ( int i = 0; i < 4/* float4 */; ++i )
+	{
+		weight			= boneWeights[i];
+		transform		= instanceBones[boneOffset + boneIndices[i]].transform;
+		resultPos		+= ( weight * mul( inPosition,	transform ) ).xyz;
+	}
+	inoutPosition	= float4( resultPos,    1.0f );
+}
+
+VS_OUT main( VS_IN vin, uint instanceID : SV_InstanceID )
+{
+	vin.pos.w		= 1.0f;
+	//vin.normal.w	= 0.0f;
+	//vin.tangent.w	= 0.0f;
+	ApplyBoneMatrices( instanceID, vin.weights, vin.bones, vin.pos );
+
+	float4x4 W		= mul( cbAdjustMatrix, instances[instanceID].world );
+	float4x4 WVP	= mul( W, cbViewProj );
+
+	VS_OUT vout		= ( VS_OUT )( 0 );
+	vout.svPos		= mul( vin.pos, WVP );
+	vout.lssPosNDC	= vout.svPos / vout.svPos.w;
+	return vout;
+}
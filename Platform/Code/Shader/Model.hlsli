@@ -11,6 +11,7 @@ struct VS_OUT
 	float4		tsEyeVec	: NORMAL1;		// (vertex->camera) vector in tangent space
 	float2		texCoord	: TEXCOORD0;
 	float2		shadowMapUV	: TEXCOORD1;
+	float4		color		: COLOR;		// Draw color, it is fetched per model or per instance
 };
 
 cbuffer CBPerScene : register( b0 )
@@ -0,0 +1,18 @@
+// The per instance data of instanced drawing.
+// These are used instead of the "CBPerModel".
+
+struct InstanceData
+{
+	float4		drawColor;
+	row_major
+	float4x4	world;
+};
+StructuredBuffer<InstanceData>	instances		: register( t3 );
+
+// [instance][bone], the "bone" count is the cbBoneCountPerInstance
+struct BoneTransform
+{
+	row_major
+	float4x4	transform;
+};
+StructuredBuffer<BoneTransform>	instanceBones	: register( t4 );
@@ -34,7 +34,7 @@ float4 main( VS_OUT pin ) : SV_TARGET
 	
 	float4	diffuseMapColor	= diffuseMap.Sample( diffuseMapSampler, pin.texCoord );
 			diffuseMapColor	= SRGBToLinear( diffuseMapColor );
-	float	diffuseAlpha	= diffuseMapColor.a * cbDrawColor.a;
+	float	diffuseAlpha	= diffuseMapColor.a * pin.color.a;
 	clip(	diffuseAlpha - 0.001f ); // Also discard the 0.0f
 
 	float3	totalLight		= CalcLightInfluence
@@ -55,7 +55,7 @@ float4 main( VS_OUT pin ) : SV_TARGET
 	}
 			totalLight		+= cbAmbient.rgb * cbAmbient.w;
 
-	float3	resultColor		= diffuseMapColor.rgb * totalLight * cbDrawColor.rgb;
+	float3	resultColor		= diffuseMapColor.rgb * totalLight * pin.color.rgb;
 	
 	float	pixelDepth		= pin.lssPosNDC.z - cbShadowBias;
 	float	shadowMapDepth	= shadowMap.Sample( shadowMapSampler, pin.shadowMapUV ).r;
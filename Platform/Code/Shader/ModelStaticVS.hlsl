@@ -38,5 +38,6 @@ VS_OUT main( VS_IN vin )
 	vout.tsEyeVec		=  normalize( mul( cbEyePosition - vout.wsPos, VT ) );
 	vout.texCoord		=  vin.texCoord;
 	vout.shadowMapUV	=  NDCToTexCoord( vout.lssPosNDC.xy );
+	vout.color			=  cbDrawColor;
 	return vout;
 }
@@ -0,0 +1,56 @@
+#include "StagePrefetch.h"
+
+#include "Donya/AsyncIO.h"
+#include "Donya/Constant.h"		// Use DEBUG_MODE
+
+#include "Boss.h"
+#include "CheckPoint.h"
+#include "ClearEvent.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "Map.h"
+#include "Player.h"
+#include "Room.h"
+
+namespace
+{
+	// The stage objects read the json in debug build
+#if DEBUG_MODE
+	constexpr bool IOFromBinary = false;
+#else
+	constexpr bool IOFromBinary = true;
+#endif // DEBUG_MODE
+}
+
+namespace StagePrefetch
+{
+	std::vector<std::string> MakeFilePaths( int stageNumber )
+	{
+		return std::vector<std::string>
+		{
+			Map::MakeModelFilePath( stageNumber ),
+			Map::MakeStageFilePath( stageNumber, /* fromBinary = */ true ), // Map::Init() reads the binary always
+			House::MakeStageFilePath( stageNumber, IOFromBinary ),
+			PlayerInitializer::MakeStageFilePath( stageNumber, IOFromBinary ),
+			CheckPoint::Container::MakeStageFilePath( stageNumber, IOFromBinary ),
+			ClearEvent::MakeStageFilePath( stageNumber, IOFromBinary ),
+			Boss::Container::MakeStageFilePath( stageNumber, IOFromBinary ),
+			Enemy::Admin::MakeStageFilePath( stageNumber, IOFromBinary ),
+			Item::Admin::MakeStageFilePath( stageNumber, IOFromBinary ),
+		};
+	}
+	void Request( int stageNumber )
+	{
+		for ( const auto &it : MakeFilePaths( stageNumber ) )
+		{
+			Donya::AsyncIO::Request( it );
+		}
+	}
+	void Release( int stageNumber )
+	{
+		for ( const auto &it : MakeFilePaths( stageNumber ) )
+		{
+			Donya::AsyncIO::Release( it );
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Reads the files of a stage into the memory by Donya::AsyncIO, before the stage is initialized.<para></para>
+/// The loadings of the stage(e.g. Map::Init(), House::Init()) parse the read buffers instead of the files.
+/// </summary>
+namespace StagePrefetch
+{
+	/// <summary>
+	/// Returns the files that the initialization of the stage reads.
+	/// </summary>
+	std::vector<std::string> MakeFilePaths( int stageNumber );
+	/// <summary>
+	/// Requests the reading of the stage files. It does not block.
+	/// </summary>
+	void Request( int stageNumber );
+	/// <summary>
+	/// Releases the read buffers of the stage.
+	/// </summary>
+	void Release( int stageNumber );
+}
@@ -0,0 +1,293 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Donya/Constant.h"		// Use scast macro
+#include "Donya/Profiler.h"		// Use Now()
+
+#undef max
+#undef min
+
+namespace
+{
+	constexpr float toSeconds = 0.000000001f;
+}
+
+float TaskGraph::Progress::Ratio() const
+{
+	return ( wholeCount == 0 ) ? 1.0f : scast<float>( finishedCount ) / scast<float>( wholeCount );
+}
+float TaskGraph::Statistics::CalcParallelism() const
+{
+	if ( wallSeconds <= 0.0f ) { return 0.0f; }
+	// else
+
+	float sum = 0.0f;
+	for ( const float &it : stageSeconds ) { sum += it; }
+	return sum / wallSeconds;
+}
+
+TaskGraph::~TaskGraph()
+{
+	Join();
+}
+
+TaskGraph::Handle TaskGraph::Add( const std::string &name, Stage stage, Affinity affinity, const Job &job, const std::vector<Handle> &dependencies )
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	_ASSERT_EXPR( !started, L"Error: Can not add a task after the start!" );
+
+	const Handle handle = tasks.size();
+
+	Task task{};
+	task.name		= name;
+	task.stage		= stage;
+	task.affinity	= affinity;
+	task.job		= job;
+	for ( const Handle &dependency : dependencies )
+	{
+		if ( handle <= dependency )
+		{
+			_ASSERT_EXPR( 0, L"Error: The dependency is invalid!" );
+			continue;
+		}
+		// else
+
+		tasks[dependency].dependents.emplace_back( handle );
+		task.waitingCount++;
+	}
+	tasks.emplace_back( std::move( task ) );
+
+	return handle;
+}
+void TaskGraph::Start( unsigned int workerCount, const std::function<void()> &workerBegin, const std::function<void()> &workerEnd )
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		if ( started ) { return; }
+		// else
+
+		started			= true;
+		stopRequested	= false;
+		onWorkerBegin	= workerBegin;
+		onWorkerEnd		= workerEnd;
+		beginNS			= Donya::Profiler::Now();
+		endNS			= beginNS;
+
+		const size_t taskCount = tasks.size();
+		for ( size_t i = 0; i < taskCount; ++i )
+		{
+			if ( tasks[i].waitingCount == 0 ) { Enqueue( i ); }
+		}
+	}
+
+	workerCount = std::max( 1U, workerCount );
+	startedWorkerCount = workerCount;
+	for ( unsigned int i = 0; i < workerCount; ++i )
+	{
+		workers.emplace_back( &TaskGraph::WorkerLoop, this );
+	}
+}
+size_t TaskGraph::RunMainThreadJobs( float budgetSeconds )
+{
+	const std::int64_t beginOfRun = Donya::Profiler::Now();
+
+	size_t ranCount = 0;
+	while ( true )
+	{
+		Handle handle = 0;
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			if ( mainQueue.empty() || stopRequested ) { break; }
+			// else
+
+			handle = mainQueue.front();
+			mainQueue.pop_front();
+		}
+
+		RunJob( handle );
+		ranCount++;
+
+		const float elapsed = scast<float>( Donya::Profiler::Now() - beginOfRun ) * toSeconds;
+		if ( budgetSeconds <= elapsed ) { break; }
+	}
+
+	return ranCount;
+}
+void TaskGraph::RunUntilFinished()
+{
+	while ( true )
+	{
+		RunMainThreadJobs( std::numeric_limits<float>::max() );
+
+		std::unique_lock<std::mutex> lock( mutex );
+		mainWakeUp.wait( lock, [&]() { return FinishedImpl() || stopRequested || !mainQueue.empty(); } );
+		if ( FinishedImpl() || stopRequested ) { break; }
+	}
+}
+void TaskGraph::Join()
+{
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		stopRequested = true;
+	}
+	workerWakeUp.notify_all();
+	mainWakeUp.notify_all();
+
+	for ( auto &it : workers )
+	{
+		if ( it.joinable() ) { it.join(); }
+	}
+	workers.clear();
+}
+
+bool TaskGraph::Finished() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return FinishedImpl();
+}
+bool TaskGraph::Succeeded() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+	return ( FinishedImpl() && failedCount == 0 );
+}
+TaskGraph::Progress TaskGraph::GetProgress() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	Progress progress{};
+	progress.finishedCount	= finishedCount;
+	progress.wholeCount		= tasks.size();
+	return progress;
+}
+TaskGraph::Statistics TaskGraph::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	Statistics statistics{};
+	statistics.workerCount	= startedWorkerCount;
+	statistics.failedCount	= failedCount;
+	if ( started )
+	{
+		const std::int64_t lastNS = ( FinishedImpl() ) ? endNS : Donya::Profiler::Now();
+		statistics.wallSeconds = scast<float>( lastNS - beginNS ) * toSeconds;
+	}
+	for ( const auto &it : tasks )
+	{
+		if ( !it.finished ) { continue; }
+		// else
+
+		const size_t stage = scast<size_t>( it.stage );
+		statistics.stageSeconds[stage] += it.seconds;
+		statistics.stageCounts[stage]++;
+	}
+	return statistics;
+}
+std::vector<std::string> TaskGraph::GetFailedNames() const
+{
+	std::lock_guard<std::mutex> lock( mutex );
+
+	std::vector<std::string> names;
+	for ( const auto &it : tasks )
+	{
+		if ( it.finished && !it.succeeded ) { names.emplace_back( it.name ); }
+	}
+	return names;
+}
+
+unsigned int TaskGraph::RecommendWorkerCount()
+{
+	// hardware_concurrency() may return zero if it is not computable
+	const unsigned int coreCount = std::thread::hardware_concurrency();
+	return ( coreCount <= 1 ) ? 1U : coreCount - 1;
+}
+
+void TaskGraph::WorkerLoop()
+{
+	if ( onWorkerBegin ) { onWorkerBegin(); }
+
+	while ( true )
+	{
+		Handle handle = 0;
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			workerWakeUp.wait( lock, [&]() { return stopRequested || FinishedImpl() || !workerQueue.empty(); } );
+			if ( stopRequested || workerQueue.empty() ) { break; }
+			// else
+
+			handle = workerQueue.front();
+			workerQueue.pop_front();
+		}
+
+		RunJob( handle );
+	}
+
+	if ( onWorkerEnd ) { onWorkerEnd(); }
+}
+bool TaskGraph::RunJob( Handle handle )
+{
+	// The job is not changed after the start, so I can call it without the lock
+	const Job &job = tasks[handle].job;
+
+	const std::int64_t jobBeginNS = Donya::Profiler::Now();
+	const bool succeeded = ( job ) ? job() : true;
+	const float seconds = scast<float>( Donya::Profiler::Now() - jobBeginNS ) * toSeconds;
+
+	std::lock_guard<std::mutex> lock( mutex );
+	Complete( handle, succeeded, seconds );
+
+	return succeeded;
+}
+void TaskGraph::Enqueue( Handle handle )
+{
+	if ( tasks[handle].blocked )
+	{
+		// Does not run the job that depends on a failed job
+		Complete( handle, /* succeeded = */ false, 0.0f );
+		return;
+	}
+	// else
+
+	if ( tasks[handle].affinity == Affinity::MainThread )
+	{
+		mainQueue.emplace_back( handle );
+		mainWakeUp.notify_all();
+	}
+	else
+	{
+		workerQueue.emplace_back( handle );
+		workerWakeUp.notify_one();
+	}
+}
+void TaskGraph::Complete( Handle handle, bool succeeded, float seconds )
+{
+	Task &task		= tasks[handle];
+	task.finished	= true;
+	task.succeeded	= succeeded;
+	task.seconds	= seconds;
+	finishedCount++;
+	if ( !succeeded ) { failedCount++; }
+
+	for ( const Handle &dependentHandle : task.dependents )
+	{
+		Task &dependent = tasks[dependentHandle];
+		if ( !succeeded ) { dependent.blocked = true; }
+
+		dependent.waitingCount--;
+		if ( dependent.waitingCount == 0 ) { Enqueue( dependentHandle ); }
+	}
+
+	if ( FinishedImpl() )
+	{
+		endNS = Donya::Profiler::Now();
+
+		// Let the waiting threads exit
+		workerWakeUp.notify_all();
+		mainWakeUp.notify_all();
+	}
+}
+bool TaskGraph::FinishedImpl() const
+{
+	return ( finishedCount == tasks.size() );
+}
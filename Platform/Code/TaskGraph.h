@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// Runs the jobs that depend on each other by a worker pool, e.g. the loading of assets.<para></para>
+/// A job that must run on the main thread(e.g. it uses the immediate-context) is marshalled to a queue, and it runs in RunMainThreadJobs().<para></para>
+/// If a job fails, the jobs that depend on it are not run and regarded as failed.
+/// </summary>
+class TaskGraph
+{
+public:
+	/// <summary>
+	/// It is used for the statistics only.
+	/// </summary>
+	enum class Stage
+	{
+		Read,		// File read
+		Decode,		// Parse, decompress, etc.
+		Upload,		// Create the GPU resources
+		Other,
+
+		StageCount
+	};
+	enum class Affinity
+	{
+		Worker,
+		MainThread,
+	};
+	using Handle	= size_t;
+	using Job		= std::function<bool()>;
+	static constexpr size_t stageCount = static_cast<size_t>( Stage::StageCount );
+public:
+	struct Progress
+	{
+		size_t	finishedCount	= 0;
+		size_t	wholeCount		= 0;
+	public:
+		float	Ratio() const;
+	};
+	struct Statistics
+	{
+		unsigned int	workerCount		= 0;
+		size_t			failedCount		= 0;
+		float			wallSeconds		= 0.0f;	// From Start() to the finish of the last job, or until now
+		std::array<float,  stageCount>	stageSeconds{};	// Sum of the job times of each stage
+		std::array<size_t, stageCount>	stageCounts{};
+	public:
+		/// <summary>
+		/// The sum of the job times divided by the wall time.
+		/// </summary>
+		float	CalcParallelism() const;
+	};
+private:
+	struct Task
+	{
+		std::string			name;
+		Stage				stage		= Stage::Other;
+		Affinity			affinity	= Affinity::Worker;
+		Job					job;
+		std::vector<Handle>	dependents;
+		size_t				waitingCount	= 0;	// The count of unfinished dependencies
+		bool				blocked			= false;// A dependency has failed
+		bool				finished		= false;
+		bool				succeeded		= false;
+		float				seconds			= 0.0f;
+	};
+private:
+	std::vector<Task>			tasks;
+	std::vector<std::thread>	workers;
+	std::deque<Handle>			workerQueue;
+	std::deque<Handle>			mainQueue;
+	mutable std::mutex			mutex;
+	std::condition_variable		workerWakeUp;
+	std::condition_variable		mainWakeUp;
+	size_t						finishedCount	= 0;
+	size_t						failedCount		= 0;
+	unsigned int				startedWorkerCount	= 0;
+	bool						started			= false;
+	bool						stopRequested	= false;
+	std::int64_t				beginNS			= 0;
+	std::int64_t				endNS			= 0;
+	std::function<void()>		onWorkerBegin;
+	std::function<void()>		onWorkerEnd;
+public:
+	TaskGraph() = default;
+	~TaskGraph();
+	TaskGraph( const TaskGraph &  ) = delete;
+	TaskGraph( const TaskGraph && ) = delete;
+	TaskGraph & operator = ( const TaskGraph &  ) = delete;
+	TaskGraph & operator = ( const TaskGraph && ) = delete;
+public:
+	/// <summary>
+	/// Please call before Start(). The "dependencies" must be the handles that were returned by Add().
+	/// </summary>
+	Handle	Add( const std::string &name, Stage stage, Affinity affinity, const Job &job, const std::vector<Handle> &dependencies = {} );
+	/// <summary>
+	/// Starts the workers. The "onWorkerBegin" and "onWorkerEnd" are called on each worker thread, e.g. for CoInitializeEx().
+	/// </summary>
+	void	Start( unsigned int workerCount, const std::function<void()> &onWorkerBegin = nullptr, const std::function<void()> &onWorkerEnd = nullptr );
+	/// <summary>
+	/// Runs the marshalled jobs on the calling thread, until the queue becomes empty or the "budgetSeconds" elapses.<para></para>
+	/// One job is run at least if exists. Returns the count of the ran jobs.
+	/// </summary>
+	size_t	RunMainThreadJobs( float budgetSeconds );
+	/// <summary>
+	/// Runs the marshalled jobs on the calling thread, and blocks until all jobs are finished.
+	/// </summary>
+	void	RunUntilFinished();
+	/// <summary>
+	/// Stops the workers. The jobs that have not been started are not run.
+	/// </summary>
+	void	Join();
+public:
+	bool		Finished()		const;
+	bool		Succeeded()		const;
+	Progress	GetProgress()	const;
+	Statistics	GetStatistics()	const;
+	/// <summary>
+	/// Returns the names of the failed jobs.
+	/// </summary>
+	std::vector<std::string> GetFailedNames() const;
+public:
+	/// <summary>
+	/// Returns the count that leaves a core for the main thread. It is one at least.
+	/// </summary>
+	static unsigned int RecommendWorkerCount();
+private:
+	void	WorkerLoop();
+	bool	RunJob( Handle handle );
+	// These require the lock.
+	void	Enqueue( Handle handle );
+	void	Complete( Handle handle, bool succeeded, float seconds );
+	bool	FinishedImpl() const;
+};
@@ -1,13 +1,16 @@
 #include <locale.h>
+#include <string>
 #include <time.h>
 #include <windows.h>
 
 #include "Donya/Constant.h"
 #include "Donya/Donya.h"
+#include "Donya/Profiler.h"
 #include "Donya/Useful.h"
 
 #include "Common.h"
 #include "Effect/EffectAdmin.h"
+#include "Effect/Particle.h"
 #include "Framework.h"
 #include "Icon.h"
 
@@ -16,6 +19,8 @@ namespace
 	constexpr auto mbTellFatalError	= MB_OK | MB_ICONERROR;
 	constexpr UINT waitToSync		= 1U;
 	constexpr UINT dontWaitToSync	= 0U;
+
+	constexpr const wchar_t *noAudioOption = L"-noaudio"; // Run without the audio device, e.g. benchmarks on a headless machine
 }
 
 INT WINAPI wWinMain( _In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _In_ LPWSTR cmdLine, _In_ INT cmdShow )
@@ -45,6 +50,7 @@ INT WINAPI wWinMain( _In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _
 	desc.windowCaption		= "Mimit";
 	desc.enableCaptionBar	= true;
 	desc.fullScreenMode		= false;
+	desc.enableAudioDevice	= ( !cmdLine || std::wstring{ cmdLine }.find( noAudioOption ) == std::wstring::npos );
 	initResult = Donya::Init( cmdShow, desc );
 	if ( !initResult )
 	{
@@ -56,6 +62,7 @@ INT WINAPI wWinMain( _In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _
 	Donya::SetWindowIcon( instance, IDI_ICON );
 
 	Effect::Admin::Get().Init( Donya::GetDevice(), Donya::GetImmediateContext() );
+	Effect::Particle::Admin::Get().Init();
 	
 	Framework framework{};
 	initResult = framework.Init();
@@ -73,6 +80,8 @@ INT WINAPI wWinMain( _In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _
 	constexpr UINT syncInterval = waitToSync;
 #endif // DEBUG_MODE
 
+	Donya::Profiler::SetThreadName( "Main" );
+
 	while ( Donya::MessageLoop() )
 	{
 		Donya::ClearViews();
@@ -81,11 +90,12 @@ INT WINAPI wWinMain( _In_ HINSTANCE instance, _In_opt_ HINSTANCE prevInstance, _
 		framework.Update( Donya::GetElapsedTime() );
 
 		framework.Draw( Donya::GetElapsedTime() );
-		Donya::Present( syncInterval );
+		framework.Present( syncInterval );
 	}
 
 	framework.Uninit();
 
+	Effect::Particle::Admin::Get().Uninit();
 	Effect::Admin::Get().Uninit();
 
 	auto   returnValue = Donya::Uninit();